@@ -0,0 +1,55 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickCompressor_h
+#define itkBrickCompressor_h
+
+#include "itkIntTypes.h"
+#include "ITKCommonExport.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class BrickCompressor
+ * \brief Compresses and decompresses the bricks of a BrickedImage with the
+ * zlib library configured for ITK.
+ *
+ * \sa BrickedImage
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT BrickCompressor
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BrickCompressor);
+
+  using CompressedBufferType = std::vector<unsigned char>;
+
+  /** Compress numberOfBytes bytes of data into compressed, at the given
+   * compression level, from 1 (fastest) to 9 (smallest).  Throws an
+   * ExceptionObject on failure. */
+  static void
+  Compress(const void * data, SizeValueType numberOfBytes, int level, CompressedBufferType & compressed);
+
+  /** Decompress compressed into the numberOfBytes bytes of data.  Throws an
+   * ExceptionObject on failure, or when the size does not match. */
+  static void
+  Decompress(const CompressedBufferType & compressed, void * data, SizeValueType numberOfBytes);
+};
+} // end namespace itk
+
+#endif
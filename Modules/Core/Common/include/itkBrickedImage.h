@@ -0,0 +1,241 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImage_h
+#define itkBrickedImage_h
+
+#include "itkImageBase.h"
+#include "itkBrickCompressor.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+/** \class BrickedImage
+ * \brief An image stored as fixed-size bricks, compressed in memory.
+ *
+ * The buffered region is divided into bricks of BrickSize pixels, the
+ * bricks at the upper borders being cropped.  Each brick is stored either as
+ * a single value, when all its pixels are equal, or compressed with zlib.
+ * The most recently used bricks are kept decompressed, up to
+ * MaximumNumberOfCachedBricks of them; the least recently used one is
+ * compressed again, if it was modified, when another brick is needed.  So
+ * large volumes of sparse or label data take a fraction of the memory of an
+ * Image, while still allowing random access through GetPixel() and
+ * SetPixel().
+ *
+ * Unlike Image, a BrickedImage has no contiguous pixel buffer, so it cannot
+ * be processed by the filters that take an Image.  Its pixels are accessed
+ * with GetPixel() and SetPixel(), or, faster, brick by brick with
+ * BrickedImageRegionConstIterator and BrickedImageRegionIterator.  A brick
+ * that is referenced by an iterator, or by a buffer returned by
+ * GetBrickBuffer(), is not evicted from the cache.
+ *
+ * GetPixel(), SetPixel() and GetBrickBuffer() may be called from several
+ * threads; writing the same brick from several threads is not supported.
+ *
+ * TPixel must be trivially copyable.
+ *
+ * \sa BrickCompressor
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+template <typename TPixel, unsigned int VImageDimension = 2>
+class ITK_TEMPLATE_EXPORT BrickedImage : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BrickedImage);
+
+  /** Standard class type aliases. */
+  using Self = BrickedImage;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(BrickedImage);
+
+  static_assert(std::is_trivially_copyable_v<TPixel>, "The pixels of a BrickedImage must be trivially copyable.");
+
+  /** Pixel type alias. */
+  using PixelType = TPixel;
+  using ValueType = TPixel;
+
+  /** Dimension of the image. */
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  /** Types derived from the Superclass */
+  using typename Superclass::IndexType;
+  using typename Superclass::IndexValueType;
+  using typename Superclass::SizeType;
+  using typename Superclass::SizeValueType;
+  using typename Superclass::OffsetValueType;
+  using typename Superclass::RegionType;
+
+  /** The decompressed pixels of a brick, in the order of an Image of the
+   * size of the brick. */
+  using BrickBufferType = std::vector<PixelType>;
+  using BrickBufferPointer = std::shared_ptr<BrickBufferType>;
+  using BrickBufferConstPointer = std::shared_ptr<const BrickBufferType>;
+
+  /** Set/Get the size of the bricks.  Takes effect at the next Allocate().
+   * Defaults to 32 pixels along every dimension. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BrickSize, SizeType);
+  itkGetConstReferenceMacro(BrickSize, SizeType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the number of bricks kept decompressed.  Defaults to 64. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(MaximumNumberOfCachedBricks, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(MaximumNumberOfCachedBricks, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the zlib compression level, from 1 (fastest, the default) to
+   * 9 (smallest). */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(CompressionLevel, int, 1, 9);
+  itkGetConstMacro(CompressionLevel, int);
+  /** @ITKEndGrouping */
+
+  /** Allocate the bricks of the buffered region.  All the pixels are zero
+   * initialized, as a single value per brick, whatever initialize. */
+  void
+  Allocate(bool initialize = false) override;
+
+  /** Restore the image to its initial state, releasing the bricks. */
+  void
+  Initialize() override;
+
+  /** Set all the pixels to value, releasing the compressed bricks. */
+  void
+  FillBuffer(const PixelType & value);
+
+  /** Get/Set a pixel of the buffered region. */
+  /** @ITKStartGrouping */
+  PixelType
+  GetPixel(const IndexType & index) const;
+  void
+  SetPixel(const IndexType & index, const PixelType & value);
+  /** @ITKEndGrouping */
+
+  /** The number of bricks of the buffered region. */
+  SizeValueType
+  GetNumberOfBricks() const
+  {
+    return static_cast<SizeValueType>(m_Bricks.size());
+  }
+
+  /** The number of bricks along each dimension. */
+  itkGetConstReferenceMacro(NumberOfBricksPerDimension, SizeType);
+
+  /** The region of brick brickNumber.  The bricks are numbered with the
+   * first dimension varying fastest. */
+  RegionType
+  GetBrickRegion(SizeValueType brickNumber) const;
+
+  /** The number of the brick that contains index. */
+  SizeValueType
+  ComputeBrickNumber(const IndexType & index) const;
+
+  /** The decompressed pixels of brick brickNumber, which stays in the cache
+   * as long as the returned buffer is referenced.  The non-const overload
+   * marks the brick as modified. */
+  /** @ITKStartGrouping */
+  BrickBufferPointer
+  GetBrickBuffer(SizeValueType brickNumber);
+  BrickBufferConstPointer
+  GetBrickBuffer(SizeValueType brickNumber) const;
+  /** @ITKEndGrouping */
+
+  /** Compress the modified bricks of the cache, and release those that are
+   * not referenced. */
+  void
+  FlushCache();
+
+  /** The number of bricks currently decompressed. */
+  SizeValueType
+  GetNumberOfCachedBricks() const;
+
+  /** The size, in bytes, of the compressed bricks.  The bricks modified
+   * since the last FlushCache(), or eviction from the cache, are counted
+   * with their previous size. */
+  SizeValueType
+  GetCompressedBufferSize() const;
+
+protected:
+  BrickedImage();
+  ~BrickedImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  struct Brick
+  {
+    BrickCompressor::CompressedBufferType       Compressed{};
+    PixelType                                   UniformValue{};
+    bool                                        Uniform{ true };
+    bool                                        Modified{ false };
+    BrickBufferPointer                          Buffer{};
+    typename std::list<SizeValueType>::iterator CachePosition{};
+  };
+
+  /** Decompresses brick brickNumber into the cache, if needed, and returns
+   * its pixels.  m_Mutex must be locked. */
+  const BrickBufferPointer &
+  LoadBrick(SizeValueType brickNumber) const;
+
+  /** Compresses the pixels of brick.  m_Mutex must be locked. */
+  void
+  StoreBrick(Brick & brick) const;
+
+  /** Releases the least recently used bricks that are not referenced, until
+   * there is room for another brick in the cache.  m_Mutex must be locked. */
+  void
+  EvictBricks() const;
+
+  /** The brick that contains index, and the offset of index in it. */
+  void
+  ComputeBrickNumberAndOffset(const IndexType & index, SizeValueType & brickNumber, OffsetValueType & offset) const;
+
+  SizeType      m_BrickSize{};
+  SizeValueType m_MaximumNumberOfCachedBricks{ 64 };
+  int           m_CompressionLevel{ 1 };
+  SizeType      m_NumberOfBricksPerDimension{};
+
+  /** The bricks, and the numbers of the cached ones, most recently used
+   * first.  Both are updated by const methods, under m_Mutex. */
+  mutable std::vector<Brick>       m_Bricks{};
+  mutable std::list<SizeValueType> m_CachedBricks{};
+  mutable std::mutex               m_Mutex{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBrickedImage.hxx"
+#endif
+
+#endif
@@ -0,0 +1,335 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImage_hxx
+#define itkBrickedImage_hxx
+
+#include <algorithm>
+#include <cstring>
+
+namespace itk
+{
+
+template <typename TPixel, unsigned int VImageDimension>
+BrickedImage<TPixel, VImageDimension>::BrickedImage()
+{
+  m_BrickSize.Fill(32);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::Allocate(bool itkNotUsed(initialize))
+{
+  this->ComputeOffsetTable();
+
+  const SizeType & bufferedSize = this->GetBufferedRegion().GetSize();
+  SizeValueType    numberOfBricks = 1;
+  for (unsigned int i = 0; i < VImageDimension; ++i)
+  {
+    if (m_BrickSize[i] == 0)
+    {
+      itkExceptionMacro("BrickSize must be positive along every dimension: " << m_BrickSize);
+    }
+    m_NumberOfBricksPerDimension[i] = (bufferedSize[i] + m_BrickSize[i] - 1) / m_BrickSize[i];
+    numberOfBricks *= m_NumberOfBricksPerDimension[i];
+  }
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_CachedBricks.clear();
+  m_Bricks.clear();
+  m_Bricks.resize(numberOfBricks);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::Initialize()
+{
+  Superclass::Initialize();
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_CachedBricks.clear();
+  m_Bricks.clear();
+  m_Bricks.shrink_to_fit();
+  m_NumberOfBricksPerDimension.Fill(0);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::FillBuffer(const PixelType & value)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_CachedBricks.clear();
+  for (Brick & brick : m_Bricks)
+  {
+    brick = Brick{};
+    brick.UniformValue = value;
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::GetPixel(const IndexType & index) const -> PixelType
+{
+  SizeValueType   brickNumber;
+  OffsetValueType offset;
+  this->ComputeBrickNumberAndOffset(index, brickNumber, offset);
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  const Brick &                     brick = m_Bricks[brickNumber];
+  if (!brick.Buffer && brick.Uniform)
+  {
+    return brick.UniformValue;
+  }
+  return (*this->LoadBrick(brickNumber))[offset];
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::SetPixel(const IndexType & index, const PixelType & value)
+{
+  SizeValueType   brickNumber;
+  OffsetValueType offset;
+  this->ComputeBrickNumberAndOffset(index, brickNumber, offset);
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  (*this->LoadBrick(brickNumber))[offset] = value;
+  m_Bricks[brickNumber].Modified = true;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::GetBrickRegion(SizeValueType brickNumber) const -> RegionType
+{
+  const RegionType & bufferedRegion = this->GetBufferedRegion();
+  RegionType         region;
+  for (unsigned int i = 0; i < VImageDimension; ++i)
+  {
+    const SizeValueType gridIndex = brickNumber % m_NumberOfBricksPerDimension[i];
+    brickNumber /= m_NumberOfBricksPerDimension[i];
+
+    const SizeValueType start = gridIndex * m_BrickSize[i];
+    region.SetIndex(i, bufferedRegion.GetIndex(i) + static_cast<IndexValueType>(start));
+    region.SetSize(i, std::min(m_BrickSize[i], bufferedRegion.GetSize(i) - start));
+  }
+  return region;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::ComputeBrickNumber(const IndexType & index) const -> SizeValueType
+{
+  SizeValueType   brickNumber;
+  OffsetValueType offset;
+  this->ComputeBrickNumberAndOffset(index, brickNumber, offset);
+  return brickNumber;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::GetBrickBuffer(SizeValueType brickNumber) -> BrickBufferPointer
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  BrickBufferPointer                buffer = this->LoadBrick(brickNumber);
+  m_Bricks[brickNumber].Modified = true;
+  return buffer;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::GetBrickBuffer(SizeValueType brickNumber) const -> BrickBufferConstPointer
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return this->LoadBrick(brickNumber);
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::FlushCache()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto it = m_CachedBricks.begin(); it != m_CachedBricks.end();)
+  {
+    Brick &    brick = m_Bricks[*it];
+    const bool referenced = brick.Buffer.use_count() > 1;
+    if (brick.Modified)
+    {
+      this->StoreBrick(brick);
+      // A referenced brick may still be written to.
+      brick.Modified = referenced;
+    }
+    if (referenced)
+    {
+      ++it;
+    }
+    else
+    {
+      brick.Buffer.reset();
+      it = m_CachedBricks.erase(it);
+    }
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::GetNumberOfCachedBricks() const -> SizeValueType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_CachedBricks.size());
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::GetCompressedBufferSize() const -> SizeValueType
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  SizeValueType                     size = 0;
+  for (const Brick & brick : m_Bricks)
+  {
+    size += brick.Uniform ? sizeof(PixelType) : brick.Compressed.size();
+  }
+  return size;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+auto
+BrickedImage<TPixel, VImageDimension>::LoadBrick(SizeValueType brickNumber) const -> const BrickBufferPointer &
+{
+  Brick & brick = m_Bricks[brickNumber];
+  if (brick.Buffer)
+  {
+    m_CachedBricks.splice(m_CachedBricks.begin(), m_CachedBricks, brick.CachePosition);
+    return brick.Buffer;
+  }
+
+  this->EvictBricks();
+
+  const SizeValueType numberOfPixels = this->GetBrickRegion(brickNumber).GetNumberOfPixels();
+  auto                buffer = std::make_shared<BrickBufferType>(numberOfPixels, brick.UniformValue);
+  if (!brick.Uniform)
+  {
+    BrickCompressor::Decompress(brick.Compressed, buffer->data(), numberOfPixels * sizeof(PixelType));
+  }
+  brick.Buffer = std::move(buffer);
+  m_CachedBricks.push_front(brickNumber);
+  brick.CachePosition = m_CachedBricks.begin();
+  return brick.Buffer;
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::StoreBrick(Brick & brick) const
+{
+  const BrickBufferType & pixels = *brick.Buffer;
+
+  // A brick whose pixels are all equal is stored as a single value.
+  const auto isUniform = std::all_of(pixels.cbegin(), pixels.cend(), [&pixels](const PixelType & pixel) {
+    return std::memcmp(&pixel, pixels.data(), sizeof(PixelType)) == 0;
+  });
+  if (isUniform)
+  {
+    brick.Uniform = true;
+    brick.UniformValue = pixels.front();
+    brick.Compressed = {};
+  }
+  else
+  {
+    brick.Uniform = false;
+    BrickCompressor::Compress(pixels.data(), pixels.size() * sizeof(PixelType), m_CompressionLevel, brick.Compressed);
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::EvictBricks() const
+{
+  auto it = m_CachedBricks.end();
+  while (m_CachedBricks.size() >= m_MaximumNumberOfCachedBricks && it != m_CachedBricks.begin())
+  {
+    --it;
+    Brick & brick = m_Bricks[*it];
+    if (brick.Buffer.use_count() > 1)
+    {
+      // Referenced by an iterator, or by a buffer returned to the user.
+      continue;
+    }
+    if (brick.Modified)
+    {
+      this->StoreBrick(brick);
+      brick.Modified = false;
+    }
+    brick.Buffer.reset();
+    it = m_CachedBricks.erase(it);
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::ComputeBrickNumberAndOffset(const IndexType & index,
+                                                                   SizeValueType &   brickNumber,
+                                                                   OffsetValueType & offset) const
+{
+  const RegionType & bufferedRegion = this->GetBufferedRegion();
+  SizeValueType      brickStride = 1;
+  OffsetValueType    pixelStride = 1;
+  brickNumber = 0;
+  offset = 0;
+  for (unsigned int i = 0; i < VImageDimension; ++i)
+  {
+    const auto          position = static_cast<SizeValueType>(index[i] - bufferedRegion.GetIndex(i));
+    const SizeValueType gridIndex = position / m_BrickSize[i];
+    const SizeValueType start = gridIndex * m_BrickSize[i];
+
+    brickNumber += gridIndex * brickStride;
+    brickStride *= m_NumberOfBricksPerDimension[i];
+    offset += static_cast<OffsetValueType>(position - start) * pixelStride;
+    pixelStride *= static_cast<OffsetValueType>(std::min(m_BrickSize[i], bufferedRegion.GetSize(i) - start));
+  }
+}
+
+
+template <typename TPixel, unsigned int VImageDimension>
+void
+BrickedImage<TPixel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BrickSize: " << m_BrickSize << std::endl;
+  os << indent << "MaximumNumberOfCachedBricks: " << m_MaximumNumberOfCachedBricks << std::endl;
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "NumberOfBricksPerDimension: " << m_NumberOfBricksPerDimension << std::endl;
+  os << indent << "NumberOfBricks: " << m_Bricks.size() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImageRegionConstIterator_h
+#define itkBrickedImageRegionConstIterator_h
+
+#include "itkBrickedImage.h"
+
+namespace itk
+{
+/** \class BrickedImageRegionConstIterator
+ * \brief A read-only iterator over a region of a BrickedImage, brick by
+ * brick.
+ *
+ * The iterator visits the bricks that intersect the region in increasing
+ * brick number, and the pixels of each brick in the order of
+ * ImageRegionConstIterator, so that each brick is decompressed only once.
+ * The current brick stays in the cache of the image as long as the iterator
+ * is on it.
+ *
+ * \code
+   itk::BrickedImageRegionConstIterator<BrickedImageType> it(image, region);
+   for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+   {
+     sum += it.Get();
+   }
+   \endcode
+ *
+ * \sa BrickedImage, BrickedImageRegionIterator
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT BrickedImageRegionConstIterator
+{
+public:
+  /** Standard class type aliases. */
+  using Self = BrickedImageRegionConstIterator;
+
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using SizeType = typename ImageType::SizeType;
+  using RegionType = typename ImageType::RegionType;
+  using SizeValueType = typename ImageType::SizeValueType;
+  using OffsetValueType = typename ImageType::OffsetValueType;
+  using BrickBufferConstPointer = typename ImageType::BrickBufferConstPointer;
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+
+  /** Default constructor.  The iterator is at end. */
+  BrickedImageRegionConstIterator() = default;
+
+  /** Iterate over region, which must be inside the buffered region of
+   * image. */
+  BrickedImageRegionConstIterator(const ImageType * image, const RegionType & region)
+    : BrickedImageRegionConstIterator(image, region, false)
+  {}
+
+  /** Move to the first pixel of the region. */
+  void
+  GoToBegin();
+
+  /** Whether the iterator is past the last pixel of the region. */
+  bool
+  IsAtEnd() const
+  {
+    return m_IsAtEnd;
+  }
+
+  /** Move to the next pixel. */
+  Self &
+  operator++();
+
+  /** The value of the current pixel. */
+  const PixelType &
+  Get() const
+  {
+    return m_Buffer[m_Offset];
+  }
+
+  /** The index of the current pixel. */
+  const IndexType &
+  GetIndex() const
+  {
+    return m_Index;
+  }
+
+  /** The number of the current brick. */
+  SizeValueType
+  GetBrickNumber() const
+  {
+    return m_BrickNumber;
+  }
+
+  /** The region iterated over. */
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+protected:
+  BrickedImageRegionConstIterator(const ImageType * image, const RegionType & region, bool writable);
+
+  /** Acquire the current brick and move to the first pixel of its
+   * intersection with the region. */
+  void
+  LoadBrick();
+
+  /** The offset of m_Index in the current brick. */
+  OffsetValueType
+  ComputeOffset() const;
+
+  typename ImageType::ConstPointer m_Image{};
+  RegionType                       m_Region{};
+  bool                             m_Writable{ false };
+
+  /** The bricks that intersect the region, as a box of the brick grid, and
+   * the position of the current brick in it. */
+  SizeType m_FirstBrick{};
+  SizeType m_EndBrick{};
+  SizeType m_Brick{};
+
+  SizeValueType           m_BrickNumber{ 0 };
+  RegionType              m_BrickRegion{};
+  IndexType               m_BeginIndex{};
+  IndexType               m_EndIndex{};
+  OffsetValueType         m_OffsetTable[ImageDimension]{};
+  BrickBufferConstPointer m_BrickBuffer{};
+  const PixelType *       m_Buffer{ nullptr };
+  OffsetValueType         m_Offset{ 0 };
+  IndexType               m_Index{};
+  bool                    m_IsAtEnd{ true };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBrickedImageRegionConstIterator.hxx"
+#endif
+
+#endif
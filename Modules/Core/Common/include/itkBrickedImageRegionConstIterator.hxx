@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImageRegionConstIterator_hxx
+#define itkBrickedImageRegionConstIterator_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TImage>
+BrickedImageRegionConstIterator<TImage>::BrickedImageRegionConstIterator(const ImageType *  image,
+                                                                         const RegionType & region,
+                                                                         bool               writable)
+  : m_Image(image)
+  , m_Region(region)
+  , m_Writable(writable)
+{
+  const RegionType & bufferedRegion = image->GetBufferedRegion();
+  if (!bufferedRegion.IsInside(region))
+  {
+    itkGenericExceptionMacro("Region " << region << " is outside of the buffered region " << bufferedRegion);
+  }
+
+  const SizeType & brickSize = image->GetBrickSize();
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const auto first = static_cast<SizeValueType>(region.GetIndex(i) - bufferedRegion.GetIndex(i));
+    m_FirstBrick[i] = first / brickSize[i];
+    m_EndBrick[i] = region.GetSize(i) > 0 ? (first + region.GetSize(i) - 1) / brickSize[i] + 1 : m_FirstBrick[i];
+  }
+  this->GoToBegin();
+}
+
+
+template <typename TImage>
+void
+BrickedImageRegionConstIterator<TImage>::GoToBegin()
+{
+  if (m_Image.IsNull() || m_Region.GetNumberOfPixels() == 0)
+  {
+    m_IsAtEnd = true;
+    return;
+  }
+  m_Brick = m_FirstBrick;
+  this->LoadBrick();
+  m_IsAtEnd = false;
+}
+
+
+template <typename TImage>
+auto
+BrickedImageRegionConstIterator<TImage>::operator++() -> Self &
+{
+  ++m_Offset;
+  ++m_Index[0];
+  if (m_Index[0] < m_EndIndex[0])
+  {
+    return *this;
+  }
+
+  // Move to the next line of the current brick.
+  m_Index[0] = m_BeginIndex[0];
+  for (unsigned int i = 1; i < ImageDimension; ++i)
+  {
+    ++m_Index[i];
+    if (m_Index[i] < m_EndIndex[i])
+    {
+      m_Offset = this->ComputeOffset();
+      return *this;
+    }
+    m_Index[i] = m_BeginIndex[i];
+  }
+
+  // Move to the next brick.
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    ++m_Brick[i];
+    if (m_Brick[i] < m_EndBrick[i])
+    {
+      this->LoadBrick();
+      return *this;
+    }
+    m_Brick[i] = m_FirstBrick[i];
+  }
+
+  m_IsAtEnd = true;
+  m_BrickBuffer.reset();
+  m_Buffer = nullptr;
+  return *this;
+}
+
+
+template <typename TImage>
+void
+BrickedImageRegionConstIterator<TImage>::LoadBrick()
+{
+  const SizeType & numberOfBricks = m_Image->GetNumberOfBricksPerDimension();
+  SizeValueType    stride = 1;
+  m_BrickNumber = 0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    m_BrickNumber += m_Brick[i] * stride;
+    stride *= numberOfBricks[i];
+  }
+  m_BrickRegion = m_Image->GetBrickRegion(m_BrickNumber);
+
+  OffsetValueType offsetStride = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    m_BeginIndex[i] = std::max(m_Region.GetIndex(i), m_BrickRegion.GetIndex(i));
+    m_EndIndex[i] = std::min(m_Region.GetUpperIndex()[i], m_BrickRegion.GetUpperIndex()[i]) + 1;
+    m_OffsetTable[i] = offsetStride;
+    offsetStride *= static_cast<OffsetValueType>(m_BrickRegion.GetSize(i));
+  }
+
+  // Release the previous brick first, so that it may leave the cache.
+  m_BrickBuffer.reset();
+  if (m_Writable)
+  {
+    m_BrickBuffer = const_cast<ImageType *>(m_Image.GetPointer())->GetBrickBuffer(m_BrickNumber);
+  }
+  else
+  {
+    m_BrickBuffer = m_Image->GetBrickBuffer(m_BrickNumber);
+  }
+  m_Buffer = m_BrickBuffer->data();
+
+  m_Index = m_BeginIndex;
+  m_Offset = this->ComputeOffset();
+}
+
+
+template <typename TImage>
+auto
+BrickedImageRegionConstIterator<TImage>::ComputeOffset() const -> OffsetValueType
+{
+  OffsetValueType offset = 0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    offset += (m_Index[i] - m_BrickRegion.GetIndex(i)) * m_OffsetTable[i];
+  }
+  return offset;
+}
+
+} // end namespace itk
+
+#endif
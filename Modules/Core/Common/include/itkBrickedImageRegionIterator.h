@@ -0,0 +1,81 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBrickedImageRegionIterator_h
+#define itkBrickedImageRegionIterator_h
+
+#include "itkBrickedImageRegionConstIterator.h"
+
+namespace itk
+{
+/** \class BrickedImageRegionIterator
+ * \brief A read-write iterator over a region of a BrickedImage, brick by
+ * brick.
+ *
+ * Every brick visited is marked as modified, and compressed again when it
+ * leaves the cache of the image.
+ *
+ * \sa BrickedImage, BrickedImageRegionConstIterator
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT BrickedImageRegionIterator : public BrickedImageRegionConstIterator<TImage>
+{
+public:
+  /** Standard class type aliases. */
+  using Self = BrickedImageRegionIterator;
+  using Superclass = BrickedImageRegionConstIterator<TImage>;
+
+  using typename Superclass::ImageType;
+  using typename Superclass::PixelType;
+  using typename Superclass::RegionType;
+
+  /** Default constructor.  The iterator is at end. */
+  BrickedImageRegionIterator() = default;
+
+  /** Iterate over region, which must be inside the buffered region of
+   * image. */
+  BrickedImageRegionIterator(ImageType * image, const RegionType & region)
+    : Superclass(image, region, true)
+  {}
+
+  /** Set the value of the current pixel. */
+  void
+  Set(const PixelType & value) const
+  {
+    this->Value() = value;
+  }
+
+  /** A reference to the current pixel. */
+  PixelType &
+  Value() const
+  {
+    return const_cast<PixelType *>(this->m_Buffer)[this->m_Offset];
+  }
+
+  /** Move to the next pixel. */
+  Self &
+  operator++()
+  {
+    Superclass::operator++();
+    return *this;
+  }
+};
+} // end namespace itk
+
+#endif
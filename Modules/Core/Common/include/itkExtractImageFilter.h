@@ -270,6 +270,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Write the extraction region and the direction collapse strategy, so
+   * that the filter can use the PipelineOutputCache. */
+  bool
+  AppendParametersToOutputCacheKey(std::ostream & key) const override;
+
   /** ExtractImageFilter can produce an image which is a different
    * resolution than its input image.  As such, ExtractImageFilter
    * needs to provide an implementation for
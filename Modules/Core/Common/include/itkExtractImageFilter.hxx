@@ -43,6 +43,15 @@ ExtractImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Inde
   os << indent << "DirectionCollapseStrategy: " << m_DirectionCollapseStrategy << std::endl;
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+ExtractImageFilter<TInputImage, TOutputImage>::AppendParametersToOutputCacheKey(std::ostream & key) const
+{
+  key << m_ExtractionRegion.GetIndex() << m_ExtractionRegion.GetSize() << ' '
+      << static_cast<int>(m_DirectionCollapseStrategy);
+  return true;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 ExtractImageFilter<TInputImage, TOutputImage>::CallCopyOutputRegionToInputRegion(
@@ -28,6 +28,7 @@
 #include "itkNeighborhoodAccessorFunctor.h"
 
 #include <type_traits> // For is_same
+#include <utility>     // For as_const
 
 namespace itk
 {
@@ -185,7 +186,9 @@ public:
 
 
   /** Allocate the image memory. The size of the image must
-   * already be set, e.g. by calling SetRegions(). */
+   * already be set, e.g. by calling SetRegions().  When initializePixels is
+   * true, a new buffer of a trivial pixel type is zero-initialized in
+   * parallel, as by FillBuffer(). */
   void
   Allocate(bool initializePixels = false) override;
 
@@ -195,7 +198,11 @@ public:
   Initialize() override;
 
   /** Fill the image buffer with a value.  Be sure to call Allocate()
-   * first. */
+   * first.
+   *
+   * A large buffer is filled in parallel, split by the same splitter as
+   * the threaded filters, so that on NUMA systems its pages are first
+   * touched, and thus placed, near the threads that later process them. */
   void
   FillBuffer(const TPixel & value);
 
@@ -219,7 +226,7 @@ public:
   GetPixel(const IndexType & index) const
   {
     const OffsetValueType offset = this->FastComputeOffset(index);
-    return (*m_Buffer)[offset];
+    return std::as_const(*m_Buffer)[offset];
   }
 
   /** \brief Get a reference to a pixel (e.g. for editing).
@@ -254,7 +261,9 @@ public:
   }
 
   /** Return a pointer to the beginning of the buffer.  This is used by
-   * the image iterator class. */
+   * the image iterator class.  The non-const version first gives the pixel
+   * container its own copy of a buffer that it shares, see
+   * ImportImageContainer::ShareBuffer(); the const version never copies. */
   /** @ITKStartGrouping */
   virtual TPixel *
   GetBufferPointer()
@@ -264,7 +273,7 @@ public:
   virtual const TPixel *
   GetBufferPointer() const
   {
-    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+    return m_Buffer ? std::as_const(*m_Buffer).GetBufferPointer() : nullptr;
   }
   /** @ITKEndGrouping */
   /** Return a pointer to the container. */
@@ -356,8 +365,8 @@ public:
       return false;
     }
 
-    auto & lhsBuffer = *(lhs.m_Buffer);
-    auto & rhsBuffer = *(rhs.m_Buffer);
+    const auto & lhsBuffer = *(lhs.m_Buffer);
+    const auto & rhsBuffer = *(rhs.m_Buffer);
 
     const auto bufferSize = lhsBuffer.Size();
 
@@ -404,6 +413,21 @@ private:
   /** Memory for the current buffer. */
   PixelContainerPointer m_Buffer{ PixelContainer::New() };
 };
+
+/** Gives image its own copy of a pixel buffer that it shares with another
+ * image, and returns image.  The iterators that write pixels through a
+ * pointer to the buffer pass their image through it, since they take that
+ * pointer from the const GetBufferPointer(). */
+template <typename TImage>
+TImage *
+MakeImageBufferUnique(TImage * image)
+{
+  if (image)
+  {
+    image->GetBufferPointer();
+  }
+  return image;
+}
 } // end namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -28,7 +28,9 @@
 #ifndef itkImage_hxx
 #define itkImage_hxx
 
+#include "itkMultiThreaderBase.h"
 #include "itkProcessObject.h"
+#include "itkThreadPool.h"
 #include <algorithm>
 
 namespace itk
@@ -43,6 +45,16 @@ Image<TPixel, VImageDimension>::Allocate(bool initializePixels)
   this->ComputeOffsetTable();
   num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
 
+  if constexpr (std::is_trivially_default_constructible_v<TPixel>)
+  {
+    if (initializePixels && std::as_const(*m_Buffer).GetImportPointer() == nullptr)
+    {
+      // Initialize the new buffer in parallel rather than in the container.
+      m_Buffer->Reserve(num, false);
+      this->FillBuffer(TPixel{});
+      return;
+    }
+  }
   m_Buffer->Reserve(num, initializePixels);
 }
 
@@ -70,9 +82,55 @@ template <typename TPixel, unsigned int VImageDimension>
 void
 Image<TPixel, VImageDimension>::FillBuffer(const TPixel & value)
 {
-  const SizeValueType numberOfPixels = this->GetBufferedRegion().GetNumberOfPixels();
+  const RegionType &  bufferedRegion = this->GetBufferedRegion();
+  const SizeValueType numberOfPixels = bufferedRegion.GetNumberOfPixels();
+  TPixel * const      buffer = m_Buffer->GetBufferPointer();
+
+  // Below this size, splitting the work costs more than it saves. Threads of
+  // the pool fill serially, as they may not wait for other threads of the pool.
+  constexpr SizeValueType minimumNumberOfBytesToSplit{ SizeValueType{ 1 } << 20 };
+  if (numberOfPixels * sizeof(TPixel) < minimumNumberOfBytesToSplit || ThreadPool::IsCalledFromPoolThread())
+  {
+    std::fill_n(buffer, numberOfPixels, value);
+    return;
+  }
 
-  std::fill_n(&(*m_Buffer)[0], numberOfPixels, value);
+  const auto multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeImageRegion<VImageDimension>(
+    bufferedRegion,
+    [this, buffer, &bufferedRegion, &value](const RegionType & region) {
+      const SizeValueType numberOfRegionPixels = region.GetNumberOfPixels();
+      if (numberOfRegionPixels == 0)
+      {
+        return;
+      }
+
+      // The region is contiguous in the buffer along the first dimensions
+      // that it spans entirely, and along the next one.
+      unsigned int  contiguousDimension = 0;
+      SizeValueType chunkLength = region.GetSize(0);
+      while (contiguousDimension + 1 < VImageDimension &&
+             region.GetSize(contiguousDimension) == bufferedRegion.GetSize(contiguousDimension))
+      {
+        ++contiguousDimension;
+        chunkLength *= region.GetSize(contiguousDimension);
+      }
+
+      IndexType index = region.GetIndex();
+      for (SizeValueType chunk = 0; chunk < numberOfRegionPixels / chunkLength; ++chunk)
+      {
+        std::fill_n(buffer + this->ComputeOffset(index), chunkLength, value);
+        for (unsigned int d = contiguousDimension + 1; d < VImageDimension; ++d)
+        {
+          if (++index[d] < region.GetIndex(d) + static_cast<IndexValueType>(region.GetSize(d)))
+          {
+            break;
+          }
+          index[d] = region.GetIndex(d);
+        }
+      }
+    },
+    nullptr);
 }
 
 
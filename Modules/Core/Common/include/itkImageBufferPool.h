@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferPool_h
+#define itkImageBufferPool_h
+
+#include "itkMacro.h"
+#include "itkSingletonMacro.h"
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace itk
+{
+/** \class ImageBufferPoolStatistics
+ * \brief Counters reported by ImageBufferPool::GetStatistics().
+ *
+ * \ingroup ITKCommon
+ */
+struct ImageBufferPoolStatistics
+{
+  /** Number of buffers handed out by the pool. */
+  size_t NumberOfAllocations{};
+  /** Number of those allocations that reused a cached buffer. */
+  size_t NumberOfReuses{};
+  /** Number of buffers returned to the pool. */
+  size_t NumberOfReleases{};
+  /** Number of returned buffers that were freed instead of being cached,
+   * because of the caps or because the pool was disabled. */
+  size_t NumberOfEvictions{};
+  /** Number and total size of the idle buffers kept for reuse. */
+  size_t NumberOfCachedBuffers{};
+  size_t CachedBytes{};
+  /** Current and peak total size of the buffers in use. */
+  size_t OutstandingBytes{};
+  size_t PeakOutstandingBytes{};
+};
+
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & os, const ImageBufferPoolStatistics & statistics);
+
+/** \class ImageBufferPool
+ * \brief Process-wide pool of image pixel buffers.
+ *
+ * When the pool is enabled, ImportImageContainer draws the buffers of
+ * images of trivial pixel types from this pool and returns them to it when
+ * the image releases its data, instead of calling new[] and delete[].
+ * Running the same pipeline on many images of the same size then reuses
+ * the buffers of the previous run instead of allocating and page faulting
+ * new memory at each update.
+ *
+ * Requests are rounded up to size classes, four per power of two, so that
+ * a buffer can be reused for a request that is up to 25% smaller.  Idle
+ * buffers are kept until the MaximumCachedBytes or the
+ * MaximumCachedBuffersPerSizeClass caps are reached, at which point the
+ * least recently released buffers are freed.  Requests smaller than
+ * MinimumBufferSize are not served by the pool.
+ *
+ * Buffers are aligned on Alignment bytes (64 by default, the size of a
+ * cache line).  When UseHugePages is on, buffers of at least 2 MiB are
+ * aligned on 2 MiB and, on Linux, advised to be backed by transparent huge
+ * pages.
+ *
+ * The pool is disabled by default.  Its settings and statistics are
+ * global and thread safe.
+ *
+ * \warning A buffer allocated by the pool must be returned with
+ * ReleaseBuffer(), not with delete[].  This matters for code that takes
+ * over the buffer of an ImportImageContainer with ContainerManageMemoryOff().
+ *
+ * \ingroup ITKCommon
+ */
+struct ImageBufferPoolGlobals;
+
+class ITKCommon_EXPORT ImageBufferPool
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferPool);
+
+  /** Set/Get whether new image buffers are drawn from the pool.
+   * Default = false. */
+  /** @ITKStartGrouping */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  /** @ITKEndGrouping */
+  /** Set/Get the maximum total size, in bytes, of the idle buffers kept for
+   * reuse.  Default = 1 GiB. */
+  /** @ITKStartGrouping */
+  static void
+  SetMaximumCachedBytes(size_t bytes);
+  static size_t
+  GetMaximumCachedBytes();
+  /** @ITKEndGrouping */
+  /** Set/Get the maximum number of idle buffers kept for each size class.
+   * Default = 8. */
+  /** @ITKStartGrouping */
+  static void
+  SetMaximumCachedBuffersPerSizeClass(size_t numberOfBuffers);
+  static size_t
+  GetMaximumCachedBuffersPerSizeClass();
+  /** @ITKEndGrouping */
+  /** Set/Get the size, in bytes, below which requests are not served by the
+   * pool.  Default = 64 KiB. */
+  /** @ITKStartGrouping */
+  static void
+  SetMinimumBufferSize(size_t bytes);
+  static size_t
+  GetMinimumBufferSize();
+  /** @ITKEndGrouping */
+  /** Set/Get the alignment, in bytes, of the buffers.  Must be a power of
+   * two.  Default = 64. */
+  /** @ITKStartGrouping */
+  static void
+  SetAlignment(size_t alignment);
+  static size_t
+  GetAlignment();
+  /** @ITKEndGrouping */
+  /** Set/Get whether large buffers are backed by huge pages.
+   * Default = false. */
+  /** @ITKStartGrouping */
+  static void
+  SetUseHugePages(bool useHugePages);
+  static bool
+  GetUseHugePages();
+  /** @ITKEndGrouping */
+
+  /** Return a buffer of at least numberOfBytes bytes, or nullptr when the
+   * pool is disabled or the request is smaller than MinimumBufferSize.  The
+   * content of the buffer is undefined.  Throws std::bad_alloc when the
+   * memory cannot be allocated. */
+  static void *
+  AllocateBuffer(size_t numberOfBytes);
+
+  /** Return a buffer obtained from AllocateBuffer() to the pool.  Return
+   * false, without doing anything, when the buffer was not allocated by the
+   * pool. */
+  static bool
+  ReleaseBuffer(void * buffer);
+
+  /** Free all the idle buffers. */
+  static void
+  ReleaseCachedBuffers();
+
+  /** Get the size class of a request, that is the actual size of the buffer
+   * allocated for it. */
+  static size_t
+  GetSizeClass(size_t numberOfBytes);
+
+  /** Get/Reset the statistics of the pool.  Resetting keeps the cached and
+   * outstanding sizes, which describe the current state of the pool. */
+  /** @ITKStartGrouping */
+  static ImageBufferPoolStatistics
+  GetStatistics();
+  static void
+  ResetStatistics();
+  /** @ITKEndGrouping */
+
+private:
+  ImageBufferPool() = default;
+  ~ImageBufferPool() = default;
+
+  itkGetGlobalDeclarationMacro(ImageBufferPoolGlobals, PimplGlobals);
+
+  static ImageBufferPoolGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
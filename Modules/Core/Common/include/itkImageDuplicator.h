@@ -44,6 +44,13 @@ namespace itk
  * that provides the input to the ImageDuplicator object. This is needed
  * because the ImageDuplicator is not a pipeline filter.
  *
+ * With ShareBuffer on, the duplicate shares the pixel buffer of the input
+ * image, copy on write (see ImportImageContainer::ShareBuffer()), so that
+ * duplicating an image takes constant time and memory until either image is
+ * modified.  The pixel container of the input image then shares its buffer
+ * too: pixel pointers of the input image obtained before the duplication must
+ * not be used to write.
+ *
  * \ingroup ITKCommon
  *
  * \sphinx
@@ -79,6 +86,14 @@ public:
 
   itkSetConstObjectMacro(InputImage, ImageType);
 
+  /** Set/Get whether the duplicate shares the pixel buffer of the input image
+   * until either image is written, instead of copying it.  Off by default. */
+  /** @ITKStartGrouping */
+  itkSetMacro(ShareBuffer, bool);
+  itkGetConstMacro(ShareBuffer, bool);
+  itkBooleanMacro(ShareBuffer);
+  /** @ITKEndGrouping */
+
   /**
    * Provide an interface to match that
    * of other ProcessObjects
@@ -125,6 +140,7 @@ private:
   ImageConstPointer m_InputImage{};
   ImagePointer      m_DuplicateImage{};
   ModifiedTimeType  m_InternalImageTime{};
+  bool              m_ShareBuffer{ false };
 };
 } // end namespace itk
 
@@ -50,6 +50,15 @@ ImageDuplicator<TInputImage>::Update()
   m_DuplicateImage->CopyInformation(m_InputImage);
   m_DuplicateImage->SetRequestedRegion(m_InputImage->GetRequestedRegion());
   m_DuplicateImage->SetBufferedRegion(m_InputImage->GetBufferedRegion());
+  if (m_ShareBuffer)
+  {
+    // The pixels are copied when either image is first written, which
+    // changes how the pixel container of the input image manages its buffer.
+    const auto pixelContainer = ImageType::PixelContainer::New();
+    pixelContainer->ShareBuffer(const_cast<typename ImageType::PixelContainer *>(m_InputImage->GetPixelContainer()));
+    m_DuplicateImage->SetPixelContainer(pixelContainer);
+    return;
+  }
   m_DuplicateImage->Allocate();
   const typename ImageType::RegionType region = m_InputImage->GetBufferedRegion();
   ImageAlgorithm::Copy(m_InputImage.GetPointer(), m_DuplicateImage.GetPointer(), region, region);
@@ -63,6 +72,7 @@ ImageDuplicator<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
 
   itkPrintSelfObjectMacro(InputImage);
   itkPrintSelfObjectMacro(DuplicateImage);
+  itkPrintSelfBooleanMacro(ShareBuffer);
 
   os << indent << "InternalImageTime: " << static_cast<NumericTraits<ModifiedTimeType>::PrintType>(m_InternalImageTime)
      << std::endl;
@@ -27,7 +27,7 @@ namespace itk
 //----------------------------------------------------------------------
 template <typename TImage>
 ImageIterator<TImage>::ImageIterator(TImage * ptr, const RegionType & region)
-  : ImageConstIterator<TImage>(ptr, region)
+  : ImageConstIterator<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 //----------------------------------------------------------------------
@@ -27,7 +27,7 @@ namespace itk
 //----------------------------------------------------------------------
 template <typename TImage>
 ImageIteratorWithIndex<TImage>::ImageIteratorWithIndex(TImage * ptr, const RegionType & region)
-  : ImageConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 //----------------------------------------------------------------------
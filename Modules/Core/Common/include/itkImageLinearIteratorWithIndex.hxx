@@ -23,7 +23,7 @@ namespace itk
 {
 template <typename TImage>
 ImageLinearIteratorWithIndex<TImage>::ImageLinearIteratorWithIndex(TImage * ptr, const RegionType & region)
-  : ImageLinearConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageLinearConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
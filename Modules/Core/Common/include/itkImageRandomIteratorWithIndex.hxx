@@ -23,7 +23,7 @@ namespace itk
 {
 template <typename TImage>
 ImageRandomIteratorWithIndex<TImage>::ImageRandomIteratorWithIndex(TImage * ptr, const RegionType & region)
-  : ImageRandomConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageRandomConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
@@ -24,7 +24,7 @@ namespace itk
 template <typename TImage>
 ImageRandomNonRepeatingIteratorWithIndex<TImage>::ImageRandomNonRepeatingIteratorWithIndex(TImage *           ptr,
                                                                                            const RegionType & region)
-  : ImageRandomNonRepeatingConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageRandomNonRepeatingConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
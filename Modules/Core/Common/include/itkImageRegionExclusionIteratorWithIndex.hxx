@@ -24,7 +24,7 @@ namespace itk
 template <typename TImage>
 ImageRegionExclusionIteratorWithIndex<TImage>::ImageRegionExclusionIteratorWithIndex(TImage *           ptr,
                                                                                      const RegionType & region)
-  : ImageRegionExclusionConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageRegionExclusionConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
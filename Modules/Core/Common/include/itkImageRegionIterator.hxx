@@ -23,7 +23,7 @@ namespace itk
 {
 template <typename TImage>
 ImageRegionIterator<TImage>::ImageRegionIterator(TImage * ptr, const RegionType & region)
-  : ImageRegionConstIterator<TImage>(ptr, region)
+  : ImageRegionConstIterator<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
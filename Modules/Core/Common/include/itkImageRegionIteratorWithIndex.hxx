@@ -23,7 +23,7 @@ namespace itk
 {
 template <typename TImage>
 ImageRegionIteratorWithIndex<TImage>::ImageRegionIteratorWithIndex(TImage * ptr, const RegionType & region)
-  : ImageRegionConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageRegionConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
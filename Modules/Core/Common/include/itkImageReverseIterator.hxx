@@ -23,7 +23,7 @@ namespace itk
 {
 template <typename TImage>
 ImageReverseIterator<TImage>::ImageReverseIterator(TImage * ptr, const RegionType & region)
-  : ImageRegionReverseConstIterator<TImage>(ptr, region)
+  : ImageRegionReverseConstIterator<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
@@ -63,7 +63,7 @@ public:
 
   /** Constructor establishes an iterator to walk a particular image and a particular region of that image. Initializes
    * the iterator at the begin of the region. */
-  ImageScanlineIterator(TImage * ptr, const RegionType & region);
+  ImageScanlineIterator(TImage * ptr, const typename TImage::RegionType & region);
 
   /** Constructor that can be used to cast from an ImageIterator to an
    * ImageScanlineIterator. Many routines return an ImageIterator but for a
@@ -22,8 +22,8 @@
 namespace itk
 {
 template <typename TImage>
-ImageScanlineIterator<TImage>::ImageScanlineIterator(TImage * ptr, const RegionType & region)
-  : ImageScanlineConstIterator<TImage>(ptr, region)
+ImageScanlineIterator<TImage>::ImageScanlineIterator(TImage * ptr, const typename TImage::RegionType & region)
+  : ImageScanlineConstIterator<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
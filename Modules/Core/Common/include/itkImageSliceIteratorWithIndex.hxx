@@ -23,7 +23,7 @@ namespace itk
 {
 template <typename TImage>
 ImageSliceIteratorWithIndex<TImage>::ImageSliceIteratorWithIndex(TImage * ptr, const RegionType & region)
-  : ImageSliceConstIteratorWithIndex<TImage>(ptr, region)
+  : ImageSliceConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
@@ -395,6 +395,16 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Copies the output if it is an itk::Image of type TOutputImage with a
+   * pixel type that can be copied with memcpy. */
+  DataObjectPointer
+  CopyOutputForCache(const DataObject * output, SizeValueType & numberOfBytes) const override;
+
+  /** Estimates the size of the output if it is an itk::Image of type
+   * TOutputImage. */
+  SizeValueType
+  EstimateOutputBulkDataSize(const DataObject * output) const override;
+
   /** Whether to use classic multi-threading infrastructure (OFF by default).
    * Classic multi-threading uses derived class' ImageRegionSplitter,
    * thus enabling custom region splitting methods. */
@@ -34,6 +34,8 @@
 
 #include "itkMath.h"
 
+#include <algorithm> // For copy_n.
+
 namespace itk
 {
 template <typename TOutputImage>
@@ -287,6 +289,53 @@ ImageSource<TOutputImage>::ThreaderCallback(void * arg)
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+template <typename TOutputImage>
+auto
+ImageSource<TOutputImage>::CopyOutputForCache(const DataObject * output, SizeValueType & numberOfBytes) const
+  -> DataObjectPointer
+{
+  numberOfBytes = 0;
+  if constexpr (std::is_same_v<TOutputImage, Image<typename TOutputImage::PixelType, OutputImageDimension>> &&
+                std::is_trivially_copyable_v<typename TOutputImage::PixelType>)
+  {
+    const auto * image = dynamic_cast<const TOutputImage *>(output);
+    if (image == nullptr || image->GetBufferPointer() == nullptr)
+    {
+      return nullptr;
+    }
+
+    auto copy = TOutputImage::New();
+    copy->CopyInformation(image);
+    copy->SetBufferedRegion(image->GetBufferedRegion());
+    copy->SetRequestedRegion(image->GetRequestedRegion());
+    copy->SetMetaDataDictionary(image->GetMetaDataDictionary());
+    copy->Allocate();
+
+    const SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+    std::copy_n(image->GetBufferPointer(), numberOfPixels, copy->GetBufferPointer());
+    numberOfBytes = numberOfPixels * sizeof(typename TOutputImage::PixelType);
+    return copy;
+  }
+  else
+  {
+    return Superclass::CopyOutputForCache(output, numberOfBytes);
+  }
+}
+
+template <typename TOutputImage>
+SizeValueType
+ImageSource<TOutputImage>::EstimateOutputBulkDataSize(const DataObject * output) const
+{
+  if constexpr (std::is_same_v<TOutputImage, Image<typename TOutputImage::PixelType, OutputImageDimension>>)
+  {
+    if (const auto * image = dynamic_cast<const TOutputImage *>(output))
+    {
+      return image->GetRequestedRegion().GetNumberOfPixels() * sizeof(typename TOutputImage::PixelType);
+    }
+  }
+  return Superclass::EstimateOutputBulkDataSize(output);
+}
+
 template <typename TOutputImage>
 void
 ImageSource<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -226,6 +226,13 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Writes the geometry and a hash of the pixels of the input if it is an
+   * itk::Image of type TInputImage with a pixel type that can be copied
+   * with memcpy, so that a filter hits the PipelineOutputCache on any input
+   * image of the same contents. */
+  void
+  AppendInputToOutputCacheKey(const DataObject * input, std::ostream & key) const override;
+
   /** \brief Verifies that the input images occupy the same physical
    * space and the each index is at the same physical location.
    *
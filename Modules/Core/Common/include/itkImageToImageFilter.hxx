@@ -29,6 +29,7 @@
 #define itkImageToImageFilter_hxx
 #include "itkInputDataObjectIterator.h"
 #include "itkInputDataObjectConstIterator.h"
+#include "itkPipelineOutputCache.h"
 
 #include <cmath>
 
@@ -143,6 +144,30 @@ ImageToImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Inde
 }
 
 
+template <typename TInputImage, typename TOutputImage>
+void
+ImageToImageFilter<TInputImage, TOutputImage>::AppendInputToOutputCacheKey(const DataObject * input,
+                                                                          std::ostream &     key) const
+{
+  if constexpr (std::is_same_v<TInputImage, Image<typename TInputImage::PixelType, InputImageDimension>> &&
+                std::is_trivially_copyable_v<typename TInputImage::PixelType>)
+  {
+    const auto * image = dynamic_cast<const TInputImage *>(input);
+    if (image != nullptr && image->GetBufferPointer() != nullptr)
+    {
+      const InputImageRegionType & bufferedRegion = image->GetBufferedRegion();
+      const InputImageRegionType & largestRegion = image->GetLargestPossibleRegion();
+      const size_t numberOfBytes = bufferedRegion.GetNumberOfPixels() * sizeof(typename TInputImage::PixelType);
+      key << "image " << bufferedRegion.GetIndex() << bufferedRegion.GetSize() << largestRegion.GetIndex()
+          << largestRegion.GetSize() << image->GetOrigin() << image->GetSpacing() << image->GetDirection() << ' '
+          << PipelineOutputCache::HashBytes(image->GetBufferPointer(), numberOfBytes);
+      return;
+    }
+  }
+  Superclass::AppendInputToOutputCacheKey(input, key);
+}
+
+
 template <typename TInputImage, typename TOutputImage>
 void
 ImageToImageFilter<TInputImage, TOutputImage>::VerifyInputInformation() const
@@ -18,8 +18,13 @@
 #ifndef itkImportImageContainer_h
 #define itkImportImageContainer_h
 
+#include "itkImageBufferPool.h"
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkPipelineTrace.h"
+#include <atomic>
+#include <mutex>
+#include <type_traits>
 #include <utility>
 
 namespace itk
@@ -36,6 +41,24 @@ namespace itk
  *
  * \tparam TElement The element type stored in the container.
  *
+ * When ImageBufferPool is enabled, the buffers of elements that are
+ * trivially constructible and destructible are drawn from the pool and
+ * returned to it when released.
+ *
+ * Containers may share a buffer, copy on write: ShareBuffer() makes a
+ * container use the buffer of another one without copying it, and the
+ * first access to the elements through GetImportPointer(),
+ * GetBufferPointer() or the non-const operator[] of a container that still
+ * shares its buffer gives it its own copy first.  The const accessors never
+ * copy.  A pointer to the elements obtained before the buffer was shared
+ * does not trigger the copy, and so must not be used to write them.
+ *
+ * The first write access may come from several threads at once, as when
+ * the work units of a filter take the buffer of their output: the copy is
+ * made once, under a lock, and all of them then get the same buffer.
+ * Sharing a buffer must not be concurrent with other accesses to either
+ * container.
+ *
  * \ingroup ImageObjects
  * \ingroup IOFilters
  * \ingroup ITKCommon
@@ -63,12 +86,21 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(ImportImageContainer);
 
-  /** Get the pointer from which the image data is imported. */
+  /** Get the pointer from which the image data is imported.  The
+   * non-const version copies a shared buffer first. */
+  /** @ITKStartGrouping */
   TElement *
   GetImportPointer()
+  {
+    this->MakeBufferUnique();
+    return m_ImportPointer;
+  }
+  const TElement *
+  GetImportPointer() const
   {
     return m_ImportPointer;
   }
+  /** @ITKEndGrouping */
 
   /** Set the pointer from which the image data is imported.  "num" is
    * the number of pixels in the block of memory. If
@@ -79,10 +111,12 @@ public:
   void
   SetImportPointer(TElement * ptr, TElementIdentifier num, bool LetContainerManageMemory = false);
 
-  /** Index operator. This version can be an lvalue. */
+  /** Index operator. This version can be an lvalue, and copies a shared
+   * buffer first. */
   TElement &
   operator[](const ElementIdentifier id)
   {
+    this->MakeBufferUnique();
     return m_ImportPointer[id];
   }
 
@@ -94,12 +128,32 @@ public:
   }
 
   /** Return a pointer to the beginning of the buffer.  This is used by
-   * the image iterator class. */
+   * the image iterator class.  The non-const version copies a shared buffer
+   * first. */
+  /** @ITKStartGrouping */
   TElement *
   GetBufferPointer()
+  {
+    this->MakeBufferUnique();
+    return m_ImportPointer;
+  }
+  const TElement *
+  GetBufferPointer() const
   {
     return m_ImportPointer;
   }
+  /** @ITKEndGrouping */
+
+  /** Use the elements of container, sharing its buffer until either
+   * container is written.  The buffer is copied instead when container does
+   * not manage its memory, since the application may then release it.
+   * Neither container may be accessed by other threads meanwhile. */
+  void
+  ShareBuffer(Self * container);
+
+  /** Whether the buffer is shared with another container. */
+  bool
+  IsBufferShared() const;
 
   /** Get the capacity of the container. */
   ElementIdentifier
@@ -207,10 +261,39 @@ protected:
   }
 
 private:
+  /** Gives this container its own copy of a buffer shared with others.
+   * Concurrent calls make a single copy. */
+  void
+  MakeBufferUnique()
+  {
+    if (m_BufferIsShared.load(std::memory_order_acquire))
+    {
+      const std::lock_guard<std::mutex> lock(m_CopySharedBufferMutex);
+      if (m_BufferIsShared.load(std::memory_order_relaxed))
+      {
+        this->CopySharedBuffer();
+      }
+    }
+  }
+
+  void
+  CopySharedBuffer();
+
+  /** Whether buffers of TElement can be drawn from ImageBufferPool, which
+   * hands out raw memory and never runs constructors or destructors. */
+  static constexpr bool CanUseBufferPool =
+    std::is_trivially_default_constructible_v<TElement> && std::is_trivially_destructible_v<TElement>;
+
   TElement *         m_ImportPointer{};
   TElementIdentifier m_Size{};
   TElementIdentifier m_Capacity{};
-  bool               m_ContainerManageMemory{ true };
+
+  /** Sharing a buffer hands its ownership over to m_SharedBufferOwner, a
+   * container referenced by all the containers that share it. */
+  bool    m_ContainerManageMemory{ true };
+  Pointer           m_SharedBufferOwner{};
+  std::atomic<bool> m_BufferIsShared{ false };
+  std::mutex        m_CopySharedBufferMutex{};
 };
 } // end namespace itk
 
@@ -29,6 +29,8 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <limits>
+#include <memory> // For uninitialized_value_construct_n.
 
 namespace itk
 {
@@ -150,6 +152,92 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::ShareBuffer(Self * container)
+{
+  if (container == nullptr || container == this)
+  {
+    return;
+  }
+
+  TElement * const         pointer = container->m_ImportPointer;
+  const TElementIdentifier size = container->m_Size;
+  TElementIdentifier       capacity = container->m_Capacity;
+  if (pointer && !container->m_SharedBufferOwner && container->m_ContainerManageMemory)
+  {
+    // Hand the buffer over to a new container of the same type, so that it
+    // is released the same way by the last container that shares it.
+    const LightObject::Pointer another = container->CreateAnother();
+    if (auto * const newOwner = dynamic_cast<Self *>(another.GetPointer()))
+    {
+      newOwner->m_ImportPointer = pointer;
+      newOwner->m_Size = size;
+      newOwner->m_Capacity = capacity;
+      newOwner->m_ContainerManageMemory = true;
+      container->m_SharedBufferOwner = newOwner;
+      container->m_ContainerManageMemory = false;
+      container->m_BufferIsShared = true;
+    }
+  }
+  const Pointer owner = container->m_SharedBufferOwner;
+
+  DeallocateManagedMemory();
+  if (owner)
+  {
+    m_ImportPointer = pointer;
+    m_ContainerManageMemory = false;
+    m_SharedBufferOwner = owner;
+    m_BufferIsShared = true;
+  }
+  else if (pointer)
+  {
+    // The application owns the buffer of container, which may not outlive
+    // this one.
+    m_ImportPointer = this->AllocateElements(size, false);
+    std::copy_n(pointer, size, m_ImportPointer);
+    m_ContainerManageMemory = true;
+    capacity = size;
+  }
+  else
+  {
+    m_ContainerManageMemory = true;
+  }
+  m_Size = size;
+  m_Capacity = capacity;
+  this->Modified();
+}
+
+template <typename TElementIdentifier, typename TElement>
+bool
+ImportImageContainer<TElementIdentifier, TElement>::IsBufferShared() const
+{
+  return m_SharedBufferOwner && m_SharedBufferOwner->GetReferenceCount() > 1;
+}
+
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::CopySharedBuffer()
+{
+  if (m_SharedBufferOwner->GetReferenceCount() > 1)
+  {
+    TElement * const temp = this->AllocateElements(m_Size, false);
+    std::copy_n(m_ImportPointer, m_Size, temp);
+    m_ImportPointer = temp;
+    m_Capacity = m_Size;
+  }
+  else
+  {
+    // This is the last container that shares the buffer: take it back.
+    m_SharedBufferOwner->m_ImportPointer = nullptr;
+    m_SharedBufferOwner->m_ContainerManageMemory = false;
+  }
+  m_ContainerManageMemory = true;
+  m_SharedBufferOwner = nullptr;
+  // Publish the new buffer to the threads that do not take the lock.
+  m_BufferIsShared.store(false, std::memory_order_release);
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
@@ -159,6 +247,24 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
 
   try
   {
+    if constexpr (CanUseBufferPool)
+    {
+      if (static_cast<size_t>(size) <= std::numeric_limits<size_t>::max() / sizeof(TElement))
+      {
+        data = static_cast<TElement *>(ImageBufferPool::AllocateBuffer(static_cast<size_t>(size) * sizeof(TElement)));
+      }
+      if (data)
+      {
+        // A reused buffer holds the values of its previous image.
+        if (UseValueInitialization)
+        {
+          std::uninitialized_value_construct_n(data, size);
+        }
+        PipelineTrace::AddAllocatedBytes(static_cast<SizeValueType>(size) * sizeof(TElement));
+        return data;
+      }
+    }
+
     if (UseValueInitialization)
     {
       data = new TElement[size]();
@@ -178,6 +284,7 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
     // of memory.  Do not use the exception macro.
     throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
   }
+  PipelineTrace::AddAllocatedBytes(static_cast<SizeValueType>(size) * sizeof(TElement));
   return data;
 }
 
@@ -188,11 +295,22 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
+    if constexpr (CanUseBufferPool)
+    {
+      if (ImageBufferPool::ReleaseBuffer(m_ImportPointer))
+      {
+        m_ImportPointer = nullptr;
+      }
+    }
     delete[] m_ImportPointer;
   }
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
+
+  // A shared buffer is released by the last container that shares it.
+  m_SharedBufferOwner = nullptr;
+  m_BufferIsShared = false;
 }
 
 template <typename TElementIdentifier, typename TElement>
@@ -203,6 +321,7 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
 
   os << indent << "Pointer: " << static_cast<void *>(m_ImportPointer) << std::endl;
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
+  os << indent << "Buffer shared: " << (this->IsBufferShared() ? "true" : "false") << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
 }
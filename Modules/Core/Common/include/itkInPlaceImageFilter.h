@@ -126,7 +126,35 @@ public:
   [[nodiscard]] virtual bool
   CanRunInPlace() const;
 
+  /** Returns whether InPlace is on and the filter can run in place. */
+  bool
+  IsInPlaceExecutionEnabled() const override
+  {
+    return this->GetInPlace() && this->CanRunInPlace();
+  }
+
+  /** Turns InPlace on if the filter can run in place.  The filter is not
+   * modified, as running in place does not change its outputs. */
+  bool
+  EnableInPlaceExecution() override
+  {
+    if (this->CanRunInPlace())
+    {
+      m_InPlace = true;
+      return true;
+    }
+    return false;
+  }
+
+  /** Turns InPlace off, without modifying the filter. */
+  void
+  DisableInPlaceExecution() override
+  {
+    m_InPlace = false;
+  }
+
 protected:
+
   InPlaceImageFilter() = default;
   ~InPlaceImageFilter() override = default;
 
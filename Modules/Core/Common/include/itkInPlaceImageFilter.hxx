@@ -28,9 +28,22 @@
 #ifndef itkInPlaceImageFilter_hxx
 #define itkInPlaceImageFilter_hxx
 
+#include <utility>
 
 namespace itk
 {
+namespace InPlaceImageFilterDetail
+{
+/** Whether TImage stores its pixels in a buffer accessed through
+ * GetBufferPointer(), unlike e.g. RunLengthLabelImage. */
+template <typename TImage, typename = void>
+struct HasBufferPointer : std::false_type
+{};
+
+template <typename TImage>
+struct HasBufferPointer<TImage, std::void_t<decltype(std::declval<TImage &>().GetBufferPointer())>> : std::true_type
+{};
+} // namespace InPlaceImageFilterDetail
 
 template <typename TInputImage, typename TOutputImage>
 void
@@ -87,6 +100,13 @@ InPlaceImageFilter<TInputImage, TOutputImage>::InternalAllocateOutputs()
     this->GraftOutput(inputAsOutput);
     this->m_RunningInPlace = true;
 
+    // Copy a pixel buffer shared with another image (see
+    // ImageDuplicator::SetShareBuffer()) before the threads write it.
+    if constexpr (InPlaceImageFilterDetail::HasBufferPointer<TOutputImage>::value)
+    {
+      this->GetOutput()->GetBufferPointer();
+    }
+
     using ImageBaseType = ImageBase<OutputImageDimension>;
 
     // If there are more than one outputs, allocate the remaining outputs
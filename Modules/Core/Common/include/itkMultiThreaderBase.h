@@ -355,15 +355,18 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [&funcP](const IndexValueType index[], const SizeValueType size[]) {
-        ImageRegion<VDimension> region;
-        for (unsigned int d = 0; d < VDimension; ++d)
-        {
-          region.SetIndex(d, index[d]);
-          region.SetSize(d, size[d]);
-        }
-        funcP(region);
-      },
+      TraceWorkUnits(
+        VDimension,
+        [&funcP](const IndexValueType index[], const SizeValueType size[]) {
+          ImageRegion<VDimension> region;
+          for (unsigned int d = 0; d < VDimension; ++d)
+          {
+            region.SetIndex(d, index[d]);
+            region.SetSize(d, size[d]);
+          }
+          funcP(region);
+        },
+        filter),
       filter);
   }
 
@@ -403,21 +406,24 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitIndex.m_InternalArray,
         splitSize.m_InternalArray,
-        [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
-          ImageRegion<VDimension> restrictedRequestedRegion;
-          restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
-          restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
-          for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
-          {
-            if (dimension != restrictedDirection)
+        TraceWorkUnits(
+          SplitDimension,
+          [restrictedDirection, &requestedRegion, &funcP](const IndexValueType index[], const SizeValueType size[]) {
+            ImageRegion<VDimension> restrictedRequestedRegion;
+            restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
+            restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
+            for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
             {
-              restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
-              restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
-              ++splitDimension;
+              if (dimension != restrictedDirection)
+              {
+                restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
+                restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
+                ++splitDimension;
+              }
             }
-          }
-          funcP(restrictedRequestedRegion);
-        },
+            funcP(restrictedRequestedRegion);
+          },
+          filter),
         filter);
     }
   }
@@ -460,6 +466,11 @@ protected:
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   ParallelizeImageRegionHelper(void * arg);
 
+  /** Returns funcP, wrapped to record each of its calls as a work unit of
+   * filter in the PipelineTrace when the trace is enabled. */
+  static ThreadingFunctorType
+  TraceWorkUnits(unsigned int dimension, ThreadingFunctorType funcP, const ProcessObject * filter);
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits{};
 
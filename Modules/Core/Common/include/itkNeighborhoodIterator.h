@@ -251,7 +251,7 @@ public:
   /** Constructor which establishes the region size, neighborhood, and image
    * over which to walk. */
   NeighborhoodIterator(const SizeType & radius, ImageType * ptr, const RegionType & region)
-    : Superclass(radius, ptr, region)
+    : Superclass(radius, MakeImageBufferUnique(ptr), region)
   {}
 
   /** Returns the central memory pointer of the neighborhood. */
@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelStreamingExecutor_h
+#define itkParallelStreamingExecutor_h
+
+#include "itkProcessObject.h"
+
+#include <functional>
+#include <vector>
+
+namespace itk
+{
+/** \class ParallelStreamingExecutor
+ * \brief Executes the pieces of a streamed update with several pieces in
+ * flight.
+ *
+ * A pipeline updates one requested region at a time, so that each piece in
+ * flight needs its own instance of the upstream pipeline.  Execute() runs
+ * one worker per instance: worker 0 in the calling thread, and the others
+ * in threads of their own.  The workers take the pieces in increasing
+ * order, and:
+ *  - wait until the estimated size of the pieces in flight, including the
+ *    new piece, fits in the memory budget, unless no piece is in flight;
+ *  - compute the piece, concurrently with the other workers;
+ *  - when a consume function is given, wait until all the previous pieces
+ *    are consumed, and consume the piece, so that the pieces are consumed
+ *    in order, one at a time.  The worker keeps the piece, and its share of
+ *    the budget, until then.
+ * So a writer can write the pieces in order, while the next pieces are
+ * being computed.
+ *
+ * When a function throws, no more pieces are started, and the first
+ * exception is rethrown by Execute() once all the workers are done.
+ *
+ * \sa StreamingImageFilter, ImageFileWriter
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ParallelStreamingExecutor
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelStreamingExecutor);
+
+  /** The filters of an instance of a pipeline.  The primary output of the
+   * last filter is the output of the pipeline. */
+  using PipelineType = std::vector<ProcessObject::Pointer>;
+
+  /** Builds a new instance of a pipeline. */
+  using PipelineFactoryType = std::function<PipelineType()>;
+
+  /** Estimated size, in bytes, of a piece. */
+  using PieceBytesFunctionType = std::function<SizeValueType(unsigned int piece)>;
+
+  /** Computes or consumes a piece with a worker. */
+  using PieceFunctionType = std::function<void(unsigned int worker, unsigned int piece)>;
+
+  /** Execute numberOfPieces pieces with numberOfWorkers workers.  consume
+   * may be empty. */
+  static void
+  Execute(unsigned int                   numberOfPieces,
+          unsigned int                   numberOfWorkers,
+          SizeValueType                  memoryBudget,
+          const PieceBytesFunctionType & pieceBytes,
+          const PieceFunctionType &      compute,
+          const PieceFunctionType &      consume);
+
+  /** Returns the primary output of the last filter of pipeline, if it is of
+   * type TImage, and nullptr otherwise. */
+  template <typename TImage>
+  static TImage *
+  GetOutput(const PipelineType & pipeline)
+  {
+    if (pipeline.empty() || pipeline.back()->GetIndexedOutputs().empty())
+    {
+      return nullptr;
+    }
+    return dynamic_cast<TImage *>(pipeline.back()->GetIndexedOutputs()[0].GetPointer());
+  }
+};
+} // end namespace itk
+
+#endif
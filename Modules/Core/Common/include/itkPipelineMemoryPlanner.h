@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineMemoryPlanner_h
+#define itkPipelineMemoryPlanner_h
+
+#include "itkProcessObject.h"
+
+namespace itk
+{
+/** \class PipelineMemoryPlanner
+ * \brief Enables in-place execution and early release of intermediate
+ * outputs across a pipeline, and estimates its peak memory.
+ *
+ * Plan() analyzes the pipeline that produces Output.  For each
+ * intermediate output, that is an output of a filter of the pipeline other
+ * than Output, that was added by AddIntermediateOutput() and that is the
+ * input of exactly one filter of the pipeline:
+ *  - its ReleaseDataFlag is turned on, so that its bulk data is released as
+ *    soon as its consumer has executed;
+ *  - if it is the primary input of an InPlaceImageFilter whose primary
+ *    output has the same requested region, InPlace is turned on for that
+ *    filter, which then overwrites the intermediate output instead of
+ *    allocating a new buffer.
+ * Intermediate outputs with several consumers, and the inputs of the
+ * pipeline that are not produced by a filter, are never overwritten nor
+ * released.  The planner cannot tell whether the application still reads
+ * an output, for instance through a raw pointer returned by
+ * ProcessObject::GetOutput(), so only the outputs added by
+ * AddIntermediateOutput() are candidates.
+ *
+ * Plan() also simulates the execution of the pipeline before and after
+ * the changes, and estimates the peak size of the bulk data of the outputs
+ * of the filters, excluding the inputs of the pipeline.  The sizes are
+ * estimated by ProcessObject::EstimateOutputBulkDataSize(), which counts
+ * itk::Image outputs only.
+ *
+ * The changes made by Plan() are undone by RestorePipeline().  Update()
+ * plans the pipeline, updates Output and restores the pipeline.  Note that
+ * released intermediate outputs must be generated again when a later
+ * update re-executes their consumers.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineMemoryPlanner : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineMemoryPlanner);
+
+  /** Standard class type aliases. */
+  using Self = PipelineMemoryPlanner;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PipelineMemoryPlanner);
+
+  /** Set/Get the terminal output of the pipeline. */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(Output, DataObject);
+  itkGetModifiableObjectMacro(Output, DataObject);
+  /** @ITKEndGrouping */
+
+  /** Add an output of a filter of the pipeline that the application does
+   * not read, so that Plan() may release it early or overwrite it. */
+  void
+  AddIntermediateOutput(DataObject * output);
+
+  /** Remove all the outputs added by AddIntermediateOutput(). */
+  void
+  ClearIntermediateOutputs();
+
+  /** Update the output information and the requested regions of the
+   * pipeline, then enable in-place execution and early release of the
+   * intermediate outputs wherever it is safe. */
+  void
+  Plan();
+
+  /** Turn off again the ReleaseDataFlag and in-place execution that Plan()
+   * turned on. */
+  void
+  RestorePipeline();
+
+  /** Plan() the pipeline, update Output, then RestorePipeline(). */
+  void
+  Update();
+
+  /** Estimated peak size, in bytes, of the outputs of the filters, with
+   * the settings of the pipeline before and after Plan(). */
+  /** @ITKStartGrouping */
+  itkGetConstMacro(PeakBytesBeforePlan, SizeValueType);
+  itkGetConstMacro(PeakBytesAfterPlan, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Number of filters of the pipeline, of those for which Plan() turned
+   * in-place execution on, and of outputs whose ReleaseDataFlag it
+   * turned on. */
+  /** @ITKStartGrouping */
+  itkGetConstMacro(NumberOfFilters, SizeValueType);
+  itkGetConstMacro(NumberOfInPlaceFilters, SizeValueType);
+  itkGetConstMacro(NumberOfReleasedOutputs, SizeValueType);
+  /** @ITKEndGrouping */
+
+protected:
+  PipelineMemoryPlanner() = default;
+  ~PipelineMemoryPlanner() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Estimated peak size of the outputs when updating Output. */
+  SizeValueType
+  SimulateUpdate() const;
+
+  DataObject::Pointer m_Output{};
+
+  /** Filters of the pipeline, in the order in which they execute. */
+  std::vector<ProcessObject *> m_Filters{};
+
+  std::vector<DataObject::Pointer> m_IntermediateOutputs{};
+
+  /** Outputs and filters changed by Plan(), restored by RestorePipeline(). */
+  std::vector<DataObject::Pointer>    m_ReleasedOutputs{};
+  std::vector<ProcessObject::Pointer> m_InPlaceFilters{};
+
+  SizeValueType m_PeakBytesBeforePlan{ 0 };
+  SizeValueType m_PeakBytesAfterPlan{ 0 };
+  SizeValueType m_NumberOfFilters{ 0 };
+  SizeValueType m_NumberOfInPlaceFilters{ 0 };
+  SizeValueType m_NumberOfReleasedOutputs{ 0 };
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineOutputCache_h
+#define itkPipelineOutputCache_h
+
+#include "itkDataObject.h"
+#include "itkSingletonMacro.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class PipelineOutputCacheStatistics
+ * \brief Counters reported by PipelineOutputCache::GetStatistics().
+ *
+ * \ingroup ITKCommon
+ */
+struct PipelineOutputCacheStatistics
+{
+  /** Number of lookups that found, or did not find, an entry. */
+  SizeValueType NumberOfHits{};
+  SizeValueType NumberOfMisses{};
+  /** Number of entries added, and removed to respect MaximumCachedBytes. */
+  SizeValueType NumberOfInsertions{};
+  SizeValueType NumberOfEvictions{};
+  /** Number and total size of the cached entries. */
+  SizeValueType NumberOfEntries{};
+  SizeValueType CachedBytes{};
+};
+
+extern ITKCommon_EXPORT std::ostream &
+                        operator<<(std::ostream & os, const PipelineOutputCacheStatistics & statistics);
+
+/** \class PipelineOutputCache
+ * \brief Process-wide cache of the outputs of filters, keyed on their inputs
+ * and parameters.
+ *
+ * When ProcessObject::UseOutputCache is on, ProcessObject::UpdateOutputData()
+ * looks up the key generated by ProcessObject::GenerateOutputCacheKey()
+ * before executing the filter.  On a hit, copies of the cached outputs are
+ * grafted onto the outputs of the filter, and GenerateData() is not called.
+ * On a miss, copies of the outputs are added once the filter has executed.
+ * The key is made of the class of the filter, of its parameters, of the
+ * requested regions of its outputs, and of the contents, or the identity
+ * and modification times, of its inputs.  Unlike the modification times
+ * that drive the pipeline, it lets a new filter reuse the outputs of a
+ * filter that executed earlier on identical inputs with identical
+ * parameters.  Only the filters that override
+ * ProcessObject::AppendParametersToOutputCacheKey() to write their
+ * parameters are cached.
+ *
+ * Entries are kept until their total size reaches MaximumCachedBytes, at
+ * which point the least recently used entries are removed.  The cache and
+ * its statistics are global and thread safe.
+ *
+ * \ingroup ITKCommon
+ */
+struct PipelineOutputCacheGlobals;
+
+class ITKCommon_EXPORT PipelineOutputCache
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineOutputCache);
+
+  /** Named outputs of a filter. */
+  using OutputsType = std::vector<std::pair<std::string, DataObject::ConstPointer>>;
+
+  /** Set/Get the maximum total size of the cached outputs.  Setting it
+   * removes least recently used entries as needed.  Default = 512 MiB. */
+  /** @ITKStartGrouping */
+  static void
+  SetMaximumCachedBytes(SizeValueType numberOfBytes);
+  static SizeValueType
+  GetMaximumCachedBytes();
+  /** @ITKEndGrouping */
+
+  /** Look up the outputs cached under key.  Returns false, and leaves
+   * outputs unchanged, when there is no such entry. */
+  static bool
+  Find(const std::string & key, OutputsType & outputs);
+
+  /** Cache outputs, whose total size is numberOfBytes, under key.  The
+   * outputs must not be modified afterwards.  Outputs larger than
+   * MaximumCachedBytes are not cached. */
+  static void
+  Insert(const std::string & key, OutputsType outputs, SizeValueType numberOfBytes);
+
+  /** Remove all the entries. */
+  static void
+  Clear();
+
+  /** Get/Reset the counters of the cache.  Resetting does not change the
+   * number and size of the cached entries. */
+  /** @ITKStartGrouping */
+  static PipelineOutputCacheStatistics
+  GetStatistics();
+  static void
+  ResetStatistics();
+  /** @ITKEndGrouping */
+
+  /** Hash numberOfBytes bytes of data.  Used to key outputs on the
+   * contents of the inputs. */
+  static std::uint64_t
+  HashBytes(const void * data, size_t numberOfBytes);
+
+private:
+  PipelineOutputCache() = default;
+  ~PipelineOutputCache() = default;
+
+  itkGetGlobalDeclarationMacro(PipelineOutputCacheGlobals, PimplGlobals);
+
+  static PipelineOutputCacheGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,269 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineStreamingPlanner_h
+#define itkPipelineStreamingPlanner_h
+
+#include "itkProcessObject.h"
+#include "itkImageRegion.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class PipelineStreamingPlanner
+ * \brief Plans and executes a whole pipeline tile by tile, within a memory
+ * budget.
+ *
+ * Plan() analyzes the pipeline that produces Output, an image of type
+ * TImage:
+ *  - for each filter, it requests a single pixel in the middle of its
+ *    primary output and measures the halo, that is the margin of its image
+ *    inputs around that pixel, as set by its GenerateInputRequestedRegion();
+ *  - it reports the filters that break streaming, either because they
+ *    enlarge their output requested region to the largest possible region,
+ *    or because they request the largest possible region of an input, or
+ *    because they have an image input of another dimension.  The pipeline
+ *    upstream of such a filter is buffered as a whole;
+ *  - it chooses the tile size, by halving the longest side of the tile until
+ *    the estimated size of the outputs of the filters needed for one tile,
+ *    halos included, fits in MemoryBudget / NumberOfParallelTiles.  The
+ *    outputs that are buffered as a whole are excluded from that estimate,
+ *    and reported separately by GetWholeImageBytes().
+ *
+ * Plan() propagates requested regions through the pipeline, then restores
+ * the requested regions of its data objects.
+ *
+ * Update() plans the pipeline, then updates the tiles of the requested
+ * region of Output and copies them into StreamedOutput.
+ *
+ * The tiles are updated in parallel when NumberOfParallelTiles is greater
+ * than one, a PipelineFactory is set, and no filter breaks streaming.
+ * Because a pipeline cannot update two regions at the same time, each
+ * additional tile in flight is updated by another instance of the pipeline,
+ * built by the PipelineFactory.  The instances must not share data objects:
+ * to share an input image, graft it into a new image in each instance.
+ *
+ * \ingroup ITKCommon
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT PipelineStreamingPlanner : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineStreamingPlanner);
+
+  /** Standard class type aliases. */
+  using Self = PipelineStreamingPlanner;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(PipelineStreamingPlanner);
+
+  using ImageType = TImage;
+  using ImagePointer = typename ImageType::Pointer;
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+  using RegionType = ImageRegion<ImageDimension>;
+  using SizeType = typename RegionType::SizeType;
+  using IndexType = typename RegionType::IndexType;
+  using OffsetType = typename RegionType::OffsetType;
+
+  /** The filters of an instance of the pipeline.  The primary output of the
+   * last filter is the terminal output, of type TImage. */
+  using PipelineType = std::vector<ProcessObject::Pointer>;
+
+  /** Builds a new instance of the pipeline. */
+  using PipelineFactoryType = std::function<PipelineType()>;
+
+  /** What Plan() found out about a filter of the pipeline. */
+  struct FilterReport
+  {
+    ProcessObject::ConstPointer Filter{};
+
+    /** Margins of the image inputs of the filter around its output. */
+    OffsetType LowerHalo{};
+    OffsetType UpperHalo{};
+
+    bool BreaksStreaming{ false };
+
+    /** Why the filter breaks streaming. */
+    std::string Reason{};
+  };
+
+  /** Set/Get the terminal output of the pipeline. */
+  /** @ITKStartGrouping */
+  itkSetObjectMacro(Output, ImageType);
+  itkGetModifiableObjectMacro(Output, ImageType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum estimated size, in bytes, of the outputs of the
+   * filters for all the tiles in flight.  Defaults to 256 MiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum number of tiles updated at the same time.
+   * Defaults to one. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(NumberOfParallelTiles, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfParallelTiles, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** Set the function that builds the additional instances of the pipeline
+   * needed to update tiles in parallel. */
+  void
+  SetPipelineFactory(PipelineFactoryType factory)
+  {
+    m_PipelineFactory = std::move(factory);
+    this->Modified();
+  }
+
+  /** Update the output information of the pipeline, measure the halos,
+   * find the filters that break streaming, and choose the tile size. */
+  void
+  Plan();
+
+  /** Plan() the pipeline, then update the requested region of Output tile
+   * by tile into StreamedOutput. */
+  void
+  Update();
+
+  /** The requested region of Output, assembled from the tiles by Update(). */
+  itkGetModifiableObjectMacro(StreamedOutput, ImageType);
+
+  /** Reports on the filters of the pipeline, in execution order. */
+  const std::vector<FilterReport> &
+  GetFilterReports() const
+  {
+    return m_FilterReports;
+  }
+
+  /** Whether no filter breaks streaming. */
+  itkGetConstMacro(Streamable, bool);
+
+  /** Margins of the inputs of the pipeline around a tile. */
+  /** @ITKStartGrouping */
+  itkGetConstReferenceMacro(LowerHalo, OffsetType);
+  itkGetConstReferenceMacro(UpperHalo, OffsetType);
+  /** @ITKEndGrouping */
+
+  /** Size of the tiles, and number of tiles in the requested region. */
+  /** @ITKStartGrouping */
+  itkGetConstReferenceMacro(TileSize, SizeType);
+  itkGetConstMacro(NumberOfTiles, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Estimated size of the outputs of the filters needed for one tile, and
+   * of the outputs buffered as a whole, in bytes. */
+  /** @ITKStartGrouping */
+  itkGetConstMacro(TileBytes, SizeValueType);
+  itkGetConstMacro(WholeImageBytes, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Print the reports on the filters, and the tiling. */
+  void
+  PrintReport(std::ostream & os) const;
+
+protected:
+  PipelineStreamingPlanner() = default;
+  ~PipelineStreamingPlanner() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Filters of the pipeline that produces output, in execution order. */
+  static std::vector<ProcessObject *>
+  GetFilters(const DataObject * output);
+
+  using DataObjectSetType = std::unordered_set<const DataObject *>;
+
+  /** Data objects of the pipeline, with copies of their requested regions. */
+  using RequestedRegionsType = std::vector<std::pair<DataObject::Pointer, DataObject::Pointer>>;
+
+  /** The primary output of filter, or nullptr. */
+  static DataObject *
+  GetPrimaryOutput(ProcessObject * filter);
+
+  /** Save the requested regions of the inputs and outputs of filters. */
+  static RequestedRegionsType
+  SaveRequestedRegions(const std::vector<ProcessObject *> & filters);
+
+  static void
+  RestoreRequestedRegions(const RequestedRegionsType & requestedRegions);
+
+  /** Measure the halos and choose the tile size, for Plan(). */
+  void
+  PlanTiles(const std::vector<ProcessObject *> & filters);
+
+  /** Fills m_FilterReports, and inserts into wholeOutputs the data objects
+   * that the filters which break streaming need as a whole. */
+  void
+  MeasureHalos(const std::vector<ProcessObject *> & filters, DataObjectSetType & wholeOutputs);
+
+  /** Estimated size of the outputs of the filters needed for tile, split
+   * into the outputs that follow the tile, and those buffered as a whole. */
+  void
+  EstimateTileBytes(const std::vector<ProcessObject *> & filters,
+                    const DataObjectSetType &            wholeOutputs,
+                    const RegionType &                   tile,
+                    SizeValueType &                      tileBytes,
+                    SizeValueType &                      wholeImageBytes) const;
+
+  /** The tile of number tileNumber. */
+  RegionType
+  GetTile(SizeValueType tileNumber) const;
+
+  /** Updates the tiles whose numbers nextTile hands out, with the pipeline
+   * that produces output. */
+  void
+  UpdateTiles(ImageType * output, std::atomic<SizeValueType> & nextTile) const;
+
+  ImagePointer        m_Output{};
+  ImagePointer        m_StreamedOutput{};
+  PipelineFactoryType m_PipelineFactory{};
+
+  SizeValueType m_MemoryBudget{ SizeValueType{ 256 } << 20 };
+  unsigned int  m_NumberOfParallelTiles{ 1 };
+
+  std::vector<FilterReport> m_FilterReports{};
+  bool                      m_Streamable{ true };
+  OffsetType                m_LowerHalo{};
+  OffsetType                m_UpperHalo{};
+  RegionType                m_Region{};
+  SizeType                  m_TileSize{};
+  SizeValueType             m_NumberOfTiles{ 0 };
+  SizeValueType             m_TileBytes{ 0 };
+  SizeValueType             m_WholeImageBytes{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPipelineStreamingPlanner.hxx"
+#endif
+
+#endif
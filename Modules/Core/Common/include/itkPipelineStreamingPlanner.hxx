@@ -0,0 +1,524 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineStreamingPlanner_hxx
+#define itkPipelineStreamingPlanner_hxx
+
+#include "itkImageAlgorithm.h"
+#include "itkImageBase.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace itk
+{
+
+template <typename TImage>
+DataObject *
+PipelineStreamingPlanner<TImage>::GetPrimaryOutput(ProcessObject * filter)
+{
+  const ProcessObject::DataObjectPointerArray outputs = filter->GetIndexedOutputs();
+  return outputs.empty() ? nullptr : outputs.front().GetPointer();
+}
+
+
+template <typename TImage>
+auto
+PipelineStreamingPlanner<TImage>::SaveRequestedRegions(const std::vector<ProcessObject *> & filters)
+  -> RequestedRegionsType
+{
+  RequestedRegionsType requestedRegions;
+  DataObjectSetType    savedData;
+  for (ProcessObject * filter : filters)
+  {
+    ProcessObject::DataObjectPointerArray data = filter->GetInputs();
+    const ProcessObject::DataObjectPointerArray outputs = filter->GetOutputs();
+    data.insert(data.end(), outputs.cbegin(), outputs.cend());
+    for (const auto & dataObject : data)
+    {
+      if (dataObject && savedData.insert(dataObject).second)
+      {
+        // An empty data object of the same type holds the requested region.
+        const auto copy = dataObject->CreateAnother();
+        auto       savedRegion = DataObject::Pointer(dynamic_cast<DataObject *>(copy.GetPointer()));
+        if (savedRegion)
+        {
+          savedRegion->SetRequestedRegion(dataObject);
+          requestedRegions.emplace_back(dataObject, savedRegion);
+        }
+      }
+    }
+  }
+  return requestedRegions;
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::RestoreRequestedRegions(const RequestedRegionsType & requestedRegions)
+{
+  for (const auto & requestedRegion : requestedRegions)
+  {
+    requestedRegion.first->SetRequestedRegion(requestedRegion.second);
+  }
+}
+
+
+template <typename TImage>
+std::vector<ProcessObject *>
+PipelineStreamingPlanner<TImage>::GetFilters(const DataObject * output)
+{
+  // Depth first, in the order in which UpdateOutputData() executes them.
+  std::vector<ProcessObject *>              filters;
+  std::unordered_set<const ProcessObject *> visitedFilters;
+
+  const std::function<void(ProcessObject *)> visit = [&](ProcessObject * filter) {
+    if (!visitedFilters.insert(filter).second)
+    {
+      return;
+    }
+    for (const auto & input : filter->GetInputs())
+    {
+      if (input)
+      {
+        if (const auto source = input->GetSource())
+        {
+          visit(source);
+        }
+      }
+    }
+    filters.push_back(filter);
+  };
+  if (const auto source = output->GetSource())
+  {
+    visit(source);
+  }
+  return filters;
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::MeasureHalos(const std::vector<ProcessObject *> & filters,
+                                               DataObjectSetType &                  wholeOutputs)
+{
+  using ImageBaseType = ImageBase<ImageDimension>;
+
+  const auto isImageOfOtherDimension = [](const DataObject * data) {
+    const bool isImage =
+      dynamic_cast<const ImageBase<1> *>(data) != nullptr || dynamic_cast<const ImageBase<2> *>(data) != nullptr ||
+      dynamic_cast<const ImageBase<3> *>(data) != nullptr || dynamic_cast<const ImageBase<4> *>(data) != nullptr;
+    return isImage && dynamic_cast<const ImageBaseType *>(data) == nullptr;
+  };
+
+  m_FilterReports.clear();
+  m_Streamable = true;
+
+  for (ProcessObject * filter : filters)
+  {
+    FilterReport report;
+    report.Filter = filter;
+
+    // The names and the inputs are in the same order.
+    const ProcessObject::NameArray             inputNames = filter->GetInputNames();
+    const ProcessObject::DataObjectPointerArray inputs = filter->GetInputs();
+
+    auto * const output = dynamic_cast<ImageBaseType *>(GetPrimaryOutput(filter));
+    if (output == nullptr)
+    {
+      report.BreaksStreaming = true;
+      report.Reason = "its primary output is not an image of dimension " + std::to_string(ImageDimension);
+      wholeOutputs.insert(inputs.cbegin(), inputs.cend());
+    }
+    else
+    {
+      // Request the pixel in the middle of the output.
+      const RegionType largestRegion = output->GetLargestPossibleRegion();
+      RegionType       pixel = largestRegion;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        pixel.SetIndex(i, largestRegion.GetIndex(i) + static_cast<IndexValueType>(largestRegion.GetSize(i) / 2));
+        pixel.SetSize(i, std::min<SizeValueType>(largestRegion.GetSize(i), 1));
+      }
+      output->SetRequestedRegion(pixel);
+      filter->PropagateRequestedRegion(output);
+
+      if (output->GetRequestedRegion() != pixel && output->GetRequestedRegion() == largestRegion)
+      {
+        report.BreaksStreaming = true;
+        report.Reason = "it enlarges its output requested region to the largest possible region";
+        const ProcessObject::DataObjectPointerArray outputs = filter->GetOutputs();
+        wholeOutputs.insert(outputs.cbegin(), outputs.cend());
+        wholeOutputs.insert(inputs.cbegin(), inputs.cend());
+      }
+
+      for (size_t k = 0; k < inputs.size(); ++k)
+      {
+        if (isImageOfOtherDimension(inputs[k]))
+        {
+          report.BreaksStreaming = true;
+          report.Reason = "its input " + inputNames[k] + " is an image of another dimension";
+          wholeOutputs.insert(inputs[k]);
+          continue;
+        }
+        const auto * const image = dynamic_cast<const ImageBaseType *>(inputs[k].GetPointer());
+        if (image == nullptr || report.BreaksStreaming)
+        {
+          continue;
+        }
+
+        const RegionType & requestedRegion = image->GetRequestedRegion();
+        if (requestedRegion == image->GetLargestPossibleRegion() && requestedRegion.GetNumberOfPixels() > 1 &&
+            output->GetRequestedRegion() != largestRegion)
+        {
+          report.BreaksStreaming = true;
+          report.Reason = "it requests the largest possible region of its input " + inputNames[k];
+          wholeOutputs.insert(image);
+        }
+        else if (image->GetLargestPossibleRegion() == largestRegion)
+        {
+          // The halo is only meaningful when the input and the output share
+          // their index space.
+          for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+            report.LowerHalo[i] = std::max(report.LowerHalo[i], pixel.GetIndex(i) - requestedRegion.GetIndex(i));
+            report.UpperHalo[i] =
+              std::max(report.UpperHalo[i], requestedRegion.GetUpperIndex()[i] - pixel.GetUpperIndex()[i]);
+          }
+        }
+      }
+    }
+
+    m_Streamable = m_Streamable && !report.BreaksStreaming;
+    m_FilterReports.push_back(std::move(report));
+  }
+
+  // A filter needs its inputs as a whole to produce an output as a whole.
+  for (auto filter = filters.rbegin(); filter != filters.rend(); ++filter)
+  {
+    const ProcessObject::DataObjectPointerArray outputs = (*filter)->GetOutputs();
+    const bool                                  producesWholeOutput =
+      std::any_of(outputs.cbegin(), outputs.cend(), [&wholeOutputs](const auto & output) {
+        return wholeOutputs.count(output) > 0;
+      });
+    if (producesWholeOutput)
+    {
+      const ProcessObject::DataObjectPointerArray inputs = (*filter)->GetInputs();
+      wholeOutputs.insert(inputs.cbegin(), inputs.cend());
+    }
+  }
+  wholeOutputs.erase(nullptr);
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::EstimateTileBytes(const std::vector<ProcessObject *> & filters,
+                                                    const DataObjectSetType &            wholeOutputs,
+                                                    const RegionType &                   tile,
+                                                    SizeValueType &                      tileBytes,
+                                                    SizeValueType &                      wholeImageBytes) const
+{
+  m_Output->SetRequestedRegion(tile);
+  m_Output->PropagateRequestedRegion();
+
+  tileBytes = 0;
+  wholeImageBytes = 0;
+  for (ProcessObject * filter : filters)
+  {
+    for (const auto & output : filter->GetOutputs())
+    {
+      if (output)
+      {
+        const SizeValueType outputBytes = filter->EstimateOutputBulkDataSize(output);
+        (wholeOutputs.count(output) > 0 ? wholeImageBytes : tileBytes) += outputBytes;
+      }
+    }
+  }
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::Plan()
+{
+  if (m_Output.IsNull())
+  {
+    itkExceptionMacro("Output is not set.");
+  }
+
+  m_Output->UpdateOutputInformation();
+  m_Region = m_Output->GetRequestedRegion();
+
+  const std::vector<ProcessObject *> filters = GetFilters(m_Output);
+  const RequestedRegionsType         requestedRegions = SaveRequestedRegions(filters);
+  try
+  {
+    this->PlanTiles(filters);
+  }
+  catch (...)
+  {
+    RestoreRequestedRegions(requestedRegions);
+    throw;
+  }
+  RestoreRequestedRegions(requestedRegions);
+
+  if (!m_Streamable)
+  {
+    itkDebugMacro("The pipeline is buffered as a whole upstream of the filters that break streaming.");
+  }
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::PlanTiles(const std::vector<ProcessObject *> & filters)
+{
+  DataObjectSetType wholeOutputs;
+  this->MeasureHalos(filters, wholeOutputs);
+
+  // Margins of the images of the pipeline around the pixel in the middle of
+  // Output.
+  const RegionType & largestRegion = m_Output->GetLargestPossibleRegion();
+  RegionType         pixel = largestRegion;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    pixel.SetIndex(i, largestRegion.GetIndex(i) + static_cast<IndexValueType>(largestRegion.GetSize(i) / 2));
+    pixel.SetSize(i, std::min<SizeValueType>(largestRegion.GetSize(i), 1));
+  }
+  m_Output->SetRequestedRegion(pixel);
+  m_Output->PropagateRequestedRegion();
+  m_LowerHalo.Fill(0);
+  m_UpperHalo.Fill(0);
+  for (ProcessObject * filter : filters)
+  {
+    for (const auto & input : filter->GetInputs())
+    {
+      const auto * const image = dynamic_cast<const ImageBase<ImageDimension> *>(input.GetPointer());
+      if (image != nullptr && image->GetLargestPossibleRegion() == largestRegion &&
+          wholeOutputs.count(image) == 0)
+      {
+        const RegionType & requestedRegion = image->GetRequestedRegion();
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          m_LowerHalo[i] = std::max(m_LowerHalo[i], pixel.GetIndex(i) - requestedRegion.GetIndex(i));
+          m_UpperHalo[i] = std::max(m_UpperHalo[i], requestedRegion.GetUpperIndex()[i] - pixel.GetUpperIndex()[i]);
+        }
+      }
+    }
+  }
+
+  // Halve the longest side of the tile, centered in the requested region,
+  // until the outputs for one tile in flight fit in the budget.
+  const SizeValueType budget = m_MemoryBudget / m_NumberOfParallelTiles;
+  m_TileSize = m_Region.GetSize();
+  while (true)
+  {
+    RegionType tile = m_Region;
+    tile.SetSize(m_TileSize);
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      tile.SetIndex(i, m_Region.GetIndex(i) + static_cast<IndexValueType>((m_Region.GetSize(i) - m_TileSize[i]) / 2));
+    }
+    this->EstimateTileBytes(filters, wholeOutputs, tile, m_TileBytes, m_WholeImageBytes);
+
+    const auto longestSide = std::max_element(m_TileSize.begin(), m_TileSize.end());
+    if (m_TileBytes <= budget || *longestSide <= 1)
+    {
+      break;
+    }
+    *longestSide = (*longestSide + 1) / 2;
+  }
+
+  m_NumberOfTiles = 0;
+  if (m_Region.GetNumberOfPixels() > 0)
+  {
+    m_NumberOfTiles = 1;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      m_NumberOfTiles *= (m_Region.GetSize(i) + m_TileSize[i] - 1) / m_TileSize[i];
+    }
+  }
+}
+
+
+template <typename TImage>
+auto
+PipelineStreamingPlanner<TImage>::GetTile(SizeValueType tileNumber) const -> RegionType
+{
+  RegionType tile;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const SizeValueType numberOfTiles = (m_Region.GetSize(i) + m_TileSize[i] - 1) / m_TileSize[i];
+    const SizeValueType start = (tileNumber % numberOfTiles) * m_TileSize[i];
+    tileNumber /= numberOfTiles;
+
+    tile.SetIndex(i, m_Region.GetIndex(i) + static_cast<IndexValueType>(start));
+    tile.SetSize(i, std::min(m_TileSize[i], m_Region.GetSize(i) - start));
+  }
+  return tile;
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::UpdateTiles(ImageType * output, std::atomic<SizeValueType> & nextTile) const
+{
+  for (SizeValueType tileNumber = nextTile++; tileNumber < m_NumberOfTiles; tileNumber = nextTile++)
+  {
+    const RegionType tile = this->GetTile(tileNumber);
+    output->SetRequestedRegion(tile);
+    output->PropagateRequestedRegion();
+    output->UpdateOutputData();
+
+    // The tiles are disjoint, so that they can be copied concurrently.
+    ImageAlgorithm::Copy(output, m_StreamedOutput.GetPointer(), tile, tile);
+  }
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::Update()
+{
+  this->Plan();
+
+  m_StreamedOutput = ImageType::New();
+  m_StreamedOutput->CopyInformation(m_Output);
+  m_StreamedOutput->SetRequestedRegion(m_Region);
+  m_StreamedOutput->SetBufferedRegion(m_Region);
+  m_StreamedOutput->Allocate();
+
+  // The additional instances of the pipeline, for the tiles in flight.
+  std::vector<PipelineType> pipelines;
+  std::vector<ImageType *>  outputs{ m_Output.GetPointer() };
+  if (m_PipelineFactory && m_Streamable)
+  {
+    const SizeValueType numberOfInstances = std::min<SizeValueType>(m_NumberOfParallelTiles, m_NumberOfTiles);
+    for (SizeValueType i = 1; i < numberOfInstances; ++i)
+    {
+      pipelines.push_back(m_PipelineFactory());
+      auto * const output =
+        pipelines.back().empty() ? nullptr : dynamic_cast<ImageType *>(GetPrimaryOutput(pipelines.back().back()));
+      if (output == nullptr)
+      {
+        itkExceptionMacro("The pipeline factory built a pipeline whose primary output is not a "
+                          << m_Output->GetNameOfClass());
+      }
+      output->UpdateOutputInformation();
+      if (output->GetLargestPossibleRegion() != m_Output->GetLargestPossibleRegion())
+      {
+        itkExceptionMacro("The pipeline factory built a pipeline whose output has the largest possible region "
+                          << output->GetLargestPossibleRegion() << " instead of "
+                          << m_Output->GetLargestPossibleRegion());
+      }
+      outputs.push_back(output);
+    }
+  }
+
+  std::atomic<SizeValueType> nextTile{ 0 };
+  if (outputs.size() == 1)
+  {
+    this->UpdateTiles(m_Output, nextTile);
+  }
+  else
+  {
+    std::exception_ptr exception;
+    std::mutex         exceptionMutex;
+    const auto         updateTiles = [this, &nextTile, &exception, &exceptionMutex](ImageType * output) {
+      try
+      {
+        this->UpdateTiles(output, nextTile);
+      }
+      catch (...)
+      {
+        // Stop handing out tiles, and report the first exception.
+        nextTile = m_NumberOfTiles;
+        const std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < outputs.size(); ++i)
+    {
+      threads.emplace_back(updateTiles, outputs[i]);
+    }
+    updateTiles(outputs.front());
+    for (auto & thread : threads)
+    {
+      thread.join();
+    }
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  m_Output->SetRequestedRegion(m_Region);
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::PrintReport(std::ostream & os) const
+{
+  for (const FilterReport & report : m_FilterReports)
+  {
+    os << report.Filter->GetNameOfClass() << " (" << report.Filter.GetPointer() << "): halo " << report.LowerHalo
+       << ' ' << report.UpperHalo;
+    if (report.BreaksStreaming)
+    {
+      os << ", breaks streaming because " << report.Reason;
+    }
+    os << std::endl;
+  }
+  os << "Tile size " << m_TileSize << ", " << m_NumberOfTiles << " tiles of " << m_TileBytes << " bytes, "
+     << m_WholeImageBytes << " bytes buffered as a whole" << std::endl;
+}
+
+
+template <typename TImage>
+void
+PipelineStreamingPlanner<TImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Output);
+  itkPrintSelfObjectMacro(StreamedOutput);
+  os << indent << "PipelineFactory: " << (m_PipelineFactory ? "(set)" : "(none)") << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "NumberOfParallelTiles: " << m_NumberOfParallelTiles << std::endl;
+  os << indent << "NumberOfFilterReports: " << m_FilterReports.size() << std::endl;
+  itkPrintSelfBooleanMacro(Streamable);
+  os << indent << "LowerHalo: " << m_LowerHalo << std::endl;
+  os << indent << "UpperHalo: " << m_UpperHalo << std::endl;
+  os << indent << "Region: " << m_Region << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
+  os << indent << "NumberOfTiles: " << m_NumberOfTiles << std::endl;
+  os << indent << "TileBytes: " << m_TileBytes << std::endl;
+  os << indent << "WholeImageBytes: " << m_WholeImageBytes << std::endl;
+}
+
+} // end namespace itk
+
+#endif
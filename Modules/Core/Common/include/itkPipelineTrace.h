@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineTrace_h
+#define itkPipelineTrace_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include "itkSingletonMacro.h"
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class PipelineTrace
+ * \brief Records the executions of pipeline filters and of their work units.
+ *
+ * When the trace is enabled, ProcessObject::UpdateOutputData() records an
+ * event for each execution of a filter, with its wall time, the CPU time
+ * consumed meanwhile by the whole process (including other threads and
+ * pipelines running concurrently), the bytes of image buffers allocated meanwhile, the
+ * requested and buffered region sizes of its image outputs, and the
+ * number of times the filter has executed since the trace was cleared.
+ * MultiThreaderBase records an event for each work unit, on the thread
+ * that executes it.  Load imbalance between work units, and filters that
+ * execute again although their inputs did not change, then show in the
+ * trace.
+ *
+ * The events are written in the Chrome trace event format by
+ * WriteChromeTrace(), and can be viewed with chrome://tracing or
+ * https://ui.perfetto.dev.
+ *
+ * The trace is disabled by default.  Besides SetEnabled(), it is enabled
+ * when the ITK_PIPELINE_TRACE environment variable is set to a file name,
+ * in which case the trace is written to that file at exit.
+ *
+ * \ingroup ITKCommon
+ */
+struct PipelineTraceGlobals;
+
+class ITKCommon_EXPORT PipelineTrace
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineTrace);
+
+  /** Name and value of an argument of an event. */
+  using ArgumentType = std::pair<std::string, std::string>;
+  using ArgumentsType = std::vector<ArgumentType>;
+
+  /** Set/Get whether events are recorded.  Default = false, unless the
+   * ITK_PIPELINE_TRACE environment variable is set. */
+  /** @ITKStartGrouping */
+  static void
+  SetEnabled(bool enabled);
+  static bool
+  GetEnabled();
+  /** @ITKEndGrouping */
+
+  /** Remove all the recorded events and execution counts. */
+  static void
+  Clear();
+
+  /** Get the number of recorded events. */
+  static SizeValueType
+  GetNumberOfEvents();
+
+  /** Get the time, in microseconds, since the trace was created.  Used as
+   * the start time of events. */
+  static double
+  GetTime();
+
+  /** Record an event of the calling thread that started at startTime and
+   * lasted duration microseconds.  Does nothing when the trace is disabled. */
+  static void
+  AddEvent(std::string name, std::string category, double startTime, double duration, ArgumentsType arguments = {});
+
+  /** Count an execution of object, and return the number of times it
+   * executed since the trace was cleared, including this one. */
+  static SizeValueType
+  AddExecution(const void * object);
+
+  /** Forget the executions of object, when it is destroyed, so that they are
+   * not counted for another object later allocated at the same address. */
+  static void
+  RemoveExecutions(const void * object);
+
+  /** Add/Get the total number of bytes of image buffers allocated while
+   * the trace is enabled. */
+  /** @ITKStartGrouping */
+  static void
+  AddAllocatedBytes(SizeValueType numberOfBytes);
+  static SizeValueType
+  GetAllocatedBytes();
+  /** @ITKEndGrouping */
+
+  /** Write the recorded events in the Chrome trace event format. */
+  /** @ITKStartGrouping */
+  static void
+  WriteChromeTrace(std::ostream & os);
+  static void
+  WriteChromeTrace(const std::string & fileName);
+  /** @ITKEndGrouping */
+
+private:
+  PipelineTrace() = default;
+  ~PipelineTrace() = default;
+
+  itkGetGlobalDeclarationMacro(PipelineTraceGlobals, PimplGlobals);
+
+  static PipelineTraceGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
@@ -498,6 +498,19 @@ public:
   itkBooleanMacro(ReleaseDataBeforeUpdateFlag);
   /** @ITKEndGrouping */
 
+  /** Turn on/off the PipelineOutputCache for this filter.  When on, the
+   * filter does not execute if outputs computed by a filter of the same
+   * class, with the same parameters, on the same inputs and for the same
+   * requested regions are in the cache, and copies of those outputs are
+   * used instead.  Only the filters that write their parameters with
+   * AppendParametersToOutputCacheKey() are cached; the setting has no
+   * effect on the others.  Default value is off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseOutputCache, bool);
+  itkGetConstMacro(UseOutputCache, bool);
+  itkBooleanMacro(UseOutputCache);
+  /** @ITKEndGrouping */
+
   /** Get/Set the number of work units to create when executing. */
   /** @ITKStartGrouping */
   itkSetClampMacro(NumberOfWorkUnits, ThreadIdType, 1, ITK_MAX_THREADS);
@@ -524,6 +537,31 @@ public:
   virtual void
   PrepareOutputs();
 
+  /** Return the size in bytes of the bulk data of output for its requested
+   * region, or 0 when it is not known, which is the case of the default
+   * implementation.  Used by the PipelineMemoryPlanner.  ImageSource
+   * estimates the size of its images. */
+  virtual SizeValueType
+  EstimateOutputBulkDataSize(const DataObject * output) const;
+
+  /** Return whether the filter reuses the bulk data of its primary input
+   * for its primary output, when their regions match.  Used by the
+   * PipelineMemoryPlanner.  The default implementation returns false. */
+  virtual bool
+  IsInPlaceExecutionEnabled() const;
+
+  /** Let the filter reuse the bulk data of its primary input for its
+   * primary output, if it supports it, and return whether it does.  Used
+   * by the PipelineMemoryPlanner.  The default implementation returns
+   * false.  InPlaceImageFilter turns InPlace on when it can run in place. */
+  virtual bool
+  EnableInPlaceExecution();
+
+  /** Undo EnableInPlaceExecution().  Used by the PipelineMemoryPlanner.  The
+   * default implementation does nothing. */
+  virtual void
+  DisableInPlaceExecution();
+
 protected:
   ProcessObject();
   ~ProcessObject() override;
@@ -946,6 +984,38 @@ protected:
     return static_cast<uint32_t>(temp);
   }
 
+  /** Write to key what determines the outputs of the filter, for the
+   * PipelineOutputCache: the class of the filter, its parameters as written
+   * by AppendParametersToOutputCacheKey(), the inputs as written by
+   * AppendInputToOutputCacheKey(), and the requested regions of the outputs.
+   * Returns false if the outputs cannot be cached. */
+  virtual bool
+  GenerateOutputCacheKey(std::ostream & key) const;
+
+  /** Write to key all the parameters that determine the outputs of the
+   * filter, besides its inputs and requested regions, for the
+   * PipelineOutputCache.  key writes floating point values with all their
+   * significant digits.  Returns false if the outputs cannot be cached,
+   * which is the case of the default implementation: a filter opts in to
+   * the cache by overriding this method and returning true. */
+  virtual bool
+  AppendParametersToOutputCacheKey(std::ostream & key) const;
+
+  /** Write to key what identifies input for the PipelineOutputCache.  The
+   * default implementation writes its address and modification times, so
+   * that only a filter executed on the same input objects hits the cache.
+   * ImageToImageFilter writes the geometry and a hash of the pixels of its
+   * images instead. */
+  virtual void
+  AppendInputToOutputCacheKey(const DataObject * input, std::ostream & key) const;
+
+  /** Return a copy of output that does not share its bulk data, and its size
+   * in bytes, for the PipelineOutputCache.  Returns nullptr when output
+   * cannot be copied, which is the case of the default implementation.
+   * ImageSource copies its images. */
+  virtual DataObjectPointer
+  CopyOutputForCache(const DataObject * output, SizeValueType & numberOfBytes) const;
+
   /** Sets the required number of outputs, and creates each of them by MakeOutput. */
   template <typename TSourceObject>
   static void
@@ -974,6 +1044,15 @@ private:
   DataObjectPointerArraySizeType
   MakeIndexFromName(const DataObjectIdentifierType &) const;
 
+  /** Graft copies of the outputs cached under key onto the outputs.
+   * Returns false if they are not in the PipelineOutputCache. */
+  bool
+  GraftCachedOutputs(const std::string & key);
+
+  /** Add copies of the outputs to the PipelineOutputCache under key. */
+  void
+  CacheOutputs(const std::string & key) const;
+
   /** STL map to store the named inputs and outputs */
   using DataObjectPointerMap = std::map<DataObjectIdentifierType, DataObjectPointer>;
 
@@ -1014,9 +1093,12 @@ private:
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag{};
 
+  bool m_UseOutputCache{ false };
+
   /** Friends of ProcessObject */
   friend class DataObject;
 
+
   friend class ProgressReporter;
   friend class TotalProgressReporter;
 
@@ -205,7 +205,7 @@ public:
   GetPixel(const IndexType & index) const
   {
     const OffsetValueType offset = this->FastComputeOffset(index);
-    return (*m_Buffer)[offset];
+    return std::as_const(*m_Buffer)[offset];
   }
 
   /** \brief Get a reference to a pixel (e.g. for editing).
@@ -250,7 +250,7 @@ public:
   const TPixel *
   GetBufferPointer() const
   {
-    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+    return m_Buffer ? std::as_const(*m_Buffer).GetBufferPointer() : nullptr;
   }
   /** @ITKEndGrouping */
   /** Return a pointer to the container. */
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkImageRegionSplitterBase.h"
+#include "itkParallelStreamingExecutor.h"
 
 namespace itk
 {
@@ -36,6 +37,20 @@ namespace itk
  * This filter will produce the entire output as one image, but the upstream
  * filters will do their processing in pieces.
  *
+ * By default, the pieces are processed one after another.  When
+ * NumberOfPiecesInFlight is greater than one and a PipelineFactory is set,
+ * up to NumberOfPiecesInFlight pieces are processed at the same time, each
+ * by its own instance of the upstream pipeline: the input of this filter
+ * processes the first one, and the PipelineFactory builds the instances for
+ * the others.  The instances must not share data objects; to share an
+ * input image, graft it into a new image in each instance.  The pieces in
+ * flight are limited so that their estimated size stays within
+ * MemoryBudget.  The size of a piece is estimated as the size of the
+ * corresponding region of the input, and does not count the intermediate
+ * outputs of the upstream filters.
+ *
+ * \sa ParallelStreamingExecutor
+ *
  * \ingroup ITKSystemObjects
  * \ingroup DataProcessing
  * \ingroup ITKCommon
@@ -91,6 +106,34 @@ public:
   itkSetObjectMacro(RegionSplitter, SplitterType);
   itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
   /** @ITKEndGrouping */
+
+  /** Instances of the upstream pipeline, built by the PipelineFactory. */
+  using PipelineType = ParallelStreamingExecutor::PipelineType;
+  using PipelineFactoryType = ParallelStreamingExecutor::PipelineFactoryType;
+
+  /** Set/Get the maximum number of pieces processed at the same time.
+   * Defaults to one. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(NumberOfPiecesInFlight, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfPiecesInFlight, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum estimated size, in bytes, of the pieces in flight.
+   * Defaults to 256 MiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set the function that builds the instances of the upstream pipeline
+   * for the pieces in flight other than the first.  The primary output of
+   * the last filter of an instance must be a TInputImage. */
+  void
+  SetPipelineFactory(PipelineFactoryType factory)
+  {
+    m_PipelineFactory = std::move(factory);
+    this->Modified();
+  }
   /** Override UpdateOutputData() from ProcessObject to divide upstream
    * updates into pieces. This filter does not have a GenerateData()
    * or ThreadedGenerateData() method.  Instead, all the work is done
@@ -115,9 +158,17 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Update the numDivisions pieces of the output, with up to
+   * NumberOfPiecesInFlight pieces in flight. */
+  void
+  UpdatePiecesInFlight(unsigned int numDivisions);
+
 private:
   unsigned int          m_NumberOfStreamDivisions{};
   RegionSplitterPointer m_RegionSplitter{};
+  unsigned int          m_NumberOfPiecesInFlight{ 1 };
+  SizeValueType         m_MemoryBudget{ SizeValueType{ 256 } << 20 };
+  PipelineFactoryType   m_PipelineFactory{};
 };
 } // end namespace itk
 
@@ -21,6 +21,10 @@
 #include "itkImageAlgorithm.h"
 #include "itkImageRegionSplitterSlowDimension.h"
 
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
 namespace itk
 {
 /**
@@ -46,6 +50,9 @@ StreamingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions << std::endl;
 
   itkPrintSelfObjectMacro(RegionSplitter);
+  os << indent << "NumberOfPiecesInFlight: " << m_NumberOfPiecesInFlight << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "PipelineFactory: " << (m_PipelineFactory ? "(set)" : "(none)") << std::endl;
 }
 
 /**
@@ -88,6 +95,77 @@ StreamingImageFilter<TInputImage, TOutputImage>::PropagateRequestedRegion(DataOb
   // because the pipeline managed later
 }
 
+/**
+ *
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+StreamingImageFilter<TInputImage, TOutputImage>::UpdatePiecesInFlight(unsigned int numDivisions)
+{
+  OutputImageType *           outputPtr = this->GetOutput(0);
+  const OutputImageRegionType outputRegion = outputPtr->GetRequestedRegion();
+
+  std::vector<InputImageRegionType> streamRegions(numDivisions, outputRegion);
+  for (unsigned int piece = 0; piece < numDivisions; ++piece)
+  {
+    m_RegionSplitter->GetSplit(piece, numDivisions, streamRegions[piece]);
+  }
+
+  // One instance of the upstream pipeline per piece in flight.
+  std::vector<PipelineType>     pipelines;
+  std::vector<InputImageType *> inputs{ const_cast<InputImageType *>(this->GetInput(0)) };
+  const InputImageRegionType    largestRegion = inputs.front()->GetLargestPossibleRegion();
+  while (inputs.size() < std::min(m_NumberOfPiecesInFlight, numDivisions))
+  {
+    pipelines.push_back(m_PipelineFactory());
+    auto * const input = ParallelStreamingExecutor::GetOutput<InputImageType>(pipelines.back());
+    if (input == nullptr)
+    {
+      itkExceptionMacro("The pipeline factory built a pipeline whose output is not a "
+                        << inputs.front()->GetNameOfClass());
+    }
+    input->UpdateOutputInformation();
+    if (input->GetLargestPossibleRegion() != largestRegion)
+    {
+      itkExceptionMacro("The pipeline factory built a pipeline whose output has the largest possible region "
+                        << input->GetLargestPossibleRegion() << " instead of " << largestRegion);
+    }
+    inputs.push_back(input);
+  }
+
+  using InternalPixelType = typename InputImageType::InternalPixelType;
+  const SizeValueType pixelBytes =
+    sizeof(InternalPixelType) *
+    (std::is_same_v<InternalPixelType, InputImagePixelType> ? 1 : inputs.front()->GetNumberOfComponentsPerPixel());
+  const auto pieceBytes = [&streamRegions, pixelBytes](unsigned int piece) -> SizeValueType {
+    return streamRegions[piece].GetNumberOfPixels() * pixelBytes;
+  };
+
+  std::atomic<unsigned int> numberOfUpdatedPieces{ 0 };
+  const auto                updatePiece = [&](unsigned int worker, unsigned int piece) {
+    if (this->GetAbortGenerateData())
+    {
+      return;
+    }
+    InputImageType * const inputPtr = inputs[worker];
+    inputPtr->SetRequestedRegion(streamRegions[piece]);
+    inputPtr->PropagateRequestedRegion();
+    inputPtr->UpdateOutputData();
+
+    // The pieces are disjoint, so that they can be copied concurrently.
+    ImageAlgorithm::Copy(inputPtr, outputPtr, streamRegions[piece], streamRegions[piece]);
+
+    const unsigned int numberOfPieces = ++numberOfUpdatedPieces;
+    if (worker == 0)
+    {
+      this->UpdateProgress(static_cast<float>(numberOfPieces) / static_cast<float>(numDivisions));
+    }
+  };
+
+  ParallelStreamingExecutor::Execute(
+    numDivisions, static_cast<unsigned int>(inputs.size()), m_MemoryBudget, pieceBytes, updatePiece, nullptr);
+}
+
 /**
  *
  */
@@ -162,6 +240,11 @@ StreamingImageFilter<TInputImage, TOutputImage>::UpdateOutputData(DataObject * i
    * piece, and copy the results into the output image.
    */
   unsigned int piece = 0;
+  if (m_NumberOfPiecesInFlight > 1 && m_PipelineFactory && numDivisions > 1)
+  {
+    this->UpdatePiecesInFlight(numDivisions);
+    piece = numDivisions;
+  }
   for (; piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
   {
     InputImageRegionType streamRegion = outputRegion;
@@ -115,6 +115,12 @@ auto result = pool->AddWork([](int param) { return param; }, 7);
   int
   GetNumberOfCurrentlyIdleThreads() const;
 
+  /** Return whether the calling thread is one of the threads of the pool.
+   * Such a thread should not wait for work that it submits to the pool,
+   * as all the threads of the pool may be waiting already. */
+  static bool
+  IsCalledFromPoolThread();
+
   /** Set/Get wait for threads.
   This function should be used carefully, probably only during static
   initialization phase to disable waiting for threads when ITK is built as a
@@ -243,7 +243,7 @@ public:
 
     // Do not create a local for this method, to use return value
     // optimization.
-    return PixelType(&((*m_Buffer)[offset]), m_VectorLength);
+    return PixelType(const_cast<InternalPixelType *>(&std::as_const(*m_Buffer)[offset]), m_VectorLength);
   }
 
   /** \brief Get a "reference" to a pixel. This result cannot be used
@@ -301,7 +301,7 @@ public:
   const InternalPixelType *
   GetBufferPointer() const
   {
-    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+    return m_Buffer ? std::as_const(*m_Buffer).GetBufferPointer() : nullptr;
   }
   /** @ITKEndGrouping */
   /** Return a pointer to the container. */
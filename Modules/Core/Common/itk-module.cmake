@@ -23,6 +23,7 @@ itk_module(
     ${ITKCOMMON_TBB_DEPENDS}
   PRIVATE_DEPENDS
     ITKDoubleConversion
+    ITKZLIB
   COMPILE_DEPENDS
     ITKKWSys
   TEST_DEPENDS
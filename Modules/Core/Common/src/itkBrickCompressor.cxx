@@ -0,0 +1,62 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBrickCompressor.h"
+#include "itkMacro.h"
+#include "itk_zlib.h"
+
+namespace itk
+{
+
+void
+BrickCompressor::Compress(const void * data, SizeValueType numberOfBytes, int level, CompressedBufferType & compressed)
+{
+  const auto sourceLength = static_cast<uLong>(numberOfBytes);
+  if (sourceLength != numberOfBytes)
+  {
+    itkGenericExceptionMacro("Brick of " << numberOfBytes << " bytes is too large to be compressed.");
+  }
+
+  auto destinationLength = compressBound(sourceLength);
+  compressed.resize(destinationLength);
+  const int result =
+    compress2(compressed.data(), &destinationLength, static_cast<const Bytef *>(data), sourceLength, level);
+  if (result != Z_OK)
+  {
+    itkGenericExceptionMacro("zlib compress2 failed with error " << result << '.');
+  }
+  compressed.resize(destinationLength);
+  compressed.shrink_to_fit();
+}
+
+
+void
+BrickCompressor::Decompress(const CompressedBufferType & compressed, void * data, SizeValueType numberOfBytes)
+{
+  auto      destinationLength = static_cast<uLongf>(numberOfBytes);
+  const int result = uncompress(static_cast<Bytef *>(data),
+                                &destinationLength,
+                                compressed.data(),
+                                static_cast<uLong>(compressed.size()));
+  if (result != Z_OK || destinationLength != numberOfBytes)
+  {
+    itkGenericExceptionMacro("zlib uncompress failed with error " << result << ", " << destinationLength << " of "
+                                                                  << numberOfBytes << " bytes decompressed.");
+  }
+}
+
+} // end namespace itk
@@ -0,0 +1,434 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+constexpr size_t SmallestSizeClass{ 4096 };
+constexpr size_t HugePageSize{ size_t{ 2 } << 20 };
+
+struct BufferInfo
+{
+  size_t Size;
+  size_t Alignment;
+};
+
+struct CachedBuffer
+{
+  void *     Buffer;
+  BufferInfo Info;
+};
+
+void
+FreeBuffer(const CachedBuffer & cachedBuffer)
+{
+  ::operator delete(cachedBuffer.Buffer, std::align_val_t{ cachedBuffer.Info.Alignment });
+}
+} // namespace
+
+struct ImageBufferPoolGlobals
+{
+  ImageBufferPoolGlobals() = default;
+
+  /** Remove the least recently released buffers until the cache holds at
+   * most maximumBytes bytes, and return them. */
+  std::vector<CachedBuffer>
+  Trim(size_t maximumBytes)
+  {
+    std::vector<CachedBuffer> evictedBuffers;
+    while (m_Statistics.CachedBytes > maximumBytes)
+    {
+      evictedBuffers.push_back(m_CachedBuffers.back());
+      this->Uncache(std::prev(m_CachedBuffers.end()));
+    }
+    return evictedBuffers;
+  }
+
+  void
+  Uncache(std::list<CachedBuffer>::iterator it)
+  {
+    m_Statistics.CachedBytes -= it->Info.Size;
+    --m_Statistics.NumberOfCachedBuffers;
+    m_CachedBuffers.erase(it);
+  }
+
+  std::mutex m_Mutex{};
+
+  /** Read without the lock by AllocateBuffer, which returns early when the
+   * pool is disabled or the request is small. */
+  std::atomic<bool>   m_Enabled{ false };
+  std::atomic<size_t> m_MinimumBufferSize{ size_t{ 64 } << 10 };
+
+  size_t m_MaximumCachedBytes{ size_t{ 1 } << 30 };
+  size_t m_MaximumCachedBuffersPerSizeClass{ 8 };
+  size_t m_Alignment{ 64 };
+  bool   m_UseHugePages{ false };
+
+  /** Set at program exit, after which released buffers are not cached. */
+  bool m_Finalized{ false };
+
+  /** Buffers in use, and idle buffers with the most recently released first. */
+  std::unordered_map<void *, BufferInfo> m_OutstandingBuffers{};
+  std::atomic<size_t>                    m_NumberOfOutstandingBuffers{ 0 };
+  std::list<CachedBuffer>                m_CachedBuffers{};
+
+  ImageBufferPoolStatistics m_Statistics{};
+};
+
+ImageBufferPoolGlobals *
+ImageBufferPool::GetPimplGlobalsPointer()
+{
+  if (m_PimplGlobals == nullptr)
+  {
+    // Images may outlive the singleton index and release their buffers after
+    // it is destroyed, so the globals are only emptied at exit, never deleted.
+    const auto finalizeLambda = []() {
+      std::vector<CachedBuffer> evictedBuffers;
+      {
+        const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+        m_PimplGlobals->m_Finalized = true;
+        evictedBuffers = m_PimplGlobals->Trim(0);
+      }
+      std::for_each(evictedBuffers.begin(), evictedBuffers.end(), FreeBuffer);
+    };
+    m_PimplGlobals = Singleton<ImageBufferPoolGlobals>("ImageBufferPool", finalizeLambda);
+  }
+  return m_PimplGlobals;
+}
+
+void
+ImageBufferPool::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+ImageBufferPool::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_Enabled;
+}
+
+void
+ImageBufferPool::SetMaximumCachedBytes(size_t bytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::vector<CachedBuffer> evictedBuffers;
+  {
+    const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+    m_PimplGlobals->m_MaximumCachedBytes = bytes;
+    evictedBuffers = m_PimplGlobals->Trim(bytes);
+    m_PimplGlobals->m_Statistics.NumberOfEvictions += evictedBuffers.size();
+  }
+  std::for_each(evictedBuffers.begin(), evictedBuffers.end(), FreeBuffer);
+}
+
+size_t
+ImageBufferPool::GetMaximumCachedBytes()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumCachedBytes;
+}
+
+void
+ImageBufferPool::SetMaximumCachedBuffersPerSizeClass(size_t numberOfBuffers)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MaximumCachedBuffersPerSizeClass = numberOfBuffers;
+}
+
+size_t
+ImageBufferPool::GetMaximumCachedBuffersPerSizeClass()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumCachedBuffersPerSizeClass;
+}
+
+void
+ImageBufferPool::SetMinimumBufferSize(size_t bytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_MinimumBufferSize = bytes;
+}
+
+size_t
+ImageBufferPool::GetMinimumBufferSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_MinimumBufferSize;
+}
+
+void
+ImageBufferPool::SetAlignment(size_t alignment)
+{
+  if (alignment < alignof(std::max_align_t) || (alignment & (alignment - 1)) != 0)
+  {
+    itkGenericExceptionMacro("The alignment of the image buffers must be a power of two not smaller than "
+                             << alignof(std::max_align_t) << ", got " << alignment << '.');
+  }
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Alignment = alignment;
+}
+
+size_t
+ImageBufferPool::GetAlignment()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Alignment;
+}
+
+void
+ImageBufferPool::SetUseHugePages(bool useHugePages)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_UseHugePages = useHugePages;
+}
+
+bool
+ImageBufferPool::GetUseHugePages()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_UseHugePages;
+}
+
+size_t
+ImageBufferPool::GetSizeClass(size_t numberOfBytes)
+{
+  if (numberOfBytes <= SmallestSizeClass)
+  {
+    return SmallestSizeClass;
+  }
+
+  // Four size classes per power of two.
+  size_t powerOfTwo = SmallestSizeClass;
+  while (powerOfTwo <= numberOfBytes / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const size_t step = powerOfTwo / 4;
+  if (numberOfBytes > std::numeric_limits<size_t>::max() - step)
+  {
+    return numberOfBytes;
+  }
+  return (numberOfBytes + step - 1) / step * step;
+}
+
+void *
+ImageBufferPool::AllocateBuffer(size_t numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Most buffers are not served by the pool, so avoid taking the lock for them.
+  if (!m_PimplGlobals->m_Enabled || numberOfBytes < m_PimplGlobals->m_MinimumBufferSize)
+  {
+    return nullptr;
+  }
+
+  BufferInfo info{};
+  {
+    const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+    info.Size = GetSizeClass(numberOfBytes);
+    info.Alignment = m_PimplGlobals->m_Alignment;
+    if (m_PimplGlobals->m_UseHugePages && info.Size >= HugePageSize)
+    {
+      info.Alignment = std::max(info.Alignment, HugePageSize);
+    }
+
+    auto & cachedBuffers = m_PimplGlobals->m_CachedBuffers;
+    const auto it = std::find_if(cachedBuffers.begin(), cachedBuffers.end(), [&info](const CachedBuffer & cached) {
+      return cached.Info.Size == info.Size && cached.Info.Alignment == info.Alignment;
+    });
+    if (it != cachedBuffers.end())
+    {
+      void * buffer = it->Buffer;
+      m_PimplGlobals->Uncache(it);
+      m_PimplGlobals->m_OutstandingBuffers.emplace(buffer, info);
+      ++m_PimplGlobals->m_NumberOfOutstandingBuffers;
+
+      auto & statistics = m_PimplGlobals->m_Statistics;
+      ++statistics.NumberOfAllocations;
+      ++statistics.NumberOfReuses;
+      statistics.OutstandingBytes += info.Size;
+      statistics.PeakOutstandingBytes = std::max(statistics.PeakOutstandingBytes, statistics.OutstandingBytes);
+      return buffer;
+    }
+  }
+
+  // Allocate a new buffer without holding the lock.
+  void * buffer = ::operator new(info.Size, std::align_val_t{ info.Alignment });
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (info.Alignment >= HugePageSize)
+  {
+    // Only a hint: the buffer is still usable when it is not honored.
+    madvise(buffer, info.Size, MADV_HUGEPAGE);
+  }
+#endif
+
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_OutstandingBuffers.emplace(buffer, info);
+  ++m_PimplGlobals->m_NumberOfOutstandingBuffers;
+
+  auto & statistics = m_PimplGlobals->m_Statistics;
+  ++statistics.NumberOfAllocations;
+  statistics.OutstandingBytes += info.Size;
+  statistics.PeakOutstandingBytes = std::max(statistics.PeakOutstandingBytes, statistics.OutstandingBytes);
+  return buffer;
+}
+
+bool
+ImageBufferPool::ReleaseBuffer(void * buffer)
+{
+  // Buffers that were not allocated by the pool are the common case when the
+  // pool is not used, so avoid taking the lock for them.
+  if (buffer == nullptr || m_PimplGlobals == nullptr || m_PimplGlobals->m_NumberOfOutstandingBuffers == 0)
+  {
+    return false;
+  }
+
+  std::vector<CachedBuffer> evictedBuffers;
+  {
+    const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+    auto &                            outstandingBuffers = m_PimplGlobals->m_OutstandingBuffers;
+    const auto                        outstanding = outstandingBuffers.find(buffer);
+    if (outstanding == outstandingBuffers.end())
+    {
+      return false;
+    }
+    const CachedBuffer released{ buffer, outstanding->second };
+    outstandingBuffers.erase(outstanding);
+    --m_PimplGlobals->m_NumberOfOutstandingBuffers;
+
+    auto & statistics = m_PimplGlobals->m_Statistics;
+    ++statistics.NumberOfReleases;
+    statistics.OutstandingBytes -= released.Info.Size;
+
+    if (m_PimplGlobals->m_Enabled && !m_PimplGlobals->m_Finalized &&
+        m_PimplGlobals->m_MaximumCachedBuffersPerSizeClass > 0 &&
+        released.Info.Size <= m_PimplGlobals->m_MaximumCachedBytes)
+    {
+      // Make room in the size class by evicting its least recently released buffer.
+      auto & cachedBuffers = m_PimplGlobals->m_CachedBuffers;
+      auto   oldest = cachedBuffers.end();
+      size_t numberInSizeClass = 0;
+      for (auto it = cachedBuffers.begin(); it != cachedBuffers.end(); ++it)
+      {
+        if (it->Info.Size == released.Info.Size)
+        {
+          ++numberInSizeClass;
+          oldest = it;
+        }
+      }
+      if (numberInSizeClass >= m_PimplGlobals->m_MaximumCachedBuffersPerSizeClass)
+      {
+        evictedBuffers.push_back(*oldest);
+        m_PimplGlobals->Uncache(oldest);
+      }
+
+      cachedBuffers.push_front(released);
+      statistics.CachedBytes += released.Info.Size;
+      ++statistics.NumberOfCachedBuffers;
+
+      const std::vector<CachedBuffer> trimmedBuffers = m_PimplGlobals->Trim(m_PimplGlobals->m_MaximumCachedBytes);
+      evictedBuffers.insert(evictedBuffers.end(), trimmedBuffers.begin(), trimmedBuffers.end());
+    }
+    else
+    {
+      evictedBuffers.push_back(released);
+    }
+    statistics.NumberOfEvictions += evictedBuffers.size();
+  }
+
+  std::for_each(evictedBuffers.begin(), evictedBuffers.end(), FreeBuffer);
+  return true;
+}
+
+void
+ImageBufferPool::ReleaseCachedBuffers()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  std::vector<CachedBuffer> evictedBuffers;
+  {
+    const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+    evictedBuffers = m_PimplGlobals->Trim(0);
+  }
+  std::for_each(evictedBuffers.begin(), evictedBuffers.end(), FreeBuffer);
+}
+
+ImageBufferPoolStatistics
+ImageBufferPool::GetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Statistics;
+}
+
+void
+ImageBufferPool::ResetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+
+  auto & statistics = m_PimplGlobals->m_Statistics;
+  statistics.NumberOfAllocations = 0;
+  statistics.NumberOfReuses = 0;
+  statistics.NumberOfReleases = 0;
+  statistics.NumberOfEvictions = 0;
+  statistics.PeakOutstandingBytes = statistics.OutstandingBytes;
+}
+
+std::ostream &
+operator<<(std::ostream & os, const ImageBufferPoolStatistics & statistics)
+{
+  return os << "NumberOfAllocations: " << statistics.NumberOfAllocations
+            << ", NumberOfReuses: " << statistics.NumberOfReuses
+            << ", NumberOfReleases: " << statistics.NumberOfReleases
+            << ", NumberOfEvictions: " << statistics.NumberOfEvictions
+            << ", NumberOfCachedBuffers: " << statistics.NumberOfCachedBuffers
+            << ", CachedBytes: " << statistics.CachedBytes << ", OutstandingBytes: " << statistics.OutstandingBytes
+            << ", PeakOutstandingBytes: " << statistics.PeakOutstandingBytes;
+}
+
+ImageBufferPoolGlobals * ImageBufferPool::m_PimplGlobals;
+
+} // end namespace itk
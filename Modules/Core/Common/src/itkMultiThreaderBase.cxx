@@ -39,6 +39,7 @@
 #include "itkImageSourceCommon.h"
 #include "itkSingleton.h"
 #include "itkProcessObject.h"
+#include "itkPipelineTrace.h"
 
 #include <algorithm> // For clamp.
 #include <iostream>
@@ -454,9 +455,58 @@ MultiThreaderBase::SingleMethodProxy(void * arg)
 }
 
 
+namespace
+{
+// The method and data of a SingleMethodExecute() whose work units are traced.
+struct TracedSingleMethod
+{
+  ThreadFunctionType Function;
+  void *             UserData;
+};
+
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+TracedSingleMethodProxy(void * arg)
+{
+  auto *       workUnitInfo = static_cast<MultiThreaderBase::WorkUnitInfo *>(arg);
+  const auto * tracedMethod = static_cast<const TracedSingleMethod *>(workUnitInfo->UserData);
+  workUnitInfo->UserData = tracedMethod->UserData;
+  workUnitInfo->ThreadFunction = tracedMethod->Function;
+
+  const double startTime = PipelineTrace::GetTime();
+  const auto   recordEvent = [workUnitInfo, startTime] {
+    PipelineTrace::AddEvent("Work unit",
+                            "work unit",
+                            startTime,
+                            PipelineTrace::GetTime() - startTime,
+                            { { "work unit", std::to_string(workUnitInfo->WorkUnitID) },
+                              { "number of work units", std::to_string(workUnitInfo->NumberOfWorkUnits) } });
+  };
+  try
+  {
+    workUnitInfo->ThreadFunction(workUnitInfo);
+  }
+  catch (...)
+  {
+    recordEvent();
+    throw;
+  }
+  recordEvent();
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+} // namespace
+
+
 void
 MultiThreaderBase::SetSingleMethodAndExecute(ThreadFunctionType func, void * data)
 {
+  // The work units of ParallelizeImageRegion() are traced by TraceWorkUnits().
+  if (PipelineTrace::GetEnabled() && func != &MultiThreaderBase::ParallelizeImageRegionHelper)
+  {
+    TracedSingleMethod tracedMethod{ func, data };
+    this->SetSingleMethod(&TracedSingleMethodProxy, &tracedMethod);
+    this->SingleMethodExecute();
+    return;
+  }
   this->SetSingleMethod(std::move(func), data);
   this->SingleMethodExecute();
 }
@@ -569,6 +619,37 @@ MultiThreaderBase::ParallelizeImageRegionHelper(void * arg)
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+MultiThreaderBase::ThreadingFunctorType
+MultiThreaderBase::TraceWorkUnits(unsigned int dimension, ThreadingFunctorType funcP, const ProcessObject * filter)
+{
+  if (!PipelineTrace::GetEnabled())
+  {
+    return funcP;
+  }
+
+  std::string name = filter ? std::string(filter->GetNameOfClass()) + " work unit" : std::string("Work unit");
+  return [dimension, funcP = std::move(funcP), name = std::move(name)](const IndexValueType index[],
+                                                                       const SizeValueType  size[]) {
+    const double startTime = PipelineTrace::GetTime();
+    funcP(index, size);
+    const double duration = PipelineTrace::GetTime() - startTime;
+
+    SizeValueType numberOfPixels = 1;
+    std::string   indexString = "[";
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      numberOfPixels *= size[d];
+      indexString += (d > 0 ? ", " : "") + std::to_string(index[d]);
+    }
+    indexString += ']';
+    PipelineTrace::AddEvent(name,
+                            "work unit",
+                            startTime,
+                            duration,
+                            { { "pixels", std::to_string(numberOfPixels) }, { "index", indexString } });
+  };
+}
+
 // Print method for the multithreader
 void
 MultiThreaderBase::PrintSelf(std::ostream & os, Indent indent) const
@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkParallelStreamingExecutor.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace itk
+{
+
+void
+ParallelStreamingExecutor::Execute(unsigned int                   numberOfPieces,
+                                   unsigned int                   numberOfWorkers,
+                                   SizeValueType                  memoryBudget,
+                                   const PieceBytesFunctionType & pieceBytes,
+                                   const PieceFunctionType &      compute,
+                                   const PieceFunctionType &      consume)
+{
+  std::mutex              mutex;
+  std::condition_variable condition;
+  unsigned int            nextPiece = 0;
+  unsigned int            nextPieceToConsume = 0;
+  unsigned int            numberOfPiecesInFlight = 0;
+  SizeValueType           bytesInFlight = 0;
+  bool                    stopped = false;
+  std::exception_ptr      exception;
+
+  const auto work = [&](unsigned int worker) {
+    while (true)
+    {
+      unsigned int  piece;
+      SizeValueType bytes;
+      {
+        // Start the pieces in order, within the budget.
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] {
+          return stopped || nextPiece >= numberOfPieces || numberOfPiecesInFlight == 0 ||
+                 bytesInFlight + (pieceBytes ? pieceBytes(nextPiece) : 0) <= memoryBudget;
+        });
+        if (stopped || nextPiece >= numberOfPieces)
+        {
+          return;
+        }
+        piece = nextPiece++;
+        bytes = pieceBytes ? pieceBytes(piece) : 0;
+        ++numberOfPiecesInFlight;
+        bytesInFlight += bytes;
+      }
+
+      try
+      {
+        compute(worker, piece);
+        if (consume)
+        {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&] { return stopped || nextPieceToConsume == piece; });
+            if (stopped)
+            {
+              return;
+            }
+          }
+          // Only the worker of the next piece gets here.
+          consume(worker, piece);
+        }
+      }
+      catch (...)
+      {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+        stopped = true;
+        condition.notify_all();
+        return;
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      --numberOfPiecesInFlight;
+      bytesInFlight -= bytes;
+      ++nextPieceToConsume;
+      condition.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int worker = 1; worker < numberOfWorkers; ++worker)
+  {
+    threads.emplace_back(work, worker);
+  }
+  work(0);
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+} // end namespace itk
@@ -0,0 +1,272 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineMemoryPlanner.h"
+#include "itkImageBase.h"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace itk
+{
+
+namespace
+{
+// Returns whether data1 and data2 are images of the same dimension, up to
+// VDimension = 4, with the same requested region.
+template <unsigned int VDimension = 1>
+bool
+HaveSameRequestedRegion(const DataObject * data1, const DataObject * data2)
+{
+  const auto * image1 = dynamic_cast<const ImageBase<VDimension> *>(data1);
+  const auto * image2 = dynamic_cast<const ImageBase<VDimension> *>(data2);
+  if (image1 != nullptr && image2 != nullptr)
+  {
+    return image1->GetRequestedRegion() == image2->GetRequestedRegion();
+  }
+  if constexpr (VDimension < 4)
+  {
+    return HaveSameRequestedRegion<VDimension + 1>(data1, data2);
+  }
+  else
+  {
+    return false;
+  }
+}
+
+// The first indexed input and output of filter, or nullptr.
+DataObject *
+GetPrimaryInputOf(ProcessObject * filter)
+{
+  const ProcessObject::DataObjectPointerArray inputs = filter->GetIndexedInputs();
+  return inputs.empty() ? nullptr : inputs.front().GetPointer();
+}
+
+DataObject *
+GetPrimaryOutputOf(ProcessObject * filter)
+{
+  const ProcessObject::DataObjectPointerArray outputs = filter->GetIndexedOutputs();
+  return outputs.empty() ? nullptr : outputs.front().GetPointer();
+}
+} // namespace
+
+
+void
+PipelineMemoryPlanner::AddIntermediateOutput(DataObject * output)
+{
+  if (std::find(m_IntermediateOutputs.cbegin(), m_IntermediateOutputs.cend(), output) == m_IntermediateOutputs.cend())
+  {
+    m_IntermediateOutputs.push_back(output);
+    this->Modified();
+  }
+}
+
+
+void
+PipelineMemoryPlanner::ClearIntermediateOutputs()
+{
+  if (!m_IntermediateOutputs.empty())
+  {
+    m_IntermediateOutputs.clear();
+    this->Modified();
+  }
+}
+
+
+void
+PipelineMemoryPlanner::Plan()
+{
+  if (m_Output.IsNull())
+  {
+    itkExceptionMacro("Output is not set.");
+  }
+
+  m_Output->UpdateOutputInformation();
+  m_Output->PropagateRequestedRegion();
+
+  // Collect the filters in the order in which UpdateOutputData() executes
+  // them, and count the input slots that refer to each data object.
+  m_Filters.clear();
+  std::unordered_set<const ProcessObject *>           visitedFilters;
+  std::unordered_map<const DataObject *, SizeValueType> numberOfConsumers;
+
+  const std::function<void(ProcessObject *)> visit = [&](ProcessObject * filter) {
+    if (!visitedFilters.insert(filter).second)
+    {
+      return;
+    }
+    for (const auto & input : filter->GetInputs())
+    {
+      if (input)
+      {
+        ++numberOfConsumers[input];
+        if (const auto source = input->GetSource())
+        {
+          visit(source);
+        }
+      }
+    }
+    m_Filters.push_back(filter);
+  };
+  if (const auto source = m_Output->GetSource())
+  {
+    visit(source);
+  }
+
+  m_PeakBytesBeforePlan = this->SimulateUpdate();
+  m_NumberOfFilters = m_Filters.size();
+  m_NumberOfInPlaceFilters = 0;
+  m_NumberOfReleasedOutputs = 0;
+
+  for (ProcessObject * filter : m_Filters)
+  {
+    for (const auto & input : filter->GetInputs())
+    {
+      DataObject * const data = input;
+
+      // Only the intermediate outputs that the application does not read,
+      // and that have this single consumer, can be released early or
+      // overwritten.
+      if (data == nullptr || data == m_Output || numberOfConsumers[data] != 1 || data->GetSource().IsNull() ||
+          std::find(m_IntermediateOutputs.cbegin(), m_IntermediateOutputs.cend(), data) == m_IntermediateOutputs.cend())
+      {
+        continue;
+      }
+
+      if (!data->GetReleaseDataFlag())
+      {
+        data->SetReleaseDataFlag(true);
+        m_ReleasedOutputs.push_back(data);
+        ++m_NumberOfReleasedOutputs;
+      }
+
+      if (data == GetPrimaryInputOf(filter) && !filter->IsInPlaceExecutionEnabled() &&
+          HaveSameRequestedRegion(data, GetPrimaryOutputOf(filter)) && filter->EnableInPlaceExecution())
+      {
+        m_InPlaceFilters.push_back(filter);
+        ++m_NumberOfInPlaceFilters;
+      }
+    }
+  }
+
+  m_PeakBytesAfterPlan = this->SimulateUpdate();
+  m_Filters.clear();
+
+  itkDebugMacro("Planned " << m_NumberOfFilters << " filters: " << m_NumberOfInPlaceFilters << " in place, "
+                           << m_NumberOfReleasedOutputs << " outputs released early, estimated peak "
+                           << m_PeakBytesBeforePlan << " bytes before and " << m_PeakBytesAfterPlan << " after.");
+}
+
+
+void
+PipelineMemoryPlanner::RestorePipeline()
+{
+  for (const auto & output : m_ReleasedOutputs)
+  {
+    output->SetReleaseDataFlag(false);
+  }
+  for (const auto & filter : m_InPlaceFilters)
+  {
+    filter->DisableInPlaceExecution();
+  }
+  m_ReleasedOutputs.clear();
+  m_InPlaceFilters.clear();
+}
+
+
+void
+PipelineMemoryPlanner::Update()
+{
+  this->Plan();
+  try
+  {
+    m_Output->Update();
+  }
+  catch (...)
+  {
+    this->RestorePipeline();
+    throw;
+  }
+  this->RestorePipeline();
+}
+
+
+SizeValueType
+PipelineMemoryPlanner::SimulateUpdate() const
+{
+  // The bulk data held by each output while the filters execute in turn.
+  std::unordered_map<const DataObject *, SizeValueType> bytes;
+  SizeValueType                                         currentBytes = 0;
+  SizeValueType                                         peakBytes = 0;
+
+  for (ProcessObject * filter : m_Filters)
+  {
+    const DataObject * primaryInput = GetPrimaryInputOf(filter);
+    const DataObject * primaryOutput = GetPrimaryOutputOf(filter);
+    const bool         inPlace = primaryInput != nullptr && primaryOutput != nullptr &&
+                         filter->IsInPlaceExecutionEnabled() && HaveSameRequestedRegion(primaryInput, primaryOutput);
+
+    for (const auto & output : filter->GetOutputs())
+    {
+      if (output == nullptr)
+      {
+        continue;
+      }
+      if (inPlace && output == primaryOutput)
+      {
+        // The bulk data of the input is transferred to the output.
+        bytes[primaryOutput] = std::exchange(bytes[primaryInput], 0);
+      }
+      else
+      {
+        const SizeValueType outputBytes = filter->EstimateOutputBulkDataSize(output);
+        bytes[output] = outputBytes;
+        currentBytes += outputBytes;
+      }
+    }
+    peakBytes = std::max(peakBytes, currentBytes);
+
+    for (const auto & input : filter->GetInputs())
+    {
+      if (input && input != m_Output && input->ShouldIReleaseData())
+      {
+        currentBytes -= std::exchange(bytes[input], 0);
+      }
+    }
+  }
+  return peakBytes;
+}
+
+
+void
+PipelineMemoryPlanner::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Output);
+  os << indent << "PeakBytesBeforePlan: " << m_PeakBytesBeforePlan << std::endl;
+  os << indent << "PeakBytesAfterPlan: " << m_PeakBytesAfterPlan << std::endl;
+  os << indent << "NumberOfFilters: " << m_NumberOfFilters << std::endl;
+  os << indent << "NumberOfInPlaceFilters: " << m_NumberOfInPlaceFilters << std::endl;
+  os << indent << "NumberOfReleasedOutputs: " << m_NumberOfReleasedOutputs << std::endl;
+  os << indent << "NumberOfIntermediateOutputs: " << m_IntermediateOutputs.size() << std::endl;
+}
+
+} // end namespace itk
@@ -0,0 +1,232 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineOutputCache.h"
+#include "itkSingleton.h"
+
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace itk
+{
+
+namespace
+{
+struct CacheEntry
+{
+  std::string                      Key;
+  PipelineOutputCache::OutputsType Outputs;
+  SizeValueType                    NumberOfBytes;
+};
+
+constexpr std::uint64_t HashPrime1{ 0x9E3779B185EBCA87ULL };
+constexpr std::uint64_t HashPrime2{ 0xC2B2AE3D27D4EB4FULL };
+
+inline std::uint64_t
+RotateLeft(std::uint64_t value, unsigned int bits)
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t
+HashRound(std::uint64_t accumulator, std::uint64_t input)
+{
+  return RotateLeft(accumulator + input * HashPrime2, 31) * HashPrime1;
+}
+} // namespace
+
+struct PipelineOutputCacheGlobals
+{
+  // Removes least recently used entries until the cached outputs fit in maximumBytes.
+  void
+  Trim(SizeValueType maximumBytes)
+  {
+    while (m_Statistics.CachedBytes > maximumBytes)
+    {
+      const CacheEntry & entry = m_Entries.back();
+      m_Statistics.CachedBytes -= entry.NumberOfBytes;
+      m_EntryMap.erase(entry.Key);
+      m_Entries.pop_back();
+      ++m_Statistics.NumberOfEvictions;
+    }
+    m_Statistics.NumberOfEntries = m_Entries.size();
+  }
+
+  SizeValueType m_MaximumCachedBytes{ SizeValueType{ 512 } << 20 };
+
+  std::mutex m_Mutex{};
+
+  /** Most recently used first. */
+  std::list<CacheEntry>                                            m_Entries{};
+  std::unordered_map<std::string, std::list<CacheEntry>::iterator> m_EntryMap{};
+
+  PipelineOutputCacheStatistics m_Statistics{};
+};
+
+itkGetGlobalSimpleMacro(PipelineOutputCache, PipelineOutputCacheGlobals, PimplGlobals);
+
+void
+PipelineOutputCache::SetMaximumCachedBytes(SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_MaximumCachedBytes = numberOfBytes;
+  m_PimplGlobals->Trim(numberOfBytes);
+}
+
+SizeValueType
+PipelineOutputCache::GetMaximumCachedBytes()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_MaximumCachedBytes;
+}
+
+bool
+PipelineOutputCache::Find(const std::string & key, OutputsType & outputs)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+
+  const auto found = m_PimplGlobals->m_EntryMap.find(key);
+  if (found == m_PimplGlobals->m_EntryMap.end())
+  {
+    ++m_PimplGlobals->m_Statistics.NumberOfMisses;
+    return false;
+  }
+  auto & entries = m_PimplGlobals->m_Entries;
+  entries.splice(entries.begin(), entries, found->second);
+  outputs = found->second->Outputs;
+  ++m_PimplGlobals->m_Statistics.NumberOfHits;
+  return true;
+}
+
+void
+PipelineOutputCache::Insert(const std::string & key, OutputsType outputs, SizeValueType numberOfBytes)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Replaced outputs are released after the lock.
+  OutputsType replacedOutputs;
+
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  if (numberOfBytes > m_PimplGlobals->m_MaximumCachedBytes)
+  {
+    return;
+  }
+
+  auto &     entries = m_PimplGlobals->m_Entries;
+  const auto found = m_PimplGlobals->m_EntryMap.find(key);
+  if (found != m_PimplGlobals->m_EntryMap.end())
+  {
+    // Another filter computed the same outputs meanwhile.
+    m_PimplGlobals->m_Statistics.CachedBytes -= found->second->NumberOfBytes;
+    replacedOutputs = std::move(found->second->Outputs);
+    found->second->Outputs = std::move(outputs);
+    found->second->NumberOfBytes = numberOfBytes;
+    entries.splice(entries.begin(), entries, found->second);
+  }
+  else
+  {
+    entries.push_front({ key, std::move(outputs), numberOfBytes });
+    m_PimplGlobals->m_EntryMap.emplace(key, entries.begin());
+  }
+  m_PimplGlobals->m_Statistics.CachedBytes += numberOfBytes;
+  ++m_PimplGlobals->m_Statistics.NumberOfInsertions;
+  m_PimplGlobals->Trim(m_PimplGlobals->m_MaximumCachedBytes);
+}
+
+void
+PipelineOutputCache::Clear()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_EntryMap.clear();
+  m_PimplGlobals->m_Entries.clear();
+  m_PimplGlobals->m_Statistics.NumberOfEntries = 0;
+  m_PimplGlobals->m_Statistics.CachedBytes = 0;
+}
+
+PipelineOutputCacheStatistics
+PipelineOutputCache::GetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_Statistics;
+}
+
+void
+PipelineOutputCache::ResetStatistics()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  auto & statistics = m_PimplGlobals->m_Statistics;
+  statistics.NumberOfHits = 0;
+  statistics.NumberOfMisses = 0;
+  statistics.NumberOfInsertions = 0;
+  statistics.NumberOfEvictions = 0;
+}
+
+std::uint64_t
+PipelineOutputCache::HashBytes(const void * data, size_t numberOfBytes)
+{
+  // Four independent lanes of 64-bit words, so that hashing is bound by
+  // memory bandwidth rather than by the latency of the multiplications.
+  const auto *  bytes = static_cast<const unsigned char *>(data);
+  std::uint64_t lanes[4] = { HashPrime1 + HashPrime2, HashPrime2, 0, 0 - HashPrime1 };
+
+  size_t offset = 0;
+  for (; offset + 32 <= numberOfBytes; offset += 32)
+  {
+    for (unsigned int lane = 0; lane < 4; ++lane)
+    {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + offset + 8 * lane, sizeof(word));
+      lanes[lane] = HashRound(lanes[lane], word);
+    }
+  }
+
+  std::uint64_t hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) +
+                       RotateLeft(lanes[3], 18) + numberOfBytes;
+  for (; offset < numberOfBytes; ++offset)
+  {
+    hash = HashRound(hash, bytes[offset]);
+  }
+
+  // Final avalanche.
+  hash ^= hash >> 33;
+  hash *= HashPrime2;
+  hash ^= hash >> 29;
+  hash *= HashPrime1;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+std::ostream &
+operator<<(std::ostream & os, const PipelineOutputCacheStatistics & statistics)
+{
+  return os << "NumberOfHits: " << statistics.NumberOfHits << ", NumberOfMisses: " << statistics.NumberOfMisses
+            << ", NumberOfInsertions: " << statistics.NumberOfInsertions
+            << ", NumberOfEvictions: " << statistics.NumberOfEvictions
+            << ", NumberOfEntries: " << statistics.NumberOfEntries << ", CachedBytes: " << statistics.CachedBytes;
+}
+
+PipelineOutputCacheGlobals * PipelineOutputCache::m_PimplGlobals;
+
+} // end namespace itk
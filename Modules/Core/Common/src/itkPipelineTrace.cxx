@@ -0,0 +1,276 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineTrace.h"
+#include "itkSingleton.h"
+#include "itkStdStreamStateSave.h"
+#include "itksys/SystemTools.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace itk
+{
+
+namespace
+{
+struct TraceEvent
+{
+  std::string                  Name;
+  std::string                  Category;
+  double                       StartTime;
+  double                       Duration;
+  unsigned int                 ThreadIndex;
+  PipelineTrace::ArgumentsType Arguments;
+};
+
+// Writes a JSON string literal.
+void
+WriteJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+             << std::setfill(' ');
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+} // namespace
+
+struct PipelineTraceGlobals
+{
+  PipelineTraceGlobals()
+  {
+    if (itksys::SystemTools::GetEnv("ITK_PIPELINE_TRACE", m_FileName) && !m_FileName.empty())
+    {
+      m_Enabled = true;
+    }
+  }
+
+  ~PipelineTraceGlobals()
+  {
+    if (!m_FileName.empty())
+    {
+      std::ofstream file(m_FileName);
+      this->Write(file);
+    }
+  }
+
+  void
+  Write(std::ostream & os)
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    const StdStreamStateSave          streamStateSave(os);
+
+    os << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    const char * separator = "\n";
+    for (const auto & event : m_Events)
+    {
+      os << separator << "{\"name\":";
+      WriteJSONString(os, event.Name);
+      os << ",\"cat\":";
+      WriteJSONString(os, event.Category);
+      os << ",\"ph\":\"X\",\"ts\":" << event.StartTime << ",\"dur\":" << event.Duration
+         << ",\"pid\":1,\"tid\":" << event.ThreadIndex << ",\"args\":{";
+      const char * argumentSeparator = "";
+      for (const auto & argument : event.Arguments)
+      {
+        os << argumentSeparator;
+        WriteJSONString(os, argument.first);
+        os << ':';
+        WriteJSONString(os, argument.second);
+        argumentSeparator = ",";
+      }
+      os << "}}";
+      separator = ",\n";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+  }
+
+  std::atomic<bool>          m_Enabled{ false };
+  std::atomic<SizeValueType> m_AllocatedBytes{ 0 };
+
+  /** The size of m_ExecutionCounts, read without the lock when objects are
+   * destroyed. */
+  std::atomic<SizeValueType> m_NumberOfExecutionCounts{ 0 };
+
+  const std::chrono::steady_clock::time_point m_Origin{ std::chrono::steady_clock::now() };
+
+  /** Written at exit when set by the ITK_PIPELINE_TRACE environment variable. */
+  std::string m_FileName{};
+
+  std::mutex                                        m_Mutex{};
+  std::vector<TraceEvent>                           m_Events{};
+  std::unordered_map<std::thread::id, unsigned int> m_ThreadIndices{};
+  std::unordered_map<const void *, SizeValueType>   m_ExecutionCounts{};
+};
+
+itkGetGlobalSimpleMacro(PipelineTrace, PipelineTraceGlobals, PimplGlobals);
+
+void
+PipelineTrace::SetEnabled(bool enabled)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->m_Enabled = enabled;
+}
+
+bool
+PipelineTrace::GetEnabled()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  // The globals are deleted at exit, when pipelines may still be destroyed.
+  return m_PimplGlobals != nullptr && m_PimplGlobals->m_Enabled;
+}
+
+void
+PipelineTrace::Clear()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_Events.clear();
+  m_PimplGlobals->m_ExecutionCounts.clear();
+  m_PimplGlobals->m_NumberOfExecutionCounts = 0;
+}
+
+SizeValueType
+PipelineTrace::GetNumberOfEvents()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return static_cast<SizeValueType>(m_PimplGlobals->m_Events.size());
+}
+
+double
+PipelineTrace::GetTime()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_PimplGlobals->m_Origin)
+    .count();
+}
+
+void
+PipelineTrace::AddEvent(std::string   name,
+                        std::string   category,
+                        double        startTime,
+                        double        duration,
+                        ArgumentsType arguments)
+{
+  if (!GetEnabled())
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+
+  auto &             threadIndices = m_PimplGlobals->m_ThreadIndices;
+  const unsigned int threadIndex =
+    threadIndices.emplace(std::this_thread::get_id(), static_cast<unsigned int>(threadIndices.size())).first->second;
+
+  m_PimplGlobals->m_Events.push_back(
+    { std::move(name), std::move(category), startTime, duration, threadIndex, std::move(arguments) });
+}
+
+SizeValueType
+PipelineTrace::AddExecution(const void * object)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  auto &                            executionCounts = m_PimplGlobals->m_ExecutionCounts;
+  const SizeValueType               count = ++executionCounts[object];
+  m_PimplGlobals->m_NumberOfExecutionCounts = executionCounts.size();
+  return count;
+}
+
+void
+PipelineTrace::RemoveExecutions(const void * object)
+{
+  // Most objects are destroyed while no execution is counted, so avoid taking
+  // the lock for them.
+  if (m_PimplGlobals == nullptr || m_PimplGlobals->m_NumberOfExecutionCounts == 0)
+  {
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  auto &                            executionCounts = m_PimplGlobals->m_ExecutionCounts;
+  executionCounts.erase(object);
+  m_PimplGlobals->m_NumberOfExecutionCounts = executionCounts.size();
+}
+
+void
+PipelineTrace::AddAllocatedBytes(SizeValueType numberOfBytes)
+{
+  if (GetEnabled())
+  {
+    m_PimplGlobals->m_AllocatedBytes += numberOfBytes;
+  }
+}
+
+SizeValueType
+PipelineTrace::GetAllocatedBytes()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return m_PimplGlobals->m_AllocatedBytes;
+}
+
+void
+PipelineTrace::WriteChromeTrace(std::ostream & os)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  m_PimplGlobals->Write(os);
+}
+
+void
+PipelineTrace::WriteChromeTrace(const std::string & fileName)
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " to write the pipeline trace.");
+  }
+  WriteChromeTrace(file);
+}
+
+PipelineTraceGlobals * PipelineTrace::m_PimplGlobals;
+
+} // end namespace itk
@@ -29,13 +29,52 @@
 #include <mutex>
 
 #include <cstdio>
+#include <ctime>
 #include <sstream>
 #include <algorithm>
+#include "itkImageBase.h"
 #include "itkMultiThreaderBase.h"
+#include "itkPipelineOutputCache.h"
+#include "itkPipelineTrace.h"
+#include <typeinfo>
 
 namespace itk
 {
 
+namespace
+{
+// Adds the requested and buffered region sizes of output to the arguments of
+// a trace event, if it is an image of dimension VDimension.
+template <unsigned int VDimension>
+void
+AddImageRegionTraceArguments(const DataObject *             output,
+                             const std::string &            outputName,
+                             PipelineTrace::ArgumentsType & arguments)
+{
+  if (const auto * image = dynamic_cast<const ImageBase<VDimension> *>(output))
+  {
+    arguments.emplace_back(outputName + " requested pixels",
+                           std::to_string(image->GetRequestedRegion().GetNumberOfPixels()));
+    arguments.emplace_back(outputName + " buffered pixels",
+                           std::to_string(image->GetBufferedRegion().GetNumberOfPixels()));
+  }
+}
+
+// Writes the index and size of the requested region of output to key, if it
+// is an image of dimension VDimension.
+template <unsigned int VDimension>
+bool
+AppendRequestedRegionToOutputCacheKey(const DataObject * output, std::ostream & key)
+{
+  if (const auto * image = dynamic_cast<const ImageBase<VDimension> *>(output))
+  {
+    key << image->GetRequestedRegion().GetIndex() << image->GetRequestedRegion().GetSize();
+    return true;
+  }
+  return false;
+}
+} // namespace
+
 
 namespace
 { // local namespace for managing globals
@@ -116,6 +155,8 @@ ProcessObject::~ProcessObject()
       output.second = nullptr;
     }
   }
+
+  PipelineTrace::RemoveExecutions(this);
 }
 
 
@@ -1261,6 +1302,7 @@ ProcessObject::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "NumberOfRequiredOutputs: " << m_NumberOfRequiredOutputs << std::endl;
   os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
   itkPrintSelfBooleanMacro(ReleaseDataBeforeUpdateFlag);
+  itkPrintSelfBooleanMacro(UseOutputCache);
   itkPrintSelfBooleanMacro(AbortGenerateData);
   os << indent << "Progress: " << progressFixedToFloat(m_Progress) << std::endl;
   os << indent << "Multithreader: " << std::endl;
@@ -1679,9 +1721,29 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
   m_AbortGenerateData = false;
   m_Progress = 0u;
 
+  const bool          tracing = PipelineTrace::GetEnabled();
+  const double        traceStartTime = tracing ? PipelineTrace::GetTime() : 0.0;
+  const std::clock_t  traceStartProcessCPUTime = tracing ? std::clock() : 0;
+  const SizeValueType traceStartAllocatedBytes = tracing ? PipelineTrace::GetAllocatedBytes() : 0;
+
+  std::string outputCacheKey;
+  bool        outputsFromCache = false;
   try
   {
-    this->GenerateData();
+    if (m_UseOutputCache)
+    {
+      std::ostringstream key;
+      key.precision(17);
+      if (this->GenerateOutputCacheKey(key))
+      {
+        outputCacheKey = key.str();
+        outputsFromCache = this->GraftCachedOutputs(outputCacheKey);
+      }
+    }
+    if (!outputsFromCache)
+    {
+      this->GenerateData();
+    }
   }
   catch (const ProcessAborted &)
   {
@@ -1702,10 +1764,44 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
    * it probably didn't end there)
    *
    */
-  if (m_AbortGenerateData)
+  if (m_AbortGenerateData || outputsFromCache)
   {
     this->UpdateProgress(1.0f);
   }
+  else if (!outputCacheKey.empty())
+  {
+    this->CacheOutputs(outputCacheKey);
+  }
+
+  if (tracing)
+  {
+    const double duration = PipelineTrace::GetTime() - traceStartTime;
+    // std::clock() measures all the threads of the process, not only the ones
+    // executing this filter.
+    const double processCPUTime =
+      1000.0 * static_cast<double>(std::clock() - traceStartProcessCPUTime) / CLOCKS_PER_SEC;
+
+    std::ostringstream object;
+    object << static_cast<const void *>(this);
+
+    PipelineTrace::ArgumentsType arguments{
+      { "object", object.str() },
+      { "execution", std::to_string(PipelineTrace::AddExecution(this)) },
+      { "process CPU time (ms)", std::to_string(processCPUTime) },
+      { "allocated bytes", std::to_string(PipelineTrace::GetAllocatedBytes() - traceStartAllocatedBytes) },
+      { "work units", std::to_string(m_NumberOfWorkUnits) },
+      { "outputs from cache", outputsFromCache ? "true" : "false" }
+    };
+    for (const auto & output : m_Outputs)
+    {
+      const std::string outputName = "output " + output.first;
+      AddImageRegionTraceArguments<1>(output.second, outputName, arguments);
+      AddImageRegionTraceArguments<2>(output.second, outputName, arguments);
+      AddImageRegionTraceArguments<3>(output.second, outputName, arguments);
+      AddImageRegionTraceArguments<4>(output.second, outputName, arguments);
+    }
+    PipelineTrace::AddEvent(this->GetNameOfClass(), "filter", traceStartTime, duration, std::move(arguments));
+  }
 
   /**
    * Notify end event observers
@@ -1738,6 +1834,150 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
 }
 
 
+bool
+ProcessObject::GenerateOutputCacheKey(std::ostream & key) const
+{
+  key << typeid(*this).name() << '\n';
+  if (!this->AppendParametersToOutputCacheKey(key))
+  {
+    return false;
+  }
+  key << '\n';
+
+  for (const auto & input : m_Inputs)
+  {
+    key << "input " << input.first << ": ";
+    if (input.second)
+    {
+      this->AppendInputToOutputCacheKey(input.second, key);
+    }
+    key << '\n';
+  }
+
+  for (const auto & output : m_Outputs)
+  {
+    key << "output " << output.first << ": ";
+    if (!AppendRequestedRegionToOutputCacheKey<1>(output.second, key) &&
+        !AppendRequestedRegionToOutputCacheKey<2>(output.second, key) &&
+        !AppendRequestedRegionToOutputCacheKey<3>(output.second, key) &&
+        !AppendRequestedRegionToOutputCacheKey<4>(output.second, key))
+    {
+      return false;
+    }
+    key << '\n';
+  }
+  return true;
+}
+
+
+bool
+ProcessObject::AppendParametersToOutputCacheKey(std::ostream & itkNotUsed(key)) const
+{
+  return false;
+}
+
+
+void
+ProcessObject::AppendInputToOutputCacheKey(const DataObject * input, std::ostream & key) const
+{
+  key << input->GetNameOfClass() << ' ' << static_cast<const void *>(input) << ' ' << input->GetMTime() << ' '
+      << input->GetUpdateMTime();
+}
+
+
+DataObject::Pointer
+ProcessObject::CopyOutputForCache(const DataObject * itkNotUsed(output), SizeValueType & numberOfBytes) const
+{
+  numberOfBytes = 0;
+  return nullptr;
+}
+
+
+SizeValueType
+ProcessObject::EstimateOutputBulkDataSize(const DataObject * itkNotUsed(output)) const
+{
+  return 0;
+}
+
+
+bool
+ProcessObject::IsInPlaceExecutionEnabled() const
+{
+  return false;
+}
+
+
+bool
+ProcessObject::EnableInPlaceExecution()
+{
+  return false;
+}
+
+
+void
+ProcessObject::DisableInPlaceExecution()
+{}
+
+
+bool
+ProcessObject::GraftCachedOutputs(const std::string & key)
+{
+  PipelineOutputCache::OutputsType cachedOutputs;
+  if (!PipelineOutputCache::Find(key, cachedOutputs) || cachedOutputs.size() != m_Outputs.size())
+  {
+    return false;
+  }
+
+  // Copy all the outputs before grafting any, so that the outputs are left
+  // unchanged if one of them cannot be copied.  Both containers are sorted
+  // by name.
+  std::vector<DataObjectPointer> copies;
+  auto                           cachedOutput = cachedOutputs.cbegin();
+  for (const auto & output : m_Outputs)
+  {
+    SizeValueType numberOfBytes = 0;
+    if (cachedOutput->first != output.first)
+    {
+      return false;
+    }
+    copies.push_back(this->CopyOutputForCache(cachedOutput->second, numberOfBytes));
+    if (copies.back().IsNull())
+    {
+      return false;
+    }
+    ++cachedOutput;
+  }
+
+  auto copy = copies.cbegin();
+  for (auto & output : m_Outputs)
+  {
+    output.second->Graft(*copy);
+    ++copy;
+  }
+  return true;
+}
+
+
+void
+ProcessObject::CacheOutputs(const std::string & key) const
+{
+  PipelineOutputCache::OutputsType copies;
+  SizeValueType                    totalNumberOfBytes = 0;
+  for (const auto & output : m_Outputs)
+  {
+    SizeValueType           numberOfBytes = 0;
+    const DataObjectPointer copy = this->CopyOutputForCache(output.second, numberOfBytes);
+    if (copy.IsNull())
+    {
+      return;
+    }
+    copies.emplace_back(output.first, copy.GetPointer());
+    totalNumberOfBytes += numberOfBytes;
+  }
+  PipelineOutputCache::Insert(key, std::move(copies), totalNumberOfBytes);
+}
+
+
 void
 ProcessObject::CacheInputReleaseDataFlags()
 {
@@ -33,6 +33,12 @@
 namespace itk
 {
 
+namespace
+{
+// Set in each thread of the pool.
+thread_local bool isPoolThread{ false };
+} // namespace
+
 struct ThreadPoolGlobals
 {
   ThreadPoolGlobals() = default;
@@ -136,6 +142,12 @@ ThreadPool::GetMutex() const
   return m_PimplGlobals->m_Mutex;
 }
 
+bool
+ThreadPool::IsCalledFromPoolThread()
+{
+  return isPoolThread;
+}
+
 int
 ThreadPool::GetNumberOfCurrentlyIdleThreads() const
 {
@@ -191,6 +203,7 @@ ThreadPool::ThreadExecute()
 {
   // plain pointer does not increase reference count
   ThreadPool * threadPool = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  isPoolThread = true;
 
   while (true)
   {
@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBrickedImage.h"
+#include "itkBrickedImageRegionIterator.h"
+#include "itkIndexRange.h"
+#include "itkLexicographicCompare.h"
+#include <gtest/gtest.h>
+
+#include <set>
+
+
+namespace
+{
+
+using BrickedImageType = itk::BrickedImage<short, 3>;
+
+// A value that differs between most pixels, so that the bricks do not
+// compress to a single value.
+short
+ComputeValue(const BrickedImageType::IndexType & index)
+{
+  return static_cast<short>(index[0] * 7 - index[1] * 13 + index[2] * 31);
+}
+
+// An image whose buffered region does not start at the origin, and is not a
+// multiple of the brick size.
+BrickedImageType::Pointer
+MakeBrickedImage(itk::SizeValueType maximumNumberOfCachedBricks)
+{
+  auto image = BrickedImageType::New();
+  image->SetRegions(BrickedImageType::RegionType{ { { -3, 2, 5 } }, { { 20, 17, 9 } } });
+  image->SetBrickSize(BrickedImageType::SizeType{ { 8, 8, 4 } });
+  image->SetMaximumNumberOfCachedBricks(maximumNumberOfCachedBricks);
+  image->Allocate();
+  return image;
+}
+
+} // namespace
+
+
+TEST(BrickedImage, SetsAndGetsPixelsThroughASmallCache)
+{
+  const auto image = MakeBrickedImage(2);
+  EXPECT_EQ(image->GetNumberOfBricksPerDimension(), (BrickedImageType::SizeType{ { 3, 3, 3 } }));
+  EXPECT_EQ(image->GetNumberOfBricks(), 27u);
+  EXPECT_EQ(image->GetBrickRegion(26), (BrickedImageType::RegionType{ { { 13, 18, 13 } }, { { 4, 1, 1 } } }));
+
+  const BrickedImageType::RegionType region = image->GetBufferedRegion();
+  for (const auto & index : itk::ImageRegionIndexRange<3>(region))
+  {
+    EXPECT_EQ(image->GetPixel(index), 0);
+  }
+
+  for (const auto & index : itk::ImageRegionIndexRange<3>(region))
+  {
+    image->SetPixel(index, ComputeValue(index));
+    EXPECT_LE(image->GetNumberOfCachedBricks(), 2u);
+  }
+  for (const auto & index : itk::ImageRegionIndexRange<3>(region))
+  {
+    ASSERT_EQ(image->GetPixel(index), ComputeValue(index));
+  }
+
+  image->FlushCache();
+  EXPECT_EQ(image->GetNumberOfCachedBricks(), 0u);
+  EXPECT_EQ(image->GetPixel({ { 16, 18, 13 } }), ComputeValue({ { 16, 18, 13 } }));
+
+  image->FillBuffer(5);
+  EXPECT_EQ(image->GetPixel({ { 16, 18, 13 } }), 5);
+  EXPECT_EQ(image->GetCompressedBufferSize(), 27 * sizeof(short));
+}
+
+
+TEST(BrickedImage, IteratesBrickByBrick)
+{
+  const auto image = MakeBrickedImage(1);
+
+  itk::SizeValueType numberOfPixels = 0;
+  for (itk::BrickedImageRegionIterator<BrickedImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ComputeValue(it.GetIndex()));
+    ++numberOfPixels;
+  }
+  EXPECT_EQ(numberOfPixels, image->GetBufferedRegion().GetNumberOfPixels());
+
+  // A region across the borders of bricks is visited once per pixel, in
+  // increasing brick number.
+  const BrickedImageType::RegionType region{ { { 2, 5, 6 } }, { { 10, 9, 8 } } };
+  itk::SizeValueType                 previousBrickNumber = 0;
+  std::set<itk::SizeValueType>       brickNumbers;
+
+  std::set<BrickedImageType::IndexType, itk::Functor::LexicographicCompare> indices;
+
+  itk::BrickedImageRegionConstIterator<BrickedImageType> it(image, region);
+  for (; !it.IsAtEnd(); ++it)
+  {
+    ASSERT_TRUE(region.IsInside(it.GetIndex()));
+    EXPECT_EQ(it.Get(), ComputeValue(it.GetIndex()));
+    EXPECT_GE(it.GetBrickNumber(), previousBrickNumber);
+    EXPECT_EQ(it.GetBrickNumber(), image->ComputeBrickNumber(it.GetIndex()));
+    previousBrickNumber = it.GetBrickNumber();
+    brickNumbers.insert(it.GetBrickNumber());
+    indices.insert(it.GetIndex());
+  }
+  EXPECT_EQ(indices.size(), region.GetNumberOfPixels());
+  EXPECT_EQ(brickNumbers.size(), 2u * 2u * 3u);
+
+  // The pixels written by the iterator survive the eviction of their brick.
+  image->FlushCache();
+  EXPECT_EQ(image->GetPixel({ { 0, 10, 12 } }), ComputeValue({ { 0, 10, 12 } }));
+}
+
+
+TEST(BrickedImage, CompressesLabelData)
+{
+  using LabelImageType = itk::BrickedImage<unsigned int, 3>;
+
+  auto image = LabelImageType::New();
+  image->SetRegions(LabelImageType::SizeType{ { 128, 128, 128 } });
+  image->Allocate();
+
+  // A ball of label 1, and a slab of label 2.
+  for (itk::BrickedImageRegionIterator<LabelImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const LabelImageType::IndexType & index = it.GetIndex();
+    const auto                        dx = index[0] - 40;
+    const auto                        dy = index[1] - 60;
+    const auto                        dz = index[2] - 50;
+    if (dx * dx + dy * dy + dz * dz < 30 * 30)
+    {
+      it.Set(1);
+    }
+    else if (index[2] >= 100 && index[2] < 110)
+    {
+      it.Set(2);
+    }
+  }
+  image->FlushCache();
+
+  const itk::SizeValueType denseSize = image->GetBufferedRegion().GetNumberOfPixels() * sizeof(unsigned int);
+  EXPECT_LT(image->GetCompressedBufferSize() * 10, denseSize);
+
+  EXPECT_EQ(image->GetPixel({ { 40, 60, 50 } }), 1u);
+  EXPECT_EQ(image->GetPixel({ { 40, 60, 105 } }), 2u);
+  EXPECT_EQ(image->GetPixel({ { 0, 0, 0 } }), 0u);
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkImageBufferPool.h"
+#include "itkImage.h"
+#include "itkVariableLengthVector.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+
+// Enables the pool for the duration of a test, and restores the default
+// settings afterwards.
+class ImageBufferPoolFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    itk::ImageBufferPool::ReleaseCachedBuffers();
+    itk::ImageBufferPool::ResetStatistics();
+    itk::ImageBufferPool::SetEnabled(true);
+  }
+
+  void
+  TearDown() override
+  {
+    itk::ImageBufferPool::SetEnabled(false);
+    itk::ImageBufferPool::SetMaximumCachedBytes(size_t{ 1 } << 30);
+    itk::ImageBufferPool::SetMaximumCachedBuffersPerSizeClass(8);
+    itk::ImageBufferPool::SetMinimumBufferSize(size_t{ 64 } << 10);
+    itk::ImageBufferPool::SetAlignment(64);
+    itk::ImageBufferPool::SetUseHugePages(false);
+    itk::ImageBufferPool::ReleaseCachedBuffers();
+  }
+};
+
+
+ImageType::Pointer
+MakeImage(bool initializePixels = false)
+{
+  auto                          image = ImageType::New();
+  constexpr ImageType::SizeType size{ 64, 64, 64 };
+  image->SetRegions(size);
+  image->Allocate(initializePixels);
+  return image;
+}
+
+} // namespace
+
+
+TEST(ImageBufferPool, SizeClasses)
+{
+  EXPECT_EQ(itk::ImageBufferPool::GetSizeClass(1), 4096u);
+  EXPECT_EQ(itk::ImageBufferPool::GetSizeClass(4096), 4096u);
+  EXPECT_EQ(itk::ImageBufferPool::GetSizeClass(4097), 5120u);
+  EXPECT_EQ(itk::ImageBufferPool::GetSizeClass(1 << 20), size_t{ 1 } << 20);
+  EXPECT_EQ(itk::ImageBufferPool::GetSizeClass((1 << 20) + 1), size_t{ 5 } << 18);
+
+  // A size class never wastes more than a quarter of the buffer.
+  for (size_t numberOfBytes = 4096; numberOfBytes < (size_t{ 1 } << 24); numberOfBytes = numberOfBytes * 3 / 2 + 7)
+  {
+    const size_t sizeClass = itk::ImageBufferPool::GetSizeClass(numberOfBytes);
+    EXPECT_GE(sizeClass, numberOfBytes);
+    EXPECT_LE(sizeClass - numberOfBytes, sizeClass / 4);
+  }
+}
+
+
+TEST(ImageBufferPool, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::ImageBufferPool::GetEnabled());
+  EXPECT_EQ(itk::ImageBufferPool::AllocateBuffer(size_t{ 1 } << 20), nullptr);
+
+  const auto buffer = std::make_unique<float[]>(16);
+  EXPECT_FALSE(itk::ImageBufferPool::ReleaseBuffer(buffer.get()));
+}
+
+
+TEST(ImageBufferPool, InvalidAlignmentThrows)
+{
+  EXPECT_THROW(itk::ImageBufferPool::SetAlignment(100), itk::ExceptionObject);
+  EXPECT_THROW(itk::ImageBufferPool::SetAlignment(1), itk::ExceptionObject);
+}
+
+
+TEST_F(ImageBufferPoolFixture, ReusesReleasedImageBuffers)
+{
+  auto         image = MakeImage();
+  const auto * firstBuffer = image->GetBufferPointer();
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(firstBuffer) % itk::ImageBufferPool::GetAlignment(), 0u);
+  image->FillBuffer(1.0f);
+  image = nullptr;
+
+  itk::ImageBufferPoolStatistics statistics = itk::ImageBufferPool::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfAllocations, 1u);
+  EXPECT_EQ(statistics.NumberOfReleases, 1u);
+  EXPECT_EQ(statistics.NumberOfCachedBuffers, 1u);
+  EXPECT_EQ(statistics.OutstandingBytes, 0u);
+  EXPECT_EQ(statistics.PeakOutstandingBytes, statistics.CachedBytes);
+
+  // The buffer of the released image is reused, and value initialized on request.
+  image = MakeImage(true);
+  EXPECT_EQ(image->GetBufferPointer(), firstBuffer);
+  const float * const bufferBegin = image->GetBufferPointer();
+  const float * const bufferEnd = bufferBegin + image->GetPixelContainer()->Size();
+  EXPECT_TRUE(std::all_of(bufferBegin, bufferEnd, [](float pixel) { return pixel == 0.0f; }));
+
+  statistics = itk::ImageBufferPool::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfAllocations, 2u);
+  EXPECT_EQ(statistics.NumberOfReuses, 1u);
+  EXPECT_EQ(statistics.NumberOfCachedBuffers, 0u);
+  EXPECT_EQ(statistics.CachedBytes, 0u);
+
+  // A second image of the same size needs a new buffer.
+  const auto otherImage = MakeImage();
+  EXPECT_NE(otherImage->GetBufferPointer(), image->GetBufferPointer());
+  EXPECT_EQ(itk::ImageBufferPool::GetStatistics().NumberOfReuses, 1u);
+}
+
+
+TEST_F(ImageBufferPoolFixture, RespectsCaps)
+{
+  itk::ImageBufferPool::SetMaximumCachedBuffersPerSizeClass(1);
+  {
+    const auto image1 = MakeImage();
+    const auto image2 = MakeImage();
+  }
+  itk::ImageBufferPoolStatistics statistics = itk::ImageBufferPool::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfReleases, 2u);
+  EXPECT_EQ(statistics.NumberOfCachedBuffers, 1u);
+  EXPECT_EQ(statistics.NumberOfEvictions, 1u);
+
+  itk::ImageBufferPool::SetMaximumCachedBytes(0);
+  statistics = itk::ImageBufferPool::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfCachedBuffers, 0u);
+  EXPECT_EQ(statistics.NumberOfEvictions, 2u);
+
+  MakeImage();
+  EXPECT_EQ(itk::ImageBufferPool::GetStatistics().NumberOfCachedBuffers, 0u);
+
+  // Small requests are not served by the pool.
+  itk::ImageBufferPool::ResetStatistics();
+  auto                          smallImage = ImageType::New();
+  constexpr ImageType::SizeType smallSize{ 4, 4, 4 };
+  smallImage->SetRegions(smallSize);
+  smallImage->Allocate();
+  EXPECT_EQ(itk::ImageBufferPool::GetStatistics().NumberOfAllocations, 0u);
+}
+
+
+TEST_F(ImageBufferPoolFixture, HonorsAlignment)
+{
+  itk::ImageBufferPool::SetAlignment(4096);
+  itk::ImageBufferPool::SetUseHugePages(true);
+
+  void * buffer = itk::ImageBufferPool::AllocateBuffer(size_t{ 1 } << 20);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % 4096, 0u);
+  EXPECT_TRUE(itk::ImageBufferPool::ReleaseBuffer(buffer));
+  EXPECT_FALSE(itk::ImageBufferPool::ReleaseBuffer(buffer));
+
+  buffer = itk::ImageBufferPool::AllocateBuffer(size_t{ 4 } << 20);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % (size_t{ 2 } << 20), 0u);
+  EXPECT_TRUE(itk::ImageBufferPool::ReleaseBuffer(buffer));
+}
+
+
+TEST_F(ImageBufferPoolFixture, SkipsNonTrivialPixelTypes)
+{
+  using VectorImageType = itk::Image<itk::VariableLengthVector<float>, 3>;
+  auto                                image = VectorImageType::New();
+  constexpr VectorImageType::SizeType size{ 64, 64, 64 };
+  image->SetRegions(size);
+  image->Allocate();
+  EXPECT_EQ(itk::ImageBufferPool::GetStatistics().NumberOfAllocations, 0u);
+}
@@ -18,8 +18,13 @@
 
 // First include the header file to be tested:
 #include "itkImage.h"
+#include "itkImageBufferPool.h"
+#include "itkMultiThreaderBase.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
 template <typename T>
@@ -205,6 +210,57 @@ TEST(Image, FillBufferOfNonEqualityComparableType)
   }
 }
 
+
+// Tests `FillBuffer` and `Allocate(true)` on images that are large enough to
+// be filled in parallel.
+TEST(Image, FillBufferOfLargeImage)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  constexpr ImageType::IndexType index{ -3, 5, 2 };
+  constexpr ImageType::SizeType  size{ 67, 61, 129 };
+  const ImageType::RegionType    region(index, size);
+
+  const auto hasValue = [](const ImageType & image, float value) {
+    const float * const buffer = image.GetBufferPointer();
+    const float * const bufferEnd = buffer + image.GetBufferedRegion().GetNumberOfPixels();
+    return std::all_of(buffer, bufferEnd, [value](float pixel) { return pixel == value; });
+  };
+
+  itk::ImageBufferPool::SetEnabled(true);
+
+  std::vector<ImageType::Pointer> images;
+  for (unsigned int n = 0; n < 4; ++n)
+  {
+    images.push_back(ImageType::New());
+    images.back()->SetRegions(region);
+    images.back()->Allocate();
+    images.back()->FillBuffer(2.5f);
+    EXPECT_TRUE(hasValue(*images.back(), 2.5f));
+  }
+
+  // Threads of the pool fill the buffers by themselves.
+  const auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0, images.size(), [&images](itk::SizeValueType n) { images[n]->FillBuffer(-1.0f); }, nullptr);
+  for (const auto & image : images)
+  {
+    EXPECT_TRUE(hasValue(*image, -1.0f));
+  }
+
+  // A buffer reused from the pool is zero-initialized.
+  const float * const buffer = images.front()->GetBufferPointer();
+  images.front()->Initialize();
+  images.front()->SetRegions(region);
+  images.front()->Allocate(true);
+  EXPECT_EQ(images.front()->GetBufferPointer(), buffer);
+  EXPECT_TRUE(hasValue(*images.front(), 0.0f));
+
+  itk::ImageBufferPool::SetEnabled(false);
+  images.clear();
+  itk::ImageBufferPool::ReleaseCachedBuffers();
+}
+
 template <typename ImageType>
 typename ImageType::Pointer
 generate_image(typename ImageType::SizeType size)
@@ -17,7 +17,13 @@
  *=========================================================================*/
 
 #include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "itkImportImageContainer.h"
+#include "itkImageDuplicator.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkNumericTraits.h"
 #include "itkTextOutput.h"
 #include "itkGTest.h"
@@ -169,3 +175,153 @@ TEST(ImportContainer, ConvertedLegacyTest)
   }
 #endif
 }
+
+
+TEST(ImportContainer, SharesBufferUntilWritten)
+{
+  using ContainerType = itk::ImportImageContainer<unsigned long, int>;
+
+  auto container1 = ContainerType::New();
+  container1->Reserve(100);
+  for (unsigned long i = 0; i < 100; ++i)
+  {
+    (*container1)[i] = static_cast<int>(i);
+  }
+  const int * const buffer1 = std::as_const(*container1).GetBufferPointer();
+
+  // Sharing and reading do not copy.
+  auto container2 = ContainerType::New();
+  container2->ShareBuffer(container1);
+  auto container3 = ContainerType::New();
+  container3->ShareBuffer(container2);
+  EXPECT_TRUE(container1->IsBufferShared());
+  EXPECT_EQ(container2->Size(), 100u);
+  EXPECT_EQ(std::as_const(*container2).GetBufferPointer(), buffer1);
+  EXPECT_EQ(std::as_const(*container3)[42], 42);
+
+  // Writing copies.
+  (*container2)[42] = -1;
+  EXPECT_NE(std::as_const(*container2).GetBufferPointer(), buffer1);
+  EXPECT_EQ(std::as_const(*container1)[42], 42);
+  EXPECT_EQ(std::as_const(*container3)[42], 42);
+  EXPECT_FALSE(container2->IsBufferShared());
+
+  // The last container that shares the buffer writes it in place.
+  container3 = nullptr;
+  EXPECT_FALSE(container1->IsBufferShared());
+  EXPECT_EQ(container1->GetBufferPointer(), buffer1);
+  EXPECT_TRUE(container1->GetContainerManageMemory());
+}
+
+
+TEST(ImportContainer, CopiesBufferManagedByApplication)
+{
+  using ContainerType = itk::ImportImageContainer<unsigned long, int>;
+
+  std::vector<int> values(10, 7);
+  auto             container1 = ContainerType::New();
+  container1->SetImportPointer(values.data(), values.size(), false);
+
+  auto container2 = ContainerType::New();
+  container2->ShareBuffer(container1);
+  EXPECT_FALSE(container2->IsBufferShared());
+  EXPECT_NE(std::as_const(*container2).GetBufferPointer(), values.data());
+  EXPECT_EQ(std::as_const(*container2)[9], 7);
+}
+
+
+TEST(ImportContainer, SharedByImageDuplicator)
+{
+  using ImageType = itk::Image<short, 3>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 8, 8, 8 } });
+  image->AllocateInitialized();
+  image->SetPixel({ { 1, 2, 3 } }, 5);
+
+  auto duplicator = itk::ImageDuplicator<ImageType>::New();
+  duplicator->SetInputImage(image);
+  duplicator->Update();
+  EXPECT_NE(std::as_const(*duplicator->GetOutput()).GetBufferPointer(), std::as_const(*image).GetBufferPointer());
+  EXPECT_EQ(std::as_const(*duplicator->GetOutput()).GetPixel({ { 1, 2, 3 } }), 5);
+
+  image->Modified();
+  duplicator->ShareBufferOn();
+  duplicator->Update();
+  const ImageType::Pointer duplicate = duplicator->GetOutput();
+
+  EXPECT_EQ(std::as_const(*duplicate).GetBufferPointer(), std::as_const(*image).GetBufferPointer());
+  EXPECT_EQ(std::as_const(*duplicate).GetPixel({ { 1, 2, 3 } }), 5);
+
+  duplicate->SetPixel({ { 1, 2, 3 } }, 6);
+  EXPECT_NE(std::as_const(*duplicate).GetBufferPointer(), std::as_const(*image).GetBufferPointer());
+  EXPECT_EQ(std::as_const(*image).GetPixel({ { 1, 2, 3 } }), 5);
+  EXPECT_EQ(std::as_const(*duplicate).GetPixel({ { 1, 2, 3 } }), 6);
+}
+
+
+TEST(ImportContainer, WrittenThroughImageIterators)
+{
+  using ImageType = itk::Image<short, 3>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 8, 8, 8 } });
+  image->AllocateInitialized();
+
+  auto duplicator = itk::ImageDuplicator<ImageType>::New();
+  duplicator->SetInputImage(image);
+  duplicator->ShareBufferOn();
+  duplicator->Update();
+  const ImageType::Pointer duplicate = duplicator->GetOutput();
+  ASSERT_EQ(std::as_const(*duplicate).GetBufferPointer(), std::as_const(*image).GetBufferPointer());
+
+  for (itk::ImageRegionIterator<ImageType> it(duplicate, duplicate->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(1);
+  }
+  EXPECT_NE(std::as_const(*duplicate).GetBufferPointer(), std::as_const(*image).GetBufferPointer());
+  EXPECT_EQ(std::as_const(*image).GetPixel({ { 7, 7, 7 } }), 0);
+  EXPECT_EQ(std::as_const(*duplicate).GetPixel({ { 7, 7, 7 } }), 1);
+
+  // The source is written through its own copy as well.
+  image->Modified();
+  duplicator->Update();
+  const ImageType::Pointer another = duplicator->GetOutput();
+  ASSERT_EQ(std::as_const(*another).GetBufferPointer(), std::as_const(*image).GetBufferPointer());
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Value() = 2;
+  }
+  EXPECT_EQ(std::as_const(*image).GetPixel({ { 7, 7, 7 } }), 2);
+  EXPECT_EQ(std::as_const(*another).GetPixel({ { 7, 7, 7 } }), 0);
+}
+
+
+TEST(ImportContainer, CopiesSharedBufferOnceForConcurrentWrites)
+{
+  using ContainerType = itk::ImportImageContainer<unsigned long, int>;
+
+  auto container1 = ContainerType::New();
+  container1->Reserve(1000, true);
+  auto container2 = ContainerType::New();
+  container2->ShareBuffer(container1);
+
+  constexpr unsigned int   numberOfThreads = 8;
+  std::vector<int *>       buffers(numberOfThreads);
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < numberOfThreads; ++i)
+  {
+    threads.emplace_back([&buffers, &container2, i] { buffers[i] = container2->GetBufferPointer(); });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+
+  for (int * const buffer : buffers)
+  {
+    EXPECT_EQ(buffer, buffers.front());
+  }
+  EXPECT_NE(buffers.front(), std::as_const(*container1).GetBufferPointer());
+  EXPECT_FALSE(container2->IsBufferShared());
+}
@@ -0,0 +1,240 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkParallelStreamingExecutor.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 2>;
+
+// The number of AddOneImageFilter executing at the same time, and its maximum.
+std::atomic<unsigned int> numberOfExecutingFilters{ 0 };
+std::atomic<unsigned int> maximumNumberOfExecutingFilters{ 0 };
+
+void
+UpdateMaximum(std::atomic<unsigned int> & maximum, unsigned int value)
+{
+  unsigned int current = maximum;
+  while (value > current && !maximum.compare_exchange_weak(current, value))
+  {
+  }
+}
+
+// Adds one to each pixel, slowly.
+class AddOneImageFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AddOneImageFilter);
+
+  using Self = AddOneImageFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(AddOneImageFilter);
+
+protected:
+  AddOneImageFilter() = default;
+  ~AddOneImageFilter() override = default;
+
+  void
+  GenerateData() override
+  {
+    UpdateMaximum(maximumNumberOfExecutingFilters, ++numberOfExecutingFilters);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    this->AllocateOutputs();
+    const ImageType::RegionType              region = this->GetOutput()->GetRequestedRegion();
+    itk::ImageRegionConstIterator<ImageType> inputIt(this->GetInput(), region);
+    itk::ImageRegionIterator<ImageType>      outputIt(this->GetOutput(), region);
+    for (; !outputIt.IsAtEnd(); ++inputIt, ++outputIt)
+    {
+      outputIt.Set(inputIt.Get() + 1.0f);
+    }
+    --numberOfExecutingFilters;
+  }
+};
+
+
+ImageType::Pointer
+MakeImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 40 } });
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(it.GetIndex()[0] + 100 * it.GetIndex()[1]));
+  }
+  return image;
+}
+
+
+// Adds one to a graft of image, so that several instances can share it.
+itk::ParallelStreamingExecutor::PipelineType
+MakePipeline(const ImageType * image)
+{
+  auto input = ImageType::New();
+  input->Graft(image);
+  auto filter = AddOneImageFilter::New();
+  filter->SetInput(input);
+  return { filter.GetPointer() };
+}
+
+
+ImageType::Pointer
+Stream(const ImageType * image, unsigned int numberOfPiecesInFlight, itk::SizeValueType memoryBudget)
+{
+  const auto pipeline = MakePipeline(image);
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(itk::ParallelStreamingExecutor::GetOutput<ImageType>(pipeline));
+  streamer->SetNumberOfStreamDivisions(8);
+  streamer->SetNumberOfPiecesInFlight(numberOfPiecesInFlight);
+  streamer->SetMemoryBudget(memoryBudget);
+  streamer->SetPipelineFactory([image] { return MakePipeline(image); });
+
+  numberOfExecutingFilters = 0;
+  maximumNumberOfExecutingFilters = 0;
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+
+bool
+IsImagePlusOne(const ImageType * output, const ImageType * image)
+{
+  if (output->GetBufferedRegion() != image->GetLargestPossibleRegion())
+  {
+    return false;
+  }
+  itk::ImageRegionConstIterator<ImageType> outputIt(output, output->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> imageIt(image, output->GetBufferedRegion());
+  for (; !outputIt.IsAtEnd(); ++outputIt, ++imageIt)
+  {
+    if (outputIt.Get() != imageIt.Get() + 1.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+
+TEST(ParallelStreamingExecutor, ConsumesPiecesInOrderWithinBudget)
+{
+  constexpr unsigned int    numberOfPieces = 20;
+  std::atomic<unsigned int> numberOfPiecesInFlight{ 0 };
+  std::atomic<unsigned int> maximumNumberOfPiecesInFlight{ 0 };
+  std::mutex                mutex;
+  std::vector<unsigned int> consumedPieces;
+
+  const auto compute = [&](unsigned int, unsigned int) {
+    UpdateMaximum(maximumNumberOfPiecesInFlight, ++numberOfPiecesInFlight);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+  const auto consume = [&](unsigned int, unsigned int piece) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    consumedPieces.push_back(piece);
+    --numberOfPiecesInFlight;
+  };
+
+  // Pieces of 10 bytes, within a budget of 25 bytes.
+  itk::ParallelStreamingExecutor::Execute(
+    numberOfPieces, 4, 25, [](unsigned int) -> itk::SizeValueType { return 10; }, compute, consume);
+
+  ASSERT_EQ(consumedPieces.size(), numberOfPieces);
+  for (unsigned int piece = 0; piece < numberOfPieces; ++piece)
+  {
+    EXPECT_EQ(consumedPieces[piece], piece);
+  }
+  EXPECT_LE(maximumNumberOfPiecesInFlight, 2u);
+}
+
+
+TEST(ParallelStreamingExecutor, RethrowsExceptions)
+{
+  std::atomic<unsigned int> numberOfComputedPieces{ 0 };
+  const auto                compute = [&numberOfComputedPieces](unsigned int, unsigned int piece) {
+    ++numberOfComputedPieces;
+    if (piece == 3)
+    {
+      throw std::runtime_error("piece 3");
+    }
+  };
+  EXPECT_THROW(itk::ParallelStreamingExecutor::Execute(100, 3, 1000, nullptr, compute, nullptr), std::runtime_error);
+  EXPECT_LT(numberOfComputedPieces, 100u);
+}
+
+
+TEST(ParallelStreamingExecutor, StreamingImageFilterPiecesInFlight)
+{
+  const auto image = MakeImage();
+
+  const auto sequentialOutput = Stream(image, 1, itk::NumericTraits<itk::SizeValueType>::max());
+  EXPECT_TRUE(IsImagePlusOne(sequentialOutput, image));
+  EXPECT_EQ(maximumNumberOfExecutingFilters, 1u);
+
+  const auto parallelOutput = Stream(image, 3, itk::NumericTraits<itk::SizeValueType>::max());
+  EXPECT_TRUE(IsImagePlusOne(parallelOutput, image));
+  EXPECT_GT(maximumNumberOfExecutingFilters, 1u);
+  EXPECT_LE(maximumNumberOfExecutingFilters, 3u);
+
+  // A budget of one piece leaves a single piece in flight.
+  const itk::SizeValueType pieceBytes = image->GetLargestPossibleRegion().GetNumberOfPixels() / 8 * sizeof(float);
+  const auto               boundedOutput = Stream(image, 3, pieceBytes);
+  EXPECT_TRUE(IsImagePlusOne(boundedOutput, image));
+  EXPECT_EQ(maximumNumberOfExecutingFilters, 1u);
+}
+
+
+TEST(ParallelStreamingExecutor, StreamingImageFilterChecksFactoryPipelines)
+{
+  const auto image = MakeImage();
+
+  auto largerImage = ImageType::New();
+  largerImage->SetRegions(ImageType::SizeType{ { 64, 40 } });
+  largerImage->AllocateInitialized();
+
+  const auto pipeline = MakePipeline(image);
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(itk::ParallelStreamingExecutor::GetOutput<ImageType>(pipeline));
+  streamer->SetNumberOfStreamDivisions(8);
+  streamer->SetNumberOfPiecesInFlight(3);
+  streamer->SetPipelineFactory([largerImage] { return MakePipeline(largerImage); });
+  EXPECT_THROW(streamer->Update(), itk::ExceptionObject);
+}
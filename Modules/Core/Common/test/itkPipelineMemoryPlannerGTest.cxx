@@ -0,0 +1,239 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineMemoryPlanner.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkInPlaceImageFilter.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 2>;
+
+// Adds one to each pixel; out of place unless InPlace is turned on.
+class AddOneImageFilter : public itk::InPlaceImageFilter<ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AddOneImageFilter);
+
+  using Self = AddOneImageFilter;
+  using Superclass = itk::InPlaceImageFilter<ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(AddOneImageFilter);
+
+protected:
+  AddOneImageFilter()
+  {
+    this->InPlaceOff();
+    this->DynamicMultiThreadingOn();
+  }
+  ~AddOneImageFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & outputRegion) override
+  {
+    itk::ImageRegionConstIterator<ImageType> inputIt(this->GetInput(), outputRegion);
+    itk::ImageRegionIterator<ImageType>      outputIt(this->GetOutput(), outputRegion);
+    for (; !outputIt.IsAtEnd(); ++inputIt, ++outputIt)
+    {
+      outputIt.Set(inputIt.Get() + 1.0f);
+    }
+  }
+};
+
+
+constexpr itk::SizeValueType imageSize{ 64 };
+constexpr itk::SizeValueType imageBytes{ imageSize * imageSize * sizeof(float) };
+
+
+ImageType::Pointer
+MakeImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(imageSize));
+  image->AllocateInitialized();
+  return image;
+}
+
+
+// Returns a chain of numberOfFilters AddOneImageFilter.
+std::vector<AddOneImageFilter::Pointer>
+MakeChain(const ImageType * image, unsigned int numberOfFilters)
+{
+  std::vector<AddOneImageFilter::Pointer> filters;
+  for (unsigned int i = 0; i < numberOfFilters; ++i)
+  {
+    filters.push_back(AddOneImageFilter::New());
+    filters.back()->SetInput(i == 0 ? image : filters[i - 1]->GetOutput());
+  }
+  return filters;
+}
+
+
+// Returns a planner of the chain, for which the outputs of the filters other
+// than the last one are intermediate outputs.
+itk::PipelineMemoryPlanner::Pointer
+MakePlanner(const std::vector<AddOneImageFilter::Pointer> & filters)
+{
+  auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetOutput(filters.back()->GetOutput());
+  for (size_t i = 0; i + 1 < filters.size(); ++i)
+  {
+    planner->AddIntermediateOutput(filters[i]->GetOutput());
+  }
+  return planner;
+}
+
+
+bool
+HasValue(const ImageType * image, float value)
+{
+  const float * const buffer = image->GetBufferPointer();
+  return buffer != nullptr && std::all_of(buffer, buffer + image->GetBufferedRegion().GetNumberOfPixels(),
+                                          [value](float pixel) { return pixel == value; });
+}
+
+} // namespace
+
+
+TEST(PipelineMemoryPlanner, ThrowsWithoutOutput)
+{
+  EXPECT_THROW(itk::PipelineMemoryPlanner::New()->Plan(), itk::ExceptionObject);
+}
+
+
+TEST(PipelineMemoryPlanner, RunsChainInPlace)
+{
+  const auto image = MakeImage();
+  const auto filters = MakeChain(image, 5);
+
+  const auto planner = MakePlanner(filters);
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfFilters(), 5u);
+  EXPECT_EQ(planner->GetNumberOfInPlaceFilters(), 4u);
+  EXPECT_EQ(planner->GetNumberOfReleasedOutputs(), 4u);
+  EXPECT_EQ(planner->GetPeakBytesBeforePlan(), 5 * imageBytes);
+  EXPECT_EQ(planner->GetPeakBytesAfterPlan(), imageBytes);
+
+  // The input of the pipeline is left untouched.
+  EXPECT_TRUE(HasValue(filters.back()->GetOutput(), 5.0f));
+  EXPECT_TRUE(HasValue(image, 0.0f));
+
+  // The pipeline is restored after the update.
+  for (const auto & filter : filters)
+  {
+    EXPECT_FALSE(filter->GetInPlace());
+    EXPECT_FALSE(filter->GetOutput()->GetReleaseDataFlag());
+  }
+}
+
+
+TEST(PipelineMemoryPlanner, PlansUntilRestored)
+{
+  const auto image = MakeImage();
+  const auto filters = MakeChain(image, 3);
+  const auto planner = MakePlanner(filters);
+
+  const auto filterMTime = filters.back()->GetMTime();
+  planner->Plan();
+  EXPECT_FALSE(filters.front()->GetInPlace());
+  EXPECT_TRUE(filters.back()->GetInPlace());
+  EXPECT_TRUE(filters.front()->GetOutput()->GetReleaseDataFlag());
+  EXPECT_EQ(filters.back()->GetMTime(), filterMTime);
+
+  // Planning again changes nothing.
+  planner->Plan();
+  EXPECT_EQ(planner->GetNumberOfInPlaceFilters(), 0u);
+  EXPECT_EQ(planner->GetNumberOfReleasedOutputs(), 0u);
+  EXPECT_EQ(planner->GetPeakBytesBeforePlan(), imageBytes);
+
+  planner->RestorePipeline();
+  EXPECT_FALSE(filters.back()->GetInPlace());
+  EXPECT_FALSE(filters.front()->GetOutput()->GetReleaseDataFlag());
+  EXPECT_EQ(filters.back()->GetMTime(), filterMTime);
+}
+
+
+TEST(PipelineMemoryPlanner, KeepsOutputsThatAreNotIntermediate)
+{
+  const auto image = MakeImage();
+  const auto filters = MakeChain(image, 3);
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetOutput(filters.back()->GetOutput());
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfFilters(), 3u);
+  EXPECT_EQ(planner->GetNumberOfInPlaceFilters(), 0u);
+  EXPECT_EQ(planner->GetNumberOfReleasedOutputs(), 0u);
+  EXPECT_EQ(planner->GetPeakBytesAfterPlan(), 3 * imageBytes);
+}
+
+
+TEST(PipelineMemoryPlanner, KeepsReferencedOutputs)
+{
+  const auto image = MakeImage();
+  const auto filters = MakeChain(image, 5);
+
+  // An output read by the application, here through a raw pointer, is
+  // neither released nor overwritten when it is not an intermediate output.
+  const ImageType * const readOutput = filters[2]->GetOutput();
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetOutput(filters.back()->GetOutput());
+  for (const unsigned int i : { 0, 1, 3 })
+  {
+    planner->AddIntermediateOutput(filters[i]->GetOutput());
+  }
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfInPlaceFilters(), 3u);
+  EXPECT_EQ(planner->GetNumberOfReleasedOutputs(), 3u);
+  EXPECT_EQ(planner->GetPeakBytesAfterPlan(), 2 * imageBytes);
+  EXPECT_FALSE(filters[3]->GetInPlace());
+  EXPECT_TRUE(HasValue(readOutput, 3.0f));
+  EXPECT_TRUE(HasValue(filters.back()->GetOutput(), 5.0f));
+}
+
+
+TEST(PipelineMemoryPlanner, KeepsOutputsWithSeveralConsumers)
+{
+  const auto image = MakeImage();
+  const auto filters = MakeChain(image, 3);
+
+  // The output of the first filter is also the second input of the last one.
+  filters[2]->SetInput(1, filters[0]->GetOutput());
+
+  const auto planner = MakePlanner(filters);
+  planner->Update();
+
+  EXPECT_EQ(planner->GetNumberOfFilters(), 3u);
+  EXPECT_EQ(planner->GetNumberOfInPlaceFilters(), 1u);
+  EXPECT_TRUE(HasValue(filters[0]->GetOutput(), 1.0f));
+  EXPECT_TRUE(HasValue(filters.back()->GetOutput(), 3.0f));
+}
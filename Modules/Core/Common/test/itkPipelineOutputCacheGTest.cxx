@@ -0,0 +1,301 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineOutputCache.h"
+#include "itkExtractImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 2>;
+using FilterType = itk::ExtractImageFilter<ImageType, ImageType>;
+
+// Adds a constant to the pixels, without opting in to the cache.
+class AddConstantFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AddConstantFilter);
+
+  using Self = AddConstantFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkOverrideGetNameOfClassMacro(AddConstantFilter);
+
+  itkNewMacro(Self);
+
+  itkSetMacro(Constant, double);
+  itkGetConstMacro(Constant, double);
+
+protected:
+  AddConstantFilter() = default;
+  ~AddConstantFilter() override = default;
+
+  void
+  GenerateData() override
+  {
+    this->AllocateOutputs();
+    itk::ImageRegionConstIterator<ImageType> inputIt(this->GetInput(), this->GetOutput()->GetRequestedRegion());
+    itk::ImageRegionIterator<ImageType>      outputIt(this->GetOutput(), this->GetOutput()->GetRequestedRegion());
+    for (; !outputIt.IsAtEnd(); ++inputIt, ++outputIt)
+    {
+      outputIt.Set(static_cast<float>(inputIt.Get() + m_Constant));
+    }
+  }
+
+private:
+  double m_Constant{ 0.0 };
+};
+
+
+// The same filter, opting in to the cache.
+class CachedAddConstantFilter : public AddConstantFilter
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CachedAddConstantFilter);
+
+  using Self = CachedAddConstantFilter;
+  using Superclass = AddConstantFilter;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkOverrideGetNameOfClassMacro(CachedAddConstantFilter);
+
+  itkNewMacro(Self);
+
+protected:
+  CachedAddConstantFilter() = default;
+  ~CachedAddConstantFilter() override = default;
+
+  bool
+  AppendParametersToOutputCacheKey(std::ostream & key) const override
+  {
+    key << this->GetConstant();
+    return true;
+  }
+};
+
+
+// Empties the cache before and after each test.
+class PipelineOutputCacheFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    itk::PipelineOutputCache::Clear();
+    itk::PipelineOutputCache::ResetStatistics();
+  }
+
+  void
+  TearDown() override
+  {
+    itk::PipelineOutputCache::SetMaximumCachedBytes(itk::SizeValueType{ 512 } << 20);
+    itk::PipelineOutputCache::Clear();
+  }
+};
+
+
+ImageType::Pointer
+MakeImage(float firstValue = 0.0f)
+{
+  auto                          image = ImageType::New();
+  constexpr ImageType::SizeType size{ 64, 64 };
+  image->SetRegions(size);
+  image->Allocate();
+  std::iota(image->GetBufferPointer(), image->GetBufferPointer() + size[0] * size[1], firstValue);
+  return image;
+}
+
+
+ImageType::Pointer
+Extract(const ImageType * image, itk::IndexValueType start = 8)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  constexpr ImageType::SizeType size{ 32, 32 };
+  filter->SetExtractionRegion(ImageType::RegionType(ImageType::IndexType::Filled(start), size));
+  filter->UseOutputCacheOn();
+  filter->Update();
+  return filter->GetOutput();
+}
+
+
+template <typename TFilter>
+ImageType::Pointer
+AddConstant(const ImageType * image, double constant)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetConstant(constant);
+  filter->UseOutputCacheOn();
+  filter->Update();
+  return filter->GetOutput();
+}
+
+
+bool
+HaveSamePixels(const ImageType * image1, const ImageType * image2)
+{
+  const float * const buffer1 = image1->GetBufferPointer();
+  const float * const buffer2 = image2->GetBufferPointer();
+  return image1->GetBufferedRegion() == image2->GetBufferedRegion() &&
+         std::equal(buffer1, buffer1 + image1->GetBufferedRegion().GetNumberOfPixels(), buffer2);
+}
+
+} // namespace
+
+
+TEST(PipelineOutputCache, DisabledByDefault)
+{
+  EXPECT_FALSE(FilterType::New()->GetUseOutputCache());
+}
+
+
+TEST(PipelineOutputCache, HashBytes)
+{
+  std::vector<unsigned char> data(100);
+  std::iota(data.begin(), data.end(), 0);
+  const std::uint64_t hash = itk::PipelineOutputCache::HashBytes(data.data(), data.size());
+  EXPECT_EQ(itk::PipelineOutputCache::HashBytes(data.data(), data.size()), hash);
+  EXPECT_NE(itk::PipelineOutputCache::HashBytes(data.data(), data.size() - 1), hash);
+
+  // A change in the words or in the remaining bytes changes the hash.
+  for (const size_t position : { 0, 31, 64, 99 })
+  {
+    ++data[position];
+    EXPECT_NE(itk::PipelineOutputCache::HashBytes(data.data(), data.size()), hash);
+    --data[position];
+  }
+}
+
+
+TEST_F(PipelineOutputCacheFixture, ReusesOutputsOfIdenticalInputs)
+{
+  const auto image = MakeImage();
+  const auto output = Extract(image);
+  itk::PipelineOutputCacheStatistics statistics = itk::PipelineOutputCache::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfMisses, 1u);
+  EXPECT_EQ(statistics.NumberOfInsertions, 1u);
+  EXPECT_EQ(statistics.NumberOfEntries, 1u);
+  EXPECT_EQ(statistics.CachedBytes, 32u * 32u * sizeof(float));
+
+  // A new filter on a new image of the same contents hits the cache, and
+  // gets its own copy of the cached output.
+  const auto sameImage = MakeImage();
+  const auto cachedOutput = Extract(sameImage);
+  EXPECT_EQ(itk::PipelineOutputCache::GetStatistics().NumberOfHits, 1u);
+  EXPECT_TRUE(HaveSamePixels(cachedOutput, output));
+  EXPECT_EQ(cachedOutput->GetLargestPossibleRegion(), output->GetLargestPossibleRegion());
+  EXPECT_EQ(cachedOutput->GetOrigin(), output->GetOrigin());
+
+  cachedOutput->FillBuffer(-1.0f);
+  EXPECT_TRUE(HaveSamePixels(Extract(image), output));
+  EXPECT_EQ(itk::PipelineOutputCache::GetStatistics().NumberOfHits, 2u);
+}
+
+
+TEST_F(PipelineOutputCacheFixture, MissesOnOtherInputsOrParameters)
+{
+  const auto image = MakeImage();
+  Extract(image);
+
+  // Other pixels, geometry, or parameters.
+  const auto otherOutput = Extract(MakeImage(1.0f));
+  EXPECT_EQ(otherOutput->GetBufferPointer()[0], image->GetPixel({ { 8, 8 } }) + 1.0f);
+
+  const auto movedImage = MakeImage();
+  movedImage->SetOrigin(itk::MakePoint(1.0, 0.0));
+  Extract(movedImage);
+
+  Extract(image, 4);
+
+  const itk::PipelineOutputCacheStatistics statistics = itk::PipelineOutputCache::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfHits, 0u);
+  EXPECT_EQ(statistics.NumberOfMisses, 4u);
+  EXPECT_EQ(statistics.NumberOfEntries, 4u);
+}
+
+
+TEST_F(PipelineOutputCacheFixture, RespectsMaximumCachedBytes)
+{
+  constexpr itk::SizeValueType outputBytes{ 32 * 32 * sizeof(float) };
+  itk::PipelineOutputCache::SetMaximumCachedBytes(2 * outputBytes);
+
+  const auto image = MakeImage();
+  Extract(image, 0);
+  Extract(image, 1);
+  Extract(image, 0);
+  Extract(image, 2);
+
+  // The least recently used output was evicted.
+  itk::PipelineOutputCacheStatistics statistics = itk::PipelineOutputCache::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfHits, 1u);
+  EXPECT_EQ(statistics.NumberOfEvictions, 1u);
+  EXPECT_EQ(statistics.NumberOfEntries, 2u);
+  EXPECT_EQ(statistics.CachedBytes, 2 * outputBytes);
+  Extract(image, 0);
+  EXPECT_EQ(itk::PipelineOutputCache::GetStatistics().NumberOfHits, 2u);
+
+  itk::PipelineOutputCache::SetMaximumCachedBytes(outputBytes - 1);
+  statistics = itk::PipelineOutputCache::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfEntries, 0u);
+  EXPECT_EQ(statistics.CachedBytes, 0u);
+
+  Extract(image, 0);
+  EXPECT_EQ(itk::PipelineOutputCache::GetStatistics().NumberOfEntries, 0u);
+}
+
+
+TEST_F(PipelineOutputCacheFixture, CachesOnlyFiltersThatWriteTheirParameters)
+{
+  const auto image = MakeImage();
+  AddConstant<AddConstantFilter>(image, 1.0);
+  AddConstant<AddConstantFilter>(image, 1.0);
+
+  itk::PipelineOutputCacheStatistics statistics = itk::PipelineOutputCache::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfHits, 0u);
+  EXPECT_EQ(statistics.NumberOfMisses, 0u);
+  EXPECT_EQ(statistics.NumberOfEntries, 0u);
+
+  AddConstant<CachedAddConstantFilter>(image, 1.0);
+  AddConstant<CachedAddConstantFilter>(image, 1.0);
+  statistics = itk::PipelineOutputCache::GetStatistics();
+  EXPECT_EQ(statistics.NumberOfHits, 1u);
+  EXPECT_EQ(statistics.NumberOfMisses, 1u);
+}
+
+
+TEST_F(PipelineOutputCacheFixture, KeysParametersWithAllTheirDigits)
+{
+  const auto image = MakeImage();
+  const auto output = AddConstant<CachedAddConstantFilter>(image, 1.0);
+  const auto otherOutput = AddConstant<CachedAddConstantFilter>(image, 1.0 + 1e-9);
+  EXPECT_EQ(itk::PipelineOutputCache::GetStatistics().NumberOfHits, 0u);
+  EXPECT_EQ(itk::PipelineOutputCache::GetStatistics().NumberOfMisses, 2u);
+  EXPECT_TRUE(HaveSamePixels(output, otherOutput));
+}
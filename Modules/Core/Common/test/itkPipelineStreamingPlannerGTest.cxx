@@ -0,0 +1,292 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineStreamingPlanner.h"
+#include "itkImage.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageToImageFilter.h"
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+using PlannerType = itk::PipelineStreamingPlanner<ImageType>;
+
+// Sums the 3x3x3 neighborhood of each pixel, so that it needs a halo of one
+// pixel around its output.
+class BoxSumImageFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BoxSumImageFilter);
+
+  using Self = BoxSumImageFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(BoxSumImageFilter);
+
+protected:
+  BoxSumImageFilter() { this->DynamicMultiThreadingOn(); }
+  ~BoxSumImageFilter() override = default;
+
+  void
+  GenerateInputRequestedRegion() override
+  {
+    Superclass::GenerateInputRequestedRegion();
+    auto *                input = const_cast<ImageType *>(this->GetInput());
+    ImageType::RegionType region = this->GetOutput()->GetRequestedRegion();
+    region.PadByRadius(1);
+    region.Crop(input->GetLargestPossibleRegion());
+    input->SetRequestedRegion(region);
+  }
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & outputRegion) override
+  {
+    const ImageType * const     input = this->GetInput();
+    const ImageType::RegionType largestRegion = input->GetLargestPossibleRegion();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(this->GetOutput(), outputRegion);
+    for (; !it.IsAtEnd(); ++it)
+    {
+      float sum = 0.0f;
+      for (ImageType::OffsetValueType z = -1; z <= 1; ++z)
+      {
+        for (ImageType::OffsetValueType y = -1; y <= 1; ++y)
+        {
+          for (ImageType::OffsetValueType x = -1; x <= 1; ++x)
+          {
+            const ImageType::IndexType index = it.GetIndex() + ImageType::OffsetType{ { x, y, z } };
+            sum += largestRegion.IsInside(index) ? input->GetPixel(index) : 0.0f;
+          }
+        }
+      }
+      it.Set(sum);
+    }
+  }
+};
+
+
+// Copies its input, but requests all of it.
+class WholeInputImageFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WholeInputImageFilter);
+
+  using Self = WholeInputImageFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(WholeInputImageFilter);
+
+protected:
+  WholeInputImageFilter() { this->DynamicMultiThreadingOn(); }
+  ~WholeInputImageFilter() override = default;
+
+  void
+  GenerateInputRequestedRegion() override
+  {
+    const_cast<ImageType *>(this->GetInput())->SetRequestedRegionToLargestPossibleRegion();
+  }
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & outputRegion) override
+  {
+    itk::ImageAlgorithm::Copy(this->GetInput(), this->GetOutput(), outputRegion, outputRegion);
+  }
+};
+
+
+ImageType::Pointer
+MakeImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(24));
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(static_cast<float>((index[0] * 7 + index[1] * 3 + index[2]) % 11));
+  }
+  return image;
+}
+
+
+// Two box sums, optionally separated by a filter that breaks streaming. The
+// input image is grafted, so that several instances can share it.
+PlannerType::PipelineType
+MakePipeline(const ImageType * image, bool breakStreaming = false)
+{
+  auto input = ImageType::New();
+  input->Graft(image);
+
+  PlannerType::PipelineType pipeline;
+  ImageType *               previous = input;
+  const auto                append = [&pipeline, &previous](itk::ImageToImageFilter<ImageType, ImageType> * filter) {
+    filter->SetInput(previous);
+    previous = filter->GetOutput();
+    pipeline.push_back(filter);
+  };
+  append(BoxSumImageFilter::New());
+  if (breakStreaming)
+  {
+    append(WholeInputImageFilter::New());
+  }
+  append(BoxSumImageFilter::New());
+  return pipeline;
+}
+
+
+ImageType *
+GetOutput(const PlannerType::PipelineType & pipeline)
+{
+  return static_cast<ImageType *>(pipeline.back()->GetIndexedOutputs()[0].GetPointer());
+}
+
+
+bool
+HaveSamePixels(const ImageType * image1, const ImageType * image2)
+{
+  if (image1->GetBufferedRegion() != image2->GetBufferedRegion())
+  {
+    return false;
+  }
+  itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+ImageType::Pointer
+MakeReference(const ImageType * image, bool breakStreaming = false)
+{
+  const auto pipeline = MakePipeline(image, breakStreaming);
+  GetOutput(pipeline)->Update();
+  return GetOutput(pipeline);
+}
+
+constexpr itk::SizeValueType imageBytes{ 24 * 24 * 24 * sizeof(float) };
+
+} // namespace
+
+
+TEST(PipelineStreamingPlanner, MeasuresHalosAndChoosesTiles)
+{
+  const auto image = MakeImage();
+  const auto pipeline = MakePipeline(image);
+
+  // A requested region set by the application on the pipeline.
+  const ImageType::RegionType requestedRegion({ 2, 3, 4 }, { 10, 11, 12 });
+  auto * const                intermediateOutput = static_cast<ImageType *>(pipeline[0]->GetOutputs()[0].GetPointer());
+  GetOutput(pipeline)->UpdateOutputInformation();
+  intermediateOutput->SetRequestedRegion(requestedRegion);
+
+  const auto planner = PlannerType::New();
+  planner->SetOutput(GetOutput(pipeline));
+  planner->SetMemoryBudget(imageBytes / 4);
+  planner->Plan();
+
+  // Planning leaves the requested regions of the pipeline unchanged.
+  EXPECT_EQ(intermediateOutput->GetRequestedRegion(), requestedRegion);
+  EXPECT_EQ(GetOutput(pipeline)->GetRequestedRegion(), GetOutput(pipeline)->GetLargestPossibleRegion());
+
+  ASSERT_EQ(planner->GetFilterReports().size(), 2u);
+  for (const auto & report : planner->GetFilterReports())
+  {
+    EXPECT_FALSE(report.BreaksStreaming);
+    EXPECT_EQ(report.LowerHalo, itk::MakeFilled<PlannerType::OffsetType>(1));
+    EXPECT_EQ(report.UpperHalo, itk::MakeFilled<PlannerType::OffsetType>(1));
+  }
+  EXPECT_TRUE(planner->GetStreamable());
+  EXPECT_EQ(planner->GetLowerHalo(), itk::MakeFilled<PlannerType::OffsetType>(2));
+  EXPECT_EQ(planner->GetUpperHalo(), itk::MakeFilled<PlannerType::OffsetType>(2));
+
+  EXPECT_LE(planner->GetTileBytes(), imageBytes / 4);
+  EXPECT_GT(planner->GetNumberOfTiles(), 1u);
+  EXPECT_EQ(planner->GetWholeImageBytes(), 0u);
+
+  planner->Update();
+  EXPECT_TRUE(HaveSamePixels(planner->GetStreamedOutput(), MakeReference(image)));
+}
+
+
+TEST(PipelineStreamingPlanner, UpdatesTilesInParallel)
+{
+  const auto image = MakeImage();
+  const auto pipeline = MakePipeline(image);
+
+  const auto planner = PlannerType::New();
+  planner->SetOutput(GetOutput(pipeline));
+  planner->SetMemoryBudget(imageBytes / 2);
+  planner->SetNumberOfParallelTiles(3);
+  planner->SetPipelineFactory([&image] { return MakePipeline(image); });
+  planner->Update();
+
+  EXPECT_GT(planner->GetNumberOfTiles(), 3u);
+  EXPECT_LE(planner->GetTileBytes(), imageBytes / 6);
+  EXPECT_TRUE(HaveSamePixels(planner->GetStreamedOutput(), MakeReference(image)));
+}
+
+
+TEST(PipelineStreamingPlanner, ReportsFiltersThatBreakStreaming)
+{
+  const auto image = MakeImage();
+  const auto pipeline = MakePipeline(image, true);
+
+  const auto planner = PlannerType::New();
+  planner->SetOutput(GetOutput(pipeline));
+  planner->SetMemoryBudget(imageBytes / 4);
+  planner->SetNumberOfParallelTiles(2);
+  planner->SetPipelineFactory([&image] { return MakePipeline(image, true); });
+  planner->Update();
+
+  const auto & reports = planner->GetFilterReports();
+  ASSERT_EQ(reports.size(), 3u);
+  EXPECT_FALSE(reports[0].BreaksStreaming);
+  EXPECT_TRUE(reports[1].BreaksStreaming);
+  EXPECT_NE(reports[1].Reason.find("largest possible region"), std::string::npos);
+  EXPECT_FALSE(reports[2].BreaksStreaming);
+  EXPECT_FALSE(planner->GetStreamable());
+
+  // The output of the first box sum is buffered as a whole.
+  EXPECT_EQ(planner->GetWholeImageBytes(), imageBytes);
+  EXPECT_GT(planner->GetNumberOfTiles(), 1u);
+
+  std::ostringstream report;
+  planner->PrintReport(report);
+  EXPECT_NE(report.str().find("WholeInputImageFilter"), std::string::npos);
+
+  EXPECT_TRUE(HaveSamePixels(planner->GetStreamedOutput(), MakeReference(image, true)));
+}
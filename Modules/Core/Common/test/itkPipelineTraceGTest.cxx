@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineTrace.h"
+#include "itkExtractImageFilter.h"
+#include "itkImage.h"
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+
+using ImageType = itk::Image<float, 2>;
+using FilterType = itk::ExtractImageFilter<ImageType, ImageType>;
+
+// Enables the trace for the duration of a test.
+class PipelineTraceFixture : public ::testing::Test
+{
+protected:
+  void
+  SetUp() override
+  {
+    itk::PipelineTrace::Clear();
+    itk::PipelineTrace::SetEnabled(true);
+  }
+
+  void
+  TearDown() override
+  {
+    itk::PipelineTrace::SetEnabled(false);
+    itk::PipelineTrace::Clear();
+  }
+};
+
+
+FilterType::Pointer
+MakeFilter()
+{
+  auto                          image = ImageType::New();
+  constexpr ImageType::SizeType size{ 64, 64 };
+  image->SetRegions(size);
+  image->Allocate();
+  image->FillBuffer(1.0f);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetExtractionRegion(ImageType::RegionType(ImageType::IndexType{ 8, 8 }, ImageType::SizeType{ 32, 32 }));
+  filter->SetNumberOfWorkUnits(4);
+  return filter;
+}
+
+
+unsigned int
+CountOccurrences(const std::string & text, const std::string & pattern)
+{
+  unsigned int count = 0;
+  for (auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+
+TEST(PipelineTrace, DisabledByDefault)
+{
+  EXPECT_FALSE(itk::PipelineTrace::GetEnabled());
+
+  const auto numberOfEvents = itk::PipelineTrace::GetNumberOfEvents();
+  MakeFilter()->Update();
+  itk::PipelineTrace::AddEvent("ignored", "test", 0.0, 1.0);
+  EXPECT_EQ(itk::PipelineTrace::GetNumberOfEvents(), numberOfEvents);
+}
+
+
+TEST_F(PipelineTraceFixture, RecordsFiltersAndWorkUnits)
+{
+  const auto allocatedBytes = itk::PipelineTrace::GetAllocatedBytes();
+
+  const auto filter = MakeFilter();
+  filter->Update();
+  EXPECT_GE(itk::PipelineTrace::GetAllocatedBytes() - allocatedBytes, 32u * 32u * sizeof(float));
+
+  // An up-to-date filter does not execute again, unless it is modified.
+  filter->Update();
+  filter->Modified();
+  filter->Update();
+
+  std::ostringstream stream;
+  itk::PipelineTrace::WriteChromeTrace(stream);
+  const std::string trace = stream.str();
+
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), 0u);
+  EXPECT_EQ(CountOccurrences(trace, "\"cat\":\"filter\""), 2u);
+  EXPECT_EQ(CountOccurrences(trace, "\"execution\":\"1\""), 1u);
+  EXPECT_EQ(CountOccurrences(trace, "\"execution\":\"2\""), 1u);
+  EXPECT_NE(trace.find("\"name\":\"ExtractImageFilter\""), std::string::npos);
+  EXPECT_NE(trace.find("\"process CPU time (ms)\":"), std::string::npos);
+  EXPECT_NE(trace.find("\"output Primary requested pixels\":\"1024\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"ExtractImageFilter work unit\""), std::string::npos);
+  EXPECT_GE(CountOccurrences(trace, "\"cat\":\"work unit\""), 2u);
+  EXPECT_EQ(itk::PipelineTrace::GetNumberOfEvents(), CountOccurrences(trace, "\"ph\":\"X\""));
+
+  itk::PipelineTrace::Clear();
+  EXPECT_EQ(itk::PipelineTrace::GetNumberOfEvents(), 0u);
+}
+
+
+TEST_F(PipelineTraceFixture, EscapesJSONStrings)
+{
+  itk::PipelineTrace::AddEvent("quote \" backslash \\", "test", 1.0, 2.0, { { "line", "a\nb" } });
+
+  std::ostringstream stream;
+  itk::PipelineTrace::WriteChromeTrace(stream);
+  EXPECT_NE(stream.str().find(R"("name":"quote \" backslash \\")"), std::string::npos);
+  EXPECT_NE(stream.str().find(R"("args":{"line":"a\nb"})"), std::string::npos);
+}
+
+
+TEST_F(PipelineTraceFixture, ForgetsExecutionsOfDestroyedObjects)
+{
+  int object = 0;
+  EXPECT_EQ(itk::PipelineTrace::AddExecution(&object), 1u);
+  EXPECT_EQ(itk::PipelineTrace::AddExecution(&object), 2u);
+  itk::PipelineTrace::RemoveExecutions(&object);
+  EXPECT_EQ(itk::PipelineTrace::AddExecution(&object), 1u);
+
+  // The executions of a filter are forgotten when it is destroyed, as another
+  // filter may be allocated at the same address.
+  auto filter = MakeFilter();
+  filter->Update();
+  const void * address = filter.GetPointer();
+  filter = nullptr;
+  EXPECT_EQ(itk::PipelineTrace::AddExecution(address), 1u);
+}
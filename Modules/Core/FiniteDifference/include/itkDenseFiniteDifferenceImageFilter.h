@@ -55,6 +55,13 @@ namespace itk
  * This is an image to image filter.  The specific types of the images are not
  * fixed at this level in the hierarchy.
  *
+ * \par Fused update
+ * When the time step of an iteration is known before its update is computed,
+ * as for a constant time step (see GetFixedTimeStep()), the update of each
+ * pixel may be computed and applied in a single pass, see
+ * SetUseFusedUpdate().  The update buffer then holds the next solution
+ * rather than the change, and is swapped with the output.
+ *
  * \par How to use this class
  * This filter is only one layer in a branch the finite difference solver
  * hierarchy.  It does not define the function used in the CalculateChange() and
@@ -102,6 +109,19 @@ public:
   /** The container type for the update buffer. */
   using UpdateBufferType = OutputImageType;
 
+  /** Set/Get whether each iteration computes the change of each pixel and
+   * applies it in a single pass over the image, when the time step is known
+   * beforehand.  Otherwise the change is stored in the update buffer by a
+   * first pass, and added to the output by a second one.  The output is the
+   * same.  Default is off, since the fused update bypasses
+   * ThreadedCalculateChange(), ApplyUpdate() and ThreadedApplyUpdate();
+   * subclasses that do not override them may turn it on. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseFusedUpdate, bool);
+  itkBooleanMacro(UseFusedUpdate);
+  itkGetConstMacro(UseFusedUpdate, bool);
+  /** @ITKEndGrouping */
+
   itkConceptMacro(OutputTimesDoubleCheck, (Concept::MultiplyOperator<PixelType, double>));
   itkConceptMacro(OutputAdditiveOperatorsCheck, (Concept::AdditiveOperators<PixelType>));
   itkConceptMacro(OutputAdditiveAndAssignOperatorsCheck, (Concept::AdditiveAndAssignOperators<PixelType>));
@@ -128,7 +148,7 @@ protected:
   ApplyUpdate(const TimeStepType & dt) override;
 
   /** Method to allow subclasses to get direct access to the update
-   * buffer */
+   * buffer.  With the fused update, it holds the next solution. */
   virtual UpdateBufferType *
   GetUpdateBuffer()
   {
@@ -163,6 +183,23 @@ protected:
   virtual TimeStepType
   ThreadedCalculateChange(const ThreadRegionType & regionToProcess, ThreadIdType threadId);
 
+  /** Computes the next solution over a region supplied by the multithreading
+   * mechanism into the update buffer.
+   * \sa SetUseFusedUpdate */
+  virtual void
+  ThreadedCalculateFusedUpdate(const TimeStepType &     dt,
+                               const ThreadRegionType & regionToProcess,
+                               ThreadIdType             threadId);
+
+  /** Returns true, and the time step of the next iteration, when it is known
+   * before the change is calculated, so that the update may be fused.  The
+   * default returns false. */
+  virtual bool
+  GetFixedTimeStep(TimeStepType & itkNotUsed(timeStep)) const
+  {
+    return false;
+  }
+
 private:
   /** Structure for passing information into static callback methods.  Used in
    * the subclasses' threading mechanisms. */
@@ -185,8 +222,24 @@ private:
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   CalculateChangeThreaderCallback(void * arg);
 
+  /** This callback method uses ImageSource::SplitRequestedRegion to acquire an
+   * output region that it passes to ThreadedCalculateFusedUpdate for
+   * processing. */
+  static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+  CalculateFusedUpdateThreaderCallback(void * arg);
+
   /** The buffer that holds the updates for an iteration of the algorithm. */
   typename UpdateBufferType::Pointer m_UpdateBuffer{};
+
+  bool m_UseFusedUpdate{ false };
+
+  /** Whether the last CalculateChange() computed the next solution into the
+   * update buffer, so that ApplyUpdate() only swaps it with the output. */
+  bool m_UpdateIsFused{ false };
+
+  /** Whether ApplyUpdate() swapped the pixel containers of the update buffer
+   * and the output. */
+  bool m_UpdateBufferSwapped{ false };
 };
 } // end namespace itk
 
@@ -66,6 +66,14 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::AllocateUpdateBuffe
   // The update buffer looks just like the output.
   const typename TOutputImage::Pointer output = this->GetOutput();
 
+  // The fused update swaps the pixel containers of the update buffer and the
+  // output, so the update buffer may then hold one shared with another image,
+  // as the input when running in place.
+  if (m_UpdateBufferSwapped)
+  {
+    m_UpdateBuffer->Initialize();
+    m_UpdateBufferSwapped = false;
+  }
   m_UpdateBuffer->SetOrigin(output->GetOrigin());
   m_UpdateBuffer->SetSpacing(output->GetSpacing());
   m_UpdateBuffer->SetDirection(output->GetDirection());
@@ -79,6 +87,18 @@ template <typename TInputImage, typename TOutputImage>
 void
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ApplyUpdate(const TimeStepType & dt)
 {
+  if (m_UpdateIsFused)
+  {
+    // The update buffer holds the next solution.
+    OutputImageType * const                               output = this->GetOutput();
+    const typename UpdateBufferType::PixelContainerPointer solution = m_UpdateBuffer->GetPixelContainer();
+    m_UpdateBuffer->SetPixelContainer(output->GetPixelContainer());
+    output->SetPixelContainer(solution);
+    m_UpdateBufferSwapped = true;
+    m_UpdateIsFused = false;
+    return;
+  }
+
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
@@ -124,6 +144,21 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::CalculateChange() -
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
+  // The fused update swaps the update buffer with the output, so it must
+  // cover all of it.
+  const OutputImageType * output = this->GetOutput();
+  if (m_UseFusedUpdate && this->GetFixedTimeStep(str.TimeStep) &&
+      output->GetBufferedRegion() == output->GetRequestedRegion())
+  {
+    str.Filter = this;
+    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    this->GetMultiThreader()->SetSingleMethodAndExecute(this->CalculateFusedUpdateThreaderCallback, &str);
+
+    m_UpdateIsFused = true;
+    this->m_UpdateBuffer->Modified();
+    return str.TimeStep;
+  }
+
   str.Filter = this;
   str.TimeStep = TimeStepType{}; // Not used during the
   // calculate change step.
@@ -181,6 +216,26 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::CalculateChangeThre
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+template <typename TInputImage, typename TOutputImage>
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::CalculateFusedUpdateThreaderCallback(void * arg)
+{
+  const ThreadIdType workUnitID = (static_cast<MultiThreaderBase::WorkUnitInfo *>(arg))->WorkUnitID;
+  const ThreadIdType workUnitCount = (static_cast<MultiThreaderBase::WorkUnitInfo *>(arg))->NumberOfWorkUnits;
+
+  auto * str = (DenseFDThreadStruct *)((static_cast<MultiThreaderBase::WorkUnitInfo *>(arg))->UserData);
+
+  ThreadRegionType   splitRegion;
+  const ThreadIdType total = str->Filter->SplitRequestedRegion(workUnitID, workUnitCount, splitRegion);
+
+  if (workUnitID < total)
+  {
+    str->Filter->ThreadedCalculateFusedUpdate(str->TimeStep, splitRegion, workUnitID);
+  }
+
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedApplyUpdate(
@@ -273,11 +328,44 @@ DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateCh
   return timeStep;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::ThreadedCalculateFusedUpdate(
+  const TimeStepType &     dt,
+  const ThreadRegionType & regionToProcess,
+  ThreadIdType)
+{
+  using NeighborhoodIteratorType = typename FiniteDifferenceFunctionType::NeighborhoodType;
+  using FaceCalculatorType = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<OutputImageType>;
+
+  const OutputImageType *                              output = this->GetOutput();
+  const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+  const typename OutputImageType::SizeType             radius = df->GetRadius();
+
+  void * globalData = df->GetGlobalDataPointer();
+
+  // Write the solution after the time step into the update buffer.
+  FaceCalculatorType faceCalculator;
+  for (const ThreadRegionType & face : faceCalculator(output, regionToProcess, radius))
+  {
+    NeighborhoodIteratorType              it(radius, output, face);
+    ImageRegionIterator<UpdateBufferType> nextIt(m_UpdateBuffer, face);
+    for (; !it.IsAtEnd(); ++it, ++nextIt)
+    {
+      nextIt.Value() = it.GetCenterPixel() + static_cast<PixelType>(df->ComputeUpdate(it, globalData) * dt);
+    }
+  }
+
+  df->ReleaseGlobalDataPointer(globalData);
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 DenseFiniteDifferenceImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfBooleanMacro(UseFusedUpdate);
 }
 } // end namespace itk
 
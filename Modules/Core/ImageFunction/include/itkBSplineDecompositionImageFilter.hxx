@@ -28,10 +28,13 @@
 #ifndef itkBSplineDecompositionImageFilter_hxx
 #define itkBSplineDecompositionImageFilter_hxx
 #include "itkImageAlgorithm.h"
-#include "itkProgressReporter.h"
+#include "itkIndexRange.h"
+#include "itkTotalProgressReporter.h"
 #include "itkVector.h"
 #include "itkPrintHelper.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -50,62 +53,11 @@ BSplineDecompositionImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostre
 
   Superclass::PrintSelf(os, indent);
 
-  os << indent << "Scratch: " << m_Scratch << std::endl;
   os << indent << "Data Length: " << m_DataLength << std::endl;
   os << indent << "Spline Order: " << m_SplineOrder << std::endl;
   os << indent << "SplinePoles: " << m_SplinePoles << std::endl;
   os << indent << "Number Of Poles: " << m_NumberOfPoles << std::endl;
   os << indent << "Tolerance: " << m_Tolerance << std::endl;
-  os << indent << "Iterator Direction: " << m_IteratorDirection << std::endl;
-}
-
-template <typename TInputImage, typename TOutputImage>
-bool
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficients1D()
-{
-  // See Unser, 1993, Part II, Equation 2.5,
-  // or Unser, 1999, Box 2. for an explanation.
-
-  double c0 = 1.0;
-
-  if (m_DataLength[m_IteratorDirection] == 1) // Required by mirror boundaries
-  {
-    return false;
-  }
-
-  // Compute over all gain
-  for (unsigned int k = 0; k < m_NumberOfPoles; ++k)
-  {
-    // Note for cubic splines lambda = 6
-    c0 = c0 * (1.0 - m_SplinePoles[k]) * (1.0 - 1.0 / m_SplinePoles[k]);
-  }
-
-  // Apply the gain
-  for (SizeValueType n = 0; n < m_DataLength[m_IteratorDirection]; ++n)
-  {
-    m_Scratch[n] *= c0;
-  }
-
-  // Loop over all poles
-  for (unsigned int k = 0; k < m_NumberOfPoles; ++k)
-  {
-    // Causal initialization
-    this->SetInitialCausalCoefficient(m_SplinePoles[k]);
-    // Causal recursion
-    for (SizeValueType n = 1; n < m_DataLength[m_IteratorDirection]; ++n)
-    {
-      m_Scratch[n] += m_SplinePoles[k] * m_Scratch[n - 1];
-    }
-
-    // anticausal initialization
-    this->SetInitialAntiCausalCoefficient(m_SplinePoles[k]);
-    // anticausal recursion
-    for (int n = m_DataLength[m_IteratorDirection] - 2; 0 <= n; n--)
-    {
-      m_Scratch[n] = m_SplinePoles[k] * (m_Scratch[n + 1] - m_Scratch[n]);
-    }
-  }
-  return true;
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -169,7 +121,9 @@ BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetPoles()
 
 template <typename TInputImage, typename TOutputImage>
 void
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialCausalCoefficient(double z)
+BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialCausalCoefficients(CoeffType *    batch,
+                                                                                         SizeValueType length,
+                                                                                         double        z) const
 {
   // See Unser, 1999, Box 2 for explanation
 
@@ -178,16 +132,27 @@ BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialCausalCoef
   if (m_Tolerance > 0.0)
   {
     if (const auto horizon = static_cast<SizeValueType>(std::ceil(std::log(m_Tolerance) / std::log(std::abs(z))));
-        horizon < m_DataLength[m_IteratorDirection])
+        horizon < length)
     {
       // Accelerated loop
-      CoeffType sum = m_Scratch[0]; // verify this
+      CoeffType sum[BatchSize];
+      for (unsigned int b = 0; b < BatchSize; ++b)
+      {
+        sum[b] = batch[b];
+      }
       for (SizeValueType n = 1; n < horizon; ++n)
       {
-        sum += zn * m_Scratch[n];
+        const CoeffType * const line = batch + n * BatchSize;
+        for (unsigned int b = 0; b < BatchSize; ++b)
+        {
+          sum[b] += zn * line[b];
+        }
         zn *= z;
       }
-      m_Scratch[0] = sum;
+      for (unsigned int b = 0; b < BatchSize; ++b)
+      {
+        batch[b] = sum[b];
+      }
 
       // Return early.
       return;
@@ -195,110 +160,204 @@ BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialCausalCoef
   }
 
   // Full loop
-  const double iz = 1.0 / z;
-  double       z2n = std::pow(z, static_cast<double>(m_DataLength[m_IteratorDirection] - 1));
-  CoeffType    sum = m_Scratch[0] + z2n * m_Scratch[m_DataLength[m_IteratorDirection] - 1];
+  const double      iz = 1.0 / z;
+  double            z2n = std::pow(z, static_cast<double>(length - 1));
+  const CoeffType * last = batch + (length - 1) * BatchSize;
+  CoeffType         sum[BatchSize];
+  for (unsigned int b = 0; b < BatchSize; ++b)
+  {
+    sum[b] = batch[b] + z2n * last[b];
+  }
   z2n *= z2n * iz;
-  for (SizeValueType n = 1; n <= (m_DataLength[m_IteratorDirection] - 2); ++n)
+  for (SizeValueType n = 1; n <= (length - 2); ++n)
   {
-    sum += (zn + z2n) * m_Scratch[n];
+    const CoeffType * const line = batch + n * BatchSize;
+    for (unsigned int b = 0; b < BatchSize; ++b)
+    {
+      sum[b] += (zn + z2n) * line[b];
+    }
     zn *= z;
     z2n *= iz;
   }
-  m_Scratch[0] = sum / (1.0 - zn * zn);
+  for (unsigned int b = 0; b < BatchSize; ++b)
+  {
+    batch[b] = sum[b] / (1.0 - zn * zn);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialAntiCausalCoefficient(double z)
+BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialAntiCausalCoefficients(CoeffType *    batch,
+                                                                                             SizeValueType length,
+                                                                                             double        z) const
 {
   // This initialization corresponds to mirror boundaries.
   // See Unser, 1999, Box 2 for explanation.
   // Also see erratum at http://bigwww.epfl.ch/publications/unser9902.html
-  m_Scratch[m_DataLength[m_IteratorDirection] - 1] =
-    (z / (z * z - 1.0)) *
-    (z * m_Scratch[m_DataLength[m_IteratorDirection] - 2] + m_Scratch[m_DataLength[m_IteratorDirection] - 1]);
+  const CoeffType * const previous = batch + (length - 2) * BatchSize;
+  CoeffType * const       last = batch + (length - 1) * BatchSize;
+  for (unsigned int b = 0; b < BatchSize; ++b)
+  {
+    last[b] = (z / (z * z - 1.0)) * (z * previous[b] + last[b]);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficientsND()
+BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficientsBatch(CoeffType *   batch,
+                                                                                    SizeValueType length) const
 {
-  const OutputImagePointer output = this->GetOutput();
-
-  Size<ImageDimension> size = output->GetBufferedRegion().GetSize();
+  // See Unser, 1993, Part II, Equation 2.5,
+  // or Unser, 1999, Box 2. for an explanation.
 
-  const unsigned int count = output->GetBufferedRegion().GetNumberOfPixels() / size[0] * ImageDimension;
+  double c0 = 1.0;
 
-  ProgressReporter progress(this, 0, count, 10);
+  // Compute over all gain
+  for (unsigned int k = 0; k < m_NumberOfPoles; ++k)
+  {
+    // Note for cubic splines lambda = 6
+    c0 = c0 * (1.0 - m_SplinePoles[k]) * (1.0 - 1.0 / m_SplinePoles[k]);
+  }
 
-  // Initialize coefficient array
-  this->CopyImageToImage(); // Coefficients are initialized to the input data
+  // Apply the gain
+  for (SizeValueType i = 0; i < length * BatchSize; ++i)
+  {
+    batch[i] *= c0;
+  }
 
-  // Loop through each dimension
-  for (unsigned int n = 0; n < ImageDimension; ++n)
+  // Loop over all poles
+  for (unsigned int k = 0; k < m_NumberOfPoles; ++k)
   {
-    m_IteratorDirection = n;
+    const double z = m_SplinePoles[k];
 
-    // Initialize iterators
-    OutputLinearIterator CIterator(output, output->GetBufferedRegion());
-    CIterator.SetDirection(m_IteratorDirection);
-    // For each data vector
-    while (!CIterator.IsAtEnd())
+    // Causal initialization
+    this->SetInitialCausalCoefficients(batch, length, z);
+    // Causal recursion
+    for (SizeValueType n = 1; n < length; ++n)
     {
-      // Copy coefficients to scratch
-      this->CopyCoefficientsToScratch(CIterator);
-
-      // Perform 1D BSpline calculations
-      this->DataToCoefficients1D();
-
-      // Copy scratch back to coefficients.
-      // Brings us back to the end of the line we were working on.
-      CIterator.GoToBeginOfLine();
-      this->CopyScratchToCoefficients(CIterator); // m_Scratch = m_Image;
-      CIterator.NextLine();
-      progress.CompletedPixel();
+      const CoeffType * const previous = batch + (n - 1) * BatchSize;
+      CoeffType * const       line = batch + n * BatchSize;
+      for (unsigned int b = 0; b < BatchSize; ++b)
+      {
+        line[b] += z * previous[b];
+      }
+    }
+
+    // anticausal initialization
+    this->SetInitialAntiCausalCoefficients(batch, length, z);
+    // anticausal recursion
+    for (SizeValueType n = length - 1; n-- > 0;)
+    {
+      const CoeffType * const next = batch + (n + 1) * BatchSize;
+      CoeffType * const       line = batch + n * BatchSize;
+      for (unsigned int b = 0; b < BatchSize; ++b)
+      {
+        line[b] = z * (next[b] - line[b]);
+      }
     }
   }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyImageToImage()
+BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficientsLines(
+  unsigned int             direction,
+  const OutputRegionType & lineStartRegion)
 {
-  const TInputImage * const inputImage = this->GetInput();
-  TOutputImage * const      outputImage = this->GetOutput();
-  ImageAlgorithm::Copy(inputImage, outputImage, inputImage->GetBufferedRegion(), outputImage->GetBufferedRegion());
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  TOutputImage * const output = this->GetOutput();
+  OutputPixelType *    buffer = output->GetBufferPointer();
+
+  const SizeValueType   length = output->GetBufferedRegion().GetSize(direction);
+  const OffsetValueType stride = output->GetOffsetTable()[direction];
+
+  TotalProgressReporter progress(this, output->GetBufferedRegion().GetNumberOfPixels() / length * ImageDimension);
+
+  // The lines are gathered into batch, the samples of each line at a
+  // stride of BatchSize.  The lanes of an incomplete batch stay zero.
+  CoefficientsVectorType batch(length * BatchSize);
+  OffsetValueType        lineOffsets[BatchSize];
+  unsigned int           numberOfLines = 0;
+
+  const auto filterBatch = [&] {
+    for (unsigned int b = 0; b < numberOfLines; ++b)
+    {
+      const OutputPixelType * line = buffer + lineOffsets[b];
+      for (SizeValueType n = 0; n < length; ++n, line += stride)
+      {
+        batch[n * BatchSize + b] = static_cast<CoeffType>(*line);
+      }
+    }
+    this->DataToCoefficientsBatch(batch.data(), length);
+    for (unsigned int b = 0; b < numberOfLines; ++b)
+    {
+      OutputPixelType * line = buffer + lineOffsets[b];
+      for (SizeValueType n = 0; n < length; ++n, line += stride)
+      {
+        *line = static_cast<OutputPixelType>(batch[n * BatchSize + b]);
+      }
+    }
+    progress.Completed(numberOfLines);
+    numberOfLines = 0;
+  };
+
+  for (const auto & index : ImageRegionIndexRange<ImageDimension>(lineStartRegion))
+  {
+    lineOffsets[numberOfLines++] = output->ComputeOffset(index);
+    if (numberOfLines == BatchSize)
+    {
+      filterBatch();
+    }
+  }
+  if (numberOfLines > 0)
+  {
+    std::fill(batch.begin(), batch.end(), CoeffType{});
+    filterBatch();
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyScratchToCoefficients(OutputLinearIterator & Iter)
+BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficientsND()
 {
-  using OutputPixelType = typename TOutputImage::PixelType;
-  typename TOutputImage::SizeValueType j = 0;
-  while (!Iter.IsAtEndOfLine())
+  TOutputImage * const   output = this->GetOutput();
+  const OutputRegionType region = output->GetBufferedRegion();
+
+  // Initialize coefficient array
+  this->CopyImageToImage(); // Coefficients are initialized to the input data
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // Loop through each dimension
+  for (unsigned int n = 0; n < ImageDimension; ++n)
   {
-    Iter.Set(static_cast<OutputPixelType>(m_Scratch[j]));
-    ++Iter;
-    ++j;
+    OutputRegionType lineStartRegion = region;
+    lineStartRegion.SetSize(n, 1);
+
+    if (region.GetSize(n) == 1 || m_NumberOfPoles == 0) // Required by mirror boundaries
+    {
+      TotalProgressReporter progress(this, region.GetNumberOfPixels() / region.GetSize(n) * ImageDimension);
+      progress.Completed(lineStartRegion.GetNumberOfPixels());
+      continue;
+    }
+
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      lineStartRegion,
+      [this, n](const OutputRegionType & lineStartRegionForThread) {
+        this->DataToCoefficientsLines(n, lineStartRegionForThread);
+      },
+      nullptr);
   }
 }
 
-/**
- */
 template <typename TInputImage, typename TOutputImage>
 void
-BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyCoefficientsToScratch(OutputLinearIterator & Iter)
+BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyImageToImage()
 {
-  typename TOutputImage::SizeValueType j = 0;
-
-  while (!Iter.IsAtEndOfLine())
-  {
-    m_Scratch[j] = static_cast<CoeffType>(Iter.Get());
-    ++Iter;
-    ++j;
-  }
+  const TInputImage * const inputImage = this->GetInput();
+  TOutputImage * const      outputImage = this->GetOutput();
+  ImageAlgorithm::Copy(inputImage, outputImage, inputImage->GetBufferedRegion(), outputImage->GetBufferedRegion());
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -330,21 +389,10 @@ template <typename TInputImage, typename TOutputImage>
 void
 BSplineDecompositionImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
-  // Allocate scratch memory
   const InputImageConstPointer inputPtr = this->GetInput();
 
   m_DataLength = inputPtr->GetBufferedRegion().GetSize();
 
-  typename TOutputImage::SizeValueType maxLength = 0;
-  for (unsigned int n = 0; n < ImageDimension; ++n)
-  {
-    if (m_DataLength[n] > maxLength)
-    {
-      maxLength = m_DataLength[n];
-    }
-  }
-  m_Scratch.resize(maxLength);
-
   // Allocate memory for output image
   const OutputImagePointer outputPtr = this->GetOutput();
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
@@ -352,9 +400,6 @@ BSplineDecompositionImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   // Calculate actual output
   this->DataToCoefficientsND();
-
-  // Clean up
-  m_Scratch.clear();
 }
 } // namespace itk
 
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBSplineDecompositionImageFilter.h"
+#include "itkImage.h"
+#include "itkIndexRange.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+
+using InputImageType = itk::Image<short, Dimension>;
+
+// A region that does not start at the origin, with lines that are not a
+// multiple of the batch size, and a dimension of a single pixel.
+const InputImageType::RegionType Region{ { { 3, -2, 1 } }, { { 13, 11, 1 } } };
+
+InputImageType::Pointer
+MakeInputImage()
+{
+  auto image = InputImageType::New();
+  image->SetRegions(Region);
+  image->Allocate();
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(Region))
+  {
+    image->SetPixel(index, static_cast<short>((index[0] * 37 + index[1] * 11 + index[2] * 5) % 23 - 9));
+  }
+  return image;
+}
+
+// The prefilter of a single line, with mirror boundaries and a full causal
+// initialization, as in Unser, 1999, Box 2.
+void
+FilterLine(std::vector<double> & c, const std::vector<double> & poles)
+{
+  const size_t length = c.size();
+  if (length == 1)
+  {
+    return;
+  }
+  double gain = 1.0;
+  for (const double z : poles)
+  {
+    gain *= (1.0 - z) * (1.0 - 1.0 / z);
+  }
+  for (double & value : c)
+  {
+    value *= gain;
+  }
+  for (const double z : poles)
+  {
+    double sum = 0.0;
+    for (size_t n = 0; n < length; ++n)
+    {
+      sum += std::pow(z, static_cast<double>(n)) * c[n];
+    }
+    for (size_t n = length - 2; n > 0; --n)
+    {
+      sum += std::pow(z, static_cast<double>(2 * (length - 1) - n)) * c[n];
+    }
+    c[0] = sum / (1.0 - std::pow(z, static_cast<double>(2 * (length - 1))));
+    for (size_t n = 1; n < length; ++n)
+    {
+      c[n] += z * c[n - 1];
+    }
+    c[length - 1] = (z / (z * z - 1.0)) * (z * c[length - 2] + c[length - 1]);
+    for (size_t n = length - 1; n-- > 0;)
+    {
+      c[n] = z * (c[n + 1] - c[n]);
+    }
+  }
+}
+
+template <typename TOutputImage>
+void
+ExpectCoefficientsOfReference(unsigned int splineOrder, double tolerance)
+{
+  auto filter = itk::BSplineDecompositionImageFilter<InputImageType, TOutputImage>::New();
+  filter->SetInput(MakeInputImage());
+  filter->SetSplineOrder(splineOrder);
+  filter->Update();
+  const TOutputImage * output = filter->GetOutput();
+  ASSERT_EQ(output->GetBufferedRegion(), Region);
+
+  const auto          splinePoles = filter->GetSplinePoles();
+  std::vector<double> poles(splinePoles.begin(), splinePoles.end());
+  poles.resize(filter->GetNumberOfPoles());
+
+  // Apply the reference prefilter to the lines along each dimension.
+  std::vector<double> expected(Region.GetNumberOfPixels());
+  const auto          input = MakeInputImage();
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(Region))
+  {
+    expected[input->ComputeOffset(index)] = input->GetPixel(index);
+  }
+  for (unsigned int direction = 0; direction < Dimension; ++direction)
+  {
+    auto lineStarts = Region;
+    lineStarts.SetSize(direction, 1);
+    const auto stride = input->GetOffsetTable()[direction];
+    for (const auto & index : itk::ImageRegionIndexRange<Dimension>(lineStarts))
+    {
+      std::vector<double> line(Region.GetSize(direction));
+      for (size_t n = 0; n < line.size(); ++n)
+      {
+        line[n] = expected[input->ComputeOffset(index) + n * stride];
+      }
+      FilterLine(line, poles);
+      for (size_t n = 0; n < line.size(); ++n)
+      {
+        expected[input->ComputeOffset(index) + n * stride] = line[n];
+      }
+    }
+  }
+
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(Region))
+  {
+    ASSERT_NEAR(output->GetPixel(index), expected[input->ComputeOffset(index)], tolerance)
+      << "order " << splineOrder << " at " << index;
+  }
+}
+
+} // namespace
+
+
+TEST(BSplineDecompositionImageFilter, MatchesLinePrefilter)
+{
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    ExpectCoefficientsOfReference<itk::Image<double, Dimension>>(splineOrder, 1e-8);
+  }
+}
+
+
+TEST(BSplineDecompositionImageFilter, MatchesLinePrefilterWithFloatCoefficients)
+{
+  for (unsigned int splineOrder = 2; splineOrder <= 5; ++splineOrder)
+  {
+    ExpectCoefficientsOfReference<itk::Image<float, Dimension>>(splineOrder, 1e-3);
+  }
+}
@@ -20,6 +20,8 @@
 
 #include "itkMacro.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -84,15 +86,31 @@ TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
   outPoints->Squeeze(); // in case the previous mesh had
                         // allocated a larger memory
 
+  // The points are transformed in blocks, through contiguous buffers, as the
+  // points containers need not be contiguous.
+  constexpr SizeValueType                              blockSize = 1024;
+  std::vector<typename TransformType::InputPointType>  blockInputPoints;
+  std::vector<typename TransformType::OutputPointType> blockOutputPoints(blockSize);
+  blockInputPoints.reserve(blockSize);
+
   typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
   typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
 
   while (inputPoint != inPoints->End())
   {
-    outputPoint.Value() = m_Transform->TransformPoint(inputPoint.Value());
-
-    ++inputPoint;
-    ++outputPoint;
+    blockInputPoints.clear();
+    for (; inputPoint != inPoints->End() && blockInputPoints.size() < blockSize; ++inputPoint)
+    {
+      blockInputPoints.push_back(inputPoint.Value());
+    }
+
+    m_Transform->TransformPoints(blockInputPoints.data(), blockOutputPoints.data(), blockInputPoints.size());
+
+    for (SizeValueType n = 0; n < blockInputPoints.size(); ++n)
+    {
+      outputPoint.Value() = blockOutputPoints[n];
+      ++outputPoint;
+    }
   }
 
   // Create duplicate references to the rest of data on the mesh
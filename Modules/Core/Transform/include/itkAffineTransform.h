@@ -113,6 +113,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(AffineTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** New macro for creation of through a Smart Pointer   */
   itkNewMacro(Self);
 
@@ -239,6 +239,20 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
   /** @ITKEndGrouping */
+
+  /** Transform a contiguous array of points.  The linear offsets of the
+   * support region coefficients, in the order of the interpolation weights,
+   * are computed once for the batch so that each point only evaluates its
+   * weights and a flat weighted sum over the coefficient buffers.  The
+   * weights of each dimension are cached from one point to the next, and
+   * only computed again along the dimensions where the continuous index of
+   * the point changes, e.g. only the first one along the scanlines of an
+   * image aligned with the coefficient grid. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
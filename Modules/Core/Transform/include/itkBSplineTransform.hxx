@@ -19,10 +19,13 @@
 #define itkBSplineTransform_hxx
 
 
+#include "itkBSplineKernelFunction.h"
 #include "itkContinuousIndex.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 
@@ -592,6 +595,126 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  // A subclass may override TransformPoint, and is then applied point by point.
+  // So is a weights function overriding Evaluate, which the cache bypasses.
+  const ImageType * coefficientImage = this->m_CoefficientImages[0];
+  if (typeid(*this) != typeid(Self) || typeid(*this->m_WeightsFunction) != typeid(WeightsFunctionType) ||
+      !coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  // Linear offsets of the support region coefficients relative to the first
+  // one, in the order of the interpolation weights.
+  const OffsetValueType *                            offsetTable = coefficientImage->GetOffsetTable();
+  FixedArray<OffsetValueType, Self::NumberOfWeights> supportOffsets;
+  for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+  {
+    unsigned int    remainder = k;
+    OffsetValueType offset = 0;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      offset += static_cast<OffsetValueType>(remainder % (SplineOrder + 1)) * offsetTable[d];
+      remainder /= SplineOrder + 1;
+    }
+    supportOffsets[k] = offset;
+  }
+
+  const ParametersValueType * coefficients[SpaceDimension];
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  using ContinuousIndexValueType = typename ContinuousIndexType::ValueType;
+
+  // The weights are the products of the weights of each dimension, the first
+  // dimension varying fastest.  The weights cache holds those of each
+  // dimension for the last continuous index seen along it, so that points
+  // along a scanline of a grid aligned with the coefficient grid only
+  // evaluate the kernel along the first dimension.  The products are taken
+  // in the order of BSplineInterpolationWeightFunction, so that the points
+  // are the same as with TransformPoint.
+  constexpr unsigned int SupportLength = SplineOrder + 1;
+
+  ContinuousIndexValueType cachedIndex[SpaceDimension];
+  double                   weights1D[SpaceDimension][SupportLength];
+  bool                     cacheIsValid = false;
+
+  IndexType supportIndex;
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    // Copy the input point first, as the arrays may be the same.
+    const InputPointType point = inputPoints[n];
+
+    ContinuousIndexType index =
+      coefficientImage->template TransformPhysicalPointToContinuousIndex<ContinuousIndexValueType>(point);
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[n] = point;
+      continue;
+    }
+
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      if (cacheIsValid && index[d] == cachedIndex[d])
+      {
+        continue;
+      }
+      // As in BSplineInterpolationWeightFunction::Evaluate.
+      cachedIndex[d] = index[d];
+      supportIndex[d] = Math::Floor<IndexValueType>(index[d] + 0.5 - SplineOrder / 2.0);
+      double x = index[d] - static_cast<double>(supportIndex[d]);
+      for (unsigned int k = 0; k < SupportLength; ++k)
+      {
+        weights1D[d][k] = BSplineKernelFunction<SplineOrder>::FastEvaluate(x);
+        x -= 1.0;
+      }
+    }
+    cacheIsValid = true;
+
+    const OffsetValueType supportStart = coefficientImage->ComputeOffset(supportIndex);
+
+    ScalarType displacement[SpaceDimension];
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      displacement[j] = ScalarType{};
+    }
+    for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+    {
+      unsigned int remainder = k;
+      double       product = 1.0;
+      for (unsigned int d = 0; d < SpaceDimension; ++d)
+      {
+        product *= weights1D[d][remainder % SupportLength];
+        remainder /= SupportLength;
+      }
+      const auto            weight = static_cast<typename WeightsType::ValueType>(product);
+      const OffsetValueType offset = supportStart + supportOffsets[k];
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        displacement[j] += static_cast<ScalarType>(weight * coefficients[j][offset]);
+      }
+    }
+
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoints[n][j] = displacement[j] + point[j];
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
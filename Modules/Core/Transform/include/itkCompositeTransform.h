@@ -271,6 +271,13 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform a contiguous array of points.  Each transform of the queue is
+   * applied to the whole batch in turn, in the same order as TransformPoint. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
@@ -399,6 +406,29 @@ public:
   virtual void
   FlattenTransformQueue();
 
+  /**
+   * Return a new composite transform that maps points as this one does, but
+   * is cheaper to evaluate, e.g. for resampling.  Nested composite transforms
+   * are expanded, and each run of two or more adjacent transforms of the
+   * queue for which IsMergeableLinearTransform() is true is merged into a
+   * single AffineTransform.  The other transforms are shared with this one,
+   * not copied; the merged transforms do not follow later changes to the
+   * transforms they were made from.
+   */
+  Pointer
+  GetMergedLinearTransform() const;
+
+  /**
+   * Whether transform is an affine map that GetMergedLinearTransform() may
+   * merge with others.  Its category must be Linear, and a
+   * MatrixOffsetTransformBase must map the points by its matrix and offset,
+   * see MatrixOffsetTransformBase::TransformPointIsMatrixAndOffset(), since
+   * IsLinear() is true for all of its subclasses, including those that
+   * override TransformPoint.
+   */
+  static bool
+  IsMergeableLinearTransform(const TransformType * transform);
+
   /**
    * Compute the Jacobian with respect to the parameters for the composite
    * transform using Jacobian rule. See comments in the implementation.
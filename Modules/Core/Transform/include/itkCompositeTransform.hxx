@@ -18,6 +18,10 @@
 #ifndef itkCompositeTransform_hxx
 #define itkCompositeTransform_hxx
 
+#include "itkAffineTransform.h"
+
+#include <algorithm>
+#include <typeinfo>
 
 namespace itk
 {
@@ -70,6 +74,32 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                      OutputPointType *      outputPoints,
+                                                                      SizeValueType          numberOfPoints) const
+{
+  // A subclass may override TransformPoint, and is then applied point by point.
+  if (typeid(*this) != typeid(Self))
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  if (inputPoints != outputPoints)
+  {
+    std::copy_n(inputPoints, numberOfPoints, outputPoints);
+  }
+
+  /* Apply in reverse queue order, in place.  */
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(outputPoints, outputPoints, numberOfPoints);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
@@ -941,6 +971,120 @@ CompositeTransform<TParametersValueType, VDimension>::FlattenTransformQueue()
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransform<TParametersValueType, VDimension>::GetMergedLinearTransform() const -> Pointer
+{
+  using MatrixOffsetTransformType = MatrixOffsetTransformBase<TParametersValueType, VDimension, VDimension>;
+  using AffineTransformType = AffineTransform<TParametersValueType, VDimension>;
+  using LinearMatrixType = typename AffineTransformType::MatrixType;
+
+  // Expand the nested composite transforms.
+  TransformQueueType transformQueue;
+  for (const auto & transform : this->m_TransformQueue)
+  {
+    const auto * nestedCompositeTransform = dynamic_cast<const Self *>(transform.GetPointer());
+    if (nestedCompositeTransform)
+    {
+      const Pointer nestedMergedTransform = nestedCompositeTransform->GetMergedLinearTransform();
+      for (SizeValueType n = 0; n < nestedMergedTransform->GetNumberOfTransforms(); ++n)
+      {
+        transformQueue.push_back(nestedMergedTransform->GetNthTransformModifiablePointer(n));
+      }
+    }
+    else
+    {
+      transformQueue.push_back(transform);
+    }
+  }
+
+  auto mergedTransform = Self::New();
+
+  SizeValueType begin = 0;
+  while (begin < transformQueue.size())
+  {
+    SizeValueType end = begin;
+    while (end < transformQueue.size() && Self::IsMergeableLinearTransform(transformQueue[end]))
+    {
+      ++end;
+    }
+
+    if (end - begin < 2)
+    {
+      // Nothing to merge.
+      mergedTransform->AddTransform(transformQueue[begin]);
+      begin = std::max(begin + 1, end);
+      continue;
+    }
+
+    // The transforms of the run are applied from the back, so the merged
+    // transform is x -> M_begin * (... * (M_last * x + o_last) ...) + o_begin.
+    LinearMatrixType matrix;
+    matrix.SetIdentity();
+    OutputVectorType offset{};
+    for (SizeValueType m = begin; m < end; ++m)
+    {
+      LinearMatrixType transformMatrix;
+      OutputVectorType transformOffset;
+
+      const TransformType * transform = transformQueue[m];
+      if (const auto * matrixOffsetTransform = dynamic_cast<const MatrixOffsetTransformType *>(transform))
+      {
+        transformMatrix = matrixOffsetTransform->GetMatrix();
+        transformOffset = matrixOffsetTransform->GetOffset();
+      }
+      else
+      {
+        // Recover the affine map of any other linear transform from the
+        // images of the origin and of the unit vectors.
+        const OutputPointType origin = transform->TransformPoint(InputPointType{});
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          InputPointType unitPoint{};
+          unitPoint[j] = 1;
+          const OutputPointType image = transform->TransformPoint(unitPoint);
+          for (unsigned int i = 0; i < VDimension; ++i)
+          {
+            transformMatrix[i][j] = image[i] - origin[i];
+          }
+        }
+        transformOffset = origin.GetVectorFromOrigin();
+      }
+
+      offset += matrix * transformOffset;
+      matrix = matrix * transformMatrix;
+    }
+
+    auto affineTransform = AffineTransformType::New();
+    affineTransform->SetMatrix(matrix);
+    affineTransform->SetOffset(offset);
+    mergedTransform->AddTransform(affineTransform);
+
+    begin = end;
+  }
+
+  return mergedTransform;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+bool
+CompositeTransform<TParametersValueType, VDimension>::IsMergeableLinearTransform(const TransformType * transform)
+{
+  using MatrixOffsetTransformType = MatrixOffsetTransformBase<TParametersValueType, VDimension, VDimension>;
+
+  if (transform->GetTransformCategory() != TransformType::TransformCategoryEnum::Linear)
+  {
+    return false;
+  }
+  if (const auto * matrixOffsetTransform = dynamic_cast<const MatrixOffsetTransformType *>(transform))
+  {
+    return matrixOffsetTransform->TransformPointIsMatrixAndOffset();
+  }
+  return true;
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 void
 CompositeTransform<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
@@ -55,6 +55,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(Euler2DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** Dimension of parameters. */
   static constexpr unsigned int SpaceDimension = 2;
   static constexpr unsigned int ParametersDimension = 3;
@@ -62,6 +62,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(Euler3DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** Dimension of the space. */
   static constexpr unsigned int SpaceDimension = 3;
   static constexpr unsigned int InputSpaceDimension = 3;
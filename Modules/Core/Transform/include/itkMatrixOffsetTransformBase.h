@@ -24,6 +24,16 @@
 #include "itkTransform.h"
 
 #include <iostream>
+#include <typeinfo>
+
+/** Overrides MatrixOffsetTransformBase::TransformPointIsMatrixAndOffset() in
+ * a subclass that does not override TransformPoint. */
+#define itkTransformPointIsMatrixAndOffsetMacro()       \
+  bool TransformPointIsMatrixAndOffset() const override \
+  {                                                     \
+    return typeid(*this) == typeid(Self);               \
+  }                                                     \
+  ITK_MACROEND_NOOP_STATEMENT
 
 namespace itk
 {
@@ -390,6 +400,15 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Transform a contiguous array of points by the affine transformation.
+   * The matrix and offset are read once for the whole batch.  The points are
+   * transformed one at a time by TransformPoint instead, unless
+   * TransformPointIsMatrixAndOffset(). */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   using Superclass::TransformVector;
 
   OutputVectorType
@@ -489,6 +508,19 @@ public:
     return true;
   }
 
+  /** Whether TransformPoint maps the points by the matrix and offset, so that
+   * TransformPoints may do so for the whole batch, and
+   * CompositeTransform::GetMergedLinearTransform() may merge the transform.
+   * As a subclass may override TransformPoint, this is only true when the
+   * dynamic type of the transform is the class itself.  The affine
+   * subclasses that do not override TransformPoint opt in with
+   * itkTransformPointIsMatrixAndOffsetMacro(). */
+  virtual bool
+  TransformPointIsMatrixAndOffset() const
+  {
+    return typeid(*this) == typeid(Self);
+  }
+
 protected:
   /** Deprecated: Use GetInverse for public API instead.
    * Method will eventually be made a protected member function */
@@ -128,6 +128,49 @@ MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimensio
 }
 
 
+template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
+void
+MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  if (!this->TransformPointIsMatrixAndOffset())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  // Copy the matrix and offset to local arrays so that they stay in
+  // registers across the loop, which the compiler can then vectorize.
+  TParametersValueType matrix[VOutputDimension][VInputDimension];
+  TParametersValueType offset[VOutputDimension];
+  for (unsigned int i = 0; i < VOutputDimension; ++i)
+  {
+    for (unsigned int j = 0; j < VInputDimension; ++j)
+    {
+      matrix[i][j] = m_Matrix[i][j];
+    }
+    offset[i] = m_Offset[i];
+  }
+
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    // Copy the input point first, as the arrays may be the same.
+    const InputPointType point = inputPoints[n];
+    for (unsigned int i = 0; i < VOutputDimension; ++i)
+    {
+      TParametersValueType sum{};
+      for (unsigned int j = 0; j < VInputDimension; ++j)
+      {
+        sum += matrix[i][j] * point[j];
+      }
+      outputPoints[n][i] = sum + offset[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VInputDimension, unsigned int VOutputDimension>
 auto
 MatrixOffsetTransformBase<TParametersValueType, VInputDimension, VOutputDimension>::TransformVector(
@@ -67,6 +67,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(Rigid2DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** New macro for creation of through a Smart Pointer */
   itkNewMacro(Self);
 
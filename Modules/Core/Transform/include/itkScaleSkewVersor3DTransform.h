@@ -68,6 +68,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(ScaleSkewVersor3DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** Dimension of parameters. */
   static constexpr unsigned int InputSpaceDimension = 3;
   static constexpr unsigned int OutputSpaceDimension = 3;
@@ -76,6 +76,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(Similarity2DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** Dimension of parameters. */
   static constexpr unsigned int SpaceDimension = 2;
   static constexpr unsigned int InputSpaceDimension = 2;
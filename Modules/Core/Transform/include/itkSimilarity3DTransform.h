@@ -61,6 +61,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(Similarity3DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** Dimension of parameters. */
   static constexpr unsigned int SpaceDimension = 3;
   static constexpr unsigned int InputSpaceDimension = 3;
@@ -180,6 +180,19 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform a contiguous array of points.
+   * outputPoints[i] is set to TransformPoint(inputPoints[i]) for each of the
+   * numberOfPoints points.  When the input and output point types are the
+   * same, inputPoints and outputPoints may point to the same array.  The
+   * default implementation calls TransformPoint for each point; transforms
+   * override it to amortize the virtual call and per-point setup over the
+   * whole batch.
+   * \warning This method must be thread-safe. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
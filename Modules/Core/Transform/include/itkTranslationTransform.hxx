@@ -20,6 +20,8 @@
 
 #include "itkMath.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 
@@ -125,6 +127,30 @@ TranslationTransform<TParametersValueType, VDimension>::TransformPoint(const Inp
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+TranslationTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                        OutputPointType *      outputPoints,
+                                                                        SizeValueType          numberOfPoints) const
+{
+  // A subclass may override TransformPoint, and is then applied point by point.
+  if (typeid(*this) != typeid(Self))
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  const OutputVectorType offset = m_Offset;
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      outputPoints[n][i] = inputPoints[n][i] + offset[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 TranslationTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & vect) const
@@ -60,6 +60,8 @@ public:
   /** \see LightObject::GetNameOfClass() */
   itkOverrideGetNameOfClassMacro(VersorRigid3DTransform);
 
+  itkTransformPointIsMatrixAndOffsetMacro();
+
   /** Dimension of parameters. */
   static constexpr unsigned int SpaceDimension = 3;
   static constexpr unsigned int InputSpaceDimension = 3;
@@ -0,0 +1,313 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkAffineTransform.h"
+#include "itkAzimuthElevationToCartesianTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkEuler3DTransform.h"
+#include "itkSimilarity3DTransform.h"
+#include "itkTranslationTransform.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+
+namespace
+{
+
+constexpr unsigned int Dimension{ 3 };
+
+using ScalarType = double;
+using TransformType = itk::Transform<ScalarType, Dimension, Dimension>;
+using PointType = TransformType::InputPointType;
+
+
+std::vector<PointType>
+MakePoints()
+{
+  std::vector<PointType> points;
+  for (unsigned int n = 0; n < 200; ++n)
+  {
+    PointType point;
+    point[0] = -1.0 + 0.013 * n;
+    point[1] = 2.5 - 0.007 * ((n * 31) % 200);
+    point[2] = 0.5 * std::sin(0.1 * n);
+    points.push_back(point);
+  }
+  return points;
+}
+
+
+// Checks that TransformPoints gives the same points as TransformPoint, both
+// into a separate output array and in place.
+void
+Expect_TransformPoints_equals_TransformPoint(const TransformType & transform)
+{
+  const std::vector<PointType> inputPoints = MakePoints();
+
+  std::vector<PointType> outputPoints(inputPoints.size());
+  transform.TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+
+  std::vector<PointType> inPlacePoints = inputPoints;
+  transform.TransformPoints(inPlacePoints.data(), inPlacePoints.data(), inPlacePoints.size());
+
+  for (size_t n = 0; n < inputPoints.size(); ++n)
+  {
+    const PointType expectedPoint = transform.TransformPoint(inputPoints[n]);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      EXPECT_DOUBLE_EQ(outputPoints[n][i], expectedPoint[i]);
+      EXPECT_DOUBLE_EQ(inPlacePoints[n][i], expectedPoint[i]);
+    }
+  }
+}
+
+
+// Checks that a merged composite transform maps the points as the original
+// one does.
+void
+Expect_same_points(const TransformType & transform, const TransformType & mergedTransform)
+{
+  for (const PointType & point : MakePoints())
+  {
+    const PointType expectedPoint = transform.TransformPoint(point);
+    const PointType mergedPoint = mergedTransform.TransformPoint(point);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      EXPECT_NEAR(mergedPoint[i], expectedPoint[i], 1e-12);
+    }
+  }
+}
+
+
+// An affine transform followed by a displacement that is not affine, as a
+// subclass that overrides TransformPoint.
+class BentAffineTransform : public itk::AffineTransform<ScalarType, Dimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BentAffineTransform);
+
+  using Self = BentAffineTransform;
+  using Superclass = itk::AffineTransform<ScalarType, Dimension>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkOverrideGetNameOfClassMacro(BentAffineTransform);
+
+  itkNewMacro(Self);
+
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override
+  {
+    OutputPointType outputPoint = Superclass::TransformPoint(point);
+    outputPoint[0] += 0.2 * point[1] * point[1];
+    return outputPoint;
+  }
+
+protected:
+  BentAffineTransform() = default;
+  ~BentAffineTransform() override = default;
+};
+
+
+TransformType::Pointer
+MakeAffineTransform()
+{
+  using AffineTransformType = itk::AffineTransform<ScalarType, Dimension>;
+  auto                                transform = AffineTransformType::New();
+  AffineTransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.1 * (i + 1) * (i % 2 == 0 ? 1.0 : -1.0);
+  }
+  transform->SetParameters(parameters);
+  return transform;
+}
+
+
+TransformType::Pointer
+MakeBSplineTransform()
+{
+  using BSplineTransformType = itk::BSplineTransform<ScalarType, Dimension, 3>;
+  auto transform = BSplineTransformType::New();
+
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  physicalDimensions.Fill(4.0);
+  BSplineTransformType::OriginType origin;
+  origin.Fill(-1.5);
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize.Fill(4);
+
+  transform->SetTransformDomainOrigin(origin);
+  transform->SetTransformDomainPhysicalDimensions(physicalDimensions);
+  transform->SetTransformDomainMeshSize(meshSize);
+
+  BSplineTransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = 0.01 * std::cos(0.3 * i);
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+
+} // namespace
+
+
+TEST(TransformPoints, EqualsTransformPointForTranslationTransform)
+{
+  using TranslationTransformType = itk::TranslationTransform<ScalarType, Dimension>;
+  auto                                       transform = TranslationTransformType::New();
+  TranslationTransformType::OutputVectorType offset;
+  offset[0] = 1.5;
+  offset[1] = -2.0;
+  offset[2] = 0.25;
+  transform->SetOffset(offset);
+
+  Expect_TransformPoints_equals_TransformPoint(*transform);
+}
+
+
+TEST(TransformPoints, EqualsTransformPointForAffineTransform)
+{
+  Expect_TransformPoints_equals_TransformPoint(*MakeAffineTransform());
+}
+
+
+TEST(TransformPoints, EqualsTransformPointForBSplineTransform)
+{
+  Expect_TransformPoints_equals_TransformPoint(*MakeBSplineTransform());
+}
+
+
+TEST(TransformPoints, EqualsTransformPointForBSplineTransformAlongScanlines)
+{
+  // Points along the first and second dimensions, which reuse the cached
+  // weights of the other dimensions, and leave the transform domain.
+  const TransformType::Pointer transform = MakeBSplineTransform();
+  for (unsigned int scanDimension = 0; scanDimension < 2; ++scanDimension)
+  {
+    std::vector<PointType> inputPoints;
+    for (unsigned int line = 0; line < 5; ++line)
+    {
+      for (unsigned int n = 0; n < 60; ++n)
+      {
+        PointType point;
+        point[0] = -0.3 + 0.2 * line;
+        point[1] = 0.4 - 0.15 * line;
+        point[2] = 0.1 * line;
+        point[scanDimension] = -2.0 + 0.09 * n;
+        inputPoints.push_back(point);
+      }
+    }
+
+    std::vector<PointType> outputPoints(inputPoints.size());
+    transform->TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+    for (size_t n = 0; n < inputPoints.size(); ++n)
+    {
+      const PointType expectedPoint = transform->TransformPoint(inputPoints[n]);
+      for (unsigned int i = 0; i < Dimension; ++i)
+      {
+        EXPECT_DOUBLE_EQ(outputPoints[n][i], expectedPoint[i]);
+      }
+    }
+  }
+}
+
+
+TEST(TransformPoints, EqualsTransformPointForCompositeTransform)
+{
+  auto compositeTransform = itk::CompositeTransform<ScalarType, Dimension>::New();
+  Expect_TransformPoints_equals_TransformPoint(*compositeTransform);
+
+  compositeTransform->AddTransform(MakeAffineTransform());
+  compositeTransform->AddTransform(MakeBSplineTransform());
+  Expect_TransformPoints_equals_TransformPoint(*compositeTransform);
+}
+
+
+TEST(TransformPoints, EqualsTransformPointForRigidAndSimilarityTransforms)
+{
+  auto euler3DTransform = itk::Euler3DTransform<ScalarType>::New();
+  euler3DTransform->SetRotation(0.1, -0.2, 0.3);
+  euler3DTransform->SetTranslation(itk::MakeVector(1.0, -0.5, 2.0));
+  Expect_TransformPoints_equals_TransformPoint(*euler3DTransform);
+
+  auto similarity3DTransform = itk::Similarity3DTransform<ScalarType>::New();
+  similarity3DTransform->SetScale(1.3);
+  similarity3DTransform->SetTranslation(itk::MakeVector(-1.0, 0.5, 0.25));
+  Expect_TransformPoints_equals_TransformPoint(*similarity3DTransform);
+}
+
+
+TEST(TransformPoints, EqualsTransformPointForSubclassOverridingTransformPoint)
+{
+  auto transform = BentAffineTransform::New();
+  transform->SetParameters(MakeAffineTransform()->GetParameters());
+  Expect_TransformPoints_equals_TransformPoint(*transform);
+
+  auto compositeTransform = itk::CompositeTransform<ScalarType, Dimension>::New();
+  compositeTransform->AddTransform(transform);
+  compositeTransform->AddTransform(MakeBSplineTransform());
+  Expect_TransformPoints_equals_TransformPoint(*compositeTransform);
+}
+
+
+TEST(TransformPoints, MergesOnlyAffineMapsOfCompositeTransform)
+{
+  using CompositeTransformType = itk::CompositeTransform<ScalarType, Dimension>;
+
+  auto euler3DTransform = itk::Euler3DTransform<ScalarType>::New();
+  euler3DTransform->SetRotation(0.1, -0.2, 0.3);
+
+  auto compositeTransform = CompositeTransformType::New();
+  compositeTransform->AddTransform(MakeAffineTransform());
+  compositeTransform->AddTransform(euler3DTransform);
+  compositeTransform->AddTransform(MakeAffineTransform());
+  CompositeTransformType::Pointer mergedTransform = compositeTransform->GetMergedLinearTransform();
+  EXPECT_EQ(mergedTransform->GetNumberOfTransforms(), 1u);
+  Expect_same_points(*compositeTransform, *mergedTransform);
+
+  // IsLinear() is true for these, but they are not mapped by their matrix
+  // and offset, so they split the run of affine transforms.
+  auto azimuthElevationTransform = itk::AzimuthElevationToCartesianTransform<ScalarType, Dimension>::New();
+  EXPECT_FALSE(CompositeTransformType::IsMergeableLinearTransform(azimuthElevationTransform));
+
+  auto bentTransform = BentAffineTransform::New();
+  bentTransform->SetParameters(MakeAffineTransform()->GetParameters());
+  EXPECT_FALSE(CompositeTransformType::IsMergeableLinearTransform(bentTransform));
+
+  for (const TransformType::Pointer & transform :
+       { TransformType::Pointer(azimuthElevationTransform), TransformType::Pointer(bentTransform) })
+  {
+    compositeTransform = CompositeTransformType::New();
+    compositeTransform->AddTransform(MakeAffineTransform());
+    compositeTransform->AddTransform(euler3DTransform);
+    compositeTransform->AddTransform(transform);
+    compositeTransform->AddTransform(MakeAffineTransform());
+    compositeTransform->AddTransform(euler3DTransform);
+    mergedTransform = compositeTransform->GetMergedLinearTransform();
+    EXPECT_EQ(mergedTransform->GetNumberOfTransforms(), 3u);
+    EXPECT_EQ(mergedTransform->GetNthTransformConstPointer(1), transform.GetPointer());
+    Expect_same_points(*compositeTransform, *mergedTransform);
+  }
+}
@@ -58,6 +58,13 @@ namespace itk
  *  itkAnisotropicDiffusionFunction.   See itkAnisotropicDiffusionFunction for
  *  detailed information.
  *
+ *  \par
+ *  Since the time step is fixed, the change of each iteration is applied in
+ *  the same pass that calculates it, see
+ *  DenseFiniteDifferenceImageFilter::SetUseFusedUpdate().  A subclass that
+ *  overrides ThreadedCalculateChange(), ApplyUpdate() or
+ *  ThreadedApplyUpdate() must turn it off.
+ *
  *  \par How to use this filter
  *  AnisotropicDiffusionImageFilter must be subclassed to be used.  This class
  *  implements a generic framework for other diffusion filters.
@@ -157,6 +164,15 @@ protected:
   void
   InitializeIteration() override;
 
+  /** The time step is set, so the change may be applied as it is calculated,
+   * see SetUseFusedUpdate(). */
+  bool
+  GetFixedTimeStep(TimeStepType & timeStep) const override
+  {
+    timeStep = m_TimeStep;
+    return true;
+  }
+
   bool m_GradientMagnitudeIsFixed{};
 
 private:
@@ -32,6 +32,7 @@ AnisotropicDiffusionImageFilter<TInputImage, TOutputImage>::AnisotropicDiffusion
   , m_TimeStep(0.5 / double{ 1ULL << ImageDimension })
 {
   this->SetNumberOfIterations(1);
+  this->UseFusedUpdateOn();
 }
 
 template <typename TInputImage, typename TOutputImage>
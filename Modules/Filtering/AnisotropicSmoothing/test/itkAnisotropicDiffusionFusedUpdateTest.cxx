@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Checks that anisotropic diffusion gives the same output when the change of
+// each iteration is applied as it is calculated, for the gradient and
+// curvature filters, of scalar and vector images, in 2D and 3D.
+
+#include "itkGradientAnisotropicDiffusionImageFilter.h"
+#include "itkCurvatureAnisotropicDiffusionImageFilter.h"
+#include "itkVectorGradientAnisotropicDiffusionImageFilter.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+// Piecewise constant blocks plus Gaussian noise.
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing)
+{
+  using PixelType = typename TImage::PixelType;
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  std::mt19937                     generator(5);
+  std::normal_distribution<double> normal(0.0, 10.0);
+
+  const unsigned int numberOfComponents = itk::NumericTraits<PixelType>::GetLength(PixelType{});
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    int block = 0;
+    for (unsigned int j = 0; j < TImage::ImageDimension; ++j)
+    {
+      block += static_cast<int>(it.GetIndex()[j] / 9);
+    }
+    PixelType pixel{};
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      const double value = 100.0 + 50.0 * ((block + k) % 3) + normal(generator);
+      itk::DefaultConvertPixelTraits<PixelType>::SetNthComponent(k, pixel, value);
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+
+template <typename TFilter>
+typename TFilter::OutputImageType::Pointer
+Diffuse(const typename TFilter::InputImageType * image,
+        bool                                     useFusedUpdate,
+        bool                                     fixedAverageGradientMagnitude)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(image);
+  filter->SetNumberOfIterations(7);
+  filter->SetTimeStep(0.0625);
+  filter->SetConductanceParameter(2.0);
+  filter->SetNumberOfWorkUnits(3);
+  if (fixedAverageGradientMagnitude)
+  {
+    filter->SetFixedAverageGradientMagnitude(20.0);
+  }
+  filter->SetUseFusedUpdate(useFusedUpdate);
+  filter->Update();
+
+  if (filter->GetElapsedIterations() != filter->GetNumberOfIterations())
+  {
+    std::cerr << "Ran " << filter->GetElapsedIterations() << " iterations instead of "
+              << filter->GetNumberOfIterations() << std::endl;
+    return nullptr;
+  }
+  return filter->GetOutput();
+}
+
+template <typename TImage>
+double
+MaximumDifference(const TImage * image1, const TImage * image2)
+{
+  using PixelType = typename TImage::PixelType;
+
+  const unsigned int numberOfComponents = itk::NumericTraits<PixelType>::GetLength(PixelType{});
+
+  double maximum = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image1, image1->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const PixelType pixel1 = it.Get();
+    const PixelType pixel2 = image2->GetPixel(it.GetIndex());
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      const double difference = itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(k, pixel1) -
+                                itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(k, pixel2);
+      maximum = std::max(maximum, std::abs(difference));
+    }
+  }
+  return maximum;
+}
+
+// Compare the fused update to the separate change and update passes.
+template <typename TFilter>
+bool
+CheckFusedUpdate(const typename TFilter::InputImageType * image, bool fixedAverageGradientMagnitude)
+{
+  using ImageType = typename TFilter::OutputImageType;
+
+  const auto separate = Diffuse<TFilter>(image, false, fixedAverageGradientMagnitude);
+  const auto fused = Diffuse<TFilter>(image, true, fixedAverageGradientMagnitude);
+  if (!separate || !fused)
+  {
+    return false;
+  }
+
+  const double difference = MaximumDifference<ImageType>(separate, fused);
+  const double change = MaximumDifference<ImageType>(image, separate);
+  std::cout << TFilter::New()->GetNameOfClass() << ", " << ImageType::ImageDimension
+            << "D: largest change " << change << ", largest difference " << difference << std::endl;
+
+  if (difference > 1e-3 || change < 1.0)
+  {
+    std::cerr << "The fused update differs from the separate one" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkAnisotropicDiffusionFusedUpdateTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using Image3DType = itk::Image<float, 3>;
+  using VectorImageType = itk::Image<itk::Vector<float, 2>, 2>;
+  using GradientFilterType = itk::GradientAnisotropicDiffusionImageFilter<ImageType, ImageType>;
+  using CurvatureFilterType = itk::CurvatureAnisotropicDiffusionImageFilter<ImageType, ImageType>;
+  using Curvature3DFilterType = itk::CurvatureAnisotropicDiffusionImageFilter<Image3DType, Image3DType>;
+  using Gradient3DFilterType = itk::GradientAnisotropicDiffusionImageFilter<Image3DType, Image3DType>;
+  using VectorFilterType = itk::VectorGradientAnisotropicDiffusionImageFilter<VectorImageType, VectorImageType>;
+
+  auto filter = GradientFilterType::New();
+  ITK_TEST_EXPECT_TRUE(filter->GetUseFusedUpdate());
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseFusedUpdate, true);
+
+  const auto image = MakeImage<ImageType>(itk::MakeSize(300, 260), itk::MakeVector(1.0, 1.0));
+  const auto anisotropicImage = MakeImage<ImageType>(itk::MakeSize(70, 60), itk::MakeVector(1.0, 1.5));
+  const auto image3D = MakeImage<Image3DType>(itk::MakeSize(48, 44, 40), itk::MakeVector(1.0, 1.0, 1.0));
+  const auto vectorImage = MakeImage<VectorImageType>(itk::MakeSize(60, 50), itk::MakeVector(1.0, 1.0));
+
+  bool passed = true;
+  passed &= CheckFusedUpdate<GradientFilterType>(image, false);
+  passed &= CheckFusedUpdate<GradientFilterType>(image, true);
+  passed &= CheckFusedUpdate<CurvatureFilterType>(anisotropicImage, false);
+  passed &= CheckFusedUpdate<CurvatureFilterType>(anisotropicImage, true);
+  passed &= CheckFusedUpdate<Gradient3DFilterType>(image3D, true);
+  passed &= CheckFusedUpdate<Curvature3DFilterType>(image3D, false);
+  passed &= CheckFusedUpdate<VectorFilterType>(vectorImage, false);
+  passed &= CheckFusedUpdate<VectorFilterType>(vectorImage, true);
+
+  // A filter run with the fused update and then without it gives the output
+  // of the separate passes.
+  const auto separate = Diffuse<GradientFilterType>(image, false, false);
+  filter->SetInput(image);
+  filter->SetNumberOfIterations(7);
+  filter->SetTimeStep(0.0625);
+  filter->SetConductanceParameter(2.0);
+  filter->SetNumberOfWorkUnits(3);
+  filter->UseFusedUpdateOn();
+  filter->Update();
+  filter->UseFusedUpdateOff();
+  filter->Update();
+  if (MaximumDifference<ImageType>(separate, filter->GetOutput()) != 0.0)
+  {
+    std::cerr << "The update without fusion after a fused one differs from the separate one" << std::endl;
+    passed = false;
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,8 @@
 
 #include "vnl/vnl_vector.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -72,6 +74,14 @@ namespace itk
  * the corrected input image and spatially smoothing those results with a
  * B-spline scalar field estimate of the bias field.
  *
+ * The per-iteration passes over the included voxels (log transform,
+ * histogram construction, intensity mapping and convergence measurement)
+ * are multithreaded, and their results do not depend on the number of work
+ * units. The B-spline fitting points are computed once per update and only
+ * their values change between iterations; they may be subsampled with
+ * SetFittingSubsamplingFactor() to reduce the cost of the fitting on high
+ * resolution images.
+ *
  * \author Nicholas J. Tustison
  *
  * Contributed by Nicholas J. Tustison, James C. Gee in the Insight Journal
@@ -284,6 +294,21 @@ public:
    */
   itkGetConstMacro(NumberOfControlPoints, ArrayType);
 
+  /**
+   * Set the subsampling factor of the points used to fit the B-spline bias
+   * field estimate.  Only included voxels whose index, relative to the start
+   * of the input region, is a multiple of the factor along every dimension
+   * contribute to the fit.  Histogram sharpening and the convergence
+   * measurement still use all included voxels.  Default = 1 (no subsampling).
+   */
+  itkSetClampMacro(FittingSubsamplingFactor, unsigned int, 1, NumericTraits<unsigned int>::max());
+
+  /**
+   * Get the subsampling factor of the points used to fit the B-spline bias
+   * field estimate.  Default = 1 (no subsampling).
+   */
+  itkGetConstMacro(FittingSubsamplingFactor, unsigned int);
+
   /**
    * Set the number of fitting levels.  One of the contributions of N4 is the
    * introduction of a multi-scale approach to fitting. This allows one to
@@ -410,7 +435,15 @@ private:
    * bias field estimate.
    */
   RealImagePointer
-  UpdateBiasFieldEstimate(RealImageType *, size_t);
+  UpdateBiasFieldEstimate(RealImageType *);
+
+  /**
+   * Determine the buffer offsets of the voxels included by the mask and
+   * confidence images, and build the cached point set and weights used for
+   * B-spline fitting.
+   */
+  void
+  InitializeIncludedPixels();
 
   /**
    * Convergence is determined by the coefficient of variation of the difference
@@ -419,6 +452,15 @@ private:
   RealType
   CalculateConvergenceMeasurement(const RealImageType *, const RealImageType *) const;
 
+  /**
+   * The number of blocks of ReductionBlockSize included voxels, over which
+   * the histogram and the convergence measurement are accumulated.
+   */
+  SizeValueType
+  GetNumberOfReductionBlocks() const;
+
+  static constexpr SizeValueType ReductionBlockSize = 16384;
+
   MaskPixelType m_MaskLabel{};
   bool          m_UseMaskLabel{ false };
 
@@ -443,6 +485,16 @@ private:
   unsigned int m_SplineOrder{ 3 };
   ArrayType    m_NumberOfControlPoints{};
   ArrayType    m_NumberOfFittingLevels{};
+  unsigned int m_FittingSubsamplingFactor{ 1 };
+
+  // Cached during GenerateData(): buffer offsets of the voxels included by
+  // the mask and confidence images, and the fitting point set (parametric
+  // locations and confidence weights) with the offsets it is sampled at.
+
+  std::vector<SizeValueType>                                m_IncludedPixelOffsets{};
+  std::vector<SizeValueType>                                m_FittingPixelOffsets{};
+  PointSetPointer                                           m_FittingPointSet{};
+  typename BSplineFilterType::WeightsContainerType::Pointer m_FittingPointWeights{};
 };
 
 } // end namespace itk
@@ -27,11 +27,13 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkImportImageFilter.h"
 #include "itkIterationReporter.h"
+#include "itkMultiThreaderBase.h"
 #include "itkSubtractImageFilter.h"
 #include "itkVectorIndexSelectionCastImageFilter.h"
 
+#include <mutex>
+
 ITK_GCC_PRAGMA_PUSH
 ITK_GCC_SUPPRESS_Wfloat_equal
 #include "vnl/algo/vnl_fft_1d.h"
@@ -115,32 +117,30 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
 
   ImageAlgorithm::Copy(inputImage, logInputImage.GetPointer(), inputRegion, inputRegion);
 
-  const auto          maskImageBufferRange = MakeImageBufferRange(maskImage);
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(confidenceImage);
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
-  const ImageBufferRange logInputImageBufferRange{ *logInputImage };
-  const size_t           numberOfPixels = logInputImageBufferRange.size();
+  this->InitializeIncludedPixels();
 
-  // Number of pixels of the input image that are included with the filter.
-  size_t numberOfIncludedPixels = 0;
+  const ImageBufferRange logInputImageBufferRange{ *logInputImage };
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      ++numberOfIncludedPixels;
-      auto && logInputPixel = logInputImageBufferRange[indexValue];
+  ImageRegion<1> includedPixelsRegion;
+  includedPixelsRegion.SetSize(0, this->m_IncludedPixelOffsets.size());
 
-      if (logInputPixel > typename InputImageType::PixelType{})
+  this->GetMultiThreader()->ParallelizeImageRegion(
+    includedPixelsRegion,
+    [this, &logInputImageBufferRange](const ImageRegion<1> & chunk) {
+      const SizeValueType chunkEnd = chunk.GetIndex(0) + chunk.GetSize(0);
+      for (SizeValueType i = chunk.GetIndex(0); i < chunkEnd; ++i)
       {
-        logInputPixel = std::log(static_cast<RealType>(logInputPixel));
+        auto && logInputPixel = logInputImageBufferRange[this->m_IncludedPixelOffsets[i]];
+
+        if (logInputPixel > typename InputImageType::PixelType{})
+        {
+          logInputPixel = std::log(static_cast<RealType>(logInputPixel));
+        }
       }
-    }
-  }
+    },
+    nullptr);
 
   // Duplicate logInputImage since we reuse the original at each iteration.
 
@@ -200,7 +200,7 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
       // Smooth the residual bias field estimate and add the resulting
       // control point grid to get the new total bias field estimate.
 
-      const RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField, numberOfIncludedPixels);
+      const RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField);
 
       this->m_CurrentConvergenceMeasurement = this->CalculateConvergenceMeasurement(logBiasField, newLogBiasField);
       logBiasField = newLogBiasField;
@@ -250,76 +250,177 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Generat
   expAndDivFilter->Update();
 
   this->GraftOutput(expAndDivFilter->GetOutput());
+
+  // Release the cached voxel offsets and fitting points.
+  this->m_IncludedPixelOffsets = std::vector<SizeValueType>();
+  this->m_FittingPixelOffsets = std::vector<SizeValueType>();
+  this->m_FittingPointSet = nullptr;
+  this->m_FittingPointWeights = nullptr;
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 void
-N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::SharpenImage(
-  const RealImageType * unsharpenedImage,
-  RealImageType *       sharpenedImage) const
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::InitializeIncludedPixels()
 {
+  const InputImageType *                      inputImage = this->GetInput();
+  const typename InputImageType::RegionType & inputRegion = inputImage->GetBufferedRegion();
+
   const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
   const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
   const MaskPixelType maskLabel = this->GetMaskLabel();
   const bool          useMaskLabel = this->GetUseMaskLabel();
 
-  // Build the histogram for the uncorrected image.  Store copy
-  // in a vnl_vector to utilize vnl FFT routines.  Note that variables
-  // in real space are denoted by a single uppercase letter whereas their
-  // frequency counterparts are indicated by a trailing lowercase 'f'.
+  // The B-spline approximation algorithm works in parametric space and not
+  // physical space, so the fitting points are located using an identity
+  // direction cosine.
+  typename ScalarImageType::DirectionType identity;
+  identity.SetIdentity();
 
-  RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
-  RealType binMinimum = NumericTraits<RealType>::max();
+  const RealImagePointer parametricImage = RealImageType::New();
+  parametricImage->CopyInformation(inputImage);
+  parametricImage->SetDirection(identity);
+
+  this->m_IncludedPixelOffsets.clear();
+  this->m_FittingPixelOffsets.clear();
+  this->m_FittingPointSet = PointSetType::New();
+  this->m_FittingPointWeights = BSplineFilterType::WeightsContainerType::New();
 
-  const auto   unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
-  const size_t numberOfPixels = unsharpenedImageBufferRange.size();
+  auto & pointSTLContainer = this->m_FittingPointSet->GetPoints()->CastToSTLContainer();
+  auto & weightSTLContainer = this->m_FittingPointWeights->CastToSTLContainer();
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  const SizeValueType subsamplingFactor = this->m_FittingSubsamplingFactor;
+
+  ImageRegionConstIteratorWithIndex<InputImageType> It(inputImage, inputRegion);
+
+  for (SizeValueType indexValue = 0; !It.IsAtEnd(); ++indexValue, ++It)
   {
     if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
          (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
         (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
     {
-      const RealType pixel = unsharpenedImageBufferRange[indexValue];
-      if (pixel > binMaximum)
+      this->m_IncludedPixelOffsets.push_back(indexValue);
+
+      const typename InputImageType::IndexType & index = It.GetIndex();
+
+      bool isFittingPixel = true;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
       {
-        binMaximum = pixel;
+        if (static_cast<SizeValueType>(index[d] - inputRegion.GetIndex(d)) % subsamplingFactor != 0)
+        {
+          isFittingPixel = false;
+          break;
+        }
       }
-      else if (pixel < binMinimum)
+      if (!isFittingPixel)
       {
-        binMinimum = pixel;
+        continue;
       }
+
+      PointType point;
+      parametricImage->TransformIndexToPhysicalPoint(index, point);
+      pointSTLContainer.push_back(point);
+
+      RealType confidenceWeight = 1.0;
+      if (!confidenceImageBufferRange.empty())
+      {
+        confidenceWeight = confidenceImageBufferRange[indexValue];
+      }
+      weightSTLContainer.push_back(confidenceWeight);
+
+      this->m_FittingPixelOffsets.push_back(indexValue);
     }
   }
-  const RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
+}
 
-  // Create the intensity profile (within the masked region, if applicable)
-  // using a triangular parzen windowing scheme.
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+void
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::SharpenImage(
+  const RealImageType * unsharpenedImage,
+  RealImageType *       sharpenedImage) const
+{
+  // Build the histogram for the uncorrected image.  Store copy
+  // in a vnl_vector to utilize vnl FFT routines.  Note that variables
+  // in real space are denoted by a single uppercase letter whereas their
+  // frequency counterparts are indicated by a trailing lowercase 'f'.
 
-  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
+  RealType binMinimum = NumericTraits<RealType>::max();
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      const RealType pixel = unsharpenedImageBufferRange[indexValue];
+  const auto unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+
+  ImageRegion<1> includedPixelsRegion;
+  includedPixelsRegion.SetSize(0, this->m_IncludedPixelOffsets.size());
 
-      const RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
-      const unsigned int idx = itk::Math::floor(cidx);
-      const RealType     offset = cidx - static_cast<RealType>(idx);
+  std::mutex mutex;
 
-      if (offset == 0.0)
+  multiThreader->ParallelizeImageRegion(
+    includedPixelsRegion,
+    [this, &unsharpenedImageBufferRange, &binMaximum, &binMinimum, &mutex](const ImageRegion<1> & chunk) {
+      RealType chunkMaximum = NumericTraits<RealType>::NonpositiveMin();
+      RealType chunkMinimum = NumericTraits<RealType>::max();
+
+      const SizeValueType chunkEnd = chunk.GetIndex(0) + chunk.GetSize(0);
+      for (SizeValueType i = chunk.GetIndex(0); i < chunkEnd; ++i)
       {
-        H[idx] += 1.0;
+        const RealType pixel = unsharpenedImageBufferRange[this->m_IncludedPixelOffsets[i]];
+        chunkMaximum = std::max(chunkMaximum, pixel);
+        chunkMinimum = std::min(chunkMinimum, pixel);
       }
-      else if (idx < this->m_NumberOfHistogramBins - 1)
+
+      const std::lock_guard<std::mutex> lockGuard(mutex);
+      binMaximum = std::max(binMaximum, chunkMaximum);
+      binMinimum = std::min(binMinimum, chunkMinimum);
+    },
+    nullptr);
+
+  const RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
+
+  // Create the intensity profile (within the masked region, if applicable)
+  // using a triangular parzen windowing scheme.  Each block of included
+  // pixels accumulates its own histogram, and these are summed in the order of
+  // the blocks, so that the histogram does not depend on the number of work
+  // units nor on their scheduling.
+
+  const SizeValueType               numberOfBlocks = this->GetNumberOfReductionBlocks();
+  std::vector<vnl_vector<RealType>> blockHistograms(numberOfBlocks);
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [this, &unsharpenedImageBufferRange, binMinimum, histogramSlope, &blockHistograms](SizeValueType block) {
+      vnl_vector<RealType> & blockH = blockHistograms[block];
+      blockH.set_size(this->m_NumberOfHistogramBins);
+      blockH.fill(0.0);
+
+      const SizeValueType blockEnd =
+        std::min((block + 1) * ReductionBlockSize, static_cast<SizeValueType>(this->m_IncludedPixelOffsets.size()));
+      for (SizeValueType i = block * ReductionBlockSize; i < blockEnd; ++i)
       {
-        H[idx] += 1.0 - offset;
-        H[idx + 1] += offset;
+        const RealType pixel = unsharpenedImageBufferRange[this->m_IncludedPixelOffsets[i]];
+
+        const RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
+        const unsigned int idx = itk::Math::floor(cidx);
+        const RealType     offset = cidx - static_cast<RealType>(idx);
+
+        if (offset == 0.0)
+        {
+          blockH[idx] += 1.0;
+        }
+        else if (idx < this->m_NumberOfHistogramBins - 1)
+        {
+          blockH[idx] += 1.0 - offset;
+          blockH[idx + 1] += offset;
+        }
       }
-    }
+    },
+    nullptr);
+
+  vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+  for (const vnl_vector<RealType> & blockH : blockHistograms)
+  {
+    H += blockH;
   }
 
   // Determine information about the intensity histogram and zero-pad
@@ -447,97 +548,61 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Sharpen
 
   const ImageBufferRange sharpenedImageBufferRange{ *sharpenedImage };
 
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      const RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
-      const unsigned int idx = itk::Math::floor(cidx);
-
-      RealType correctedPixel = 0;
-      if (idx < E.size() - 1)
-      {
-        correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
-      }
-      else
+  multiThreader->ParallelizeImageRegion(
+    includedPixelsRegion,
+    [this, &unsharpenedImageBufferRange, &sharpenedImageBufferRange, &E, binMinimum, histogramSlope](
+      const ImageRegion<1> & chunk) {
+      const SizeValueType chunkEnd = chunk.GetIndex(0) + chunk.GetSize(0);
+      for (SizeValueType i = chunk.GetIndex(0); i < chunkEnd; ++i)
       {
-        correctedPixel = E.back();
+        const SizeValueType indexValue = this->m_IncludedPixelOffsets[i];
+
+        const RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
+        const unsigned int idx = itk::Math::floor(cidx);
+
+        RealType correctedPixel = 0;
+        if (idx < E.size() - 1)
+        {
+          correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+        }
+        else
+        {
+          correctedPixel = E.back();
+        }
+        sharpenedImageBufferRange[indexValue] = correctedPixel;
       }
-      sharpenedImageBufferRange[indexValue] = correctedPixel;
-    }
-  }
+    },
+    nullptr);
 }
 
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
-  RealImageType * fieldEstimate,
-  const size_t    numberOfIncludedPixels)
+  RealImageType * fieldEstimate)
 {
-  // Temporarily set the direction cosine to identity since the B-spline
-  // approximation algorithm works in parametric space and not physical
-  // space.
-  typename ScalarImageType::DirectionType identity;
-  identity.SetIdentity();
-
-  const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
-  const SizeValueType                          numberOfPixels = bufferedRegion.GetNumberOfPixels();
-  const bool                                   filterHandlesMemory = false;
-
-  using ImporterType = ImportImageFilter<RealType, ImageDimension>;
-  auto importer = ImporterType::New();
-  importer->SetImportPointer(fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory);
-  importer->SetRegion(fieldEstimate->GetBufferedRegion());
-  importer->SetOrigin(fieldEstimate->GetOrigin());
-  importer->SetSpacing(fieldEstimate->GetSpacing());
-  importer->SetDirection(identity);
-  importer->Update();
-
-  const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
-
-  const PointSetPointer fieldPoints = PointSetType::New();
-  auto &                pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-  pointSTLContainer.reserve(numberOfIncludedPixels);
-  auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-  pointDataSTLContainer.reserve(numberOfIncludedPixels);
-
-  auto   weights = BSplineFilterType::WeightsContainerType::New();
-  auto & weightSTLContainer = weights->CastToSTLContainer();
-  weightSTLContainer.reserve(numberOfIncludedPixels);
-
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
-                                                      parametricFieldEstimate->GetRequestedRegion());
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
-  {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-    {
-      PointType point;
-      parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
-
-      ScalarType scalar;
-      scalar[0] = It.Get();
-
-      pointDataSTLContainer.push_back(scalar);
-      pointSTLContainer.push_back(point);
-
-      RealType confidenceWeight = 1.0;
-      if (!confidenceImageBufferRange.empty())
+  // The fitting point locations and weights are cached; only the values
+  // sampled from the current field estimate change between iterations.
+  auto   pointData = PointSetType::PointDataContainer::New();
+  auto & pointDataSTLContainer = pointData->CastToSTLContainer();
+  pointDataSTLContainer.resize(this->m_FittingPixelOffsets.size());
+
+  const ImageBufferRange fieldEstimateBufferRange{ *fieldEstimate };
+
+  ImageRegion<1> fittingPixelsRegion;
+  fittingPixelsRegion.SetSize(0, this->m_FittingPixelOffsets.size());
+
+  this->GetMultiThreader()->ParallelizeImageRegion(
+    fittingPixelsRegion,
+    [this, &pointDataSTLContainer, &fieldEstimateBufferRange](const ImageRegion<1> & chunk) {
+      const SizeValueType chunkEnd = chunk.GetIndex(0) + chunk.GetSize(0);
+      for (SizeValueType i = chunk.GetIndex(0); i < chunkEnd; ++i)
       {
-        confidenceWeight = confidenceImageBufferRange[indexValue];
+        pointDataSTLContainer[i][0] = fieldEstimateBufferRange[this->m_FittingPixelOffsets[i]];
       }
-      weightSTLContainer.push_back(confidenceWeight);
-    }
-  }
+    },
+    nullptr);
+
+  this->m_FittingPointSet->SetPointData(pointData);
 
   auto bspliner = BSplineFilterType::New();
 
@@ -568,8 +633,8 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateB
   bspliner->SetNumberOfLevels(numberOfFittingLevels);
   bspliner->SetSplineOrder(this->m_SplineOrder);
   bspliner->SetNumberOfControlPoints(numberOfControlPoints);
-  bspliner->SetInput(fieldPoints);
-  bspliner->SetPointWeights(weights);
+  bspliner->SetInput(this->m_FittingPointSet);
+  bspliner->SetPointWeights(this->m_FittingPointWeights);
   bspliner->Update();
 
   const typename BiasFieldControlPointLatticeType::Pointer phiLattice = bspliner->GetPhiLattice();
@@ -641,47 +706,76 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::Calcula
   const RealImageType * fieldEstimate1,
   const RealImageType * fieldEstimate2) const
 {
-  using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-  auto subtracter = SubtracterType::New();
-  subtracter->SetInput1(fieldEstimate1);
-  subtracter->SetInput2(fieldEstimate2);
-  subtracter->Update();
+  // Calculate statistics over the mask region.  Each block of included
+  // pixels accumulates the running mean and sum of squared differences of its
+  // pixels, which are then combined pairwise in the order of the blocks, so
+  // that the measurement does not depend on the number of work units nor on
+  // their scheduling.
 
-  // Calculate statistics over the mask region
+  struct BlockStatistics
+  {
+    RealType Mu{ 0.0 };
+    RealType Sigma{ 0.0 };
+    RealType N{ 0.0 };
+  };
+
+  const auto fieldEstimate1BufferRange = MakeImageBufferRange(fieldEstimate1);
+  const auto fieldEstimate2BufferRange = MakeImageBufferRange(fieldEstimate2);
+
+  const SizeValueType          numberOfBlocks = this->GetNumberOfReductionBlocks();
+  std::vector<BlockStatistics> blockStatistics(numberOfBlocks);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [this, &fieldEstimate1BufferRange, &fieldEstimate2BufferRange, &blockStatistics](SizeValueType block) {
+      BlockStatistics & statistics = blockStatistics[block];
+
+      const SizeValueType blockEnd =
+        std::min((block + 1) * ReductionBlockSize, static_cast<SizeValueType>(this->m_IncludedPixelOffsets.size()));
+      for (SizeValueType i = block * ReductionBlockSize; i < blockEnd; ++i)
+      {
+        const SizeValueType indexValue = this->m_IncludedPixelOffsets[i];
+        const RealType      difference = fieldEstimate1BufferRange[indexValue] - fieldEstimate2BufferRange[indexValue];
+        const RealType      pixel = std::exp(difference);
+        statistics.N += 1.0;
+
+        if (statistics.N > 1.0)
+        {
+          statistics.Sigma += itk::Math::sqr(pixel - statistics.Mu) * (statistics.N - 1.0) / statistics.N;
+        }
+        statistics.Mu = statistics.Mu * (1.0 - 1.0 / statistics.N) + pixel / statistics.N;
+      }
+    },
+    nullptr);
 
   RealType mu = 0.0;
   RealType sigma = 0.0;
   RealType N = 0.0;
-
-  const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
-  const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
-  const MaskPixelType maskLabel = this->GetMaskLabel();
-  const bool          useMaskLabel = this->GetUseMaskLabel();
-
-  const auto   subtracterImageBufferRange = MakeImageBufferRange(subtracter->GetOutput());
-  const size_t numberOfPixels = subtracterImageBufferRange.size();
-
-  for (size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
+  for (const BlockStatistics & statistics : blockStatistics)
   {
-    if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-         (!useMaskLabel && maskImageBufferRange[indexValue] != MaskPixelType{})) &&
-        (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    if (statistics.N > 0.0)
     {
-      const RealType pixel = std::exp(subtracterImageBufferRange[indexValue]);
-      N += 1.0;
-
-      if (N > 1.0)
-      {
-        sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
-      }
-      mu = mu * (1.0 - 1.0 / N) + pixel / N;
+      const RealType total = N + statistics.N;
+      const RealType delta = statistics.Mu - mu;
+      sigma = sigma + statistics.Sigma + itk::Math::sqr(delta) * N * statistics.N / total;
+      mu = mu + delta * statistics.N / total;
+      N = total;
     }
   }
+
   sigma = std::sqrt(sigma / (N - 1.0));
 
   return sigma / mu;
 }
 
+template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+SizeValueType
+N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::GetNumberOfReductionBlocks() const
+{
+  return (this->m_IncludedPixelOffsets.size() + ReductionBlockSize - 1) / ReductionBlockSize;
+}
+
 template <typename TInputImage, typename TMaskImage, typename TOutputImage>
 void
 N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::PrintSelf(std::ostream & os,
@@ -700,6 +794,7 @@ N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::PrintSe
   os << indent << "Spline order: " << this->m_SplineOrder << std::endl;
   os << indent << "Number of fitting levels: " << this->m_NumberOfFittingLevels << std::endl;
   os << indent << "Number of control points: " << this->m_NumberOfControlPoints << std::endl;
+  os << indent << "Fitting subsampling factor: " << this->m_FittingSubsamplingFactor << std::endl;
   os << indent << "CurrentConvergenceMeasurement: " << this->m_CurrentConvergenceMeasurement << std::endl;
   os << indent << "CurrentLevel: " << this->m_CurrentLevel << std::endl;
   os << indent << "ElapsedIterations: " << this->m_ElapsedIterations << std::endl;
@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Checks that the correction does not depend on the number of work units, and
+// that the correction fitted on subsampled points is close to the one fitted
+// on all the points, for an image of piecewise constant tissues multiplied by
+// a smooth bias field.
+
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+using MaskImageType = itk::Image<unsigned char, 3>;
+using CorrecterType = itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType>;
+
+ImageType::Pointer
+MakeImage(const ImageType::SizeType & size)
+{
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  std::mt19937                     generator(13);
+  std::normal_distribution<double> normal(0.0, 2.0);
+
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    int    block = 0;
+    double logBias = 0.0;
+    for (unsigned int j = 0; j < ImageType::ImageDimension; ++j)
+    {
+      const double x = static_cast<double>(it.GetIndex()[j]) / size[j] - 0.5;
+      block += static_cast<int>(it.GetIndex()[j] / 8);
+      logBias += (0.3 - 0.1 * j) * x + 0.4 * x * x;
+    }
+    const double tissue = 100.0 + 50.0 * (block % 3) + normal(generator);
+    it.Set(static_cast<float>(tissue * std::exp(logBias)));
+  }
+  return image;
+}
+
+ImageType::Pointer
+Correct(const ImageType * image, unsigned int fittingSubsamplingFactor, unsigned int numberOfWorkUnits)
+{
+  auto correcter = CorrecterType::New();
+  correcter->SetInput(image);
+  correcter->SetNumberOfFittingLevels(2);
+  correcter->SetMaximumNumberOfIterations(CorrecterType::VariableSizeArrayType(2, 10));
+  correcter->SetConvergenceThreshold(0.0);
+  correcter->SetFittingSubsamplingFactor(fittingSubsamplingFactor);
+  correcter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  correcter->Update();
+  return correcter->GetOutput();
+}
+
+// The largest difference of two images, relative to the mean of the first.
+double
+RelativeDifference(const ImageType * image1, const ImageType * image2)
+{
+  double maximum = 0.0;
+  double sum = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image1, image1->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    maximum = std::max(maximum, std::abs(static_cast<double>(it.Get()) - image2->GetPixel(it.GetIndex())));
+    sum += it.Get();
+  }
+  return maximum * image1->GetBufferedRegion().GetNumberOfPixels() / sum;
+}
+
+} // namespace
+
+int
+itkN4BiasFieldCorrectionImageFilterSubsamplingTest(int, char *[])
+{
+  auto correcter = CorrecterType::New();
+  correcter->SetFittingSubsamplingFactor(0);
+  ITK_TEST_SET_GET_VALUE(1, correcter->GetFittingSubsamplingFactor());
+  correcter->SetFittingSubsamplingFactor(2);
+  ITK_TEST_SET_GET_VALUE(2, correcter->GetFittingSubsamplingFactor());
+
+  const auto image = MakeImage(itk::MakeSize(40, 36, 32));
+
+  const auto corrected = Correct(image, 1, 3);
+  const auto singleWorkUnit = Correct(image, 1, 1);
+  const auto subsampled = Correct(image, 2, 3);
+
+  const double correction = RelativeDifference(image, corrected);
+  const double workUnitsDifference = RelativeDifference(corrected, singleWorkUnit);
+  const double subsamplingDifference = RelativeDifference(corrected, subsampled);
+  std::cout << "Largest relative correction " << correction << ", difference with a single work unit "
+            << workUnitsDifference << ", with a subsampling factor of 2 " << subsamplingDifference << std::endl;
+
+  bool passed = true;
+  if (correction < 0.1)
+  {
+    std::cerr << "The bias field is not corrected" << std::endl;
+    passed = false;
+  }
+  if (workUnitsDifference != 0.0)
+  {
+    std::cerr << "The correction depends on the number of work units" << std::endl;
+    passed = false;
+  }
+  if (subsamplingDifference > 0.05)
+  {
+    std::cerr << "The correction fitted on subsampled points differs from the one fitted on all points" << std::endl;
+    passed = false;
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
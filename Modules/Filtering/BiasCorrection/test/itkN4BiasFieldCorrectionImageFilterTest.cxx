@@ -219,6 +219,10 @@ N4(int argc, char * argv[])
   correcter->SetNumberOfFittingLevels(numberOfFittingLevels);
   ITK_TEST_SET_GET_VALUE(numberOfFittingLevels, correcter->GetNumberOfFittingLevels());
 
+  constexpr unsigned int fittingSubsamplingFactor = 1;
+  correcter->SetFittingSubsamplingFactor(fittingSubsamplingFactor);
+  ITK_TEST_SET_GET_VALUE(fittingSubsamplingFactor, correcter->GetFittingSubsamplingFactor());
+
   // B-spline options -- we place this here to take care of the case where
   // the user wants to specify things in terms of the spline distance.
   //  1. need to pad the images to get as close to possible to the
@@ -22,6 +22,7 @@
 #include <queue>
 #include "itkBinaryMorphologyImageFilter.h"
 #include "itkConstNeighborhoodIterator.h"
+#include "itkRunLengthLabelImage.h"
 
 namespace itk
 {
@@ -52,6 +53,10 @@ namespace itk
  * This implementation is based on the papers \cite vincent1991 and
  * \cite nikopoulos1997.
  *
+ * When the input and output are RunLengthLabelImage, the runs of foreground
+ * are dilated directly, row of the structuring element by row, without
+ * decoding the images.
+ *
  * \sa ImageToImageFilter BinaryErodeImageFilter BinaryMorphologyImageFilter
  * \ingroup ITKBinaryMathematicalMorphology
  *
@@ -134,6 +139,15 @@ protected:
 
   // type inherited from the superclass
   using typename Superclass::NeighborIndexContainer;
+
+private:
+  /** GenerateData() for RunLengthLabelImage input and output. */
+  void
+  GenerateDataFromRuns();
+
+  /** GenerateData() for Image input and output. */
+  void
+  GenerateDataFromPixels();
 };
 } // end namespace itk
 
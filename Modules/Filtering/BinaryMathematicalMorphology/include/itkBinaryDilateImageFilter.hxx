@@ -26,6 +26,11 @@
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
 #include "itkMath.h"
+#include "itkIndexRange.h"
+#include "itkLexicographicCompare.h"
+
+#include <algorithm>
+#include <map>
 
 namespace itk
 {
@@ -38,6 +43,198 @@ BinaryDilateImageFilter<TInputImage, TOutputImage, TKernel>::BinaryDilateImageFi
 template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 BinaryDilateImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
+{
+  if constexpr (IsRunLengthLabelImage<InputImageType>::value)
+  {
+    this->GenerateDataFromRuns();
+  }
+  else
+  {
+    if (this->UseDistanceMap())
+    {
+      this->GenerateDataFromDistanceMap(true);
+    }
+    else
+    {
+      this->GenerateDataFromPixels();
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+void
+BinaryDilateImageFilter<TInputImage, TOutputImage, TKernel>::GenerateDataFromRuns()
+{
+  static_assert(IsRunLengthLabelImage<OutputImageType>::value,
+                "The output of the dilation of a RunLengthLabelImage must be a RunLengthLabelImage.");
+
+  this->AllocateOutputs();
+
+  OutputImageType * const      output = this->GetOutput();
+  const InputImageType * const input = this->GetInput();
+
+  const InputPixelType  foregroundValue = this->GetForegroundValue();
+  const OutputPixelType backgroundValue = static_cast<OutputPixelType>(this->GetBackgroundValue());
+  const KernelType &    kernel = this->GetKernel();
+
+  using LengthType = typename OutputImageType::LengthType;
+  using RunListType = typename OutputImageType::RunListType;
+  using IntervalType = std::pair<IndexValueType, IndexValueType>;
+
+  output->SetBackgroundValue(static_cast<OutputPixelType>(input->GetBackgroundValue()));
+
+  // Group the "on" elements of the kernel by row, the offset along the
+  // first dimension being zero, into the intervals [first, last] of their
+  // offsets along the first dimension.
+  using KernelRowType = std::pair<OffsetType, std::vector<IntervalType>>;
+  std::map<OffsetType, std::vector<IndexValueType>, Functor::LexicographicCompare> kernelColumns;
+  for (typename KernelType::NeighborIndexType i = 0; i < kernel.Size(); ++i)
+  {
+    if (kernel[i])
+    {
+      OffsetType rowOffset = kernel.GetOffset(i);
+      rowOffset[0] = 0;
+      kernelColumns[rowOffset].push_back(kernel.GetOffset(i)[0]);
+    }
+  }
+  std::vector<KernelRowType> kernelRows;
+  for (auto & [rowOffset, columns] : kernelColumns)
+  {
+    std::sort(columns.begin(), columns.end());
+    std::vector<IntervalType> intervals;
+    for (const IndexValueType column : columns)
+    {
+      if (!intervals.empty() && column <= intervals.back().second + 1)
+      {
+        intervals.back().second = column;
+      }
+      else
+      {
+        intervals.emplace_back(column, column);
+      }
+    }
+    kernelRows.emplace_back(rowOffset, std::move(intervals));
+  }
+
+  const OutputImageRegionType outputRegion = output->GetBufferedRegion();
+  const InputImageRegionType  inputRegion = input->GetBufferedRegion();
+  const IndexValueType        outputBegin = outputRegion.GetIndex(0);
+  const IndexValueType        outputEnd = outputBegin + static_cast<IndexValueType>(outputRegion.GetSize(0));
+  const IndexValueType        inputBegin = inputRegion.GetIndex(0);
+  const IndexValueType        inputEnd = inputBegin + static_cast<IndexValueType>(inputRegion.GetSize(0));
+
+  OutputImageRegionType lineStarts = outputRegion;
+  lineStarts.SetSize(0, 1);
+
+  ProgressReporter progress(this, 0, lineStarts.GetNumberOfPixels());
+
+  std::vector<IntervalType> sourceRuns;
+  std::vector<IntervalType> dilatedRuns;
+  RunListType               runs;
+
+  const auto copyRun = [&runs, foregroundValue, backgroundValue](const IndexType &      runIndex,
+                                                                 LengthType             length,
+                                                                 const InputPixelType & value) {
+    const OutputPixelType label =
+      Math::ExactlyEquals(value, foregroundValue) ? backgroundValue : static_cast<OutputPixelType>(value);
+    runs.push_back({ typename OutputImageType::LineType(runIndex, length), label });
+  };
+  for (const IndexType & lineIndex : ImageRegionIndexRange<OutputImageDimension>(lineStarts))
+  {
+    // The runs of foreground of the source lines, dilated by the intervals
+    // of the corresponding kernel rows.
+    dilatedRuns.clear();
+    for (const auto & [rowOffset, intervals] : kernelRows)
+    {
+      IndexType sourceIndex = lineIndex - rowOffset;
+      sourceIndex[0] = inputBegin;
+
+      sourceRuns.clear();
+      if (!inputRegion.IsInside(sourceIndex))
+      {
+        if (this->m_BoundaryToForeground)
+        {
+          sourceRuns.emplace_back(NumericTraits<IndexValueType>::NonpositiveMin() / 2,
+                                  NumericTraits<IndexValueType>::max() / 2);
+        }
+      }
+      else
+      {
+        if (this->m_BoundaryToForeground)
+        {
+          sourceRuns.emplace_back(NumericTraits<IndexValueType>::NonpositiveMin() / 2, inputBegin);
+        }
+        input->VisitLineSegment(sourceIndex,
+                                inputRegion.GetSize(0),
+                                [&sourceRuns, foregroundValue](const IndexType &      runIndex,
+                                                               LengthType             length,
+                                                               const InputPixelType & value) {
+                                  if (Math::ExactlyEquals(value, foregroundValue))
+                                  {
+                                    sourceRuns.emplace_back(runIndex[0],
+                                                            runIndex[0] + static_cast<IndexValueType>(length));
+                                  }
+                                });
+        if (this->m_BoundaryToForeground)
+        {
+          sourceRuns.emplace_back(inputEnd, NumericTraits<IndexValueType>::max() / 2);
+        }
+      }
+
+      for (const IntervalType & run : sourceRuns)
+      {
+        for (const IntervalType & interval : intervals)
+        {
+          const IndexValueType runBegin = std::max(run.first + interval.first, outputBegin);
+          const IndexValueType runEnd = std::min(run.second + interval.second, outputEnd);
+          if (runBegin < runEnd)
+          {
+            dilatedRuns.emplace_back(runBegin, runEnd);
+          }
+        }
+      }
+    }
+
+    // The input line, its foreground replaced by the background value ...
+    IndexType segmentIndex = lineIndex;
+    segmentIndex[0] = outputBegin;
+    runs.clear();
+    input->VisitLineSegment(segmentIndex, outputRegion.GetSize(0), copyRun);
+
+    // ... overwritten by the dilated foreground.
+    std::sort(dilatedRuns.begin(), dilatedRuns.end());
+    RunListType merged;
+    for (const IntervalType & run : dilatedRuns)
+    {
+      if (!merged.empty())
+      {
+        auto &               last = merged.back().Line;
+        const IndexValueType lastEnd = last.GetIndex()[0] + static_cast<IndexValueType>(last.GetLength());
+        if (run.first <= lastEnd)
+        {
+          last.SetLength(static_cast<LengthType>(std::max(lastEnd, run.second) - last.GetIndex()[0]));
+          continue;
+        }
+      }
+      IndexType runIndex = lineIndex;
+      runIndex[0] = run.first;
+      merged.push_back(
+        { typename OutputImageType::LineType(runIndex, static_cast<LengthType>(run.second - run.first)),
+          static_cast<OutputPixelType>(foregroundValue) });
+    }
+
+    output->SetLineSegment(segmentIndex, outputRegion.GetSize(0), runs);
+    for (const auto & run : merged)
+    {
+      output->FillLineSegment(run.Line.GetIndex(), run.Line.GetLength(), run.Label);
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+void
+BinaryDilateImageFilter<TInputImage, TOutputImage, TKernel>::GenerateDataFromPixels()
 {
   this->AllocateOutputs();
 
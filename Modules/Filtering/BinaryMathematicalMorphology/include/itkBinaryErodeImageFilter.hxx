@@ -39,6 +39,12 @@ template <typename TInputImage, typename TOutputImage, typename TKernel>
 void
 BinaryErodeImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
 {
+  if (this->UseDistanceMap())
+  {
+    this->GenerateDataFromDistanceMap(false);
+    return;
+  }
+
   this->AllocateOutputs();
 
   // Retrieve input and output pointers
@@ -25,6 +25,7 @@
 #include "itkImageBoundaryCondition.h"
 #include "itkImageRegionIterator.h"
 #include "itkConceptChecking.h"
+#include "itkMathematicalMorphologyEnums.h"
 
 namespace itk
 {
@@ -89,6 +90,14 @@ namespace itk
  * portions of these two implementations were then placed in this
  * superclass.
  *
+ * For a structuring element that is a ball for the spacing of the image,
+ * the operations can instead threshold the Euclidean distance map of the
+ * set, computed exactly with the separable algorithm of \cite felzenszwalb2012,
+ * in a time linear in the number of pixels whatever the radius of the ball.
+ * The distance map is an image of double values over the buffered region of
+ * the input, that is 8 bytes per pixel in addition to the input and the
+ * output, so that it is only used when requested.  See SetAlgorithm().
+ *
  * \sa ImageToImageFilter BinaryErodeImageFilter BinaryDilateImageFilter
  * \ingroup ITKBinaryMathematicalMorphology
  */
@@ -175,6 +184,30 @@ public:
   void
   SetKernel(const KernelType & kernel) override;
 
+  using AlgorithmEnum = MathematicalMorphologyEnums::BinaryAlgorithm;
+
+  /** The radius, in pixels, from which the AUTOMATIC algorithm thresholds
+   * the distance map for the balls. */
+  static constexpr SizeValueType DistanceMapMinimumRadius = 2;
+
+  /** Set/Get the algorithm.  SURFACE paints the structuring element along
+   * the surface of the set, in a time that grows with the area of that
+   * surface times the size of the structuring element.  DISTANCE_MAP
+   * thresholds the Euclidean distance map of the set, in a time linear in the
+   * number of pixels, but requires the structuring element to be a ball for
+   * the spacing of the input image: all the offsets within some physical
+   * distance of the center, and only them, as FlatStructuringElement::Ball
+   * or BinaryBallStructuringElement are for an isotropic spacing.  It also
+   * allocates the distance map, a double per pixel of the input.  AUTOMATIC
+   * uses DISTANCE_MAP for the balls whose radius is at least
+   * DistanceMapMinimumRadius pixels along some dimension, and SURFACE
+   * otherwise.  SURFACE is the default. */
+
+  /** @ITKStartGrouping */
+  itkSetEnumMacro(Algorithm, AlgorithmEnum);
+  itkGetEnumMacro(Algorithm, AlgorithmEnum);
+  /** @ITKEndGrouping */
+
 protected:
   BinaryMorphologyImageFilter();
   ~BinaryMorphologyImageFilter() override = default;
@@ -186,6 +219,19 @@ protected:
   void
   AnalyzeKernel();
 
+  /** Whether GenerateData() must threshold the distance map: the algorithm
+   * is DISTANCE_MAP, or AUTOMATIC and the kernel is a large enough ball. An
+   * exception is thrown if the algorithm is DISTANCE_MAP and the kernel is
+   * not a ball. */
+  bool
+  UseDistanceMap() const;
+
+  /** GenerateData() that dilates the input if dilate is true, and erodes it
+   * otherwise, by thresholding the distance map of its foreground, or
+   * background, pixels. */
+  void
+  GenerateDataFromDistanceMap(bool dilate);
+
   /** Type definition of container of neighbourhood index */
   using NeighborIndexContainer = std::vector<OffsetType>;
 
@@ -238,6 +284,14 @@ private:
    * store the position of one element, arbitrary chosen, which belongs
    * to the CC */
   std::vector<OffsetType> m_KernelCCVector{};
+
+  AlgorithmEnum m_Algorithm{ AlgorithmEnum::SURFACE };
+
+  /** The squared physical distance halfway between the farthest offset of
+   * the kernel and the nearest offset out of it, for the spacing of the
+   * input, or a negative value if the kernel is not a ball. */
+  double
+  ComputeBallSquaredRadius() const;
 };
 } // end namespace itk
 
@@ -25,6 +25,11 @@
 #include "itkConstantBoundaryCondition.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "itkIndexRange.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace itk
 {
@@ -314,6 +319,252 @@ BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::AnalyzeKernel()
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+double
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::ComputeBallSquaredRadius() const
+{
+  const KernelType & kernel = this->GetKernel();
+  const auto &       spacing = this->GetInput()->GetSpacing();
+
+  const auto squaredDistance = [&spacing](const typename KernelType::OffsetType & offset) {
+    double distance = 0.0;
+    for (unsigned int d = 0; d < KernelDimension; ++d)
+    {
+      const double component = offset[d] * spacing[d];
+      distance += component * component;
+    }
+    return distance;
+  };
+
+  // The nearest offsets out of the box of the kernel are along the axes.
+  double farthestIn = -1.0;
+  double nearestOut = std::numeric_limits<double>::max();
+  for (unsigned int d = 0; d < KernelDimension; ++d)
+  {
+    typename KernelType::OffsetType offset{};
+    offset[d] = static_cast<OffsetValueType>(kernel.GetRadius(d)) + 1;
+    nearestOut = std::min(nearestOut, squaredDistance(offset));
+  }
+  for (SizeValueType n = 0; n < kernel.Size(); ++n)
+  {
+    const double distance = squaredDistance(kernel.GetOffset(n));
+    if (kernel[n])
+    {
+      farthestIn = std::max(farthestIn, distance);
+    }
+    else
+    {
+      nearestOut = std::min(nearestOut, distance);
+    }
+  }
+
+  if (farthestIn < 0.0 || farthestIn >= nearestOut)
+  {
+    return -1.0;
+  }
+  return 0.5 * (farthestIn + nearestOut);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+bool
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::UseDistanceMap() const
+{
+  if (m_Algorithm == AlgorithmEnum::SURFACE)
+  {
+    return false;
+  }
+
+  const bool isBall = this->ComputeBallSquaredRadius() >= 0.0;
+  if (m_Algorithm == AlgorithmEnum::DISTANCE_MAP)
+  {
+    if (!isBall)
+    {
+      itkExceptionMacro("The kernel is not a ball for the spacing of the input image.");
+    }
+    return true;
+  }
+
+  // The surface algorithm is faster for the smallest balls.
+  SizeValueType largestRadius = 0;
+  for (unsigned int d = 0; d < KernelDimension; ++d)
+  {
+    largestRadius = std::max(largestRadius, static_cast<SizeValueType>(this->GetKernel().GetRadius(d)));
+  }
+  return isBall && largestRadius >= DistanceMapMinimumRadius;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TKernel>
+void
+BinaryMorphologyImageFilter<TInputImage, TOutputImage, TKernel>::GenerateDataFromDistanceMap(bool dilate)
+{
+  this->AllocateOutputs();
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  const InputImageRegionType &  inputRegion = input->GetBufferedRegion();
+  const OutputImageRegionType & outputRegion = output->GetRequestedRegion();
+  const auto &                  spacing = input->GetSpacing();
+  const double                  squaredRadius = this->ComputeBallSquaredRadius();
+
+  const InputPixelType  foregroundValue = m_ForegroundValue;
+  const OutputPixelType backgroundValue = m_BackgroundValue;
+
+  // The set whose distance map is thresholded: the foreground pixels for the
+  // dilation, and the other ones for the erosion.  The outside of the input
+  // region belongs to it when it is foreground for the dilation, or
+  // background for the erosion.
+  const auto inSet = [foregroundValue, dilate](const InputPixelType & value) {
+    return Math::ExactlyEquals(value, foregroundValue) == dilate;
+  };
+  const bool boundaryInSet = dilate == m_BoundaryToForeground;
+
+  // The squared distances beyond the radius are made infinite: they cannot
+  // be under it along the next dimensions.
+  using DistanceImageType = Image<double, InputImageDimension>;
+  auto distanceMap = DistanceImageType::New();
+  distanceMap->SetRegions(inputRegion);
+  distanceMap->Allocate();
+  double * const               distances = distanceMap->GetBufferPointer();
+  const InputPixelType * const values = input->GetBufferPointer();
+  constexpr double             infinity = std::numeric_limits<double>::infinity();
+
+  TotalProgressReporter progress(this,
+                                 inputRegion.GetNumberOfPixels() * InputImageDimension +
+                                   outputRegion.GetNumberOfPixels());
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
+  {
+    const SizeValueType   length = inputRegion.GetSize(d);
+    const OffsetValueType stride = distanceMap->GetOffsetTable()[d];
+    const double          squaredSpacing = spacing[d] * spacing[d];
+
+    InputImageRegionType lineStarts = inputRegion;
+    lineStarts.SetSize(d, 1);
+    multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+      lineStarts,
+      [&](const InputImageRegionType & lines) {
+        std::vector<double>        line(length);
+        std::vector<SizeValueType> vertices(length);
+        std::vector<double>        starts(length);
+        for (const IndexType & lineStart : ImageRegionIndexRange<InputImageDimension>(lines))
+        {
+          const OffsetValueType first = distanceMap->ComputeOffset(lineStart);
+          if (d == 0)
+          {
+            // The squared distance to the nearest pixel of the set on the
+            // line, scanning forward and then backward.
+            double nearest = infinity;
+            for (SizeValueType x = 0; x < length; ++x)
+            {
+              nearest = inSet(values[first + x * stride]) ? 0.0 : nearest + 1.0;
+              line[x] = nearest;
+            }
+            nearest = infinity;
+            for (SizeValueType x = length; x-- > 0;)
+            {
+              nearest = line[x] == 0.0 ? 0.0 : nearest + 1.0;
+              const double squaredDistance = std::min(line[x], nearest) * std::min(line[x], nearest) * squaredSpacing;
+              distances[first + x * stride] = squaredDistance <= squaredRadius ? squaredDistance : infinity;
+            }
+          }
+          else
+          {
+            // The lower envelope of the parabolas rooted at the squared
+            // distances along the previous dimensions.
+            SizeValueType numberOfParabolas = 0;
+            for (SizeValueType q = 0; q < length; ++q)
+            {
+              line[q] = distances[first + q * stride];
+              if (line[q] == infinity)
+              {
+                continue;
+              }
+              double start = -infinity;
+              while (numberOfParabolas > 0)
+              {
+                const auto v = static_cast<double>(vertices[numberOfParabolas - 1]);
+                const auto p = static_cast<double>(q);
+                start = (line[q] - line[vertices[numberOfParabolas - 1]] + squaredSpacing * (p * p - v * v)) /
+                        (2.0 * squaredSpacing * (p - v));
+                if (start > starts[numberOfParabolas - 1])
+                {
+                  break;
+                }
+                start = -infinity;
+                --numberOfParabolas;
+              }
+              vertices[numberOfParabolas] = q;
+              starts[numberOfParabolas] = start;
+              ++numberOfParabolas;
+            }
+
+            SizeValueType parabola = 0;
+            for (SizeValueType x = 0; x < length; ++x)
+            {
+              double squaredDistance = infinity;
+              if (numberOfParabolas > 0)
+              {
+                while (parabola + 1 < numberOfParabolas && starts[parabola + 1] < static_cast<double>(x))
+                {
+                  ++parabola;
+                }
+                const double step = static_cast<double>(x) - static_cast<double>(vertices[parabola]);
+                squaredDistance = line[vertices[parabola]] + squaredSpacing * step * step;
+              }
+              distances[first + x * stride] = squaredDistance <= squaredRadius ? squaredDistance : infinity;
+            }
+          }
+          progress.Completed(length);
+        }
+      },
+      nullptr);
+  }
+
+  // Whether a pixel is within the radius of the outside of the input region.
+  const auto nearBoundary = [&](const IndexType & index) {
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      const IndexValueType steps = std::min(index[d] - inputRegion.GetIndex(d) + 1,
+                                            inputRegion.GetUpperIndex()[d] - index[d] + 1);
+      if (steps * spacing[d] * steps * spacing[d] <= squaredRadius)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+    outputRegion,
+    [&](const OutputImageRegionType & region) {
+      ImageRegionConstIterator<InputImageType>    inputIt(input, region);
+      ImageRegionConstIterator<DistanceImageType> distanceIt(distanceMap, region);
+      ImageRegionIteratorWithIndex<OutputImageType> outputIt(output, region);
+      for (; !outputIt.IsAtEnd(); ++inputIt, ++distanceIt, ++outputIt)
+      {
+        const InputPixelType value = inputIt.Get();
+        const bool           reached =
+          distanceIt.Get() != infinity || (boundaryInSet && nearBoundary(outputIt.GetIndex()));
+        if (reached && dilate)
+        {
+          outputIt.Set(static_cast<OutputPixelType>(foregroundValue));
+        }
+        else if (reached && Math::ExactlyEquals(value, foregroundValue))
+        {
+          outputIt.Set(backgroundValue);
+        }
+        else
+        {
+          outputIt.Set(static_cast<OutputPixelType>(value));
+        }
+      }
+      progress.Completed(region.GetNumberOfPixels());
+    },
+    nullptr);
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -329,6 +580,7 @@ BinaryMorphologyImageFilter<TInputImage, TOutput, TKernel>::PrintSelf(std::ostre
      << "Background Value: " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_BackgroundValue)
      << std::endl;
   os << indent << "BoundaryToForeground: " << m_BoundaryToForeground << std::endl;
+  os << indent << "Algorithm: " << m_Algorithm << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,250 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Compares the binary dilations and erosions by balls computed by
+// thresholding the distance map with those of the surface algorithm, for
+// isotropic and anisotropic spacings, on images with several labels that do
+// not start at the origin, with both boundary conditions.
+
+#include "itkBinaryBallStructuringElement.h"
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+using PixelType = unsigned char;
+
+constexpr PixelType Foreground{ 200 };
+constexpr PixelType Background{ 7 };
+
+// Random blobs of the foreground label over a background of two other labels.
+template <unsigned int VDimension>
+typename itk::Image<PixelType, VDimension>::Pointer
+MakeImage(const itk::Size<VDimension> & size, const itk::Vector<double, VDimension> & spacing)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+
+  auto                           image = ImageType::New();
+  typename ImageType::RegionType region(size);
+  region.SetIndex(0, 4);
+  region.SetIndex(VDimension - 1, -2);
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  std::mt19937                          generator(3);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  std::vector<itk::Point<double, VDimension>> centers(6);
+  for (auto & center : centers)
+  {
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      center[d] = (region.GetIndex(d) + uniform(generator) * size[d]) * spacing[d];
+    }
+  }
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    itk::Point<double, VDimension> point;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      point[d] = it.GetIndex()[d] * spacing[d];
+    }
+    bool inBlob = uniform(generator) < 0.01;
+    for (const auto & center : centers)
+    {
+      inBlob |= point.SquaredEuclideanDistanceTo(center) < 16.0;
+    }
+    it.Set(inBlob ? Foreground : static_cast<PixelType>(it.GetIndex()[0] % 3 == 0 ? 0 : 100));
+  }
+  return image;
+}
+
+// The offsets whose physical length is at most radius.
+template <unsigned int VDimension>
+itk::FlatStructuringElement<VDimension>
+MakeBall(double radius, const itk::Vector<double, VDimension> & spacing)
+{
+  typename itk::FlatStructuringElement<VDimension>::RadiusType kernelRadius;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    kernelRadius[d] = static_cast<itk::SizeValueType>(radius / spacing[d]);
+  }
+  itk::FlatStructuringElement<VDimension> kernel;
+  kernel.SetRadius(kernelRadius);
+  for (itk::SizeValueType n = 0; n < kernel.Size(); ++n)
+  {
+    double squaredLength = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      squaredLength += itk::Math::sqr(kernel.GetOffset(n)[d] * spacing[d]);
+    }
+    kernel[n] = squaredLength <= radius * radius;
+  }
+  return kernel;
+}
+
+// Run the filter with both algorithms and compare their outputs.
+template <typename TFilter>
+bool
+CompareAlgorithms(const typename TFilter::InputImageType * image,
+                  const typename TFilter::KernelType &     kernel,
+                  bool                                     boundaryToForeground)
+{
+  using ImageType = typename TFilter::OutputImageType;
+  using AlgorithmEnum = typename TFilter::AlgorithmEnum;
+
+  const auto run = [&](AlgorithmEnum algorithm) {
+    auto filter = TFilter::New();
+    filter->SetInput(image);
+    filter->SetKernel(kernel);
+    filter->SetForegroundValue(Foreground);
+    filter->SetBackgroundValue(Background);
+    filter->SetBoundaryToForeground(boundaryToForeground);
+    filter->SetAlgorithm(algorithm);
+    filter->SetNumberOfWorkUnits(3);
+    filter->Update();
+    return typename ImageType::Pointer(filter->GetOutput());
+  };
+  const typename ImageType::Pointer expected = run(AlgorithmEnum::SURFACE);
+  const typename ImageType::Pointer output = run(AlgorithmEnum::DISTANCE_MAP);
+
+  itk::SizeValueType numberOfDifferences = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expected->GetPixel(it.GetIndex()))
+    {
+      if (numberOfDifferences == 0)
+      {
+        std::cerr << TFilter::New()->GetNameOfClass() << " with a kernel of radius " << kernel.GetRadius()
+                  << ", spacing " << image->GetSpacing() << ", boundary to foreground: " << boundaryToForeground
+                  << ": at " << it.GetIndex() << ", expected " << int{ expected->GetPixel(it.GetIndex()) }
+                  << ", but got " << int{ it.Get() } << std::endl;
+      }
+      ++numberOfDifferences;
+    }
+  }
+  if (numberOfDifferences > 0)
+  {
+    std::cerr << numberOfDifferences << " pixels differ" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <unsigned int VDimension, typename TKernel>
+bool
+CompareDilateAndErode(const itk::Image<PixelType, VDimension> * image, const TKernel & kernel)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+
+  bool passed = true;
+  for (const bool boundaryToForeground : { false, true })
+  {
+    passed &= CompareAlgorithms<itk::BinaryDilateImageFilter<ImageType, ImageType, TKernel>>(
+      image, kernel, boundaryToForeground);
+    passed &= CompareAlgorithms<itk::BinaryErodeImageFilter<ImageType, ImageType, TKernel>>(
+      image, kernel, boundaryToForeground);
+  }
+  return passed;
+}
+
+template <unsigned int VDimension>
+bool
+CompareBalls(const itk::Size<VDimension> & size)
+{
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+
+  bool passed = true;
+
+  const auto isotropic = itk::MakeFilled<itk::Vector<double, VDimension>>(1.0);
+  const auto image = MakeImage<VDimension>(size, isotropic);
+  for (const itk::SizeValueType radius : { 1, 2, 5 })
+  {
+    passed &= CompareDilateAndErode<VDimension>(
+      image, KernelType::Ball(itk::MakeFilled<typename KernelType::RadiusType>(radius)));
+  }
+
+  itk::BinaryBallStructuringElement<PixelType, VDimension> ball;
+  ball.SetRadius(3);
+  ball.CreateStructuringElement();
+  passed &= CompareDilateAndErode<VDimension>(image, ball);
+
+  auto anisotropic = isotropic;
+  anisotropic[0] = 0.6;
+  anisotropic[VDimension - 1] = 1.7;
+  const auto anisotropicImage = MakeImage<VDimension>(size, anisotropic);
+  for (const double radius : { 1.0, 2.5, 4.2 })
+  {
+    passed &= CompareDilateAndErode<VDimension>(anisotropicImage, MakeBall<VDimension>(radius, anisotropic));
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkBinaryMorphologyDistanceMapTest(int, char *[])
+{
+  constexpr unsigned int Dimension{ 3 };
+
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using KernelType = itk::FlatStructuringElement<Dimension>;
+  using FilterType = itk::BinaryDilateImageFilter<ImageType, ImageType, KernelType>;
+
+  auto filter = FilterType::New();
+  ITK_TEST_EXPECT_TRUE(filter->GetAlgorithm() == FilterType::AlgorithmEnum::SURFACE);
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::DISTANCE_MAP);
+  ITK_TEST_EXPECT_TRUE(filter->GetAlgorithm() == FilterType::AlgorithmEnum::DISTANCE_MAP);
+
+  // A box, or a ball for another spacing, cannot be computed from the
+  // distance map.
+  auto spacing = itk::MakeFilled<itk::Vector<double, Dimension>>(1.0);
+  spacing[1] = 2.0;
+  filter->SetInput(MakeImage<Dimension>(itk::MakeSize(10, 10, 10), spacing));
+  filter->SetKernel(KernelType::Box(itk::MakeFilled<KernelType::RadiusType>(2)));
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+  filter->SetKernel(KernelType::Ball(itk::MakeFilled<KernelType::RadiusType>(2)));
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+  filter->SetKernel(MakeBall<Dimension>(2.0, spacing));
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  // The surface algorithm is used for the kernels that are not balls.
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::AUTOMATIC);
+  filter->SetKernel(KernelType::Box(itk::MakeFilled<KernelType::RadiusType>(2)));
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  bool passed = true;
+  passed &= CompareBalls<2>(itk::MakeSize(53, 41));
+  passed &= CompareBalls<3>(itk::MakeSize(23, 19, 21));
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -53,6 +53,10 @@ namespace itk
  * proximity of the pixel being denoised at the specific point in time). It implements a specific
  * scheme for defining patch weights (mask) as described in \cite awate2005 and \cite awate2006.
  *
+ * With the exhaustive SpatialNeighborSubsampler, the image update can be computed offset by offset
+ * of the search neighborhood rather than patch by patch, as the fast non-local means of
+ * \cite darbon2008: see SetUseFastPatchDistances.
+ *
  * \ingroup Filters
  * \ingroup ITKDenoising
  * \sa PatchBasedDenoisingBaseImageFilter
@@ -186,6 +190,27 @@ public:
   itkBooleanMacro(UseFastTensorComputations);
   itkGetConstMacro(UseFastTensorComputations, bool);
   /** @ITKEndGrouping */
+  /** Set/Get flag indicating whether the patch distances of the image update should be computed
+   *  offset by offset of the search neighborhood.
+   *
+   *  When this flag is true or On, the sampler is a SpatialNeighborSubsampler, that selects all the
+   *  patches within its radius, and the components are Euclidean, the image is split into tiles that
+   *  fit in the L2 cache.  For each offset of the search neighborhood, the squared differences between
+   *  the image and the image shifted by the offset are computed once over the patches of a tile, and
+   *  summed over the patch of each pixel: as box sums, from the integrals of the lines along each
+   *  dimension, when the patch weights are uniform, and as weighted sums otherwise.  The update is the
+   *  same as the one of the patch-by-patch computation, up to rounding, and the kernel bandwidth
+   *  estimation and the noise models are unchanged.  The cost per pixel of uniform patch weights no
+   *  longer grows with the size of the patch.
+   *
+   *  Otherwise, or when this flag is false (default) or Off, each selected patch is compared
+   *  separately.
+   */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseFastPatchDistances, bool);
+  itkBooleanMacro(UseFastPatchDistances);
+  itkGetConstMacro(UseFastPatchDistances, bool);
+  /** @ITKEndGrouping */
   /** Maximum number of Newton-Raphson iterations for sigma update. */
   static constexpr unsigned int MaxSigmaUpdateIterations = 20;
 
@@ -428,6 +453,11 @@ protected:
                               BaseSamplerPointer &                sampler,
                               ThreadDataStruct &                  threadData);
 
+  /** Compute the image update of a region offset by offset of the search
+   * neighborhood of the sampler.  See SetUseFastPatchDistances. */
+  virtual void
+  ThreadedComputeImageUpdateByOffsets(const InputImageRegionType & regionToProcess, const int threadId);
+
   void
   ApplyUpdate() override;
 
@@ -522,6 +552,15 @@ private:
   RealType
   AddEuclideanUpdate(const RealType & a, const RealType & b);
 
+  /** Add the update of the noise model fidelity term, of the output pixel
+   * with respect to the input pixel, to the result. */
+  void
+  AddNoiseModelUpdate(const PixelType & in, const PixelType & out, RealType & result) const;
+
+  /** Whether the image update can be computed by offsets. */
+  bool
+  CanUseFastPatchDistances() const;
+
   /** Returns the Exp map */
   RealType
   AddExponentialMapUpdate(const DiffusionTensor3D<RealValueType> & spdMatrix,
@@ -546,6 +585,8 @@ private:
 
   bool m_UseFastTensorComputations{ true };
 
+  bool m_UseFastPatchDistances{ false };
+
   RealArrayType  m_KernelBandwidthSigma{};
   bool           m_KernelBandwidthSigmaIsSet{ false };
   RealArrayType  m_IntensityRescaleInvFactor{};
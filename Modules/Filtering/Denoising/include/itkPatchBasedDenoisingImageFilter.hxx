@@ -28,6 +28,8 @@
 #include "itkIntTypes.h"
 #include "itkVectorImageToImageAdaptor.h"
 #include "itkSpatialNeighborSubsampler.h"
+#include "itkUniformRandomSpatialNeighborSubsampler.h"
+#include "itkIndexRange.h"
 #include "itkMacro.h"
 #include "itkMath.h"
 
@@ -1928,11 +1930,16 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
   // patch
   //     calculate the gradient of the joint entropy using this difference
   //
+  if (this->CanUseFastPatchDistances())
+  {
+    this->ThreadedComputeImageUpdateByOffsets(regionToProcess, threadId);
+    return threadData;
+  }
+
   using FaceCalculatorType = typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<OutputImageType>;
   using FaceListType = typename FaceCalculatorType::FaceListType;
 
   using SampleIteratorType = typename ListAdaptorType::ConstIterator;
-  using GaussianOperatorType = GaussianOperator<RealValueType, OutputImageType::ImageDimension>;
 
   const PatchRadiusType radius = this->GetPatchRadiusInVoxels();
 
@@ -1966,11 +1973,6 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
 
     inList->SetRegion(*fIt);
 
-    // Needed because the modified Bessel functions are protected member
-    // functions of GaussianOperator for some strange reason instead of being
-    // their own proper functions.
-    GaussianOperatorType gOper;
-
     InputImageRegionConstIteratorType inputIt(inputImage, *fIt);
     OutputImageRegionIteratorType     updateIt(m_UpdateBuffer, *fIt);
     OutputImageRegionIteratorType     outputIt(output, *fIt);
@@ -1997,73 +1999,8 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
       const double fidelityWeight = this->GetNoiseModelFidelityWeight();
       if (fidelityWeight > 0)
       {
-        // We should never have fidelity weight > 0 in the non-Euclidean case
-        // so don't bother checking for component space here
-        const PixelType in = inputIt.Get();
-        const PixelType out = outputIt.Get();
-        switch (this->GetNoiseModel())
-        {
-          case Superclass::NoiseModelEnum::NOMODEL:
-          {
-            // Do nothing
-            break;
-          }
-          case Superclass::NoiseModelEnum::GAUSSIAN:
-          {
-            for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
-            {
-              const RealValueType gradientFidelity = 2.0 * (this->GetComponent(in, pc) - this->GetComponent(out, pc));
-              constexpr RealValueType stepSizeFidelity{ 0.5 };
-              const RealValueType     noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
-              this->SetComponent(result, pc, this->GetComponent(result, pc) + noiseVal);
-            }
-            break;
-          }
-          case Superclass::NoiseModelEnum::RICIAN:
-          {
-            for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
-            {
-              const PixelValueType inVal = this->GetComponent(in, pc);
-              const PixelValueType outVal = this->GetComponent(out, pc);
-              const RealValueType  sigmaSquared = this->GetComponent(m_NoiseSigmaSquared, pc);
-
-              const RealValueType alpha = inVal * outVal / sigmaSquared;
-              const RealValueType gradientFidelity =
-                (inVal * (gOper.ModifiedBesselI1(alpha) / gOper.ModifiedBesselI0(alpha)) - outVal) / sigmaSquared;
-              const RealValueType stepSizeFidelity = sigmaSquared;
-              // Update
-              const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
-              // Ensure that the result is nonnegative
-              this->SetComponent(
-                result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.0)));
-            }
-            break;
-          }
-          case Superclass::NoiseModelEnum::POISSON:
-          {
-            for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
-            {
-              const PixelValueType inVal = this->GetComponent(in, pc);
-              const PixelValueType outVal = this->GetComponent(out, pc);
-
-              const RealValueType gradientFidelity = (inVal - outVal) / (outVal + 0.00001);
-              // Prevent large unstable updates when out[pc] less than 1
-              const RealValueType stepSizeFidelity = std::min(outVal, static_cast<PixelValueType>(0.99999)) + 0.00001;
-              // Update
-              const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
-              // Ensure that the result is positive
-              this->SetComponent(
-                result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.00001)));
-            }
-            break;
-          }
-          default:
-          {
-            itkExceptionMacro("Unexpected noise model " << this->GetNoiseModel() << " specified.");
-            break;
-          }
-        }
-      } // end if fidelityWeight > 0
+        this->AddNoiseModelUpdate(inputIt.Get(), outputIt.Get(), result);
+      }
 
       // Set update value, because we can't change the output until the other
       // threads are done using it.
@@ -2087,6 +2024,464 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageU
   return threadData;
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::CanUseFastPatchDistances() const
+{
+  using SpatialNeighborSamplerType = Statistics::SpatialNeighborSubsampler<PatchSampleType, InputImageRegionType>;
+  using RandomSamplerType = Statistics::UniformRandomSpatialNeighborSubsampler<PatchSampleType, InputImageRegionType>;
+
+  // Only the exhaustive search of the spatial neighborhood selects the
+  // patches of all the offsets within its radius.
+  return m_UseFastPatchDistances && this->GetComponentSpace() == Superclass::ComponentSpaceEnum::EUCLIDEAN &&
+         dynamic_cast<const SpatialNeighborSamplerType *>(m_Sampler.GetPointer()) != nullptr &&
+         dynamic_cast<const RandomSamplerType *>(m_Sampler.GetPointer()) == nullptr;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ThreadedComputeImageUpdateByOffsets(
+  const InputImageRegionType & regionToProcess,
+  const int                    threadId)
+{
+  // For each tile of the region
+  //   for each offset of the search radius
+  //     compute the squared differences between the image and the image
+  //   shifted by the offset, over the patches of the tile
+  //     sum them over the patch of each pixel of the tile
+  //     accumulate the Gaussian of the distance, and the weighted difference
+  //   of the centers, for the pixels whose shifted patch the sampler selects
+  //   compute the update of each pixel of the tile
+  //
+  using IndexType = typename OutputImageType::IndexType;
+  using SizeType = typename OutputImageType::SizeType;
+  using SamplerType = Statistics::SpatialNeighborSubsampler<PatchSampleType, InputImageRegionType>;
+  using BufferType = std::vector<RealValueType>;
+
+  const OutputImageType *      output = this->m_OutputImage;
+  const InputImageType *       inputImage = this->m_InputImage;
+  const InputImageRegionType & bounds = output->GetBufferedRegion();
+  const SizeType               imageSize = inputImage->GetLargestPossibleRegion().GetSize();
+  const PatchRadiusType        radius = this->GetPatchRadiusInVoxels();
+  const PatchRadiusType        diameter = this->GetPatchDiameterInVoxels();
+  const SizeType               searchRadius = static_cast<const SamplerType *>(m_Sampler.GetPointer())->GetRadius();
+  const unsigned int           numComponents = m_NumPixelComponents;
+  const double                 smoothingWeight = this->GetSmoothingWeight();
+  const double                 fidelityWeight = this->GetNoiseModelFidelityWeight();
+
+  // The squared patch weights multiply the squared differences.  When they
+  // are all equal, the distances are box sums.
+  const PatchWeightsType patchWeights = this->GetPatchWeights();
+  BufferType             squaredWeights(patchWeights.Size());
+  bool                   uniformWeights = true;
+  for (SizeValueType jj = 0; jj < patchWeights.Size(); ++jj)
+  {
+    squaredWeights[jj] = static_cast<RealValueType>(patchWeights[jj]) * patchWeights[jj];
+    uniformWeights &= Math::ExactlyEquals(patchWeights[jj], patchWeights[0]);
+  }
+
+  BufferType squaredSigmas(numComponents);
+  for (unsigned int ic = 0; ic < numComponents; ++ic)
+  {
+    squaredSigmas[ic] = itk::Math::sqr(m_KernelBandwidthSigma[ic]);
+  }
+
+  // Split the region into tiles small enough for the squared differences
+  // over their patches, and their accumulators, to stay in the L2 cache while
+  // all the offsets are processed.
+  constexpr SizeValueType workingSetSize = 256 * 1024;
+  SizeType                tileSize = regionToProcess.GetSize();
+  while (true)
+  {
+    SizeValueType tilePixels = 1;
+    SizeValueType paddedPixels = 1;
+    unsigned int  largest = 0;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      tilePixels *= tileSize[dim];
+      paddedPixels *= tileSize[dim] + 2 * radius[dim];
+      largest = tileSize[dim] > tileSize[largest] ? dim : largest;
+    }
+    if ((paddedPixels + tilePixels) * (numComponents + 1) * sizeof(RealValueType) <= workingSetSize ||
+        tileSize[largest] == 1)
+    {
+      break;
+    }
+    tileSize[largest] = (tileSize[largest] + 1) / 2;
+  }
+
+  SizeType  numberOfTiles;
+  IndexType searchIndex;
+  SizeType  searchSize;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    numberOfTiles[dim] = (regionToProcess.GetSize(dim) + tileSize[dim] - 1) / tileSize[dim];
+    searchIndex[dim] = -static_cast<IndexValueType>(searchRadius[dim]);
+    // Without smoothing, only the noise model updates the pixels.
+    searchSize[dim] = smoothingWeight > 0 ? 2 * searchRadius[dim] + 1 : 0;
+  }
+  const InputImageRegionType searchRegion(searchIndex, searchSize);
+
+  ProgressReporter progress(this, threadId, regionToProcess.GetNumberOfPixels());
+
+  BufferType source;
+  BufferType squares;
+  BufferType line;
+  BufferType sumsOfGaussians;
+  BufferType gradients;
+
+  std::vector<OffsetValueType> patchOffsets(patchWeights.Size());
+
+  for (const IndexType & tileNumber : ImageRegionIndexRange<ImageDimension>(InputImageRegionType(numberOfTiles)))
+  {
+    InputImageRegionType tile;
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      const SizeValueType start = tileNumber[dim] * tileSize[dim];
+      tile.SetIndex(dim, regionToProcess.GetIndex(dim) + static_cast<IndexValueType>(start));
+      tile.SetSize(dim, std::min(tileSize[dim], regionToProcess.GetSize(dim) - start));
+    }
+    const SizeValueType tilePixels = tile.GetNumberOfPixels();
+
+    // The components of the pixels the patches of the tile and of their
+    // shifts reach.
+    InputImageRegionType sourceRegion = tile;
+    sourceRegion.PadByRadius(radius + searchRadius);
+    sourceRegion.Crop(bounds);
+    const SizeValueType sourcePixels = sourceRegion.GetNumberOfPixels();
+    source.resize(numComponents * sourcePixels);
+    SizeValueType n = 0;
+    for (ImageRegionConstIterator<OutputImageType> it(output, sourceRegion); !it.IsAtEnd(); ++it, ++n)
+    {
+      const PixelType pixel = it.Get();
+      for (unsigned int pc = 0; pc < numComponents; ++pc)
+      {
+        source[pc * sourcePixels + n] = this->GetComponent(pixel, pc);
+      }
+    }
+
+    // The squared differences cover the patches of the tile.
+    InputImageRegionType padded = tile;
+    padded.PadByRadius(radius);
+    const SizeValueType paddedPixels = padded.GetNumberOfPixels();
+    squares.resize(numComponents * paddedPixels);
+
+    OffsetValueType sourceStrides[ImageDimension];
+    OffsetValueType paddedStrides[ImageDimension];
+    OffsetValueType tileStrides[ImageDimension];
+    sourceStrides[0] = 1;
+    paddedStrides[0] = 1;
+    tileStrides[0] = 1;
+    for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+    {
+      sourceStrides[dim] = sourceStrides[dim - 1] * sourceRegion.GetSize(dim - 1);
+      paddedStrides[dim] = paddedStrides[dim - 1] * padded.GetSize(dim - 1);
+      tileStrides[dim] = tileStrides[dim - 1] * tile.GetSize(dim - 1);
+    }
+
+    // The offsets of the elements of a patch from its first one, and of its
+    // center.
+    SizeValueType   jj = 0;
+    OffsetValueType centerOffset = 0;
+    for (const IndexType & element : ImageRegionIndexRange<ImageDimension>(InputImageRegionType(diameter)))
+    {
+      patchOffsets[jj] = 0;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        patchOffsets[jj] += element[dim] * paddedStrides[dim];
+      }
+      ++jj;
+    }
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      centerOffset += static_cast<OffsetValueType>(radius[dim]) * paddedStrides[dim];
+    }
+
+    sumsOfGaussians.assign(tilePixels, 0.0);
+    gradients.assign(numComponents * tilePixels, 0.0);
+
+    for (const IndexType & shift : ImageRegionIndexRange<ImageDimension>(searchRegion))
+    {
+      // The pixels of the tile whose shifted patch the sampler selects, for
+      // which the shifted patch is at least as much inside the image as the
+      // patch, form a box.
+      IndexType       validIndex;
+      SizeType        validSize;
+      OffsetValueType shiftOffset = 0;
+      bool            empty = false;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        IndexValueType first = static_cast<IndexValueType>(tile.GetSize(dim));
+        IndexValueType end = 0;
+        const auto     r = static_cast<IndexValueType>(radius[dim]);
+        for (IndexValueType t = 0; t < static_cast<IndexValueType>(tile.GetSize(dim)); ++t)
+        {
+          const IndexValueType p = tile.GetIndex(dim) + t;
+          const IndexValueType q = p + shift[dim];
+          if (q >= std::min(p, r) && q <= std::max(p, static_cast<IndexValueType>(imageSize[dim]) - r - 1))
+          {
+            first = std::min(first, t);
+            end = t + 1;
+          }
+        }
+        validIndex[dim] = first;
+        validSize[dim] = first < end ? static_cast<SizeValueType>(end - first) : 0;
+        empty |= validSize[dim] == 0;
+        shiftOffset += shift[dim] * sourceStrides[dim];
+      }
+      if (empty)
+      {
+        continue;
+      }
+
+      // Compute the squared differences over the patches of these pixels,
+      // that are zero where the image or its shift is outside the bounds.
+      // The coordinates are relative to the padded tile.
+      const IndexType patchesIndex = validIndex;
+      SizeType        patchesSize;
+      IndexType       insideBegin;
+      IndexType       insideEnd;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        patchesSize[dim] = validSize[dim] + diameter[dim] - 1;
+        const IndexValueType boundsBegin = bounds.GetIndex(dim) - padded.GetIndex(dim);
+        const IndexValueType boundsEnd = boundsBegin + static_cast<IndexValueType>(bounds.GetSize(dim));
+        insideBegin[dim] = std::max(boundsBegin, boundsBegin - shift[dim]);
+        insideEnd[dim] = std::min(boundsEnd, boundsEnd - shift[dim]);
+      }
+      const auto lineLength = static_cast<IndexValueType>(patchesSize[0]);
+      const auto lineBegin = std::clamp(insideBegin[0] - patchesIndex[0], IndexValueType{ 0 }, lineLength);
+      const auto lineEnd = std::clamp(insideEnd[0] - patchesIndex[0], lineBegin, lineLength);
+
+      SizeType lineStartsSize = patchesSize;
+      lineStartsSize[0] = 1;
+      for (const IndexType & lineStart :
+           ImageRegionIndexRange<ImageDimension>(InputImageRegionType(patchesIndex, lineStartsSize)))
+      {
+        bool            inside = lineBegin < lineEnd;
+        OffsetValueType paddedOffset = lineStart[0];
+        OffsetValueType sourceOffset = padded.GetIndex(0) + lineStart[0] - sourceRegion.GetIndex(0);
+        for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+        {
+          inside &= lineStart[dim] >= insideBegin[dim] && lineStart[dim] < insideEnd[dim];
+          paddedOffset += lineStart[dim] * paddedStrides[dim];
+          sourceOffset += (padded.GetIndex(dim) + lineStart[dim] - sourceRegion.GetIndex(dim)) * sourceStrides[dim];
+        }
+        for (unsigned int pc = 0; pc < numComponents; ++pc)
+        {
+          RealValueType * squaresLine = squares.data() + pc * paddedPixels + paddedOffset;
+          if (!inside)
+          {
+            std::fill_n(squaresLine, lineLength, 0.0);
+            continue;
+          }
+          const RealValueType * sourceLine = source.data() + pc * sourcePixels + sourceOffset + lineBegin;
+          std::fill(squaresLine, squaresLine + lineBegin, 0.0);
+          for (IndexValueType x = lineBegin; x < lineEnd; ++x, ++sourceLine)
+          {
+            const RealValueType difference = sourceLine[shiftOffset] - sourceLine[0];
+            squaresLine[x] = difference * difference;
+          }
+          std::fill(squaresLine + lineEnd, squaresLine + lineLength, 0.0);
+        }
+      }
+
+      if (uniformWeights)
+      {
+        // Sum the squared differences over the patches one dimension after
+        // the other, each line from its integral.  The sums along the
+        // previous dimensions are only needed at the centers of the patches.
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          IndexType linesIndex = patchesIndex;
+          SizeType  linesSize = patchesSize;
+          for (unsigned int previous = 0; previous < dim; ++previous)
+          {
+            linesIndex[previous] += static_cast<IndexValueType>(radius[previous]);
+            linesSize[previous] = validSize[previous];
+          }
+          linesSize[dim] = 1;
+          const SizeValueType   length = patchesSize[dim];
+          const OffsetValueType stride = paddedStrides[dim];
+          line.resize(length + 1);
+          for (const IndexType & lineStart :
+               ImageRegionIndexRange<ImageDimension>(InputImageRegionType(linesIndex, linesSize)))
+          {
+            OffsetValueType paddedOffset = 0;
+            for (unsigned int d = 0; d < ImageDimension; ++d)
+            {
+              paddedOffset += lineStart[d] * paddedStrides[d];
+            }
+            for (unsigned int pc = 0; pc < numComponents; ++pc)
+            {
+              RealValueType * values = squares.data() + pc * paddedPixels + paddedOffset;
+              line[0] = 0.0;
+              for (SizeValueType x = 0; x < length; ++x)
+              {
+                line[x + 1] = line[x] + values[x * stride];
+              }
+              for (SizeValueType x = 0; x + diameter[dim] <= length; ++x)
+              {
+                values[(x + radius[dim]) * stride] = line[x + diameter[dim]] - line[x];
+              }
+            }
+          }
+        }
+      }
+
+      // Accumulate the Gaussians of the distances, and the differences of the
+      // centers weighted by them.
+      SizeType validLineStartsSize = validSize;
+      validLineStartsSize[0] = 1;
+      for (const IndexType & lineStart :
+           ImageRegionIndexRange<ImageDimension>(InputImageRegionType(validIndex, validLineStartsSize)))
+      {
+        OffsetValueType tileOffset = 0;
+        OffsetValueType paddedOffset = 0;
+        OffsetValueType sourceOffset = 0;
+        for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+        {
+          tileOffset += lineStart[dim] * tileStrides[dim];
+          paddedOffset += lineStart[dim] * paddedStrides[dim];
+          sourceOffset += (tile.GetIndex(dim) + lineStart[dim] - sourceRegion.GetIndex(dim)) * sourceStrides[dim];
+        }
+        for (SizeValueType x = 0; x < validSize[0]; ++x)
+        {
+          RealValueType distanceJointEntropy = 0.0;
+          RealValueType gaussianJointEntropy = 0.0;
+          for (unsigned int ic = 0; ic < numComponents; ++ic)
+          {
+            const RealValueType * values = squares.data() + ic * paddedPixels + paddedOffset + x;
+            RealValueType         squaredNorm = 0.0;
+            if (uniformWeights)
+            {
+              squaredNorm = squaredWeights[0] * values[centerOffset];
+            }
+            else
+            {
+              for (SizeValueType element = 0; element < patchOffsets.size(); ++element)
+              {
+                squaredNorm += squaredWeights[element] * values[patchOffsets[element]];
+              }
+            }
+            distanceJointEntropy += squaredNorm / squaredSigmas[ic];
+
+            gaussianJointEntropy = std::exp(-distanceJointEntropy / 2.0);
+            sumsOfGaussians[tileOffset + x] += gaussianJointEntropy;
+          }
+          for (unsigned int pc = 0; pc < numComponents; ++pc)
+          {
+            const RealValueType * center = source.data() + pc * sourcePixels + sourceOffset + x;
+            gradients[pc * tilePixels + tileOffset + x] += (center[shiftOffset] - center[0]) * gaussianJointEntropy;
+          }
+        }
+      }
+    } // end for each offset
+
+    ImageRegionConstIterator<InputImageType>  inputIt(inputImage, tile);
+    ImageRegionConstIterator<OutputImageType> outputIt(output, tile);
+    OutputImageRegionIteratorType             updateIt(m_UpdateBuffer, tile);
+    for (n = 0; !updateIt.IsAtEnd(); ++inputIt, ++outputIt, ++updateIt, ++n)
+    {
+      RealType result = outputIt.Get();
+      if (smoothingWeight > 0)
+      {
+        RealType gradientJointEntropy = m_ZeroPixel;
+        for (unsigned int pc = 0; pc < numComponents; ++pc)
+        {
+          this->SetComponent(
+            gradientJointEntropy, pc, gradients[pc * tilePixels + n] / (sumsOfGaussians[n] + m_MinProbability));
+        }
+        constexpr RealValueType stepSizeSmoothing{ 0.2 };
+        result = AddUpdate(result, gradientJointEntropy * (smoothingWeight * stepSizeSmoothing));
+      }
+      if (fidelityWeight > 0)
+      {
+        this->AddNoiseModelUpdate(inputIt.Get(), outputIt.Get(), result);
+      }
+      updateIt.Set(static_cast<PixelType>(result));
+      progress.CompletedPixel();
+    }
+  } // end for each tile
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::AddNoiseModelUpdate(const PixelType & in,
+                                                                               const PixelType & out,
+                                                                               RealType &        result) const
+{
+  const double fidelityWeight = this->GetNoiseModelFidelityWeight();
+
+  // We should never have fidelity weight > 0 in the non-Euclidean case
+  // so don't bother checking for component space here
+  switch (this->GetNoiseModel())
+  {
+    case Superclass::NoiseModelEnum::NOMODEL:
+    {
+      // Do nothing
+      break;
+    }
+    case Superclass::NoiseModelEnum::GAUSSIAN:
+    {
+      for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+      {
+        const RealValueType gradientFidelity = 2.0 * (this->GetComponent(in, pc) - this->GetComponent(out, pc));
+        constexpr RealValueType stepSizeFidelity{ 0.5 };
+        const RealValueType     noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
+        this->SetComponent(result, pc, this->GetComponent(result, pc) + noiseVal);
+      }
+      break;
+    }
+    case Superclass::NoiseModelEnum::RICIAN:
+    {
+      // Needed because the modified Bessel functions are member functions of
+      // GaussianOperator instead of being their own proper functions.
+      GaussianOperator<RealValueType, ImageDimension> gOper;
+      for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+      {
+        const PixelValueType inVal = this->GetComponent(in, pc);
+        const PixelValueType outVal = this->GetComponent(out, pc);
+        const RealValueType  sigmaSquared = this->GetComponent(m_NoiseSigmaSquared, pc);
+
+        const RealValueType alpha = inVal * outVal / sigmaSquared;
+        const RealValueType gradientFidelity =
+          (inVal * (gOper.ModifiedBesselI1(alpha) / gOper.ModifiedBesselI0(alpha)) - outVal) / sigmaSquared;
+        const RealValueType stepSizeFidelity = sigmaSquared;
+        // Update
+        const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
+        // Ensure that the result is nonnegative
+        this->SetComponent(
+          result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.0)));
+      }
+      break;
+    }
+    case Superclass::NoiseModelEnum::POISSON:
+    {
+      for (unsigned int pc = 0; pc < m_NumPixelComponents; ++pc)
+      {
+        const PixelValueType inVal = this->GetComponent(in, pc);
+        const PixelValueType outVal = this->GetComponent(out, pc);
+
+        const RealValueType gradientFidelity = (inVal - outVal) / (outVal + 0.00001);
+        // Prevent large unstable updates when out[pc] less than 1
+        const RealValueType stepSizeFidelity = std::min(outVal, static_cast<PixelValueType>(0.99999)) + 0.00001;
+        // Update
+        const RealValueType noiseVal = fidelityWeight * (stepSizeFidelity * gradientFidelity);
+        // Ensure that the result is positive
+        this->SetComponent(
+          result, pc, std::max(this->GetComponent(result, pc) + noiseVal, static_cast<RealValueType>(0.00001)));
+      }
+      break;
+    }
+    default:
+    {
+      itkExceptionMacro("Unexpected noise model " << this->GetNoiseModel() << " specified.");
+      break;
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 auto
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::ComputeGradientJointEntropy(
@@ -2350,6 +2745,7 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostrea
 
   itkPrintSelfBooleanMacro(UseSmoothDiscPatchWeights);
   itkPrintSelfBooleanMacro(UseFastTensorComputations);
+  itkPrintSelfBooleanMacro(UseFastPatchDistances);
 
   os << indent << "KernelBandwidthSigma: " << m_KernelBandwidthSigma << std::endl;
   itkPrintSelfBooleanMacro(KernelBandwidthSigmaIsSet);
@@ -0,0 +1,209 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Checks that the image update computed offset by offset of the search
+// neighborhood matches the one computed patch by patch, for uniform and
+// smooth-disc patch weights, the noise models, the kernel bandwidth
+// estimation, anisotropic spacings, and images large enough to be tiled.
+
+#include "itkPatchBasedDenoisingImageFilter.h"
+#include "itkGaussianRandomSpatialNeighborSubsampler.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+// Piecewise constant blocks plus Gaussian noise, kept positive for the
+// Rician and Poisson noise models.
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing)
+{
+  using PixelType = typename TImage::PixelType;
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  std::mt19937                     generator(11);
+  std::normal_distribution<double> normal(0.0, 8.0);
+
+  const unsigned int numberOfComponents = itk::NumericTraits<PixelType>::GetLength(PixelType{});
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    int block = 0;
+    for (unsigned int j = 0; j < TImage::ImageDimension; ++j)
+    {
+      block += static_cast<int>(it.GetIndex()[j] / 7);
+    }
+    PixelType pixel{};
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      const double value = 60.0 + 40.0 * ((block + k) % 3) + normal(generator);
+      itk::DefaultConvertPixelTraits<PixelType>::SetNthComponent(k, pixel, value);
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+Denoise(const TImage *                                           image,
+        bool                                                     useFastPatchDistances,
+        bool                                                     useSmoothDiscPatchWeights,
+        bool                                                     kernelBandwidthEstimation,
+        typename itk::PatchBasedDenoisingImageFilter<TImage, TImage>::NoiseModelEnum noiseModel,
+        bool                                                     randomSampler = false)
+{
+  using FilterType = itk::PatchBasedDenoisingImageFilter<TImage, TImage>;
+  using SamplerType =
+    itk::Statistics::SpatialNeighborSubsampler<typename FilterType::PatchSampleType, typename TImage::RegionType>;
+  using RandomSamplerType =
+    itk::Statistics::GaussianRandomSpatialNeighborSubsampler<typename FilterType::PatchSampleType,
+                                                             typename TImage::RegionType>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetPatchRadius(2);
+  filter->SetUseSmoothDiscPatchWeights(useSmoothDiscPatchWeights);
+  filter->SetUseFastPatchDistances(useFastPatchDistances);
+  filter->SetNumberOfIterations(2);
+  filter->SetNumberOfWorkUnits(3);
+  filter->SetKernelBandwidthEstimation(kernelBandwidthEstimation);
+  filter->SetKernelBandwidthUpdateFrequency(1);
+  filter->SetKernelBandwidthMultiplicationFactor(4.0);
+  filter->SetNoiseModel(noiseModel);
+  filter->SetNoiseModelFidelityWeight(noiseModel == FilterType::NoiseModelEnum::NOMODEL ? 0.0 : 0.1);
+
+  if (randomSampler)
+  {
+    auto sampler = RandomSamplerType::New();
+    sampler->SetVariance(4);
+    sampler->SetRadius(4);
+    sampler->SetNumberOfResultsRequested(20);
+    filter->SetSampler(sampler);
+  }
+  else
+  {
+    auto sampler = SamplerType::New();
+    sampler->SetRadius(TImage::ImageDimension == 2 ? 4 : 2);
+    filter->SetSampler(sampler);
+  }
+  filter->Update();
+  return filter->GetOutput();
+}
+
+template <typename TImage>
+double
+MaximumDifference(const TImage * image1, const TImage * image2)
+{
+  using PixelType = typename TImage::PixelType;
+
+  const unsigned int numberOfComponents = itk::NumericTraits<PixelType>::GetLength(PixelType{});
+
+  double maximum = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image1, image1->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const PixelType pixel1 = it.Get();
+    const PixelType pixel2 = image2->GetPixel(it.GetIndex());
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      const double difference = itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(k, pixel1) -
+                                itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(k, pixel2);
+      maximum = std::max(maximum, std::abs(difference));
+    }
+  }
+  return maximum;
+}
+
+template <typename TImage>
+bool
+CheckUpdate(const TImage *                                                               image,
+            bool                                                                         useSmoothDiscPatchWeights,
+            bool                                                                         kernelBandwidthEstimation,
+            typename itk::PatchBasedDenoisingImageFilter<TImage, TImage>::NoiseModelEnum noiseModel)
+{
+  const auto patches = Denoise(image, false, useSmoothDiscPatchWeights, kernelBandwidthEstimation, noiseModel);
+  const auto offsets = Denoise(image, true, useSmoothDiscPatchWeights, kernelBandwidthEstimation, noiseModel);
+
+  const double difference = MaximumDifference<TImage>(patches, offsets);
+  const double change = MaximumDifference<TImage>(image, patches);
+  std::cout << TImage::ImageDimension << "D, smooth disc weights " << useSmoothDiscPatchWeights
+            << ", kernel bandwidth estimation " << kernelBandwidthEstimation << ", noise model " << noiseModel
+            << ": largest change " << change << ", largest difference " << difference << std::endl;
+
+  if (difference > 1e-3 || change < 1.0)
+  {
+    std::cerr << "The update computed by offsets differs from the one computed by patches" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkPatchBasedDenoisingImageFilterFastPatchDistancesTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using Image3DType = itk::Image<float, 3>;
+  using VectorImageType = itk::Image<itk::Vector<float, 2>, 2>;
+  using FilterType = itk::PatchBasedDenoisingImageFilter<ImageType, ImageType>;
+  using NoiseModelEnum = FilterType::NoiseModelEnum;
+
+  auto filter = FilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseFastPatchDistances, true);
+
+  const auto image = MakeImage<ImageType>(itk::MakeSize(150, 130), itk::MakeVector(1.0, 1.0));
+  const auto anisotropicImage = MakeImage<ImageType>(itk::MakeSize(60, 50), itk::MakeVector(1.0, 2.0));
+  const auto image3D = MakeImage<Image3DType>(itk::MakeSize(24, 22, 20), itk::MakeVector(1.0, 1.0, 1.0));
+  const auto vectorImage = MakeImage<VectorImageType>(itk::MakeSize(50, 40), itk::MakeVector(1.0, 1.0));
+
+  bool passed = true;
+  passed &= CheckUpdate<ImageType>(image, false, false, NoiseModelEnum::NOMODEL);
+  passed &= CheckUpdate<ImageType>(image, true, true, NoiseModelEnum::GAUSSIAN);
+  passed &= CheckUpdate<ImageType>(anisotropicImage, false, true, NoiseModelEnum::POISSON);
+  passed &= CheckUpdate<ImageType>(anisotropicImage, true, false, NoiseModelEnum::RICIAN);
+  passed &= CheckUpdate<Image3DType>(image3D, false, true, NoiseModelEnum::RICIAN);
+  passed &= CheckUpdate<Image3DType>(image3D, true, false, NoiseModelEnum::NOMODEL);
+  passed &= CheckUpdate<VectorImageType>(vectorImage, false, true, NoiseModelEnum::GAUSSIAN);
+  passed &= CheckUpdate<VectorImageType>(vectorImage, true, false, NoiseModelEnum::NOMODEL);
+
+  // A random sampler selects other patches, so the flag is then ignored.
+  const auto random = Denoise<ImageType>(anisotropicImage, false, true, false, NoiseModelEnum::NOMODEL, true);
+  const auto randomFast = Denoise<ImageType>(anisotropicImage, true, true, false, NoiseModelEnum::NOMODEL, true);
+  if (MaximumDifference<ImageType>(random, randomFast) != 0.0)
+  {
+    std::cerr << "The flag is not ignored with a random sampler" << std::endl;
+    passed = false;
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
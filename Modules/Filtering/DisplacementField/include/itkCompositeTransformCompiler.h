@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompositeTransformCompiler_h
+#define itkCompositeTransformCompiler_h
+
+#include "itkCompositeTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkImageBase.h"
+
+namespace itk
+{
+/** \class CompositeTransformCompiler
+ * \brief Collapse a composite transform into a cheaper equivalent for resampling.
+ *
+ * A CompositeTransform is evaluated by applying each transform of its queue
+ * in turn.  This class compiles it into a transform that is cheaper to
+ * evaluate, in up to three steps:
+ *
+ * - Nested composite transforms are expanded and each run of adjacent
+ *   linear transforms is merged into a single AffineTransform, see
+ *   CompositeTransform::GetMergedLinearTransform().  This step is exact.
+ * - When FoldLinearTransforms is on, a linear transform (see
+ *   CompositeTransform::IsMergeableLinearTransform()) that is applied
+ *   right after a DisplacementFieldTransform with linear interpolation is
+ *   folded into a copy of its displacement field, since
+ *   \f$ L(x + u(x)) - x \f$ is interpolated exactly on the field grid.
+ *   A displacement field transform that has an inverse displacement field
+ *   is not folded into, since the inverse of the folded field is not known.
+ * - When BakeDisplacementField is on, the whole chain is sampled into a
+ *   single dense displacement field on the grid of the ReferenceImage,
+ *   instead of folding.
+ *
+ * The last two steps only agree with the composite transform inside the
+ * displacement fields: outside of its field, a DisplacementFieldTransform
+ * maps a point to itself.  The baked displacement field has no inverse
+ * displacement field, so that, unlike the composite transform, the
+ * compiled transform is then not invertible.
+ *
+ * The compiled transform is cached.  GetCompiledTransform() compiles it
+ * again only when the composite transform, one of its transforms or their
+ * displacement fields, the reference image, or the settings of this object
+ * were modified since the last compilation, so that it can be called at
+ * each resampling or optimizer iteration.
+ *
+ * \ingroup ITKDisplacementField
+ */
+template <typename TParametersValueType, unsigned int VDimension>
+class ITK_TEMPLATE_EXPORT CompositeTransformCompiler : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CompositeTransformCompiler);
+
+  /** Standard class type aliases. */
+  using Self = CompositeTransformCompiler;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(CompositeTransformCompiler);
+
+  /** Dimension of the transforms. */
+  static constexpr unsigned int Dimension = VDimension;
+
+  using TransformType = Transform<TParametersValueType, VDimension, VDimension>;
+  using CompositeTransformType = CompositeTransform<TParametersValueType, VDimension>;
+  using DisplacementFieldTransformType = DisplacementFieldTransform<TParametersValueType, VDimension>;
+  using DisplacementFieldType = typename DisplacementFieldTransformType::DisplacementFieldType;
+  using ReferenceImageBaseType = ImageBase<VDimension>;
+
+  /** Set/Get the composite transform to compile. */
+  /** @ITKStartGrouping */
+  itkSetConstObjectMacro(Transform, CompositeTransformType);
+  itkGetConstObjectMacro(Transform, CompositeTransformType);
+  /** @ITKEndGrouping */
+  /** Set/Get whether linear transforms applied after a displacement field
+   * transform are folded into its field.  Default = false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(FoldLinearTransforms, bool);
+  itkGetConstMacro(FoldLinearTransforms, bool);
+  itkBooleanMacro(FoldLinearTransforms);
+  /** @ITKEndGrouping */
+  /** Set/Get whether the whole chain is baked into a single displacement
+   * field on the grid of the reference image.  Default = false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BakeDisplacementField, bool);
+  itkGetConstMacro(BakeDisplacementField, bool);
+  itkBooleanMacro(BakeDisplacementField);
+  /** @ITKEndGrouping */
+  /** Set/Get the image whose grid the baked displacement field is sampled
+   * on.  Required when BakeDisplacementField is on. */
+  /** @ITKStartGrouping */
+  itkSetConstObjectMacro(ReferenceImage, ReferenceImageBaseType);
+  itkGetConstObjectMacro(ReferenceImage, ReferenceImageBaseType);
+  /** @ITKEndGrouping */
+
+  /** Compile the composite transform. */
+  void
+  Compile();
+
+  /** Get the compiled transform, compiling it first if it is out of date. */
+  const TransformType *
+  GetCompiledTransform();
+
+protected:
+  CompositeTransformCompiler() = default;
+  ~CompositeTransformCompiler() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Latest modification time of everything the compiled transform depends on. */
+  ModifiedTimeType
+  GetInputsMTime() const;
+
+  /** Return a displacement field transform equivalent to applying
+   * fieldTransform and then linearTransform, inside the field. */
+  typename DisplacementFieldTransformType::Pointer
+  FoldLinearTransform(const TransformType *                  linearTransform,
+                      const DisplacementFieldTransformType * fieldTransform) const;
+
+  typename CompositeTransformType::ConstPointer m_Transform{};
+  typename ReferenceImageBaseType::ConstPointer m_ReferenceImage{};
+
+  bool m_FoldLinearTransforms{ false };
+  bool m_BakeDisplacementField{ false };
+
+  typename TransformType::Pointer m_CompiledTransform{};
+  TimeStamp                       m_CompileTime{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCompositeTransformCompiler.hxx"
+#endif
+
+#endif
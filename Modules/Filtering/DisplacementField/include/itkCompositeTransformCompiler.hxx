@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCompositeTransformCompiler_hxx
+#define itkCompositeTransformCompiler_hxx
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkTransformToDisplacementFieldFilter.h"
+#include "itkVectorLinearInterpolateImageFunction.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransformCompiler<TParametersValueType, VDimension>::Compile()
+{
+  if (!this->m_Transform)
+  {
+    itkExceptionStringMacro("Missing composite transform.");
+  }
+  if (this->m_BakeDisplacementField && !this->m_ReferenceImage)
+  {
+    itkExceptionStringMacro("A reference image is required to bake the displacement field.");
+  }
+
+  const typename CompositeTransformType::Pointer mergedTransform = this->m_Transform->GetMergedLinearTransform();
+
+  std::vector<typename TransformType::Pointer> transforms;
+  for (SizeValueType n = 0; n < mergedTransform->GetNumberOfTransforms(); ++n)
+  {
+    typename TransformType::Pointer transform = mergedTransform->GetNthTransformModifiablePointer(n);
+
+    // The previous transform of the queue is applied after this one.  The
+    // whole chain is sampled when baking, so folding, which is not exact
+    // near the borders of the fields, is skipped then.
+    if (this->m_FoldLinearTransforms && !this->m_BakeDisplacementField && !transforms.empty() &&
+        CompositeTransformType::IsMergeableLinearTransform(transforms.back()))
+    {
+      using LinearInterpolatorType = VectorLinearInterpolateImageFunction<DisplacementFieldType, TParametersValueType>;
+
+      const auto * fieldTransform = dynamic_cast<const DisplacementFieldTransformType *>(transform.GetPointer());
+      if (fieldTransform && fieldTransform->GetDisplacementField() && !fieldTransform->GetInverseDisplacementField() &&
+          dynamic_cast<const LinearInterpolatorType *>(fieldTransform->GetInterpolator()))
+      {
+        transform = this->FoldLinearTransform(transforms.back(), fieldTransform);
+        transforms.pop_back();
+      }
+    }
+    transforms.push_back(transform);
+  }
+
+  auto compiledTransform = CompositeTransformType::New();
+  for (const auto & transform : transforms)
+  {
+    compiledTransform->AddTransform(transform);
+  }
+
+  if (this->m_BakeDisplacementField)
+  {
+    using FieldGeneratorType = TransformToDisplacementFieldFilter<DisplacementFieldType, TParametersValueType>;
+    auto fieldGenerator = FieldGeneratorType::New();
+    fieldGenerator->SetTransform(compiledTransform);
+    fieldGenerator->SetReferenceImage(this->m_ReferenceImage);
+    fieldGenerator->UseReferenceImageOn();
+    fieldGenerator->Update();
+
+    auto bakedTransform = DisplacementFieldTransformType::New();
+    bakedTransform->SetDisplacementField(fieldGenerator->GetOutput());
+    this->m_CompiledTransform = bakedTransform;
+  }
+  else if (transforms.size() == 1)
+  {
+    this->m_CompiledTransform = transforms.front();
+  }
+  else
+  {
+    this->m_CompiledTransform = compiledTransform;
+  }
+
+  this->m_CompileTime.Modified();
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransformCompiler<TParametersValueType, VDimension>::GetCompiledTransform() -> const TransformType *
+{
+  if (!this->m_CompiledTransform || this->GetInputsMTime() > this->m_CompileTime.GetMTime())
+  {
+    this->Compile();
+  }
+  return this->m_CompiledTransform;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+ModifiedTimeType
+CompositeTransformCompiler<TParametersValueType, VDimension>::GetInputsMTime() const
+{
+  ModifiedTimeType mtime = this->GetMTime();
+
+  if (this->m_Transform)
+  {
+    std::vector<const TransformType *> transforms{ this->m_Transform.GetPointer() };
+    while (!transforms.empty())
+    {
+      const TransformType * transform = transforms.back();
+      transforms.pop_back();
+      mtime = std::max(mtime, transform->GetMTime());
+
+      if (const auto * compositeTransform = dynamic_cast<const CompositeTransformType *>(transform))
+      {
+        for (SizeValueType n = 0; n < compositeTransform->GetNumberOfTransforms(); ++n)
+        {
+          transforms.push_back(compositeTransform->GetNthTransformConstPointer(n));
+        }
+      }
+      else if (const auto * fieldTransform = dynamic_cast<const DisplacementFieldTransformType *>(transform))
+      {
+        if (fieldTransform->GetDisplacementField())
+        {
+          mtime = std::max(mtime, fieldTransform->GetDisplacementField()->GetMTime());
+        }
+      }
+    }
+  }
+
+  if (this->m_BakeDisplacementField && this->m_ReferenceImage)
+  {
+    mtime = std::max(mtime, this->m_ReferenceImage->GetMTime());
+  }
+
+  return mtime;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransformCompiler<TParametersValueType, VDimension>::FoldLinearTransform(
+  const TransformType *                  linearTransform,
+  const DisplacementFieldTransformType * fieldTransform) const -> typename DisplacementFieldTransformType::Pointer
+{
+  const DisplacementFieldType * field = fieldTransform->GetDisplacementField();
+
+  auto foldedField = DisplacementFieldType::New();
+  foldedField->CopyInformation(field);
+  foldedField->SetRegions(field->GetBufferedRegion());
+  foldedField->Allocate();
+
+  // Linear interpolation reproduces the affine part of L(x + u(x)) - x
+  // exactly, so the folded field only needs to be exact at the grid points.
+  ImageRegionConstIteratorWithIndex<DisplacementFieldType> ItF(field, field->GetBufferedRegion());
+  ImageRegionIterator<DisplacementFieldType>               ItO(foldedField, foldedField->GetBufferedRegion());
+  for (; !ItF.IsAtEnd(); ++ItF, ++ItO)
+  {
+    typename TransformType::InputPointType point;
+    field->TransformIndexToPhysicalPoint(ItF.GetIndex(), point);
+
+    const typename TransformType::OutputPointType mappedPoint = linearTransform->TransformPoint(point + ItF.Get());
+    ItO.Set(mappedPoint - point);
+  }
+
+  auto foldedTransform = DisplacementFieldTransformType::New();
+  foldedTransform->SetDisplacementField(foldedField);
+  return foldedTransform;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransformCompiler<TParametersValueType, VDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Transform);
+  itkPrintSelfObjectMacro(ReferenceImage);
+  itkPrintSelfBooleanMacro(FoldLinearTransforms);
+  itkPrintSelfBooleanMacro(BakeDisplacementField);
+  itkPrintSelfObjectMacro(CompiledTransform);
+  os << indent << "CompileTime: " << this->m_CompileTime.GetMTime() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkCompositeTransformCompiler.h"
+#include "itkEuler2DTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include "itkTranslationTransform.h"
+
+namespace
+{
+
+constexpr unsigned int Dimension{ 2 };
+
+using ParametersValueType = double;
+using CompilerType = itk::CompositeTransformCompiler<ParametersValueType, Dimension>;
+using TransformType = CompilerType::TransformType;
+using PointType = TransformType::InputPointType;
+
+// Compare two transforms on the interior points of the [2, 18]^2 square,
+// which lies inside the displacement field of the test.
+bool
+TransformsAreEqual(const TransformType * transform1, const TransformType * transform2, double tolerance)
+{
+  for (double x = 2.0; x <= 18.0; x += 0.7)
+  {
+    for (double y = 2.0; y <= 18.0; y += 0.9)
+    {
+      PointType point;
+      point[0] = x;
+      point[1] = y;
+
+      const PointType point1 = transform1->TransformPoint(point);
+      const PointType point2 = transform2->TransformPoint(point);
+      if (point1.EuclideanDistanceTo(point2) > tolerance)
+      {
+        std::cerr << "Transforms differ at " << point << ": " << point1 << " != " << point2 << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+
+int
+itkCompositeTransformCompilerTest(int, char *[])
+{
+  using CompositeTransformType = CompilerType::CompositeTransformType;
+  using DisplacementFieldTransformType = CompilerType::DisplacementFieldTransformType;
+  using FieldType = CompilerType::DisplacementFieldType;
+
+  // A smooth displacement field on [0, 20]^2.
+  auto                          field = FieldType::New();
+  constexpr FieldType::SizeType size{ 21, 21 };
+  field->SetRegions(size);
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> It(field, field->GetBufferedRegion()); !It.IsAtEnd(); ++It)
+  {
+    FieldType::PixelType displacement;
+    displacement[0] = 0.2 * std::sin(0.3 * It.GetIndex()[1]);
+    displacement[1] = 0.1 * std::cos(0.2 * It.GetIndex()[0]);
+    It.Set(displacement);
+  }
+  auto fieldTransform = DisplacementFieldTransformType::New();
+  fieldTransform->SetDisplacementField(field);
+
+  auto rigidTransform = itk::Euler2DTransform<ParametersValueType>::New();
+  rigidTransform->SetAngle(0.02);
+
+  auto affineTransform = itk::AffineTransform<ParametersValueType, Dimension>::New();
+  affineTransform->Scale(1.01);
+
+  auto translationTransform = itk::TranslationTransform<ParametersValueType, Dimension>::New();
+  auto offset = itk::MakeFilled<itk::TranslationTransform<ParametersValueType, Dimension>::OutputVectorType>(0.25);
+  translationTransform->SetOffset(offset);
+
+  // Points go through the translation, the field, then the affine and the
+  // rigid transforms.
+  auto compositeTransform = CompositeTransformType::New();
+  compositeTransform->AddTransform(rigidTransform);
+  compositeTransform->AddTransform(affineTransform);
+  compositeTransform->AddTransform(fieldTransform);
+  compositeTransform->AddTransform(translationTransform);
+
+  // The rigid and affine transforms are merged.
+  const CompositeTransformType::Pointer mergedTransform = compositeTransform->GetMergedLinearTransform();
+  ITK_TEST_EXPECT_EQUAL(mergedTransform->GetNumberOfTransforms(), 3);
+  ITK_TEST_EXPECT_TRUE(TransformsAreEqual(compositeTransform, mergedTransform, 1e-12));
+
+  auto compiler = CompilerType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(compiler, CompositeTransformCompiler, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(compiler->Compile());
+
+  compiler->SetTransform(compositeTransform);
+  ITK_TEST_SET_GET_VALUE(compositeTransform.GetPointer(), compiler->GetTransform());
+
+  ITK_TEST_SET_GET_BOOLEAN(compiler, FoldLinearTransforms, false);
+  ITK_TEST_SET_GET_BOOLEAN(compiler, BakeDisplacementField, false);
+
+  const TransformType * compiledTransform = compiler->GetCompiledTransform();
+  ITK_TEST_EXPECT_TRUE(TransformsAreEqual(compositeTransform, compiledTransform, 1e-12));
+
+  // The compiled transform is reused until something changes.
+  ITK_TEST_EXPECT_EQUAL(compiler->GetCompiledTransform(), compiledTransform);
+
+  rigidTransform->SetAngle(-0.03);
+  compiledTransform = compiler->GetCompiledTransform();
+  ITK_TEST_EXPECT_TRUE(TransformsAreEqual(compositeTransform, compiledTransform, 1e-12));
+
+  // Folding the merged linear transform into the field leaves two transforms.
+  compiler->FoldLinearTransformsOn();
+  compiledTransform = compiler->GetCompiledTransform();
+  auto compiledCompositeTransform = dynamic_cast<const CompositeTransformType *>(compiledTransform);
+  ITK_TEST_EXPECT_TRUE(compiledCompositeTransform != nullptr);
+  ITK_TEST_EXPECT_EQUAL(compiledCompositeTransform->GetNumberOfTransforms(), 2);
+  ITK_TEST_EXPECT_TRUE(TransformsAreEqual(compositeTransform, compiledTransform, 1e-9));
+
+  // A field with an inverse is not folded into, so that the compiled
+  // transform stays invertible.
+  fieldTransform->SetInverseDisplacementField(field);
+  compiledTransform = compiler->GetCompiledTransform();
+  compiledCompositeTransform = dynamic_cast<const CompositeTransformType *>(compiledTransform);
+  ITK_TEST_EXPECT_TRUE(compiledCompositeTransform != nullptr);
+  ITK_TEST_EXPECT_EQUAL(compiledCompositeTransform->GetNumberOfTransforms(), 3);
+  ITK_TEST_EXPECT_TRUE(compiledTransform->GetInverseTransform().IsNotNull());
+  fieldTransform->SetInverseDisplacementField(nullptr);
+
+  // Baking the whole chain on the grid of the field.
+  compiler->BakeDisplacementFieldOn();
+  ITK_TRY_EXPECT_EXCEPTION(compiler->Compile());
+
+  compiler->SetReferenceImage(field);
+  ITK_TEST_SET_GET_VALUE(field.GetPointer(), compiler->GetReferenceImage());
+
+  compiledTransform = compiler->GetCompiledTransform();
+  ITK_TEST_EXPECT_TRUE(dynamic_cast<const DisplacementFieldTransformType *>(compiledTransform) != nullptr);
+
+  // The baked field is exact at the grid points and interpolated in between.
+  for (itk::ImageRegionIteratorWithIndex<FieldType> It(field, field->GetBufferedRegion()); !It.IsAtEnd(); ++It)
+  {
+    PointType point;
+    field->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+    const PointType expectedPoint = compositeTransform->TransformPoint(point);
+    if (!itk::Math::FloatAlmostEqual(
+          expectedPoint.EuclideanDistanceTo(compiledTransform->TransformPoint(point)), 0.0, 4, 1e-9))
+    {
+      std::cerr << "Baked transform differs at grid point " << point << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  ITK_TEST_EXPECT_TRUE(TransformsAreEqual(compositeTransform, compiledTransform, 0.05));
+
+  // Modifying the displacement field invalidates the baked transform.
+  field->Modified();
+  ITK_TEST_EXPECT_TRUE(compiler->GetCompiledTransform() != compiledTransform);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
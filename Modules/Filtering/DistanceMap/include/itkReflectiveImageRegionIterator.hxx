@@ -28,7 +28,7 @@ ReflectiveImageRegionIterator<TImage>::ReflectiveImageRegionIterator()
 
 template <typename TImage>
 ReflectiveImageRegionIterator<TImage>::ReflectiveImageRegionIterator(ImageType * ptr, const RegionType & region)
-  : ReflectiveImageRegionConstIterator<TImage>(ptr, region)
+  : ReflectiveImageRegionConstIterator<TImage>(MakeImageBufferUnique(ptr), region)
 {}
 
 template <typename TImage>
@@ -22,6 +22,7 @@
 #include "itkIntTypes.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkFastMarchingPriorityQueue.h"
 #include "ITKFastMarchingExport.h"
 
 #include <queue>
@@ -63,8 +64,9 @@ extern ITKFastMarching_EXPORT std::ostream &
  *
  * Updates are performed using an entropy satisfy scheme where only
  * "upwind" neighborhoods are used. This implementation of Fast Marching
- * uses a std::priority_queue to locate the next proper node to
- * update.
+ * uses a FastMarchingPriorityQueue to locate the next proper node to
+ * update: a binary heap by default, or a monotone bucket queue when
+ * BucketWidth is positive.
  *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
@@ -91,7 +93,7 @@ extern ITKFastMarching_EXPORT std::ostream &
  *    \li Superclass (itk::ImageToImageFilter or
  * itk::QuadEdgeMeshToQuadEdgeMeshFilter )
  *
- * \todo In the current implementation, std::priority_queue only allows
+ * \todo In the current implementation, the priority queue only allows
  * taking nodes out from the front and putting nodes in from the back.
  * Use itk::PriorityQueueContainer instead.
  *
@@ -217,6 +219,20 @@ public:
   itkGetMacro(NormalizationFactor, double);
   itkSetMacro(NormalizationFactor, double);
 
+  /** \brief Set/Get the width of the buckets of values of the queue of trial
+   * nodes.  Zero, the default, keeps the queue a binary heap.  A positive
+   * width groups the trial nodes into buckets of values, of which only the
+   * first one is a heap, which makes pushing and popping cheaper on large
+   * fronts.  The nodes are made alive in the same order either way.  A
+   * fraction, such as a quarter, of the arrival time between neighboring
+   * nodes, the smallest spacing divided by the largest speed, is a good
+   * start.
+   * \sa FastMarchingPriorityQueue */
+  /** @ITKStartGrouping */
+  itkSetMacro(BucketWidth, double);
+  itkGetConstMacro(BucketWidth, double);
+  /** @ITKEndGrouping */
+
   /** \brief Get the value reached by the front when it stops propagating */
   itkGetMacro(TargetReachedValue, OutputPixelType);
 
@@ -243,6 +259,7 @@ protected:
   double m_SpeedConstant{};
   double m_InverseSpeed{};
   double m_NormalizationFactor{};
+  double m_BucketWidth{ 0.0 };
 
   OutputPixelType m_TargetReachedValue{};
   OutputPixelType m_LargeValue{};
@@ -259,7 +276,7 @@ protected:
   using HeapContainerType = std::vector<NodePairType>;
   using NodeComparerType = std::greater<NodePairType>;
 
-  using PriorityQueueType = std::priority_queue<NodePairType, HeapContainerType, NodeComparerType>;
+  using PriorityQueueType = FastMarchingPriorityQueue<NodePairType>;
 
   PriorityQueueType m_Heap{};
 
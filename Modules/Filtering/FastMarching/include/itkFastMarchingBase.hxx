@@ -54,6 +54,7 @@ FastMarchingBase<TInput, TOutput>::PrintSelf(std::ostream & os, Indent indent) c
   os << indent << "Speed constant: " << m_SpeedConstant << std::endl;
   os << indent << "Topology check: " << m_TopologyCheck << std::endl;
   os << indent << "Normalization Factor: " << m_NormalizationFactor << std::endl;
+  os << indent << "Bucket width: " << m_BucketWidth << std::endl;
 }
 
 // -----------------------------------------------------------------------------
@@ -88,16 +89,8 @@ FastMarchingBase<TInput, TOutput>::Initialize(OutputDomainType * oDomain)
   }
 
   // make sure the heap is empty
-  while (!m_Heap.empty())
-  {
-    m_Heap.pop();
-  }
-  /*
-  while ( !m_Heap->Empty() )
-    {
-    m_Heap->Pop();
-    }
-  */
+  m_Heap.clear();
+  m_Heap.SetBucketWidth(m_BucketWidth);
 
   this->InitializeOutput(oDomain);
 
@@ -0,0 +1,236 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastMarchingPriorityQueue_h
+#define itkFastMarchingPriorityQueue_h
+
+#include "itkIntTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastMarchingPriorityQueue
+ * \brief The queue of the trial nodes of the fast marching, ordered by
+ * value.
+ *
+ * By default, the queue is a binary heap, as a std::priority_queue.  With a
+ * positive BucketWidth, it is a monotone bucket queue: the node pairs are
+ * grouped into buckets of values of that width, and only the bucket of the
+ * smallest values is kept as a heap, while the pairs pushed into the
+ * NumberOfBuckets following buckets are only appended to them.  The pairs
+ * beyond those buckets wait in an overflow heap.
+ *
+ * The pairs are popped in nondecreasing order of value in both cases,
+ * though pairs of equal values may be popped in a different order.  As the
+ * front of the fast marching only pushes values that are not smaller than
+ * the last popped one, the heap only holds about the nodes of one bucket
+ * instead of the whole front, so that pushing and popping take fewer and
+ * more local comparisons.  A bucket width of a fraction of the arrival time
+ * from a node to its neighbors is a good start.
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TNodePair>
+class FastMarchingPriorityQueue
+{
+public:
+  using Self = FastMarchingPriorityQueue;
+  using NodePairType = TNodePair;
+  using ContainerType = std::vector<NodePairType>;
+  using NodeComparerType = std::greater<NodePairType>;
+
+  /** Number of buckets that follow the bucket of the smallest values. */
+  static constexpr SizeValueType NumberOfBuckets = 1024;
+
+  /** Set/Get the width of the buckets.  Zero or less, the default, makes the
+   * queue a binary heap.  The queue must be empty to change it. */
+  /** @ITKStartGrouping */
+  void
+  SetBucketWidth(double width)
+  {
+    m_BucketWidth = width;
+    m_Buckets.resize(width > 0.0 ? NumberOfBuckets : 0);
+  }
+  [[nodiscard]] double
+  GetBucketWidth() const
+  {
+    return m_BucketWidth;
+  }
+  /** @ITKEndGrouping */
+
+  [[nodiscard]] bool
+  empty() const
+  {
+    return m_Size == 0;
+  }
+
+  [[nodiscard]] SizeValueType
+  size() const
+  {
+    return m_Size;
+  }
+
+  /** The pair of the smallest value. */
+  const NodePairType &
+  top() const
+  {
+    return m_Current.front();
+  }
+
+  void
+  push(const NodePairType & nodePair)
+  {
+    ++m_Size;
+    if (m_Buckets.empty())
+    {
+      PushHeap(m_Current, nodePair);
+      return;
+    }
+
+    const BucketIndexType bucket = this->ComputeBucketIndex(nodePair.GetValue());
+    if (m_Size == 1)
+    {
+      m_CurrentBucket = bucket;
+    }
+    if (bucket <= m_CurrentBucket)
+    {
+      PushHeap(m_Current, nodePair);
+    }
+    else if (bucket - m_CurrentBucket < static_cast<BucketIndexType>(NumberOfBuckets))
+    {
+      this->GetBucket(bucket).push_back(nodePair);
+    }
+    else
+    {
+      PushHeap(m_Overflow, nodePair);
+    }
+  }
+
+  void
+  pop()
+  {
+    std::pop_heap(m_Current.begin(), m_Current.end(), NodeComparerType());
+    m_Current.pop_back();
+    --m_Size;
+    if (m_Current.empty() && m_Size > 0)
+    {
+      this->AdvanceBucket();
+    }
+  }
+
+  /** Remove all the pairs, keeping the memory of the buckets. */
+  void
+  clear()
+  {
+    m_Current.clear();
+    m_Overflow.clear();
+    for (ContainerType & bucket : m_Buckets)
+    {
+      bucket.clear();
+    }
+    m_Size = 0;
+  }
+
+private:
+  using BucketIndexType = int64_t;
+
+  static void
+  PushHeap(ContainerType & heap, const NodePairType & nodePair)
+  {
+    heap.push_back(nodePair);
+    std::push_heap(heap.begin(), heap.end(), NodeComparerType());
+  }
+
+  BucketIndexType
+  ComputeBucketIndex(double value) const
+  {
+    // Clamped so that the differences of indices do not overflow.
+    constexpr double limit = 1e18;
+    return static_cast<BucketIndexType>(std::clamp(std::floor(value / m_BucketWidth), -limit, limit));
+  }
+
+  /** The buckets are reused circularly.  The conversion of negative indices
+   * to unsigned keeps their remainder, as NumberOfBuckets divides 2^64. */
+  ContainerType &
+  GetBucket(BucketIndexType bucket)
+  {
+    return m_Buckets[static_cast<SizeValueType>(bucket) % NumberOfBuckets];
+  }
+
+  /** Make the next non-empty bucket the current one, taking in the pairs of
+   * the overflow heap that then fall into the buckets. */
+  void
+  AdvanceBucket()
+  {
+    bool found = false;
+    for (BucketIndexType bucket = m_CurrentBucket + 1;
+         bucket < m_CurrentBucket + static_cast<BucketIndexType>(NumberOfBuckets);
+         ++bucket)
+    {
+      ContainerType & pairs = this->GetBucket(bucket);
+      if (!pairs.empty())
+      {
+        m_Current.swap(pairs);
+        m_CurrentBucket = bucket;
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+    {
+      m_CurrentBucket = this->ComputeBucketIndex(m_Overflow.front().GetValue());
+    }
+
+    while (!m_Overflow.empty())
+    {
+      const BucketIndexType bucket = this->ComputeBucketIndex(m_Overflow.front().GetValue());
+      if (bucket - m_CurrentBucket >= static_cast<BucketIndexType>(NumberOfBuckets))
+      {
+        break;
+      }
+      std::pop_heap(m_Overflow.begin(), m_Overflow.end(), NodeComparerType());
+      if (bucket <= m_CurrentBucket)
+      {
+        m_Current.push_back(m_Overflow.back());
+      }
+      else
+      {
+        this->GetBucket(bucket).push_back(m_Overflow.back());
+      }
+      m_Overflow.pop_back();
+    }
+
+    std::make_heap(m_Current.begin(), m_Current.end(), NodeComparerType());
+  }
+
+  double          m_BucketWidth{ 0.0 };
+  ContainerType   m_Current{};
+  BucketIndexType m_CurrentBucket{ 0 };
+
+  std::vector<ContainerType> m_Buckets{};
+  ContainerType              m_Overflow{};
+  SizeValueType              m_Size{ 0 };
+};
+} // end namespace itk
+
+#endif // itkFastMarchingPriorityQueue_h
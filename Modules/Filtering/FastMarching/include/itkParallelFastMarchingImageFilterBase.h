@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkParallelFastMarchingImageFilterBase_h
+#define itkParallelFastMarchingImageFilterBase_h
+
+#include "itkFastMarchingImageFilterBase.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ParallelFastMarchingImageFilterBase
+ * \brief Solve the Eikonal equation on an image with a multithreaded fast
+ * iterative method.
+ *
+ * This filter has the interface of FastMarchingImageFilterBase, and computes
+ * the same arrival times, but instead of making the nodes alive one at a
+ * time from a priority queue, it updates a whole list of active nodes in
+ * parallel until they converge, as in the fast iterative method of
+ * Jeong and Whitaker (A Fast Iterative Method for Eikonal Equations, SIAM
+ * Journal on Scientific Computing, 30(5), 2008).
+ *
+ * To honor the stopping criteria, the front is propagated in bands of
+ * arrival times: the nodes whose arrival time is below the upper bound of
+ * the current band are computed in parallel, and, as their values only
+ * depend on smaller values, are then final.  The nodes of the band are then
+ * passed to the stopping criterion in increasing order of arrival time, as
+ * the fast marching method does, and made alive until the criterion is
+ * satisfied.  The width of the bands starts from the arrival time of the
+ * closest neighbors of the initial front, and doubles while the bands are
+ * too small to keep the threads busy.
+ *
+ * The trial points keep their values, as in FastMarchingImageFilterBase.
+ * When the propagation stops, the nodes of the last band that are not alive
+ * are left as FastMarchingImageFilterBase leaves them: the neighbors of the
+ * alive nodes are trial nodes, with the arrival time computed from these
+ * alive nodes, and the other nodes keep the large value.
+ *
+ * The topology checks depend on the order in which the nodes become alive:
+ * when TopologyCheck is not Nothing, this filter runs the serial fast
+ * marching method of its superclass.
+ *
+ * \sa FastMarchingImageFilterBase
+ *
+ * \ingroup ITKFastMarching
+ */
+template <typename TInput, typename TOutput>
+class ITK_TEMPLATE_EXPORT ParallelFastMarchingImageFilterBase : public FastMarchingImageFilterBase<TInput, TOutput>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelFastMarchingImageFilterBase);
+
+  using Self = ParallelFastMarchingImageFilterBase;
+  using Superclass = FastMarchingImageFilterBase<TInput, TOutput>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using typename Superclass::Traits;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ParallelFastMarchingImageFilterBase);
+
+  using typename Superclass::OutputImageType;
+  using typename Superclass::OutputPixelType;
+  using typename Superclass::NodeType;
+  using typename Superclass::NodePairType;
+  using typename Superclass::InternalNodeStructure;
+  using typename Superclass::InternalNodeStructureArray;
+
+  static constexpr unsigned int ImageDimension = Superclass::ImageDimension;
+
+protected:
+  ParallelFastMarchingImageFilterBase() = default;
+  ~ParallelFastMarchingImageFilterBase() override = default;
+
+  void
+  GenerateData() override;
+
+private:
+  using NodeListType = std::vector<NodeType>;
+  using NodePairListType = std::vector<NodePairType>;
+
+  /** Flags of the nodes, besides their label. */
+  enum NodeFlag : unsigned char
+  {
+    Active = 1,
+    Deferred = 2
+  };
+
+  /** Compute the arrival time of iNode from the current values of its
+   * neighbors, whether they are final or not. */
+  double
+  ComputeValue(const OutputPixelType * values, const unsigned char * labels, const NodeType & iNode) const;
+
+  /** Whether a neighbor of iNode is alive. */
+  bool
+  HasAliveNeighbor(const unsigned char * labels, const NodeType & iNode) const;
+
+  /** Append the far neighbors of iNode that are not deferred yet to
+   * ioDeferred, as deferred. */
+  void
+  DeferFarNeighbors(const NodeType & iNode, NodeListType & ioDeferred);
+
+  /** Call function(first, last, chunk) on consecutive chunks of the
+   * numberOfNodes nodes, in parallel, and return the number of chunks. */
+  template <typename TFunction>
+  SizeValueType
+  ParallelizeNodes(SizeValueType numberOfNodes, TFunction && function);
+
+  /** Compute the arrival times of the nodes of the band below limit, from
+   * its active nodes, appending its new nodes to ioBandNodes and the
+   * neighbors of the band above limit to ioDeferred. */
+  void
+  PropagateBand(double limit, NodeListType & ioActive, NodeListType & ioBandNodes, NodeListType & ioDeferred);
+
+  /** Number of chunks into which the lists of nodes are split per work
+   * unit. */
+  static constexpr SizeValueType ChunksPerWorkUnit = 4;
+
+  /** Fewest nodes in a chunk. */
+  static constexpr SizeValueType MinimumChunkSize = 256;
+
+  std::vector<unsigned char> m_NodeFlags{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkParallelFastMarchingImageFilterBase.hxx"
+#endif
+
+#endif // itkParallelFastMarchingImageFilterBase_h
@@ -0,0 +1,455 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkParallelFastMarchingImageFilterBase_hxx
+#define itkParallelFastMarchingImageFilterBase_hxx
+
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace itk
+{
+
+template <typename TInput, typename TOutput>
+double
+ParallelFastMarchingImageFilterBase<TInput, TOutput>::ComputeValue(const OutputPixelType * values,
+                                                                   const unsigned char *   labels,
+                                                                   const NodeType &        iNode) const
+{
+  const OffsetValueType   offset = this->m_LabelImage->ComputeOffset(iNode);
+  const OffsetValueType * offsetTable = this->m_LabelImage->GetOffsetTable();
+
+  InternalNodeStructureArray neighbors;
+  for (unsigned int j = 0; j < ImageDimension; ++j)
+  {
+    InternalNodeStructure & neighbor = neighbors[j];
+    neighbor.m_Node = iNode;
+    neighbor.m_Value = this->m_LargeValue;
+    neighbor.m_Axis = j;
+
+    // Smallest value of the neighbors along j, final or not.
+    for (int s = -1; s < 2; s += 2)
+    {
+      const typename NodeType::IndexValueType temp = iNode[j] + s;
+      if (temp >= this->m_StartIndex[j] && temp <= this->m_LastIndex[j])
+      {
+        const OffsetValueType neighborOffset = offset + s * offsetTable[j];
+        if (labels[neighborOffset] != Traits::Forbidden && values[neighborOffset] < neighbor.m_Value)
+        {
+          neighbor.m_Value = values[neighborOffset];
+          neighbor.m_Node[j] = temp;
+        }
+      }
+    }
+  }
+
+  return this->Solve(nullptr, iNode, neighbors);
+}
+
+template <typename TInput, typename TOutput>
+bool
+ParallelFastMarchingImageFilterBase<TInput, TOutput>::HasAliveNeighbor(const unsigned char * labels,
+                                                                       const NodeType &      iNode) const
+{
+  const OffsetValueType   offset = this->m_LabelImage->ComputeOffset(iNode);
+  const OffsetValueType * offsetTable = this->m_LabelImage->GetOffsetTable();
+  for (unsigned int j = 0; j < ImageDimension; ++j)
+  {
+    if ((iNode[j] > this->m_StartIndex[j] && labels[offset - offsetTable[j]] == Traits::Alive) ||
+        (iNode[j] < this->m_LastIndex[j] && labels[offset + offsetTable[j]] == Traits::Alive))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename TInput, typename TOutput>
+void
+ParallelFastMarchingImageFilterBase<TInput, TOutput>::DeferFarNeighbors(const NodeType &  iNode,
+                                                                        NodeListType &    ioDeferred)
+{
+  for (unsigned int j = 0; j < ImageDimension; ++j)
+  {
+    NodeType neighbor = iNode;
+    for (int s = -1; s < 2; s += 2)
+    {
+      neighbor[j] = iNode[j] + s;
+      if (neighbor[j] >= this->m_StartIndex[j] && neighbor[j] <= this->m_LastIndex[j] &&
+          this->GetLabelValueForGivenNode(neighbor) == Traits::Far)
+      {
+        unsigned char & flags = m_NodeFlags[this->m_LabelImage->ComputeOffset(neighbor)];
+        if (!(flags & Deferred))
+        {
+          flags |= Deferred;
+          ioDeferred.push_back(neighbor);
+        }
+      }
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+template <typename TFunction>
+SizeValueType
+ParallelFastMarchingImageFilterBase<TInput, TOutput>::ParallelizeNodes(SizeValueType numberOfNodes,
+                                                                       TFunction &&  function)
+{
+  const SizeValueType numberOfChunks =
+    std::min(numberOfNodes / MinimumChunkSize + 1, ChunksPerWorkUnit * this->GetNumberOfWorkUnits());
+  if (numberOfChunks == 1)
+  {
+    function(SizeValueType{ 0 }, numberOfNodes, SizeValueType{ 0 });
+    return 1;
+  }
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [numberOfNodes, numberOfChunks, &function](SizeValueType chunk) {
+      function(numberOfNodes * chunk / numberOfChunks, numberOfNodes * (chunk + 1) / numberOfChunks, chunk);
+    },
+    nullptr);
+  return numberOfChunks;
+}
+
+template <typename TInput, typename TOutput>
+void
+ParallelFastMarchingImageFilterBase<TInput, TOutput>::PropagateBand(double         limit,
+                                                                    NodeListType & ioActive,
+                                                                    NodeListType & ioBandNodes,
+                                                                    NodeListType & ioDeferred)
+{
+  OutputImageType * const output = this->GetOutput();
+  OutputPixelType * const values = output->GetBufferPointer();
+  unsigned char * const   labels = this->m_LabelImage->GetBufferPointer();
+
+  const SizeValueType maximumNumberOfChunks = ChunksPerWorkUnit * this->GetNumberOfWorkUnits();
+
+  std::vector<OutputPixelType> newValues;
+  std::vector<unsigned char>   decreased;
+  std::vector<NodeListType>    keptNodes(maximumNumberOfChunks);
+  std::vector<NodeListType>    activatedNodes(maximumNumberOfChunks);
+  std::vector<NodeListType>    deferredNodes(maximumNumberOfChunks);
+
+  while (!ioActive.empty())
+  {
+    // Update the active nodes from the values of the previous iteration.
+    newValues.resize(ioActive.size());
+    decreased.resize(ioActive.size());
+    this->ParallelizeNodes(ioActive.size(), [&](SizeValueType first, SizeValueType last, SizeValueType) {
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        newValues[i] = static_cast<OutputPixelType>(this->ComputeValue(values, labels, ioActive[i]));
+      }
+    });
+
+    // Write the decreased values.  The active nodes that did not decrease
+    // have converged, and their neighbors that would decrease from them are
+    // activated, or deferred to a next band.
+    const SizeValueType numberOfChunks =
+      this->ParallelizeNodes(ioActive.size(), [&](SizeValueType first, SizeValueType last, SizeValueType chunk) {
+        for (SizeValueType i = first; i < last; ++i)
+        {
+          OutputPixelType & value = values[output->ComputeOffset(ioActive[i])];
+          decreased[i] = newValues[i] < value;
+          if (decreased[i])
+          {
+            value = newValues[i];
+            keptNodes[chunk].push_back(ioActive[i]);
+          }
+        }
+      });
+    this->ParallelizeNodes(ioActive.size(), [&](SizeValueType first, SizeValueType last, SizeValueType chunk) {
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        if (decreased[i])
+        {
+          continue;
+        }
+        const NodeType & node = ioActive[i];
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          NodeType neighbor = node;
+          for (int s = -1; s < 2; s += 2)
+          {
+            neighbor[j] = node[j] + s;
+            if (neighbor[j] < this->m_StartIndex[j] || neighbor[j] > this->m_LastIndex[j])
+            {
+              continue;
+            }
+            const OffsetValueType neighborOffset = output->ComputeOffset(neighbor);
+            const unsigned char   label = labels[neighborOffset];
+            if ((label != Traits::Far && label != Traits::Trial) || (m_NodeFlags[neighborOffset] & Active))
+            {
+              continue;
+            }
+            const auto value = static_cast<OutputPixelType>(this->ComputeValue(values, labels, neighbor));
+            if (value < values[neighborOffset])
+            {
+              if (static_cast<double>(value) < limit)
+              {
+                activatedNodes[chunk].push_back(neighbor);
+              }
+              else if (label == Traits::Far)
+              {
+                deferredNodes[chunk].push_back(neighbor);
+              }
+            }
+          }
+        }
+      }
+    });
+
+    // Merge the lists of the chunks.
+    for (const NodeType & node : ioActive)
+    {
+      m_NodeFlags[output->ComputeOffset(node)] &= ~Active;
+    }
+    ioActive.clear();
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      for (const NodeType & node : keptNodes[chunk])
+      {
+        m_NodeFlags[output->ComputeOffset(node)] |= Active;
+        ioActive.push_back(node);
+      }
+      keptNodes[chunk].clear();
+    }
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      for (const NodeType & node : activatedNodes[chunk])
+      {
+        const OffsetValueType offset = output->ComputeOffset(node);
+        if (!(m_NodeFlags[offset] & Active))
+        {
+          m_NodeFlags[offset] |= Active;
+          ioActive.push_back(node);
+          if (labels[offset] == Traits::Far)
+          {
+            labels[offset] = Traits::Trial;
+            ioBandNodes.push_back(node);
+          }
+        }
+      }
+      activatedNodes[chunk].clear();
+      for (const NodeType & node : deferredNodes[chunk])
+      {
+        const OffsetValueType offset = output->ComputeOffset(node);
+        if (!(m_NodeFlags[offset] & Deferred) && labels[offset] == Traits::Far)
+        {
+          m_NodeFlags[offset] |= Deferred;
+          ioDeferred.push_back(node);
+        }
+      }
+      deferredNodes[chunk].clear();
+    }
+  }
+}
+
+template <typename TInput, typename TOutput>
+void
+ParallelFastMarchingImageFilterBase<TInput, TOutput>::GenerateData()
+{
+  if (this->m_TopologyCheck != Superclass::TopologyCheckEnum::Nothing)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  OutputImageType * const output = this->GetOutput();
+
+  this->Initialize(output);
+
+  OutputPixelType * const values = output->GetBufferPointer();
+  unsigned char * const   labels = this->m_LabelImage->GetBufferPointer();
+
+  ProgressReporter progress(this, 0, this->GetTotalNumberOfNodes());
+
+  this->m_StoppingCriterion->Reinitialize();
+
+  m_NodeFlags.assign(this->m_BufferedRegion.GetNumberOfPixels(), 0);
+
+  // The trial points keep their values, and are made alive along with the
+  // nodes of the band of their value.
+  NodePairListType trialPoints;
+  while (!this->m_Heap.empty())
+  {
+    trialPoints.push_back(this->m_Heap.top());
+    this->m_Heap.pop();
+  }
+
+  // The front starts from the neighbors of the alive and trial points.
+  double       smallestValue = std::numeric_limits<double>::infinity();
+  NodeListType deferred;
+  if (this->m_AlivePoints)
+  {
+    for (const NodePairType & nodePair : this->m_AlivePoints->CastToSTLConstContainer())
+    {
+      if (this->m_BufferedRegion.IsInside(nodePair.GetNode()))
+      {
+        smallestValue = std::min(smallestValue, static_cast<double>(nodePair.GetValue()));
+        this->DeferFarNeighbors(nodePair.GetNode(), deferred);
+      }
+    }
+  }
+  for (const NodePairType & nodePair : trialPoints)
+  {
+    smallestValue = std::min(smallestValue, static_cast<double>(nodePair.GetValue()));
+    this->DeferFarNeighbors(nodePair.GetNode(), deferred);
+  }
+
+  const SizeValueType minimumBandSize = MinimumChunkSize * ChunksPerWorkUnit * this->GetNumberOfWorkUnits();
+
+  double           limit = -std::numeric_limits<double>::infinity();
+  double           width = 0.0;
+  SizeValueType    nextTrialPoint = 0;
+  NodeListType     active;
+  NodeListType     bandNodes;
+  NodePairListType bandNodePairs;
+  std::vector<double> deferredValues;
+  OutputPixelType     currentValue{};
+
+  while (!deferred.empty() || nextTrialPoint < trialPoints.size())
+  {
+    // Compute the values of the deferred nodes, to start the next band from
+    // those below its limit.
+    deferredValues.resize(deferred.size());
+    this->ParallelizeNodes(deferred.size(), [&](SizeValueType first, SizeValueType last, SizeValueType) {
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        deferredValues[i] = static_cast<double>(
+          static_cast<OutputPixelType>(this->ComputeValue(values, labels, deferred[i])));
+      }
+    });
+
+    if (width == 0.0)
+    {
+      const auto smallest = std::min_element(deferredValues.cbegin(), deferredValues.cend());
+      if (smallest != deferredValues.cend() && *smallest < static_cast<double>(this->m_LargeValue))
+      {
+        // The first band reaches one step beyond the closest neighbors.
+        limit = *smallest;
+        width = std::max(*smallest - smallestValue, std::abs(*smallest) * std::numeric_limits<double>::epsilon());
+        width = std::max(width, std::numeric_limits<double>::min());
+      }
+    }
+    limit = deferred.empty() ? std::numeric_limits<double>::infinity() : limit + width;
+
+    NodeListType stillDeferred;
+    for (SizeValueType i = 0; i < deferred.size(); ++i)
+    {
+      const OffsetValueType offset = output->ComputeOffset(deferred[i]);
+      m_NodeFlags[offset] &= ~Deferred;
+      if (labels[offset] != Traits::Far || deferredValues[i] >= static_cast<double>(this->m_LargeValue))
+      {
+        continue;
+      }
+      if (deferredValues[i] < limit)
+      {
+        m_NodeFlags[offset] |= Active;
+        labels[offset] = Traits::Trial;
+        active.push_back(deferred[i]);
+        bandNodes.push_back(deferred[i]);
+      }
+      else
+      {
+        m_NodeFlags[offset] |= Deferred;
+        stillDeferred.push_back(deferred[i]);
+      }
+    }
+    deferred.swap(stillDeferred);
+
+    this->PropagateBand(limit, active, bandNodes, deferred);
+
+    // Make the nodes of the band alive in increasing order of value, as long
+    // as the stopping criterion allows.
+    for (const NodeType & node : bandNodes)
+    {
+      bandNodePairs.emplace_back(node, values[output->ComputeOffset(node)]);
+    }
+    for (; nextTrialPoint < trialPoints.size() && trialPoints[nextTrialPoint].GetValue() < limit; ++nextTrialPoint)
+    {
+      bandNodePairs.push_back(trialPoints[nextTrialPoint]);
+    }
+    std::sort(bandNodePairs.begin(), bandNodePairs.end());
+
+    bool stopped = false;
+    for (auto nodePair = bandNodePairs.cbegin(); nodePair != bandNodePairs.cend(); ++nodePair)
+    {
+      currentValue = nodePair->GetValue();
+      this->m_StoppingCriterion->SetCurrentNodePair(*nodePair);
+      if (this->m_StoppingCriterion->IsSatisfied())
+      {
+        // The rest of the band and the deferred nodes keep the values that
+        // FastMarchingImageFilterBase gives them: those next to alive nodes
+        // are trial nodes, with the value computed from these alive nodes,
+        // and the others are far.  The trial points keep their values.
+        for (; nodePair != bandNodePairs.cend(); ++nodePair)
+        {
+          const OffsetValueType offset = output->ComputeOffset(nodePair->GetNode());
+          if (labels[offset] == Traits::Trial)
+          {
+            labels[offset] = Traits::Far;
+            values[offset] = this->m_LargeValue;
+            deferred.push_back(nodePair->GetNode());
+          }
+        }
+        for (const NodeType & node : deferred)
+        {
+          if (labels[output->ComputeOffset(node)] == Traits::Far && this->HasAliveNeighbor(labels, node))
+          {
+            this->UpdateValue(output, node);
+          }
+        }
+        stopped = true;
+        break;
+      }
+
+      if (this->m_CollectPoints)
+      {
+        this->m_ProcessedPoints->push_back(*nodePair);
+      }
+      labels[output->ComputeOffset(nodePair->GetNode())] = Traits::Alive;
+      progress.CompletedPixel();
+    }
+    if (stopped)
+    {
+      break;
+    }
+
+    // Widen the bands that are too small to keep the threads busy.
+    if (bandNodes.size() < minimumBandSize)
+    {
+      width *= 2.0;
+    }
+    bandNodes.clear();
+    bandNodePairs.clear();
+  }
+
+  this->m_TargetReachedValue = currentValue;
+  m_NodeFlags = {};
+}
+
+} // end namespace itk
+
+#endif // itkParallelFastMarchingImageFilterBase_hxx
@@ -180,6 +180,10 @@ itkFastMarchingBaseTest(int argc, char * argv[])
     fmm->SetNormalizationFactor(normalizationFactor);
     ITK_TEST_SET_GET_VALUE(normalizationFactor, fmm->GetNormalizationFactor());
 
+    constexpr double bucketWidth = 0.5;
+    fmm->SetBucketWidth(bucketWidth);
+    ITK_TEST_SET_GET_VALUE(bucketWidth, fmm->GetBucketWidth());
+
     collectPoints = true;
     ITK_TEST_SET_GET_BOOLEAN(fmm, CollectPoints, collectPoints);
 
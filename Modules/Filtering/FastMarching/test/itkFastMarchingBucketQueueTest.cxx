@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Checks that FastMarchingImageFilterBase computes the same arrival times
+// over a whole 3D speed image from a few seeds, whether its queue of trial
+// nodes is a binary heap, or a bucket queue whose width is a multiple of the
+// arrival time between neighbors at the highest speed.
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+constexpr unsigned int Dimension{ 3 };
+
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+using MarcherType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+using NodePairType = MarcherType::NodePairType;
+using NodePairContainerType = MarcherType::NodePairContainerType;
+
+constexpr double MaximumSpeed{ 1.5 };
+
+
+ImageType::Pointer
+MakeSpeedImage(itk::SizeValueType imageSize)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(imageSize));
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<PixelType>(1.0 + 0.5 * std::sin(0.1 * index[0]) * std::cos(0.13 * index[1] + 0.07 * index[2])));
+  }
+  return image;
+}
+
+
+// Runs the marcher and returns its output, or nullptr if it does not match
+// the reference.
+ImageType::Pointer
+RunMarcher(const ImageType * speedImage, double bucketWidth, const ImageType * reference)
+{
+  auto criterion = CriterionType::New();
+  criterion->SetThreshold(1e9);
+
+  auto alive = NodePairContainerType::New();
+  auto trial = NodePairContainerType::New();
+  const auto size = speedImage->GetBufferedRegion().GetSize();
+  for (const double fraction : { 0.25, 0.5, 0.75 })
+  {
+    ImageType::IndexType seed;
+    for (unsigned int j = 0; j < Dimension; ++j)
+    {
+      seed[j] = static_cast<itk::IndexValueType>(fraction * size[j]);
+    }
+    trial->push_back(NodePairType(seed, 0.0));
+  }
+
+  auto marcher = MarcherType::New();
+  marcher->SetInput(speedImage);
+  marcher->SetStoppingCriterion(criterion);
+  marcher->SetAlivePoints(alive);
+  marcher->SetTrialPoints(trial);
+  marcher->SetBucketWidth(bucketWidth);
+  marcher->Update();
+
+  ImageType::Pointer output = marcher->GetOutput();
+  if (reference != nullptr)
+  {
+    const PixelType * values = output->GetBufferPointer();
+    const PixelType * referenceValues = reference->GetBufferPointer();
+    for (itk::SizeValueType n = 0; n < output->GetBufferedRegion().GetNumberOfPixels(); ++n)
+    {
+      // The nodes of equal values may be made alive in a different order.
+      if (std::abs(values[n] - referenceValues[n]) > 1e-5f * (1.0f + referenceValues[n]))
+      {
+        std::cerr << "Value of pixel " << n << ": expected " << referenceValues[n] << ", but got " << values[n]
+                  << std::endl;
+        return nullptr;
+      }
+    }
+  }
+  return output;
+}
+
+} // namespace
+
+
+int
+itkFastMarchingBucketQueueTest(int, char *[])
+{
+  const ImageType::Pointer speedImage = MakeSpeedImage(32);
+
+  const ImageType::Pointer reference = RunMarcher(speedImage, 0.0, nullptr);
+  const double             width = 1.0 / MaximumSpeed;
+  ITK_TEST_EXPECT_TRUE(RunMarcher(speedImage, width, reference) != nullptr);
+  ITK_TEST_EXPECT_TRUE(RunMarcher(speedImage, 0.25 * width, reference) != nullptr);
+  ITK_TEST_EXPECT_TRUE(RunMarcher(speedImage, 4.0 * width, reference) != nullptr);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastMarchingPriorityQueue.h"
+#include "itkNodePair.h"
+#include "itkTestingMacros.h"
+
+#include <iostream>
+#include <queue>
+#include <random>
+
+namespace
+{
+using NodePairType = itk::NodePair<unsigned int, double>;
+using QueueType = itk::FastMarchingPriorityQueue<NodePairType>;
+using ReferenceQueueType = std::priority_queue<NodePairType, std::vector<NodePairType>, std::greater<NodePairType>>;
+
+// Push and pop the same pairs into the queue and into a std::priority_queue,
+// as a front would: each popped pair pushes a few larger values, most of them
+// close, some of them beyond the buckets, and some in the current bucket.
+// Return whether the pairs were popped in the same order of value.
+bool
+CompareWithReference(QueueType & queue, unsigned int seed)
+{
+  const double width = queue.GetBucketWidth() > 0.0 ? queue.GetBucketWidth() : 1.0;
+
+  std::mt19937                           generator(seed);
+  std::uniform_real_distribution<double> step(0.0, 3.0 * width);
+  std::uniform_int_distribution<int>     kind(0, 19);
+
+  ReferenceQueueType reference;
+  unsigned int       node = 0;
+  const auto         push = [&](double value) {
+    queue.push(NodePairType(node, value));
+    reference.push(NodePairType(node, value));
+    ++node;
+  };
+
+  // Initial trial values, some of them negative.
+  for (int i = 0; i < 20; ++i)
+  {
+    push(step(generator) - 10.0 * width);
+  }
+
+  bool         passed = true;
+  unsigned int numberOfPops = 0;
+  while (!reference.empty())
+  {
+    if (queue.size() != reference.size() || queue.empty())
+    {
+      std::cerr << "Size: expected " << reference.size() << ", but got " << queue.size() << std::endl;
+      return false;
+    }
+    const double value = queue.top().GetValue();
+    if (value != reference.top().GetValue())
+    {
+      std::cerr << "Pop " << numberOfPops << ": expected " << reference.top().GetValue() << ", but got " << value
+                << std::endl;
+      passed = false;
+    }
+    queue.pop();
+    reference.pop();
+    ++numberOfPops;
+
+    if (node < 20000)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        switch (kind(generator))
+        {
+          case 0:
+            push(value + 5000.0 * width * (1.0 + step(generator)));
+            break;
+          case 1:
+            push(value);
+            break;
+          default:
+            push(value + step(generator));
+        }
+      }
+    }
+  }
+  if (!queue.empty())
+  {
+    std::cerr << "The queue is not empty after " << numberOfPops << " pops" << std::endl;
+    passed = false;
+  }
+  return passed;
+}
+} // namespace
+
+int
+itkFastMarchingPriorityQueueTest(int, char *[])
+{
+  QueueType queue;
+  ITK_TEST_EXPECT_EQUAL(queue.GetBucketWidth(), 0.0);
+  ITK_TEST_EXPECT_TRUE(queue.empty());
+
+  bool passed = true;
+
+  // A binary heap.
+  passed &= CompareWithReference(queue, 1);
+
+  // Bucket queues, whose buckets are reused after clear().
+  for (const double width : { 0.25, 1.0, 7.5 })
+  {
+    queue.SetBucketWidth(width);
+    ITK_TEST_EXPECT_EQUAL(queue.GetBucketWidth(), width);
+    passed &= CompareWithReference(queue, 2);
+
+    queue.push(NodePairType(0, 1.0));
+    queue.push(NodePairType(1, 1e9));
+    queue.clear();
+    ITK_TEST_EXPECT_TRUE(queue.empty());
+    passed &= CompareWithReference(queue, 3);
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
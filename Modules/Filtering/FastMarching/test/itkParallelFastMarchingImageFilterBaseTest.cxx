@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkParallelFastMarchingImageFilterBase.h"
+#include "itkFastMarchingReachedTargetNodesStoppingCriterion.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkIndexRange.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+using SerialMarcherType = itk::FastMarchingImageFilterBase<ImageType, ImageType>;
+using ParallelMarcherType = itk::ParallelFastMarchingImageFilterBase<ImageType, ImageType>;
+using StoppingCriterionType = itk::FastMarchingStoppingCriterionBase<ImageType, ImageType>;
+using NodePairType = SerialMarcherType::NodePairType;
+using NodePairContainerType = SerialMarcherType::NodePairContainerType;
+
+// A speed image that varies smoothly, on an anisotropic grid.  The speed is
+// low on the border of the image, which FastMarchingImageFilterBase does not
+// propagate from, so that the arrival times of the interior do not depend on
+// it.
+ImageType::Pointer
+MakeSpeedImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType{ { { 48, 40, 28 } } });
+  image->SetSpacing(itk::MakeVector(1.0, 0.75, 1.5));
+  image->Allocate();
+  const ImageType::RegionType interior{ { { 1, 1, 1 } }, { { 46, 38, 26 } } };
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(image->GetBufferedRegion()))
+  {
+    const double speed =
+      interior.IsInside(index) ? 1.0 + 0.5 * std::sin(0.2 * index[0]) * std::cos(0.15 * index[1]) : 0.05;
+    image->SetPixel(index, static_cast<PixelType>(speed));
+  }
+  return image;
+}
+
+// Run a marcher from a seed, with trial points around it, a second trial
+// point farther away, and a wall of forbidden points.
+template <typename TMarcher>
+typename TMarcher::Pointer
+RunMarcher(const ImageType * speedImage, StoppingCriterionType * criterion)
+{
+  auto marcher = TMarcher::New();
+  marcher->SetInput(speedImage);
+  marcher->SetStoppingCriterion(criterion);
+  marcher->CollectPointsOn();
+
+  constexpr ImageType::IndexType seed{ { 12, 20, 10 } };
+
+  auto alive = NodePairContainerType::New();
+  alive->push_back(NodePairType(seed, 0.0));
+  marcher->SetAlivePoints(alive);
+
+  auto trial = NodePairContainerType::New();
+  for (unsigned int j = 0; j < Dimension; ++j)
+  {
+    for (const int s : { -1, 1 })
+    {
+      ImageType::IndexType index = seed;
+      index[j] += s;
+      trial->push_back(NodePairType(index, static_cast<PixelType>(speedImage->GetSpacing()[j])));
+    }
+  }
+  trial->push_back(NodePairType(ImageType::IndexType{ { 40, 8, 20 } }, 5.0));
+  marcher->SetTrialPoints(trial);
+
+  auto forbidden = NodePairContainerType::New();
+  for (itk::IndexValueType y = 5; y < 35; ++y)
+  {
+    for (itk::IndexValueType z = 0; z < 20; ++z)
+    {
+      forbidden->push_back(NodePairType(ImageType::IndexType{ { 24, y, z } }, 0.0));
+    }
+  }
+  marcher->SetForbiddenPoints(forbidden);
+
+  marcher->Update();
+  return marcher;
+}
+
+// Whether the node at index has a neighbor that is alive for one marcher
+// and not for the other.
+bool
+HasNeighborAliveForEither(const SerialMarcherType::LabelImageType *   serialLabels,
+                          const ParallelMarcherType::LabelImageType * parallelLabels,
+                          const ImageType::IndexType &                index)
+{
+  for (unsigned int j = 0; j < Dimension; ++j)
+  {
+    for (const int s : { -1, 1 })
+    {
+      ImageType::IndexType neighbor = index;
+      neighbor[j] += s;
+      if (serialLabels->GetBufferedRegion().IsInside(neighbor) &&
+          (serialLabels->GetPixel(neighbor) == SerialMarcherType::Traits::Alive) !=
+            (parallelLabels->GetPixel(neighbor) == ParallelMarcherType::Traits::Alive))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Compare the arrival times and alive nodes of the parallel marcher with
+// those of the serial one, and, after a stop, the values and labels of the
+// other nodes.
+bool
+CompareMarchers(SerialMarcherType * serial, ParallelMarcherType * parallel)
+{
+  const ImageType * serialOutput = serial->GetOutput();
+  const ImageType * parallelOutput = parallel->GetOutput();
+
+  const auto * serialLabels = serial->GetLabelImage();
+  const auto * parallelLabels = parallel->GetLabelImage();
+
+  bool passed = true;
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(serialOutput->GetBufferedRegion()))
+  {
+    const bool serialAlive = serialLabels->GetPixel(index) == SerialMarcherType::Traits::Alive;
+    const bool parallelAlive = parallelLabels->GetPixel(index) == ParallelMarcherType::Traits::Alive;
+    if (serialAlive != parallelAlive)
+    {
+      // The nodes of equal value may be made alive in either order.
+      if (std::abs(parallelOutput->GetPixel(index) - serial->GetTargetReachedValue()) > 1e-4f)
+      {
+        std::cerr << "Node " << index << " is " << (serialAlive ? "" : "not ") << "alive with serial value "
+                  << serialOutput->GetPixel(index) << ", but " << (parallelAlive ? "" : "not ")
+                  << "alive with parallel value " << parallelOutput->GetPixel(index) << std::endl;
+        passed = false;
+      }
+    }
+    else if (!serialAlive && serialLabels->GetPixel(index) != parallelLabels->GetPixel(index))
+    {
+      // The trial nodes next to nodes of equal value that are alive for
+      // either marcher may differ.
+      if (!HasNeighborAliveForEither(serialLabels, parallelLabels, index))
+      {
+        std::cerr << "Node " << index << " has label " << static_cast<int>(serialLabels->GetPixel(index))
+                  << ", but got " << static_cast<int>(parallelLabels->GetPixel(index)) << std::endl;
+        passed = false;
+      }
+    }
+    else if (std::abs(serialOutput->GetPixel(index) - parallelOutput->GetPixel(index)) >
+               1e-5f * (1.0f + serialOutput->GetPixel(index)) &&
+             (serialAlive || !HasNeighborAliveForEither(serialLabels, parallelLabels, index)))
+    {
+      std::cerr << "Value at " << index << ": expected " << serialOutput->GetPixel(index) << ", but got "
+                << parallelOutput->GetPixel(index) << std::endl;
+      passed = false;
+    }
+  }
+  if (std::abs(serial->GetTargetReachedValue() - parallel->GetTargetReachedValue()) > 1e-4f)
+  {
+    std::cerr << "TargetReachedValue: expected " << serial->GetTargetReachedValue() << ", but got "
+              << parallel->GetTargetReachedValue() << std::endl;
+    passed = false;
+  }
+  return passed;
+}
+} // namespace
+
+int
+itkParallelFastMarchingImageFilterBaseTest(int, char *[])
+{
+  const auto speedImage = MakeSpeedImage();
+
+  auto marcher = ParallelMarcherType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(marcher, ParallelFastMarchingImageFilterBase, FastMarchingImageFilterBase);
+
+  bool passed = true;
+
+  // Propagate over the whole image.
+  {
+    using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+    auto criterion = CriterionType::New();
+    criterion->SetThreshold(1e6);
+
+    const auto serial = RunMarcher<SerialMarcherType>(speedImage, criterion);
+    const auto parallel = RunMarcher<ParallelMarcherType>(speedImage, criterion);
+    passed &= CompareMarchers(serial, parallel);
+    ITK_TEST_EXPECT_EQUAL(serial->GetProcessedPoints()->Size(), parallel->GetProcessedPoints()->Size());
+  }
+
+  // Stop at a threshold.
+  {
+    using CriterionType = itk::FastMarchingThresholdStoppingCriterion<ImageType, ImageType>;
+    auto criterion = CriterionType::New();
+    criterion->SetThreshold(12.5);
+
+    const auto serial = RunMarcher<SerialMarcherType>(speedImage, criterion);
+    const auto parallel = RunMarcher<ParallelMarcherType>(speedImage, criterion);
+    passed &= CompareMarchers(serial, parallel);
+    for (const auto & nodePair : parallel->GetProcessedPoints()->CastToSTLConstContainer())
+    {
+      if (nodePair.GetValue() > criterion->GetThreshold())
+      {
+        std::cerr << "Node " << nodePair.GetNode() << " made alive beyond the threshold" << std::endl;
+        passed = false;
+      }
+    }
+  }
+
+  // Stop when target nodes are reached.
+  {
+    using CriterionType = itk::FastMarchingReachedTargetNodesStoppingCriterion<ImageType, ImageType>;
+    auto criterion = CriterionType::New();
+    criterion->SetTargetCondition(CriterionType::TargetConditionEnum::AllTargets);
+    criterion->SetTargetNodes({ ImageType::IndexType{ { 30, 20, 10 } }, ImageType::IndexType{ { 5, 35, 25 } } });
+
+    const auto serial = RunMarcher<SerialMarcherType>(speedImage, criterion);
+    const auto parallel = RunMarcher<ParallelMarcherType>(speedImage, criterion);
+    passed &= CompareMarchers(serial, parallel);
+    ITK_TEST_EXPECT_EQUAL(serial->GetProcessedPoints()->Size(), parallel->GetProcessedPoints()->Size());
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -22,6 +22,9 @@
 #include "itkFixedArray.h"
 #include "itkNeighborhoodIterator.h"
 #include "itkNeighborhood.h"
+#include "itkPermutohedralLattice.h"
+
+#include <memory>
 
 namespace itk
 {
@@ -38,12 +41,9 @@ namespace itk
  * regions yet has edges preserved. The result is similar to
  * anisotropic diffusion but the implementation in non-iterative.
  * Another benefit to bilateral filtering is that any distance metric
- * can be used for kernel smoothing the image range.  Hence, color
- * images can be smoothed as vector images, using the CIE distances
- * between intensity values as the similarity metric (the Gaussian
- * kernel for the image domain is evaluated using CIE distances).
- * A separate version of this filter will be designed for color
- * and vector images.
+ * can be used for kernel smoothing the image range.  Vector images,
+ * and color images, are smoothed with the Euclidean distance between
+ * their pixels in the image range.
  *
  * Bilateral filtering is capable of reducing the noise in an image
  * by an order of magnitude while maintaining edges.
@@ -51,6 +51,19 @@ namespace itk
  * The bilateral operator used here was described by Tomasi and
  * Manduchi in \cite tomasi1998.
  *
+ * The exact filter sums a whole domain neighborhood for each pixel,
+ * whose number of pixels grows as the domain sigma to the power of the
+ * image dimension.  With UsePermutohedralLattice on, the filter is
+ * instead approximated as a Gaussian in the space of the positions
+ * divided by the domain sigma and the pixel components divided by the
+ * range sigma, on a permutohedral lattice, in a time linear in the
+ * number of pixels, whatever the sigmas \cite adams2010.
+ * The Gaussians are not truncated then, and pixels outside the image
+ * do not contribute, so that the Radius, DomainMu and
+ * NumberOfRangeGaussianSamples are not used.  LatticeBlurRadius trades
+ * speed for accuracy.  Every input pixel contributes to the lattice, so
+ * that the whole output is then computed at once, without streaming.
+ *
  * \sa GaussianOperator
  * \sa RecursiveGaussianImageFilter
  * \sa DiscreteGaussianImageFilter
@@ -61,8 +74,6 @@ namespace itk
  *
  * \ingroup ImageEnhancement
  * \ingroup ImageFeatureExtraction
- * \todo Support color images
- * \todo Support vector images
  * \ingroup ITKImageFeature
  *
  * \sphinx
@@ -171,6 +182,28 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
   /** @ITKEndGrouping */
+
+  /** Set/Get whether the filter is approximated on a permutohedral
+   * lattice, rather than computed exactly on a neighborhood of each pixel.
+   * The output requested region is then enlarged to the largest possible
+   * region.  Default is off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UsePermutohedralLattice, bool);
+  itkGetConstMacro(UsePermutohedralLattice, bool);
+  itkBooleanMacro(UsePermutohedralLattice);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the radius of the kernel that blurs the permutohedral
+   * lattice, in lattice steps.  Default is 1, the standard lattice, whose
+   * spacing is about the sigmas.  Larger radii make the lattice finer,
+   * about by the square root of the radius, and approximate the Gaussians
+   * better, at the cost of a number of lattice vertices that grows quickly
+   * with the number of pixel components.
+   * \sa PermutohedralLattice */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(LatticeBlurRadius, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(LatticeBlurRadius, unsigned int);
+  /** @ITKEndGrouping */
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputPixelType>));
 
 protected:
@@ -188,6 +221,10 @@ protected:
   void
   BeforeThreadedGenerateData() override;
 
+  /** Release the permutohedral lattice. */
+  void
+  AfterThreadedGenerateData() override;
+
   /** Standard pipeline method. This filter is implemented as a multi-threaded
    * filter. */
   void
@@ -202,7 +239,30 @@ protected:
   void
   GenerateInputRequestedRegion() override;
 
+  /** The lattice is splatted from the whole input: with
+   * UsePermutohedralLattice on, the output requested region is enlarged to
+   * the largest possible region, so that the output does not depend on how
+   * it is streamed. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
 private:
+  using OutputPixelRealValueType = typename NumericTraits<OutputPixelRealType>::ValueType;
+
+  /** The distance between two pixels in the image range. */
+  static OutputPixelRealValueType
+  ComputeRangeDistance(const OutputPixelRealType & pixel1, const OutputPixelRealType & pixel2);
+
+  /** The position of a pixel of the input in the space of the lattice. */
+  void
+  ComputeLatticePosition(const typename InputImageType::IndexType & index,
+                         const InputPixelType &                     pixel,
+                         std::vector<double> &                      position) const;
+
+  /** Splat the input pixels onto the permutohedral lattice, and blur it. */
+  void
+  BuildPermutohedralLattice();
+
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
   double m_RangeSigma{};
@@ -229,6 +289,10 @@ private:
   double              m_DynamicRange{};
   double              m_DynamicRangeUsed{};
   std::vector<double> m_RangeGaussianTable{};
+
+  bool                                  m_UsePermutohedralLattice{ false };
+  unsigned int                          m_LatticeBlurRadius{ 1 };
+  std::unique_ptr<PermutohedralLattice> m_Lattice{};
 };
 } // end namespace itk
 
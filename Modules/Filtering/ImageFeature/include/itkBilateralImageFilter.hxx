@@ -19,13 +19,17 @@
 #define itkBilateralImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "itkGaussianImageSource.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkTotalProgressReporter.h"
-#include "itkStatisticsImageFilter.h"
 
+#include <algorithm>
 #include <cmath> // For abs.
+#include <mutex>
+#include <type_traits>
 
 namespace itk
 {
@@ -118,10 +122,69 @@ BilateralImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
   throw e;
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  if (m_UsePermutohedralLattice)
+  {
+    output->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
+  const InputImageType * inputImage = this->GetInput();
+
+  // Determine the dynamic range of the input intensities, the largest one
+  // over the components of vector pixels
+  const unsigned int  numberOfComponents = inputImage->GetNumberOfComponentsPerPixel();
+  std::vector<double> minimum(numberOfComponents, NumericTraits<double>::max());
+  std::vector<double> maximum(numberOfComponents, NumericTraits<double>::NonpositiveMin());
+  std::mutex          mutex;
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    inputImage->GetBufferedRegion(),
+    [&](const typename InputImageType::RegionType & region) {
+      std::vector<double> regionMinimum(numberOfComponents, NumericTraits<double>::max());
+      std::vector<double> regionMaximum(numberOfComponents, NumericTraits<double>::NonpositiveMin());
+      for (ImageRegionConstIterator<TInputImage> it(inputImage, region); !it.IsAtEnd(); ++it)
+      {
+        const InputPixelType pixel = it.Get();
+        for (unsigned int k = 0; k < numberOfComponents; ++k)
+        {
+          const auto component =
+            static_cast<double>(DefaultConvertPixelTraits<InputPixelType>::GetNthComponent(k, pixel));
+          regionMinimum[k] = std::min(regionMinimum[k], component);
+          regionMaximum[k] = std::max(regionMaximum[k], component);
+        }
+      }
+
+      // The extrema do not depend on the order of the regions.
+      const std::lock_guard<std::mutex> lock(mutex);
+      for (unsigned int k = 0; k < numberOfComponents; ++k)
+      {
+        minimum[k] = std::min(minimum[k], regionMinimum[k]);
+        maximum[k] = std::max(maximum[k], regionMaximum[k]);
+      }
+    },
+    nullptr);
+  m_DynamicRange = 0.0;
+  for (unsigned int k = 0; k < numberOfComponents; ++k)
+  {
+    m_DynamicRange = std::max(m_DynamicRange, maximum[k] - minimum[k]);
+  }
+
+  m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
+
+  if (m_UsePermutohedralLattice)
+  {
+    this->BuildPermutohedralLattice();
+    return;
+  }
+
   // Build a small image of the n-dimensional Gaussian used for domain filter
   //
   // Gaussian image size will be (2*std::ceil(2.5*sigma)+1) x
@@ -130,8 +193,6 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
   typename InputImageType::SizeType radius;
   typename InputImageType::SizeType domainKernelSize;
 
-  const InputImageType * inputImage = this->GetInput();
-
   const typename InputImageType::SpacingType inputSpacing = inputImage->GetSpacing();
   const typename InputImageType::PointType   inputOrigin = inputImage->GetOrigin();
 
@@ -190,32 +251,13 @@ BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
     *kernel_it = git.Get() / norm;
   }
 
-  // Build a lookup table for the range gaussian
-
-  auto localInput = TInputImage::New();
-  localInput->Graft(this->GetInput());
-
-  // First, determine the min and max intensity range
-  auto statistics = StatisticsImageFilter<TInputImage>::New();
-
-  statistics->SetInput(localInput);
-  statistics->Update();
-
-  // Now create the lookup table whose domain runs from 0.0 to
-  // (max-min) and range is gaussian evaluated at
-  // that point
+  // Build a lookup table for the range gaussian, whose domain runs from 0.0
+  // to (max-min) and range is gaussian evaluated at that point
   const double rangeVariance = m_RangeSigma * m_RangeSigma;
 
   // denominator (normalization factor) for Gaussian used for range
   const double rangeGaussianDenom = m_RangeSigma * std::sqrt(2.0 * itk::Math::pi);
 
-  // Maximum delta for the dynamic range
-
-
-  m_DynamicRange = (static_cast<double>(statistics->GetMaximum()) - static_cast<double>(statistics->GetMinimum()));
-
-  m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
-
   double tableDelta = m_DynamicRangeUsed / static_cast<double>(m_NumberOfRangeGaussianSamples);
 
   // Finally, build the table
@@ -237,6 +279,40 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const typename TInputImage::ConstPointer input = this->GetInput();
   const typename TOutputImage::Pointer     output = this->GetOutput();
 
+  if (m_UsePermutohedralLattice)
+  {
+    using OutputComponentType = typename DefaultConvertPixelTraits<OutputPixelType>::ComponentType;
+
+    const unsigned int numberOfComponents = m_Lattice->GetValueDimension() - 1;
+
+    TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+    // Slice the lattice at the position of each pixel, and normalize by the
+    // sum of the weights
+    PermutohedralLattice::SimplexType simplex;
+    std::vector<double>               position(m_Lattice->GetPositionDimension());
+    std::vector<double>               value(m_Lattice->GetValueDimension());
+    OutputPixelType                   outputPixel;
+    NumericTraits<OutputPixelType>::SetLength(outputPixel, numberOfComponents);
+
+    ImageRegionConstIteratorWithIndex<InputImageType> i_iter(input, outputRegionForThread);
+    ImageRegionIterator<OutputImageType>              o_iter(output, outputRegionForThread);
+    for (; !i_iter.IsAtEnd(); ++i_iter, ++o_iter)
+    {
+      this->ComputeLatticePosition(i_iter.GetIndex(), i_iter.Get(), position);
+      m_Lattice->ComputeSimplex(position.data(), simplex);
+      m_Lattice->Slice(simplex, value.data());
+      for (unsigned int k = 0; k < numberOfComponents; ++k)
+      {
+        DefaultConvertPixelTraits<OutputPixelType>::SetNthComponent(
+          k, outputPixel, static_cast<OutputComponentType>(value[k] / value[numberOfComponents]));
+      }
+      o_iter.Set(outputPixel);
+      progress.CompletedPixel();
+    }
+    return;
+  }
+
   const double rangeDistanceThreshold = m_DynamicRangeUsed;
 
   // Find the boundary "faces"
@@ -266,9 +342,9 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
     while (!b_iter.IsAtEnd())
     {
       // Setup
-      const auto          centerPixel = static_cast<OutputPixelRealType>(b_iter.GetCenterPixel());
-      OutputPixelRealType val = 0.0;
-      OutputPixelRealType normFactor = 0.0;
+      const auto               centerPixel = static_cast<OutputPixelRealType>(b_iter.GetCenterPixel());
+      OutputPixelRealType      val = NumericTraits<OutputPixelRealType>::ZeroValue(centerPixel);
+      OutputPixelRealValueType normFactor = 0.0;
 
       // Walk the neighborhood of the input and the kernel
       KernelConstIteratorType k_it = m_GaussianKernel.Begin();
@@ -277,18 +353,18 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
         // range distance between neighborhood pixel and neighborhood center
         const auto pixel = static_cast<OutputPixelRealType>(b_iter.GetPixel(i));
         // flip sign if needed
-        const OutputPixelRealType rangeDistance = std::abs(pixel - centerPixel);
+        const OutputPixelRealValueType rangeDistance = ComputeRangeDistance(pixel, centerPixel);
 
         // if the range distance is close enough, then use the pixel
         if (rangeDistance < rangeDistanceThreshold)
         {
           // look up the range gaussian in a table
-          const OutputPixelRealType tableArg = rangeDistance * distanceToTableIndex;
-          const OutputPixelRealType rangeGaussian = m_RangeGaussianTable[Math::Floor<SizeValueType>(tableArg)];
+          const OutputPixelRealValueType tableArg = rangeDistance * distanceToTableIndex;
+          const OutputPixelRealValueType rangeGaussian = m_RangeGaussianTable[Math::Floor<SizeValueType>(tableArg)];
 
           // normalization factor so filter integrates to one
           // (product of the domain and the range gaussian)
-          const OutputPixelRealType gaussianProduct = *k_it * rangeGaussian;
+          const OutputPixelRealValueType gaussianProduct = *k_it * rangeGaussian;
           normFactor += gaussianProduct;
 
           // Input Image * Domain Gaussian * Range Gaussian
@@ -308,6 +384,117 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
+{
+  m_Lattice.reset();
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+BilateralImageFilter<TInputImage, TOutputImage>::ComputeRangeDistance(const OutputPixelRealType & pixel1,
+                                                                      const OutputPixelRealType & pixel2)
+  -> OutputPixelRealValueType
+{
+  if constexpr (std::is_arithmetic_v<OutputPixelRealType>)
+  {
+    return std::abs(pixel1 - pixel2);
+  }
+  else
+  {
+    // Euclidean distance between vector pixels
+    const OutputPixelRealType difference = pixel1 - pixel2;
+    OutputPixelRealValueType  sumOfSquares = 0.0;
+    for (unsigned int k = 0; k < NumericTraits<OutputPixelRealType>::GetLength(difference); ++k)
+    {
+      const OutputPixelRealValueType component =
+        DefaultConvertPixelTraits<OutputPixelRealType>::GetNthComponent(k, difference);
+      sumOfSquares += component * component;
+    }
+    return std::sqrt(sumOfSquares);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::ComputeLatticePosition(
+  const typename InputImageType::IndexType & index,
+  const InputPixelType &                     pixel,
+  std::vector<double> &                      position) const
+{
+  // The position divided by the domain sigma, followed by the components of
+  // the pixel divided by the range sigma
+  const typename InputImageType::SpacingType & spacing = this->GetInput()->GetSpacing();
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    position[i] = index[i] * spacing[i] / m_DomainSigma[i];
+  }
+  for (unsigned int k = ImageDimension; k < position.size(); ++k)
+  {
+    position[k] =
+      static_cast<double>(DefaultConvertPixelTraits<InputPixelType>::GetNthComponent(k - ImageDimension, pixel)) /
+      m_RangeSigma;
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::BuildPermutohedralLattice()
+{
+  using LatticePointer = std::unique_ptr<PermutohedralLattice>;
+
+  const InputImageType * input = this->GetInput();
+  const unsigned int     numberOfComponents = input->GetNumberOfComponentsPerPixel();
+  const unsigned int     positionDimension = ImageDimension + numberOfComponents;
+
+  // Each chunk of the input is splatted onto a lattice of its own, with the
+  // components of its pixels followed by a unit weight.  The lattices are
+  // merged in the order of the chunks, so that the sums do not depend on the
+  // scheduling of the work units.
+  std::vector<std::pair<OffsetValueType, LatticePointer>> chunkLattices;
+  std::mutex                                              mutex;
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    input->GetBufferedRegion(),
+    [this, input, numberOfComponents, positionDimension, &chunkLattices, &mutex](
+      const typename InputImageType::RegionType & chunk) {
+      auto lattice =
+        std::make_unique<PermutohedralLattice>(positionDimension, numberOfComponents + 1, m_LatticeBlurRadius);
+
+      PermutohedralLattice::SimplexType simplex;
+      std::vector<double>               position(positionDimension);
+      std::vector<double>               value(numberOfComponents + 1, 1.0);
+      for (ImageRegionConstIteratorWithIndex<InputImageType> it(input, chunk); !it.IsAtEnd(); ++it)
+      {
+        const InputPixelType pixel = it.Get();
+        for (unsigned int k = 0; k < numberOfComponents; ++k)
+        {
+          value[k] = static_cast<double>(DefaultConvertPixelTraits<InputPixelType>::GetNthComponent(k, pixel));
+        }
+        this->ComputeLatticePosition(it.GetIndex(), pixel, position);
+        lattice->ComputeSimplex(position.data(), simplex);
+        lattice->Splat(simplex, value.data());
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      chunkLattices.emplace_back(input->ComputeOffset(chunk.GetIndex()), std::move(lattice));
+    },
+    nullptr);
+
+  std::sort(chunkLattices.begin(), chunkLattices.end(), [](const auto & chunk1, const auto & chunk2) {
+    return chunk1.first < chunk2.first;
+  });
+  m_Lattice = std::make_unique<PermutohedralLattice>(positionDimension, numberOfComponents + 1, m_LatticeBlurRadius);
+  for (const auto & chunkLattice : chunkLattices)
+  {
+    m_Lattice->Merge(*chunkLattice.second);
+  }
+  chunkLattices.clear();
+
+  m_Lattice->Blur(this->GetMultiThreader());
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -322,6 +509,8 @@ BilateralImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "UsePermutohedralLattice: " << m_UsePermutohedralLattice << std::endl;
+  os << indent << "LatticeBlurRadius: " << m_LatticeBlurRadius << std::endl;
 }
 } // end namespace itk
 
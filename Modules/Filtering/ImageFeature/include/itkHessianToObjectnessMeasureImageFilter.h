@@ -122,6 +122,11 @@ public:
   itkGetConstMacro(BrightObject, bool);
   itkBooleanMacro(BrightObject);
   /** @ITKEndGrouping */
+  /** Compute the objectness measure from the eigenvalues of a Hessian, in
+   * any order.  This is the measure of each pixel of the output. */
+  double
+  ComputeObjectnessMeasure(const EigenValueArrayType & eigenValues) const;
+
   itkConceptMacro(DoubleConvertibleToOutputCheck, (Concept::Convertible<double, OutputPixelType>));
 
 protected:
@@ -73,105 +73,102 @@ HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreade
     EigenValueArrayType eigenValues;
     eigenCalculator.ComputeEigenValues(it.Get(), eigenValues);
 
-    // Sort the eigenvalues by magnitude but retain their sign.
-    // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
-    EigenValueArrayType sortedEigenValues = eigenValues;
-    std::sort(sortedEigenValues.Begin(), sortedEigenValues.End(), AbsLessCompare());
-
-    // Check whether eigenvalues have the right sign
-    bool signConstraintsSatisfied = true;
-    for (unsigned int i = m_ObjectDimension; i < ImageDimension; ++i)
-    {
-      if ((m_BrightObject && sortedEigenValues[i] > 0.0) || (!m_BrightObject && sortedEigenValues[i] < 0.0))
-      {
-        signConstraintsSatisfied = false;
-        break;
-      }
-    }
+    oit.Set(static_cast<OutputPixelType>(this->ComputeObjectnessMeasure(eigenValues)));
 
-    if (!signConstraintsSatisfied)
-    {
-      oit.Set(OutputPixelType{});
-      ++it;
-      ++oit;
-      progress.CompletedPixel();
-      continue;
-    }
+    ++it;
+    ++oit;
+    progress.CompletedPixel();
+  }
+}
 
-    EigenValueArrayType sortedAbsEigenValues;
-    for (unsigned int i = 0; i < ImageDimension; ++i)
+template <typename TInputImage, typename TOutputImage>
+double
+HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::ComputeObjectnessMeasure(
+  const EigenValueArrayType & eigenValues) const
+{
+  // Sort the eigenvalues by magnitude but retain their sign.
+  // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
+  EigenValueArrayType sortedEigenValues = eigenValues;
+  std::sort(sortedEigenValues.Begin(), sortedEigenValues.End(), AbsLessCompare());
+
+  // Check whether eigenvalues have the right sign
+  for (unsigned int i = m_ObjectDimension; i < ImageDimension; ++i)
+  {
+    if ((m_BrightObject && sortedEigenValues[i] > 0.0) || (!m_BrightObject && sortedEigenValues[i] < 0.0))
     {
-      sortedAbsEigenValues[i] = itk::Math::Absolute(sortedEigenValues[i]);
+      return 0.0;
     }
+  }
+
+  EigenValueArrayType sortedAbsEigenValues;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    sortedAbsEigenValues[i] = itk::Math::Absolute(sortedEigenValues[i]);
+  }
 
-    // Initialize the objectness measure
-    double objectnessMeasure = 1.0;
+  // Initialize the objectness measure
+  double objectnessMeasure = 1.0;
 
-    // Compute objectness from eigenvalue ratios and second-order structureness
-    if (m_ObjectDimension < ImageDimension - 1)
+  // Compute objectness from eigenvalue ratios and second-order structureness
+  if (m_ObjectDimension < ImageDimension - 1)
+  {
+    double rA = sortedAbsEigenValues[m_ObjectDimension];
+    double rADenominatorBase = 1.0;
+    for (unsigned int j = m_ObjectDimension + 1; j < ImageDimension; ++j)
     {
-      double rA = sortedAbsEigenValues[m_ObjectDimension];
-      double rADenominatorBase = 1.0;
-      for (unsigned int j = m_ObjectDimension + 1; j < ImageDimension; ++j)
-      {
-        rADenominatorBase *= sortedAbsEigenValues[j];
-      }
-      if (itk::Math::Absolute(rADenominatorBase) > 0.0)
-      {
-        if (itk::Math::Absolute(m_Alpha) > 0.0)
-        {
-          rA /= std::pow(rADenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension - 1));
-          objectnessMeasure *= 1.0 - std::exp(-0.5 * itk::Math::sqr(rA) / itk::Math::sqr(m_Alpha));
-        }
-      }
-      else
-      {
-        objectnessMeasure = 0.0;
-      }
+      rADenominatorBase *= sortedAbsEigenValues[j];
     }
-
-    if (m_ObjectDimension > 0)
+    if (itk::Math::Absolute(rADenominatorBase) > 0.0)
     {
-      double rB = sortedAbsEigenValues[m_ObjectDimension - 1];
-      double rBDenominatorBase = 1.0;
-      for (unsigned int j = m_ObjectDimension; j < ImageDimension; ++j)
-      {
-        rBDenominatorBase *= sortedAbsEigenValues[j];
-      }
-      if (itk::Math::Absolute(rBDenominatorBase) > 0.0 && itk::Math::Absolute(m_Beta) > 0.0)
-      {
-        rB /= std::pow(rBDenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension));
-
-        objectnessMeasure *= std::exp(-0.5 * itk::Math::sqr(rB) / itk::Math::sqr(m_Beta));
-      }
-      else
+      if (itk::Math::Absolute(m_Alpha) > 0.0)
       {
-        objectnessMeasure = 0.0;
+        rA /= std::pow(rADenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension - 1));
+        objectnessMeasure *= 1.0 - std::exp(-0.5 * itk::Math::sqr(rA) / itk::Math::sqr(m_Alpha));
       }
     }
+    else
+    {
+      objectnessMeasure = 0.0;
+    }
+  }
 
-    if (itk::Math::Absolute(m_Gamma) > 0.0)
+  if (m_ObjectDimension > 0)
+  {
+    double rB = sortedAbsEigenValues[m_ObjectDimension - 1];
+    double rBDenominatorBase = 1.0;
+    for (unsigned int j = m_ObjectDimension; j < ImageDimension; ++j)
     {
-      double frobeniusNormSquared = 0.0;
-      for (unsigned int i = 0; i < ImageDimension; ++i)
-      {
-        frobeniusNormSquared += itk::Math::sqr(sortedAbsEigenValues[i]);
-      }
-      objectnessMeasure *= 1.0 - std::exp(-0.5 * frobeniusNormSquared / itk::Math::sqr(m_Gamma));
+      rBDenominatorBase *= sortedAbsEigenValues[j];
     }
+    if (itk::Math::Absolute(rBDenominatorBase) > 0.0 && itk::Math::Absolute(m_Beta) > 0.0)
+    {
+      rB /= std::pow(rBDenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension));
 
-    // Just in case, scale by largest absolute eigenvalue
-    if (m_ScaleObjectnessMeasure)
+      objectnessMeasure *= std::exp(-0.5 * itk::Math::sqr(rB) / itk::Math::sqr(m_Beta));
+    }
+    else
     {
-      objectnessMeasure *= sortedAbsEigenValues[ImageDimension - 1];
+      objectnessMeasure = 0.0;
     }
+  }
 
-    oit.Set(static_cast<OutputPixelType>(objectnessMeasure));
+  if (itk::Math::Absolute(m_Gamma) > 0.0)
+  {
+    double frobeniusNormSquared = 0.0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      frobeniusNormSquared += itk::Math::sqr(sortedAbsEigenValues[i]);
+    }
+    objectnessMeasure *= 1.0 - std::exp(-0.5 * frobeniusNormSquared / itk::Math::sqr(m_Gamma));
+  }
 
-    ++it;
-    ++oit;
-    progress.CompletedPixel();
+  // Just in case, scale by largest absolute eigenvalue
+  if (m_ScaleObjectnessMeasure)
+  {
+    objectnessMeasure *= sortedAbsEigenValues[ImageDimension - 1];
   }
+
+  return objectnessMeasure;
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkHessianRecursiveGaussianImageFilter.h"
+#include "itkHessianToObjectnessMeasureImageFilter.h"
 #include "ITKImageFeatureExport.h"
 
 namespace itk
@@ -62,6 +63,10 @@ operator<<(std::ostream & out, const MultiScaleHessianBasedMeasureImageFilterEnu
  * The filter computes a second output image (accessed by the GetScalesOutput method)
  * containing the scales at which each pixel gave the best response.
  *
+ * When the measure is a HessianToObjectnessMeasureImageFilter, the objectness
+ * of each scale may be computed without the Hessian image, see
+ * SetUseFusedObjectnessMeasure().
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Generalizing vesselness with respect to dimensionality and shape"
@@ -209,6 +214,21 @@ public:
   itkGetConstMacro(GenerateHessianOutput, bool);
   itkBooleanMacro(GenerateHessianOutput);
   /** @ITKEndGrouping */
+  /** Set/Get whether the objectness of each scale is computed without
+   * storing its Hessian image, when the HessianToMeasureFilter is a
+   * HessianToObjectnessMeasureImageFilter.  The image is then smoothed or
+   * differentiated along the first dimension once per order of derivative,
+   * and the Hessian is computed from these over slabs along this dimension.
+   * The objectness of each slab is computed from the eigenvalues of the
+   * Hessian, in closed form in 2D and 3D, and compared with the best response
+   * right away.  This saves the Hessian image, the objectness image, and a
+   * pass over them per scale.  The outputs are the same up to rounding.  Other
+   * measures ignore it.  Default is off. */
+  /** @ITKStartGrouping */
+  itkSetMacro(UseFusedObjectnessMeasure, bool);
+  itkGetConstMacro(UseFusedObjectnessMeasure, bool);
+  itkBooleanMacro(UseFusedObjectnessMeasure);
+  /** @ITKEndGrouping */
   /** This is overloaded to create the Scales and Hessian output images */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
 
@@ -230,9 +250,25 @@ protected:
   MakeOutput(DataObjectPointerArraySizeType idx) override;
 
 private:
+  using ObjectnessFilterType = HessianToObjectnessMeasureImageFilter<HessianImageType, OutputImageType>;
+  using EigenValueArrayType = typename ObjectnessFilterType::EigenValueArrayType;
+
   void
   UpdateMaximumResponse(double sigma);
 
+  /** Compute the objectness of all the scales by slabs, keeping the best
+   * response. */
+  void
+  GenerateFusedObjectnessMeasure(const ObjectnessFilterType & objectnessFilter);
+
+  /** Compute the eigenvalues of symmetric matrices given by the arrays of
+   * each of their upper triangular components, into the arrays of each
+   * eigenvalue, in 2D and 3D. */
+  static void
+  ComputeEigenValues(const std::vector<std::vector<double>> & components,
+                     std::vector<std::vector<double>> &       eigenValues,
+                     SizeValueType                            count);
+
   double
   ComputeSigmaValue(int scaleLevel);
 
@@ -255,6 +291,7 @@ private:
 
   bool m_GenerateScalesOutput{};
   bool m_GenerateHessianOutput{};
+  bool m_UseFusedObjectnessMeasure{ false };
 };
 } // end namespace itk
 
@@ -19,7 +19,11 @@
 #define itkMultiScaleHessianBasedMeasureImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
 #include "itkMath.h"
+#include "itkSymmetricEigenAnalysis.h"
+
+#include <algorithm>
 
 /*
  *
@@ -152,37 +156,45 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   // Allocate the buffer
   AllocateUpdateBuffer();
 
-  const typename InputImageType::ConstPointer input = this->GetInput();
+  const auto * objectnessFilter = dynamic_cast<const ObjectnessFilterType *>(m_HessianToMeasureFilter.GetPointer());
+  if (m_UseFusedObjectnessMeasure && objectnessFilter)
+  {
+    this->GenerateFusedObjectnessMeasure(*objectnessFilter);
+  }
+  else
+  {
+    const typename InputImageType::ConstPointer input = this->GetInput();
 
-  this->m_HessianFilter->SetInput(input);
+    this->m_HessianFilter->SetInput(input);
 
-  this->m_HessianFilter->SetNormalizeAcrossScale(true);
+    this->m_HessianFilter->SetNormalizeAcrossScale(true);
 
-  // Create a process accumulator for tracking the progress of this
-  // minipipeline
-  auto progress = ProgressAccumulator::New();
-  progress->SetMiniPipelineFilter(this);
+    // Create a process accumulator for tracking the progress of this
+    // minipipeline
+    auto progress = ProgressAccumulator::New();
+    progress->SetMiniPipelineFilter(this);
 
-  // prevent a divide by zero
-  if (m_NumberOfSigmaSteps > 0)
-  {
-    progress->RegisterInternalFilter(this->m_HessianFilter, .5 / m_NumberOfSigmaSteps);
-    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / m_NumberOfSigmaSteps);
-  }
+    // prevent a divide by zero
+    if (m_NumberOfSigmaSteps > 0)
+    {
+      progress->RegisterInternalFilter(this->m_HessianFilter, .5 / m_NumberOfSigmaSteps);
+      progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / m_NumberOfSigmaSteps);
+    }
 
-  for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
-  {
-    const double sigma = this->ComputeSigmaValue(scaleLevel);
+    for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
+    {
+      const double sigma = this->ComputeSigmaValue(scaleLevel);
 
-    itkDebugMacro("Computing measure for scale with sigma = " << sigma);
+      itkDebugMacro("Computing measure for scale with sigma = " << sigma);
 
-    m_HessianFilter->SetSigma(sigma);
+      m_HessianFilter->SetSigma(sigma);
 
-    m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
+      m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
 
-    m_HessianToMeasureFilter->Update();
+      m_HessianToMeasureFilter->Update();
 
-    this->UpdateMaximumResponse(sigma);
+      this->UpdateMaximumResponse(sigma);
+    }
   }
 
   // Write out the best response to the output image
@@ -267,6 +279,288 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 }
 
 
+template <typename TInputImage, typename THessianImage, typename TOutputImage>
+void
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::GenerateFusedObjectnessMeasure(
+  const ObjectnessFilterType & objectnessFilter)
+{
+  using RealImageType = typename HessianFilterType::RealImageType;
+  using InternalRealType = typename HessianFilterType::InternalRealType;
+  using FirstFilterType = RecursiveGaussianImageFilter<InputImageType, RealImageType>;
+  using SlabFilterType = RecursiveGaussianImageFilter<RealImageType, RealImageType>;
+  using HessianPixelType = typename HessianImageType::PixelType;
+  using HessianComponentType = typename HessianPixelType::ValueType;
+  using IndexType = typename OutputImageType::IndexType;
+  using EigenCalculatorType =
+    SymmetricEigenAnalysisFixedDimension<ImageDimension, HessianPixelType, EigenValueArrayType>;
+
+  constexpr unsigned int numberOfComponents = ImageDimension * (ImageDimension + 1) / 2;
+
+  if (objectnessFilter.GetObjectDimension() >= ImageDimension)
+  {
+    itkExceptionStringMacro("ObjectDimension must be lower than ImageDimension.");
+  }
+
+  const InputImageType * input = this->GetInput();
+  const OutputRegionType region = this->GetOutput()->GetBufferedRegion();
+
+  // The image smoothed or differentiated along the first dimension, for each
+  // order of derivative.
+  std::vector<typename FirstFilterType::Pointer> firstFilters;
+  for (unsigned int order = 0; order <= 2; ++order)
+  {
+    auto filter = FirstFilterType::New();
+    filter->SetInput(input);
+    filter->SetDirection(0);
+    filter->SetOrder(static_cast<GaussianOrderEnum>(order));
+    filter->SetNormalizeAcrossScale(true);
+    filter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    firstFilters.push_back(filter);
+  }
+
+  // Each component of the Hessian is computed from one of these by the
+  // filters along the other dimensions, and divided by the spacings, as by
+  // HessianRecursiveGaussianImageFilter.  The components are in the order of
+  // the Hessian pixel.
+  std::vector<unsigned int>                                  firstOrders;
+  std::vector<double>                                        spacingFactors;
+  std::vector<std::vector<typename SlabFilterType::Pointer>> slabFilters(numberOfComponents);
+  for (unsigned int dima = 0; dima < ImageDimension; ++dima)
+  {
+    for (unsigned int dimb = dima; dimb < ImageDimension; ++dimb)
+    {
+      std::vector<typename SlabFilterType::Pointer> & filters = slabFilters[firstOrders.size()];
+      firstOrders.push_back((dima == 0) + (dimb == 0));
+      spacingFactors.push_back(input->GetSpacing()[dima] * input->GetSpacing()[dimb]);
+      for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+      {
+        auto filter = SlabFilterType::New();
+        if (filters.empty())
+        {
+          filter->SetInput(firstFilters[firstOrders.back()]->GetOutput());
+        }
+        else
+        {
+          filter->SetInput(filters.back()->GetOutput());
+          filter->InPlaceOn();
+        }
+        filter->SetDirection(dim);
+        filter->SetOrder(static_cast<GaussianOrderEnum>((dima == dim) + (dimb == dim)));
+        filter->SetNormalizeAcrossScale(true);
+        filter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+        filters.push_back(filter);
+      }
+    }
+  }
+
+  // Slabs of about 2^22 pixels, along the first dimension.
+  constexpr SizeValueType slabPixels = SizeValueType{ 1 } << 22;
+  const SizeValueType     length = region.GetSize(0);
+  const SizeValueType     slabWidth =
+    std::clamp<SizeValueType>(slabPixels * length / region.GetNumberOfPixels(), SizeValueType{ 1 }, length);
+
+  BufferValueType *                  bestResponses = m_UpdateBuffer->GetBufferPointer();
+  ScalesImageType *                  scalesImage = static_cast<ScalesImageType *>(this->ProcessObject::GetOutput(1));
+  HessianImageType *                 hessianImage = static_cast<HessianImageType *>(this->ProcessObject::GetOutput(2));
+  std::vector<const RealImageType *> componentImages(numberOfComponents);
+
+  for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
+  {
+    const double sigma = this->ComputeSigmaValue(scaleLevel);
+
+    itkDebugMacro("Computing measure for scale with sigma = " << sigma);
+
+    for (const auto & filter : firstFilters)
+    {
+      filter->SetSigma(sigma);
+      filter->UpdateLargestPossibleRegion();
+    }
+    for (const auto & filters : slabFilters)
+    {
+      for (const auto & filter : filters)
+      {
+        filter->SetSigma(sigma);
+      }
+    }
+
+    for (SizeValueType slabStart = 0; slabStart < length; slabStart += slabWidth)
+    {
+      OutputRegionType slab = region;
+      slab.SetIndex(0, region.GetIndex(0) + static_cast<IndexValueType>(slabStart));
+      slab.SetSize(0, std::min(slabWidth, length - slabStart));
+
+      for (unsigned int element = 0; element < numberOfComponents; ++element)
+      {
+        if (slabFilters[element].empty())
+        {
+          componentImages[element] = firstFilters[firstOrders[element]]->GetOutput();
+        }
+        else
+        {
+          const typename SlabFilterType::Pointer & lastFilter = slabFilters[element].back();
+          lastFilter->GetOutput()->SetRequestedRegion(slab);
+          lastFilter->Update();
+          componentImages[element] = lastFilter->GetOutput();
+        }
+      }
+
+      // Compare the objectness of each line of the slab with the best one.
+      this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+      this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+        slab,
+        [&](const OutputRegionType & regionForThread) {
+          const SizeValueType              lineLength = regionForThread.GetSize(0);
+          std::vector<std::vector<double>> components(numberOfComponents, std::vector<double>(lineLength));
+          std::vector<std::vector<double>> eigenValues(ImageDimension, std::vector<double>(lineLength));
+          const EigenCalculatorType        eigenCalculator;
+
+          OutputRegionType lineStarts = regionForThread;
+          lineStarts.SetSize(0, 1);
+          for (const IndexType & lineStart : ImageRegionIndexRange<ImageDimension>(lineStarts))
+          {
+            for (unsigned int element = 0; element < numberOfComponents; ++element)
+            {
+              const InternalRealType * values =
+                componentImages[element]->GetBufferPointer() + componentImages[element]->ComputeOffset(lineStart);
+              for (SizeValueType x = 0; x < lineLength; ++x)
+              {
+                components[element][x] = static_cast<HessianComponentType>(values[x] / spacingFactors[element]);
+              }
+            }
+
+            if constexpr (ImageDimension == 2 || ImageDimension == 3)
+            {
+              ComputeEigenValues(components, eigenValues, lineLength);
+            }
+
+            const OffsetValueType offset = m_UpdateBuffer->ComputeOffset(lineStart);
+            for (SizeValueType x = 0; x < lineLength; ++x)
+            {
+              HessianPixelType    hessian;
+              EigenValueArrayType pixelEigenValues;
+              for (unsigned int element = 0; element < numberOfComponents; ++element)
+              {
+                hessian[element] = static_cast<HessianComponentType>(components[element][x]);
+              }
+              if constexpr (ImageDimension == 2 || ImageDimension == 3)
+              {
+                for (unsigned int i = 0; i < ImageDimension; ++i)
+                {
+                  pixelEigenValues[i] = eigenValues[i][x];
+                }
+              }
+              else
+              {
+                eigenCalculator.ComputeEigenValues(hessian, pixelEigenValues);
+              }
+
+              const auto response =
+                static_cast<OutputPixelType>(objectnessFilter.ComputeObjectnessMeasure(pixelEigenValues));
+              if (bestResponses[offset + x] < response)
+              {
+                bestResponses[offset + x] = response;
+                if (m_GenerateScalesOutput)
+                {
+                  scalesImage->GetBufferPointer()[offset + x] = static_cast<ScalesPixelType>(sigma);
+                }
+                if (m_GenerateHessianOutput)
+                {
+                  hessianImage->GetBufferPointer()[offset + x] = hessian;
+                }
+              }
+            }
+          }
+        },
+        nullptr);
+
+      this->UpdateProgress(static_cast<float>(scaleLevel * length + slabStart + slab.GetSize(0)) /
+                           static_cast<float>(m_NumberOfSigmaSteps * length));
+    }
+  }
+
+  for (const auto & filter : firstFilters)
+  {
+    filter->GetOutput()->ReleaseData();
+  }
+  for (const auto & filters : slabFilters)
+  {
+    for (const auto & filter : filters)
+    {
+      filter->GetOutput()->ReleaseData();
+    }
+  }
+}
+
+
+template <typename TInputImage, typename THessianImage, typename TOutputImage>
+void
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::ComputeEigenValues(
+  const std::vector<std::vector<double>> & components,
+  std::vector<std::vector<double>> &       eigenValues,
+  SizeValueType                            count)
+{
+  // Closed form solutions, without branches in the loops so that they may be
+  // vectorized.
+  if constexpr (ImageDimension == 2)
+  {
+    const double * a00 = components[0].data();
+    const double * a01 = components[1].data();
+    const double * a11 = components[2].data();
+    double *       e0 = eigenValues[0].data();
+    double *       e1 = eigenValues[1].data();
+    for (SizeValueType x = 0; x < count; ++x)
+    {
+      const double mean = 0.5 * (a00[x] + a11[x]);
+      const double halfDifference = 0.5 * (a00[x] - a11[x]);
+      const double radius = std::sqrt(halfDifference * halfDifference + a01[x] * a01[x]);
+      e0[x] = mean - radius;
+      e1[x] = mean + radius;
+    }
+  }
+  else if constexpr (ImageDimension == 3)
+  {
+    // The eigenvalues of A are q + 2 p cos(phi + 2 k pi / 3), for k = 0, 1,
+    // 2, where q is the mean of the diagonal, p^2 the mean of the squares of
+    // the components of B = A - q I, and cos(3 phi) the determinant of B / p,
+    // halved.  See Smith, "Eigenvalues of a symmetric 3 x 3 matrix", 1961.
+    const double * a00 = components[0].data();
+    const double * a01 = components[1].data();
+    const double * a02 = components[2].data();
+    const double * a11 = components[3].data();
+    const double * a12 = components[4].data();
+    const double * a22 = components[5].data();
+    double *       e0 = eigenValues[0].data();
+    double *       e1 = eigenValues[1].data();
+    double *       e2 = eigenValues[2].data();
+    for (SizeValueType x = 0; x < count; ++x)
+    {
+      const double q = (a00[x] + a11[x] + a22[x]) / 3.0;
+      const double b00 = a00[x] - q;
+      const double b11 = a11[x] - q;
+      const double b22 = a22[x] - q;
+      const double p = std::sqrt(
+        (b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * (a01[x] * a01[x] + a02[x] * a02[x] + a12[x] * a12[x])) / 6.0);
+
+      // B / p, or zero when A = q I.
+      const double inverseP = p > 0.0 ? 1.0 / p : 0.0;
+      const double c00 = b00 * inverseP;
+      const double c01 = a01[x] * inverseP;
+      const double c02 = a02[x] * inverseP;
+      const double c11 = b11 * inverseP;
+      const double c12 = a12[x] * inverseP;
+      const double c22 = b22 * inverseP;
+      const double halfDeterminant =
+        0.5 * (c00 * (c11 * c22 - c12 * c12) - c01 * (c01 * c22 - c12 * c02) + c02 * (c01 * c12 - c11 * c02));
+      const double phi = std::acos(std::clamp(halfDeterminant, -1.0, 1.0)) / 3.0;
+
+      e2[x] = q + 2.0 * p * std::cos(phi);
+      e0[x] = q + 2.0 * p * std::cos(phi + 2.0 * itk::Math::pi / 3.0);
+      e1[x] = 3.0 * q - e0[x] - e2[x];
+    }
+  }
+}
+
+
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 double
 MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::ComputeSigmaValue(int scaleLevel)
@@ -354,6 +648,7 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   os << indent << "NonNegativeHessianBasedMeasure:  " << m_NonNegativeHessianBasedMeasure << std::endl;
   os << indent << "GenerateScalesOutput: " << m_GenerateScalesOutput << std::endl;
   os << indent << "GenerateHessianOutput: " << m_GenerateHessianOutput << std::endl;
+  itkPrintSelfBooleanMacro(UseFusedObjectnessMeasure);
 }
 } // end namespace itk
 
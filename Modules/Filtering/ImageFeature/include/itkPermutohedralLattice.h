@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPermutohedralLattice_h
+#define itkPermutohedralLattice_h
+
+#include "itkIntTypes.h"
+#include "ITKImageFeatureExport.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace itk
+{
+class MultiThreaderBase;
+class ProcessObject;
+
+/**
+ * \class PermutohedralLattice
+ * \brief Sparse permutohedral lattice, that approximates a Gaussian filter
+ * of unit standard deviation in a space of positions of any dimension.
+ *
+ * Each value is splatted at its position onto the d+1 vertices of the
+ * simplex of the lattice that encloses it, with its barycentric weights.
+ * The lattice is then blurred along each of its d+1 directions by a
+ * binomial kernel, and the filtered values are sliced at positions with the
+ * same weights.  Only the vertices of the simplices where values are
+ * splatted are stored, in a hash table, so that the cost grows linearly with
+ * the number of values and the dimension, rather than exponentially with the
+ * dimension as for a regular grid.  See \cite adams2010.
+ *
+ * The radius of the blur kernel, in lattice steps, sets the resolution of
+ * the lattice: the positions are scaled so that the whole filter keeps a
+ * unit standard deviation.  A radius of 1 is the standard lattice, with the
+ * kernel [1 2 1], that only blurs between the stored vertices.  Larger radii
+ * make the lattice finer, and also store the vertices the blur reaches along
+ * each direction, so that the blur is not cut off where the positions are
+ * sparse.  They approximate the Gaussian better, at the cost of a number of
+ * vertices that grows quickly with the dimension.
+ *
+ * The lattice may be filled in parallel by a lattice per work unit, that
+ * are then merged.
+ *
+ * \ingroup ITKImageFeature
+ */
+class ITKImageFeature_EXPORT PermutohedralLattice
+{
+public:
+  using KeyValueType = std::int32_t;
+
+  /** The vertices of the simplex enclosing a position, as the first d
+   * coordinates of their keys, and their barycentric weights. */
+  struct SimplexType
+  {
+    std::vector<KeyValueType> Keys{};
+    std::vector<double>       Weights{};
+
+    // Workspace.
+    std::vector<double>       Elevated{};
+    std::vector<KeyValueType> Nearest{};
+    std::vector<int>          Rank{};
+  };
+
+  PermutohedralLattice(unsigned int positionDimension, unsigned int valueDimension, unsigned int blurRadius = 1);
+
+  unsigned int
+  GetPositionDimension() const
+  {
+    return m_PositionDimension;
+  }
+
+  unsigned int
+  GetValueDimension() const
+  {
+    return m_ValueDimension;
+  }
+
+  unsigned int
+  GetBlurRadius() const
+  {
+    return m_BlurRadius;
+  }
+
+  /** The number of vertices of the lattice. */
+  SizeValueType
+  GetNumberOfVertices() const
+  {
+    return m_Keys.size() / m_PositionDimension;
+  }
+
+  /** Compute the simplex enclosing a position of unit standard deviation. */
+  void
+  ComputeSimplex(const double * position, SimplexType & simplex) const;
+
+  /** Add a value onto the vertices of a simplex. */
+  void
+  Splat(const SimplexType & simplex, const double * value);
+
+  /** Interpolate the values of the vertices of a simplex. */
+  void
+  Slice(const SimplexType & simplex, double * value) const;
+
+  /** Add the values of another lattice of the same dimensions. */
+  void
+  Merge(const PermutohedralLattice & other);
+
+  /** Blur the values along each direction of the lattice. */
+  void
+  Blur(MultiThreaderBase * multiThreader, ProcessObject * filter = nullptr);
+
+private:
+  /** The index of the vertex of a key, or -1. */
+  OffsetValueType
+  Find(const KeyValueType * key) const;
+
+  /** The index of the vertex of a key, that is created if needed. */
+  SizeValueType
+  Insert(const KeyValueType * key);
+
+  std::size_t
+  Hash(const KeyValueType * key) const;
+
+  void
+  Grow();
+
+  unsigned int m_PositionDimension;
+  unsigned int m_ValueDimension;
+  unsigned int m_BlurRadius;
+
+  /** The scale of each coordinate of the positions, before elevating them
+   * onto the lattice. */
+  std::vector<double> m_Scales{};
+
+  /** The coordinates of the vertices of the canonical simplex. */
+  std::vector<KeyValueType> m_Canonical{};
+
+  /** The binomial blur kernel, from its center. */
+  std::vector<double> m_Kernel{};
+
+  std::vector<KeyValueType> m_Keys{};
+  std::vector<double>       m_Values{};
+
+  /** Open addressing hash table of the indices of the vertices, plus one,
+   * or zero. */
+  std::vector<SizeValueType> m_Table{};
+};
+} // end namespace itk
+
+#endif
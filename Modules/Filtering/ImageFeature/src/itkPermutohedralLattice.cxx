@@ -0,0 +1,346 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPermutohedralLattice.h"
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+PermutohedralLattice::PermutohedralLattice(unsigned int positionDimension,
+                                           unsigned int valueDimension,
+                                           unsigned int blurRadius)
+  : m_PositionDimension(positionDimension)
+  , m_ValueDimension(valueDimension)
+  , m_BlurRadius(std::max(blurRadius, 1u))
+{
+  const unsigned int d = m_PositionDimension;
+
+  // The blur along the d+1 directions has a variance of 3/4 of that of the
+  // filter for the standard lattice, and the splatting and slicing the rest.
+  // A kernel of radius n has n times the variance of [1 2 1], so the lattice
+  // is refined by the square root of (3n+1)/4 to keep a unit variance.
+  const double refinement = std::sqrt((3.0 * m_BlurRadius + 1.0) / 4.0);
+  const double inverseStandardDeviation = (d + 1) * std::sqrt(2.0 / 3.0) * refinement;
+  m_Scales.resize(d);
+  for (unsigned int i = 0; i < d; ++i)
+  {
+    m_Scales[i] = inverseStandardDeviation / std::sqrt((i + 1.0) * (i + 2.0));
+  }
+
+  // The vertex of remainder k of the canonical simplex has its first d+1-k
+  // coordinates equal to k, and the others to k-(d+1).
+  m_Canonical.resize((d + 1) * (d + 1));
+  for (unsigned int k = 0; k <= d; ++k)
+  {
+    for (unsigned int i = 0; i <= d; ++i)
+    {
+      m_Canonical[k * (d + 1) + i] = static_cast<KeyValueType>(k) - (i + k <= d ? 0 : static_cast<KeyValueType>(d + 1));
+    }
+  }
+
+  // Binomial coefficients of order 2n, from the center.
+  m_Kernel.assign(m_BlurRadius + 1, 1.0);
+  for (unsigned int k = 1; k <= m_BlurRadius; ++k)
+  {
+    m_Kernel[k] = m_Kernel[k - 1] * (m_BlurRadius - k + 1.0) / (m_BlurRadius + k);
+  }
+}
+
+void
+PermutohedralLattice::ComputeSimplex(const double * position, SimplexType & simplex) const
+{
+  const unsigned int d = m_PositionDimension;
+  const auto         up = static_cast<KeyValueType>(d + 1);
+
+  simplex.Keys.resize((d + 1) * d);
+  simplex.Weights.assign(d + 2, 0.0);
+  simplex.Elevated.resize(d + 1);
+  simplex.Nearest.resize(d + 1);
+  simplex.Rank.assign(d + 1, 0);
+
+  std::vector<double> &       elevated = simplex.Elevated;
+  std::vector<KeyValueType> & nearest = simplex.Nearest;
+  std::vector<int> &          rank = simplex.Rank;
+
+  // Elevate the position onto the hyperplane of the coordinates that sum to
+  // zero.
+  double sum = 0.0;
+  for (unsigned int j = d; j > 0; --j)
+  {
+    const double scaled = position[j - 1] * m_Scales[j - 1];
+    elevated[j] = sum - j * scaled;
+    sum += scaled;
+  }
+  elevated[0] = sum;
+
+  // The nearest point of remainder zero, whose coordinates are multiples of
+  // d+1, but may not sum to zero.
+  KeyValueType coordinateSum = 0;
+  for (unsigned int i = 0; i <= d; ++i)
+  {
+    const auto rounded = static_cast<KeyValueType>(std::round(elevated[i] / up));
+    nearest[i] = rounded * up;
+    coordinateSum += rounded;
+  }
+
+  // Rank the differences to that point, and move it back onto the
+  // hyperplane, along the coordinates of the extreme ranks.
+  for (unsigned int i = 0; i < d; ++i)
+  {
+    const double difference = elevated[i] - nearest[i];
+    for (unsigned int j = i + 1; j <= d; ++j)
+    {
+      if (difference < elevated[j] - nearest[j])
+      {
+        ++rank[i];
+      }
+      else
+      {
+        ++rank[j];
+      }
+    }
+  }
+  for (unsigned int i = 0; i <= d; ++i)
+  {
+    rank[i] += coordinateSum;
+    if (rank[i] < 0)
+    {
+      rank[i] += up;
+      nearest[i] += up;
+    }
+    else if (rank[i] > static_cast<int>(d))
+    {
+      rank[i] -= up;
+      nearest[i] -= up;
+    }
+  }
+
+  // The barycentric weights of the vertices, by remainder.
+  std::vector<double> & weights = simplex.Weights;
+  for (unsigned int i = 0; i <= d; ++i)
+  {
+    const double v = (elevated[i] - nearest[i]) / up;
+    weights[d - rank[i]] += v;
+    weights[d - rank[i] + 1] -= v;
+  }
+  weights[0] += 1.0 + weights[d + 1];
+
+  for (unsigned int k = 0; k <= d; ++k)
+  {
+    for (unsigned int i = 0; i < d; ++i)
+    {
+      simplex.Keys[k * d + i] = nearest[i] + m_Canonical[k * (d + 1) + rank[i]];
+    }
+  }
+}
+
+void
+PermutohedralLattice::Splat(const SimplexType & simplex, const double * value)
+{
+  for (unsigned int k = 0; k <= m_PositionDimension; ++k)
+  {
+    const SizeValueType vertex = this->Insert(&simplex.Keys[k * m_PositionDimension]);
+    double *            values = &m_Values[vertex * m_ValueDimension];
+    for (unsigned int c = 0; c < m_ValueDimension; ++c)
+    {
+      values[c] += simplex.Weights[k] * value[c];
+    }
+  }
+}
+
+void
+PermutohedralLattice::Slice(const SimplexType & simplex, double * value) const
+{
+  std::fill_n(value, m_ValueDimension, 0.0);
+  for (unsigned int k = 0; k <= m_PositionDimension; ++k)
+  {
+    const OffsetValueType vertex = this->Find(&simplex.Keys[k * m_PositionDimension]);
+    if (vertex >= 0)
+    {
+      const double * values = &m_Values[vertex * m_ValueDimension];
+      for (unsigned int c = 0; c < m_ValueDimension; ++c)
+      {
+        value[c] += simplex.Weights[k] * values[c];
+      }
+    }
+  }
+}
+
+void
+PermutohedralLattice::Merge(const PermutohedralLattice & other)
+{
+  for (SizeValueType otherVertex = 0; otherVertex < other.GetNumberOfVertices(); ++otherVertex)
+  {
+    const SizeValueType vertex = this->Insert(&other.m_Keys[otherVertex * m_PositionDimension]);
+    for (unsigned int c = 0; c < m_ValueDimension; ++c)
+    {
+      m_Values[vertex * m_ValueDimension + c] += other.m_Values[otherVertex * m_ValueDimension + c];
+    }
+  }
+}
+
+void
+PermutohedralLattice::Blur(MultiThreaderBase * multiThreader, ProcessObject * filter)
+{
+  const unsigned int d = m_PositionDimension;
+  const auto         up = static_cast<KeyValueType>(d + 1);
+
+  // A step along the direction j adds d+1 to the coordinate j, and then
+  // subtracts 1 from all of them, the last one being implicit.
+  std::vector<KeyValueType> origin(d);
+  std::vector<KeyValueType> reached(d);
+  for (unsigned int j = 0; j <= d; ++j)
+  {
+    // Beyond the standard lattice, add the vertices within the reach of the
+    // kernel, which carry the blur along the next directions.
+    if (m_BlurRadius > 1 && j < d)
+    {
+      const SizeValueType numberOfVertices = this->GetNumberOfVertices();
+      for (SizeValueType vertex = 0; vertex < numberOfVertices; ++vertex)
+      {
+        std::copy_n(&m_Keys[vertex * d], d, origin.begin());
+        for (int k = -static_cast<int>(m_BlurRadius); k <= static_cast<int>(m_BlurRadius); ++k)
+        {
+          for (unsigned int i = 0; i < d; ++i)
+          {
+            reached[i] = origin[i] - k + (i == j ? k * up : 0);
+          }
+          this->Insert(reached.data());
+        }
+      }
+    }
+
+    std::vector<double>  blurred(m_Values.size());
+    const ImageRegion<1> vertices({ { 0 } }, { { this->GetNumberOfVertices() } });
+    multiThreader->ParallelizeImageRegion<1>(
+      vertices,
+      [this, &blurred, d, j, up](const ImageRegion<1> & chunk) {
+        std::vector<KeyValueType> neighbor(d);
+        const auto                begin = static_cast<SizeValueType>(chunk.GetIndex(0));
+        for (SizeValueType vertex = begin; vertex < begin + chunk.GetSize(0); ++vertex)
+        {
+          const KeyValueType * key = &m_Keys[vertex * d];
+          double *             values = &blurred[vertex * m_ValueDimension];
+          for (unsigned int c = 0; c < m_ValueDimension; ++c)
+          {
+            values[c] = m_Kernel[0] * m_Values[vertex * m_ValueDimension + c];
+          }
+          for (int k = -static_cast<int>(m_BlurRadius); k <= static_cast<int>(m_BlurRadius); ++k)
+          {
+            if (k == 0)
+            {
+              continue;
+            }
+            for (unsigned int i = 0; i < d; ++i)
+            {
+              neighbor[i] = key[i] - k + (i == j ? k * up : 0);
+            }
+            const OffsetValueType neighborVertex = this->Find(neighbor.data());
+            if (neighborVertex >= 0)
+            {
+              const double weight = m_Kernel[std::abs(k)];
+              for (unsigned int c = 0; c < m_ValueDimension; ++c)
+              {
+                values[c] += weight * m_Values[neighborVertex * m_ValueDimension + c];
+              }
+            }
+          }
+        }
+      },
+      filter);
+    m_Values.swap(blurred);
+  }
+}
+
+OffsetValueType
+PermutohedralLattice::Find(const KeyValueType * key) const
+{
+  if (m_Table.empty())
+  {
+    return -1;
+  }
+  const std::size_t mask = m_Table.size() - 1;
+  for (std::size_t slot = this->Hash(key) & mask;; slot = (slot + 1) & mask)
+  {
+    const SizeValueType entry = m_Table[slot];
+    if (entry == 0)
+    {
+      return -1;
+    }
+    if (std::equal(key, key + m_PositionDimension, &m_Keys[(entry - 1) * m_PositionDimension]))
+    {
+      return static_cast<OffsetValueType>(entry - 1);
+    }
+  }
+}
+
+SizeValueType
+PermutohedralLattice::Insert(const KeyValueType * key)
+{
+  if (2 * (this->GetNumberOfVertices() + 1) > m_Table.size())
+  {
+    this->Grow();
+  }
+  const std::size_t mask = m_Table.size() - 1;
+  std::size_t       slot = this->Hash(key) & mask;
+  for (; m_Table[slot] != 0; slot = (slot + 1) & mask)
+  {
+    const SizeValueType entry = m_Table[slot];
+    if (std::equal(key, key + m_PositionDimension, &m_Keys[(entry - 1) * m_PositionDimension]))
+    {
+      return entry - 1;
+    }
+  }
+  const SizeValueType vertex = this->GetNumberOfVertices();
+  m_Keys.insert(m_Keys.end(), key, key + m_PositionDimension);
+  m_Values.resize(m_Values.size() + m_ValueDimension, 0.0);
+  m_Table[slot] = vertex + 1;
+  return vertex;
+}
+
+std::size_t
+PermutohedralLattice::Hash(const KeyValueType * key) const
+{
+  std::size_t hash = 0;
+  for (unsigned int i = 0; i < m_PositionDimension; ++i)
+  {
+    hash = (hash + static_cast<std::size_t>(key[i])) * 2531011;
+  }
+  return hash ^ (hash >> 17);
+}
+
+void
+PermutohedralLattice::Grow()
+{
+  m_Table.assign(std::max<std::size_t>(64, 2 * m_Table.size()), 0);
+  const std::size_t mask = m_Table.size() - 1;
+  for (SizeValueType vertex = 0; vertex < this->GetNumberOfVertices(); ++vertex)
+  {
+    std::size_t slot = this->Hash(&m_Keys[vertex * m_PositionDimension]) & mask;
+    while (m_Table[slot] != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+    m_Table[slot] = vertex + 1;
+  }
+}
+
+} // end namespace itk
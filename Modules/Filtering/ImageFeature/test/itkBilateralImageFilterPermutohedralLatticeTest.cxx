@@ -0,0 +1,243 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Bounds the error of the bilateral filter approximated on a permutohedral
+// lattice with respect to the exact filter, for scalar and vector images, in
+// 2D and 3D, and checks that a larger blur radius of the lattice reduces it
+// and that the output does not depend on streaming.
+
+#include "itkBilateralImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+// Piecewise constant blocks of the given contrast, plus Gaussian noise, with
+// a pixel type of any number of components.
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, unsigned int numberOfComponents, double contrast, double noise)
+{
+  using PixelType = typename TImage::PixelType;
+  using ComponentType = typename itk::DefaultConvertPixelTraits<PixelType>::ComponentType;
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(numberOfComponents);
+  image->Allocate();
+
+  std::mt19937                     generator(7);
+  std::normal_distribution<double> normal(0.0, noise);
+
+  PixelType pixel;
+  itk::NumericTraits<PixelType>::SetLength(pixel, numberOfComponents);
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    int block = 0;
+    for (unsigned int j = 0; j < TImage::ImageDimension; ++j)
+    {
+      block += static_cast<int>(it.GetIndex()[j] / 12);
+    }
+    for (unsigned int k = 0; k < numberOfComponents; ++k)
+    {
+      const double value = 100.0 + contrast * ((block + k) % 3) + normal(generator);
+      itk::DefaultConvertPixelTraits<PixelType>::SetNthComponent(k, pixel, static_cast<ComponentType>(value));
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+Filter(const TImage * image,
+       bool           usePermutohedralLattice,
+       unsigned int   latticeBlurRadius,
+       unsigned int   numberOfWorkUnits)
+{
+  using FilterType = itk::BilateralImageFilter<TImage, TImage>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetDomainSigma(2.5);
+  filter->SetRangeSigma(30.0);
+  filter->SetDomainMu(3.0);
+  filter->SetNumberOfRangeGaussianSamples(1000);
+  filter->SetUsePermutohedralLattice(usePermutohedralLattice);
+  filter->SetLatticeBlurRadius(latticeBlurRadius);
+  filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+// The root mean square difference of the components of two images, away
+// from the border, where the exact filter replicates the image.
+template <typename TImage>
+double
+ComputeError(const TImage * image1, const TImage * image2, itk::SizeValueType margin)
+{
+  using PixelType = typename TImage::PixelType;
+
+  auto region = image1->GetBufferedRegion();
+  region.ShrinkByRadius(margin);
+
+  double             sumOfSquares = 0.0;
+  itk::SizeValueType count = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image1, region); !it.IsAtEnd(); ++it)
+  {
+    const PixelType pixel1 = it.Get();
+    const PixelType pixel2 = image2->GetPixel(it.GetIndex());
+    for (unsigned int k = 0; k < image1->GetNumberOfComponentsPerPixel(); ++k)
+    {
+      const double difference = itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(k, pixel1) -
+                                itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(k, pixel2);
+      sumOfSquares += difference * difference;
+      ++count;
+    }
+  }
+  return std::sqrt(sumOfSquares / count);
+}
+
+// Compare the lattice with the exact filter, whose own error with respect to
+// the input is given for reference, and check that the output does not depend
+// on the number of work units.
+template <typename TImage>
+bool
+CheckError(const TImage * image, double maximumError, double maximumRefinedError)
+{
+  const auto exact = Filter(image, false, 1, 4);
+  const auto lattice = Filter(image, true, 1, 4);
+  const auto refined = Filter(image, true, 2, 4);
+
+  const itk::SizeValueType margin = 10;
+  const double             inputError = ComputeError<TImage>(image, exact, margin);
+  const double             error = ComputeError<TImage>(lattice, exact, margin);
+  const double             refinedError = ComputeError<TImage>(refined, exact, margin);
+  const double             workUnitsError = ComputeError<TImage>(lattice, Filter(image, true, 1, 1), 0);
+
+  std::cout << TImage::ImageDimension << "D, " << image->GetNumberOfComponentsPerPixel()
+            << " components: RMS difference of the exact filter to the input " << inputError << ", of the lattice "
+            << error << ", refined " << refinedError << std::endl;
+
+  bool passed = true;
+  if (error > maximumError || refinedError > maximumRefinedError || refinedError > error)
+  {
+    std::cerr << "The error of the lattice is too large" << std::endl;
+    passed = false;
+  }
+  if (workUnitsError > 1e-3)
+  {
+    std::cerr << "The lattice depends on the number of work units: " << workUnitsError << std::endl;
+    passed = false;
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkBilateralImageFilterPermutohedralLatticeTest(int, char *[])
+{
+  using Image2DType = itk::Image<float, 2>;
+  using Image3DType = itk::Image<float, 3>;
+  using VectorImage2DType = itk::Image<itk::Vector<float, 3>, 2>;
+  using VariableLengthVectorImage2DType = itk::VectorImage<float, 2>;
+
+  auto filter = itk::BilateralImageFilter<Image2DType, Image2DType>::New();
+  ITK_TEST_SET_GET_BOOLEAN(filter, UsePermutohedralLattice, true);
+  filter->SetLatticeBlurRadius(0);
+  ITK_TEST_SET_GET_VALUE(1, filter->GetLatticeBlurRadius());
+  filter->SetLatticeBlurRadius(2);
+  ITK_TEST_SET_GET_VALUE(2, filter->GetLatticeBlurRadius());
+
+  bool passed = true;
+  passed &= CheckError<Image2DType>(MakeImage<Image2DType>(itk::MakeSize(80, 70), 1, 60.0, 10.0), 1.5, 0.6);
+  passed &= CheckError<Image3DType>(MakeImage<Image3DType>(itk::MakeSize(28, 26, 24), 1, 60.0, 10.0), 1.5, 0.6);
+  passed &=
+    CheckError<VectorImage2DType>(MakeImage<VectorImage2DType>(itk::MakeSize(50, 44), 3, 40.0, 10.0), 1.5, 0.6);
+  passed &= CheckError<VariableLengthVectorImage2DType>(
+    MakeImage<VariableLengthVectorImage2DType>(itk::MakeSize(60, 50), 2, 40.0, 10.0), 1.5, 0.6);
+
+  // A vector pixel of one component is filtered as a scalar.
+  using Vector1ImageType = itk::Image<itk::Vector<float, 1>, 2>;
+  const auto scalarImage = MakeImage<Image2DType>(itk::MakeSize(40, 30), 1, 60.0, 10.0);
+  const auto vectorImage = MakeImage<Vector1ImageType>(itk::MakeSize(40, 30), 1, 60.0, 10.0);
+  for (const bool usePermutohedralLattice : { false, true })
+  {
+    const auto scalarOutput = Filter<Image2DType>(scalarImage, usePermutohedralLattice, 1, 2);
+    const auto vectorOutput = Filter<Vector1ImageType>(vectorImage, usePermutohedralLattice, 1, 2);
+    for (itk::ImageRegionConstIteratorWithIndex<Image2DType> it(scalarOutput, scalarOutput->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != vectorOutput->GetPixel(it.GetIndex())[0])
+      {
+        std::cerr << "Scalar and vector pixels differ at " << it.GetIndex() << ": " << it.Get() << " and "
+                  << vectorOutput->GetPixel(it.GetIndex()) << std::endl;
+        passed = false;
+        break;
+      }
+    }
+  }
+
+  // The lattice is splatted from the whole input, whatever the streamed
+  // pieces.  The input is produced by a filter, that only buffers the
+  // requested region.
+  auto caster = itk::CastImageFilter<Image2DType, Image2DType>::New();
+  caster->SetInput(scalarImage);
+  caster->InPlaceOff();
+  auto latticeFilter = itk::BilateralImageFilter<Image2DType, Image2DType>::New();
+  latticeFilter->SetInput(caster->GetOutput());
+  latticeFilter->SetDomainSigma(2.5);
+  latticeFilter->SetRangeSigma(30.0);
+  latticeFilter->UsePermutohedralLatticeOn();
+  latticeFilter->SetNumberOfWorkUnits(2);
+  auto streamer = itk::StreamingImageFilter<Image2DType, Image2DType>::New();
+  streamer->SetInput(latticeFilter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(4);
+  streamer->Update();
+  const auto unstreamedOutput = Filter<Image2DType>(scalarImage, true, 1, 2);
+  for (itk::ImageRegionConstIteratorWithIndex<Image2DType> it(unstreamedOutput,
+                                                              unstreamedOutput->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (it.Get() != streamer->GetOutput()->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "The streamed output differs at " << it.GetIndex() << ": " << it.Get() << " and "
+                << streamer->GetOutput()->GetPixel(it.GetIndex()) << std::endl;
+      passed = false;
+      break;
+    }
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,243 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Checks that the objectness measure computed scale by scale without the
+// Hessian image matches the one of the Hessian and objectness filters, with
+// the scales and Hessian outputs, for the object dimensions, bright and dark
+// objects, anisotropic spacings, in 2D, 3D and 4D, and for an image large
+// enough to be computed in several slabs.
+
+#include "itkHessianToObjectnessMeasureImageFilter.h"
+#include "itkMultiScaleHessianBasedMeasureImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+// Bright lines along the first two axes and the diagonal, and a dark blob,
+// plus Gaussian noise.
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  std::mt19937                     generator(3);
+  std::normal_distribution<double> normal(0.0, 2.0);
+
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double distanceToCenter = 0.0;
+    double diagonal = 0.0;
+    for (unsigned int j = 0; j < Dimension; ++j)
+    {
+      const double x = static_cast<double>(it.GetIndex()[j]) - 0.5 * size[j];
+      distanceToCenter += x * x;
+      diagonal += j % 2 ? -x : x;
+    }
+
+    // The squared distances to a line of each family, in pixels.
+    double value = 100.0 + normal(generator);
+    for (unsigned int j = 0; j < 2 && j < Dimension; ++j)
+    {
+      double distance = 0.0;
+      for (unsigned int k = 0; k < Dimension; ++k)
+      {
+        if (k != j)
+        {
+          const double x = std::fmod(static_cast<double>(it.GetIndex()[k]), 20.0) - 10.0;
+          distance += x * x;
+        }
+      }
+      value += 60.0 * std::exp(-distance / (2.0 * (1.0 + j) * (1.0 + j)));
+    }
+    value += 40.0 * std::exp(-diagonal * diagonal / 8.0);
+    value -= 50.0 * std::exp(-distanceToCenter / 18.0);
+    it.Set(static_cast<typename TImage::PixelType>(value));
+  }
+  return image;
+}
+
+template <typename TImage>
+struct Outputs
+{
+  using HessianPixelType = itk::SymmetricSecondRankTensor<double, TImage::ImageDimension>;
+  using HessianImageType = itk::Image<HessianPixelType, TImage::ImageDimension>;
+  using FilterType = itk::MultiScaleHessianBasedMeasureImageFilter<TImage, HessianImageType, TImage>;
+
+  typename TImage::Pointer                      Measure{};
+  typename FilterType::ScalesImageType::Pointer Scales{};
+  typename HessianImageType::Pointer            Hessian{};
+};
+
+template <typename TImage>
+Outputs<TImage>
+Enhance(const TImage * image,
+        bool           useFusedObjectnessMeasure,
+        unsigned int   objectDimension,
+        bool           brightObject,
+        bool           scaleObjectnessMeasure,
+        unsigned int   numberOfSigmaSteps)
+{
+  using FilterType = typename Outputs<TImage>::FilterType;
+  using ObjectnessFilterType =
+    itk::HessianToObjectnessMeasureImageFilter<typename Outputs<TImage>::HessianImageType, TImage>;
+
+  auto objectnessFilter = ObjectnessFilterType::New();
+  objectnessFilter->SetObjectDimension(objectDimension);
+  objectnessFilter->SetBrightObject(brightObject);
+  objectnessFilter->SetScaleObjectnessMeasure(scaleObjectnessMeasure);
+  objectnessFilter->SetAlpha(0.5);
+  objectnessFilter->SetBeta(0.5);
+  objectnessFilter->SetGamma(5.0);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetHessianToMeasureFilter(objectnessFilter);
+  filter->SetSigmaMinimum(1.0);
+  filter->SetSigmaMaximum(3.0);
+  filter->SetNumberOfSigmaSteps(numberOfSigmaSteps);
+  filter->SetGenerateScalesOutput(true);
+  filter->SetGenerateHessianOutput(true);
+  filter->SetUseFusedObjectnessMeasure(useFusedObjectnessMeasure);
+  filter->SetNumberOfWorkUnits(3);
+  filter->Update();
+
+  Outputs<TImage> outputs;
+  outputs.Measure = filter->GetOutput();
+  outputs.Scales = const_cast<typename FilterType::ScalesImageType *>(filter->GetScalesOutput());
+  outputs.Hessian = const_cast<typename Outputs<TImage>::HessianImageType *>(filter->GetHessianOutput());
+  return outputs;
+}
+
+// Compare the measures relative to their maximum, and the Hessians where
+// the same scale is selected, relative to their largest component.  The
+// scale may differ where the measures of two scales are almost equal, and the
+// measure is discontinuous where the eigenvalues of largest magnitude are
+// opposite, so that a few pixels may differ.
+template <typename TImage>
+bool
+CheckFusedObjectnessMeasure(const TImage * image,
+                            unsigned int   objectDimension,
+                            bool           brightObject,
+                            bool           scaleObjectnessMeasure,
+                            unsigned int   numberOfSigmaSteps = 3)
+{
+  using IteratorType = itk::ImageRegionConstIteratorWithIndex<TImage>;
+
+  const auto separate =
+    Enhance(image, false, objectDimension, brightObject, scaleObjectnessMeasure, numberOfSigmaSteps);
+  const auto fused = Enhance(image, true, objectDimension, brightObject, scaleObjectnessMeasure, numberOfSigmaSteps);
+
+  double maximumMeasure = 0.0;
+  for (IteratorType it(separate.Measure, separate.Measure->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    maximumMeasure = std::max(maximumMeasure, std::abs(static_cast<double>(it.Get())));
+  }
+
+  double             measureDifference = 0.0;
+  double             maximumHessian = 0.0;
+  double             hessianDifference = 0.0;
+  itk::SizeValueType differentPixels = 0;
+  for (IteratorType it(separate.Measure, separate.Measure->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    const double difference = std::abs(static_cast<double>(it.Get()) - fused.Measure->GetPixel(index));
+    if (difference > 1e-3 * maximumMeasure || separate.Scales->GetPixel(index) != fused.Scales->GetPixel(index))
+    {
+      ++differentPixels;
+      continue;
+    }
+    measureDifference = std::max(measureDifference, difference);
+    const auto & hessian = separate.Hessian->GetPixel(index);
+    for (unsigned int k = 0; k < hessian.Size(); ++k)
+    {
+      maximumHessian = std::max(maximumHessian, std::abs(hessian[k]));
+      hessianDifference = std::max(hessianDifference, std::abs(hessian[k] - fused.Hessian->GetPixel(index)[k]));
+    }
+  }
+
+  const itk::SizeValueType numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  std::cout << TImage::ImageDimension << "D, object dimension " << objectDimension << ", bright " << brightObject
+            << ", scaled " << scaleObjectnessMeasure << ": largest measure " << maximumMeasure
+            << ", largest difference " << measureDifference << ", largest Hessian difference " << hessianDifference
+            << ", " << differentPixels << " different pixels" << std::endl;
+
+  if (maximumMeasure == 0.0 || hessianDifference > 1e-3 * maximumHessian || differentPixels > numberOfPixels / 10000)
+  {
+    std::cerr << "The fused objectness measure differs from the separate one" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkMultiScaleHessianBasedMeasureImageFilterFusedTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using Image3DType = itk::Image<float, 3>;
+  using Image4DType = itk::Image<float, 4>;
+
+  auto filter = Outputs<ImageType>::FilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseFusedObjectnessMeasure, true);
+
+  const auto image = MakeImage<ImageType>(itk::MakeSize(90, 80), itk::MakeVector(1.0, 1.0));
+  const auto anisotropicImage = MakeImage<ImageType>(itk::MakeSize(70, 60), itk::MakeVector(1.0, 1.5));
+  const auto image3D = MakeImage<Image3DType>(itk::MakeSize(40, 36, 32), itk::MakeVector(1.0, 1.0, 1.5));
+  const auto image4D = MakeImage<Image4DType>(itk::MakeSize(14, 13, 12, 11), itk::MakeVector(1.0, 1.0, 1.0, 1.0));
+  const auto largeImage = MakeImage<ImageType>(itk::MakeSize(2200, 2000), itk::MakeVector(1.0, 1.0));
+
+  bool passed = true;
+  passed &= CheckFusedObjectnessMeasure<ImageType>(image, 1, true, false);
+  passed &= CheckFusedObjectnessMeasure<ImageType>(image, 0, false, true);
+  passed &= CheckFusedObjectnessMeasure<ImageType>(anisotropicImage, 1, true, true);
+  passed &= CheckFusedObjectnessMeasure<ImageType>(anisotropicImage, 0, false, false);
+  passed &= CheckFusedObjectnessMeasure<Image3DType>(image3D, 1, true, false);
+  passed &= CheckFusedObjectnessMeasure<Image3DType>(image3D, 2, true, true);
+  passed &= CheckFusedObjectnessMeasure<Image3DType>(image3D, 0, false, false);
+  passed &= CheckFusedObjectnessMeasure<Image4DType>(image4D, 1, true, false);
+  passed &= CheckFusedObjectnessMeasure<ImageType>(largeImage, 1, true, false, 2);
+
+  // The object dimension is checked as by the objectness filter.
+  using ObjectnessFilterType =
+    itk::HessianToObjectnessMeasureImageFilter<Outputs<ImageType>::HessianImageType, ImageType>;
+  auto objectnessFilter = ObjectnessFilterType::New();
+  objectnessFilter->SetObjectDimension(2);
+  filter->SetInput(image);
+  filter->SetHessianToMeasureFilter(objectnessFilter);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -91,7 +91,7 @@ public:
   /** Constructor establishes an iterator to walk a particular image and a
    * particular region of that image. */
   FrequencyImageRegionIteratorWithIndex(TImage * ptr, const RegionType & region)
-    : FrequencyImageRegionConstIteratorWithIndex<TImage>(ptr, region)
+    : FrequencyImageRegionConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
   {}
 
   /** Constructor that can be used to cast from an ImageIterator to an
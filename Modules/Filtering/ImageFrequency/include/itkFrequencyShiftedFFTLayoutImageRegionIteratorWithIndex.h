@@ -91,7 +91,7 @@ public:
   /** Constructor establishes an iterator to walk a particular image and a particular region of that image. Initializes
    * the iterator at the begin of the region. */
   FrequencyShiftedFFTLayoutImageRegionIteratorWithIndex(TImage * ptr, const RegionType & region)
-    : FrequencyShiftedFFTLayoutImageRegionConstIteratorWithIndex<TImage>(ptr, region)
+    : FrequencyShiftedFFTLayoutImageRegionConstIteratorWithIndex<TImage>(MakeImageBufferUnique(ptr), region)
   {}
 
   /** Constructor that can be used to cast from an ImageIterator to an
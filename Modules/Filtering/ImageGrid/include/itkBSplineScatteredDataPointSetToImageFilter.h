@@ -111,6 +111,15 @@ namespace itk
  *
  * For additional information see \cite lee1997 and \cite tustison2006.
  *
+ * By default, each work unit accumulates the fitting contributions of its
+ * share of the points into private copies of the control point lattice,
+ * which are summed afterwards.  When PartitionLattice is enabled, the
+ * points are instead sorted into slabs of the lattice along the last
+ * parametric dimension; each work unit writes its slab of a single shared
+ * lattice directly and only the SplineOrder planes past the end of its slab
+ * are merged afterwards.  This reduces the memory of the fitting from
+ * O(threads x lattice) to O(lattice).
+ *
  * \ingroup ITKImageGrid
  *
  * \sphinx
@@ -272,6 +281,14 @@ public:
   itkGetConstReferenceMacro(GenerateOutputImage, bool);
   itkBooleanMacro(GenerateOutputImage);
   /** @ITKEndGrouping */
+  /** Set/Get whether the fitting partitions the control point lattice among
+   * the work units instead of giving each work unit a private copy of the
+   * lattice.  Default = false. */
+  /** @ITKStartGrouping */
+  itkSetMacro(PartitionLattice, bool);
+  itkGetConstMacro(PartitionLattice, bool);
+  itkBooleanMacro(PartitionLattice);
+  /** @ITKEndGrouping */
   /** Get the control point lattice produced by the fitting process. */
   PointDataImagePointer
   GetPhiLattice()
@@ -335,6 +352,16 @@ private:
   void
   CollapsePhiLattice(PointDataImageType *, PointDataImageType *, const RealType, const unsigned int);
 
+  /** Sort the input points by the lattice slab they influence, for the
+   * partitioned fitting.  Called before each fitting pass. */
+  void
+  PartitionPointsForFitting(const typename RealImageType::SizeType & latticeSize);
+
+  /** Add the halo planes of each work unit to the shared lattice after a
+   * partitioned fitting pass. */
+  void
+  MergeLatticeHalos();
+
   /** Set the grid parametric domain parameters such as the origin, size,
    * spacing, and direction. */
   void
@@ -375,6 +402,16 @@ private:
   std::vector<RealImagePointer>      m_OmegaLatticePerThread{};
   std::vector<PointDataImagePointer> m_DeltaLatticePerThread{};
 
+  // Partitioned fitting: point ids sorted by slab, the first point of each
+  // work unit, the slab boundaries along the last dimension, and the halo
+  // planes written past the end of each slab.
+  bool                               m_PartitionLattice{ false };
+  std::vector<SizeValueType>         m_PartitionedPointIds{};
+  std::vector<SizeValueType>         m_PartitionPointOffsets{};
+  std::vector<IndexValueType>        m_PartitionSlabBoundaries{};
+  std::vector<RealImagePointer>      m_OmegaHaloPerThread{};
+  std::vector<PointDataImagePointer> m_DeltaHaloPerThread{};
+
   RealType m_BSplineEpsilon{ static_cast<RealType>(1e-3) };
   bool     m_IsFittingComplete{ false };
   bool     m_DoUpdateResidualValues{ false };
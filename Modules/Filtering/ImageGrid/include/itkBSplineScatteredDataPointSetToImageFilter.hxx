@@ -20,6 +20,7 @@
 
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageDuplicator.h"
 #include "itkCastImageFilter.h"
 #include "itkNumericTraits.h"
@@ -27,6 +28,8 @@
 #include "itkPrintHelper.h"
 #include "vnl/algo/vnl_matrix_inverse.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -328,8 +331,11 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::BeforeT
 {
   if (!this->m_IsFittingComplete)
   {
-    this->m_DeltaLatticePerThread.resize(this->GetNumberOfWorkUnits());
-    this->m_OmegaLatticePerThread.resize(this->GetNumberOfWorkUnits());
+    // The partitioned fitting shares a single lattice among the work units.
+    const unsigned int numberOfLattices = this->m_PartitionLattice ? 1 : this->GetNumberOfWorkUnits();
+
+    this->m_DeltaLatticePerThread.resize(numberOfLattices);
+    this->m_OmegaLatticePerThread.resize(numberOfLattices);
 
     typename RealImageType::SizeType size;
     for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -344,7 +350,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::BeforeT
       }
     }
 
-    for (unsigned int n = 0; n < this->GetNumberOfWorkUnits(); ++n)
+    for (unsigned int n = 0; n < numberOfLattices; ++n)
     {
       this->m_OmegaLatticePerThread[n] = RealImageType::New();
       this->m_OmegaLatticePerThread[n]->SetRegions(size);
@@ -354,9 +360,145 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::BeforeT
       this->m_DeltaLatticePerThread[n]->SetRegions(size);
       this->m_DeltaLatticePerThread[n]->AllocateInitialized();
     }
+
+    if (this->m_PartitionLattice)
+    {
+      this->PartitionPointsForFitting(size);
+    }
+  }
+}
+
+template <typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::PartitionPointsForFitting(
+  const typename RealImageType::SizeType & latticeSize)
+{
+  constexpr unsigned int SlabDimension = ImageDimension - 1;
+
+  const TInputPointSet * input = this->GetInput();
+  const SizeValueType    numberOfPoints = input->GetNumberOfPoints();
+  const ThreadIdType     numberOfWorkUnits = this->GetNumberOfWorkUnits();
+
+  const unsigned int totalNumberOfSpans =
+    this->m_CurrentNumberOfControlPoints[SlabDimension] - this->m_SplineOrder[SlabDimension];
+  const RealType r = static_cast<RealType>(totalNumberOfSpans) /
+                     (static_cast<RealType>(this->m_Size[SlabDimension] - 1) * this->m_Spacing[SlabDimension]);
+  const RealType epsilon = r * this->m_Spacing[SlabDimension] * this->m_BSplineEpsilon;
+
+  // Find the first lattice plane influenced by each point, using the same
+  // reparameterization as the fitting.  Points outside of the parametric
+  // domain are clamped here and reported by the fitting itself.
+  std::vector<unsigned int>  pointPlanes(numberOfPoints);
+  std::vector<SizeValueType> numberOfPointsPerPlane(totalNumberOfSpans, 0);
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    PointType point{};
+    input->GetPoint(n, &point);
+
+    RealType p = (point[SlabDimension] - this->m_Origin[SlabDimension]) * r;
+    if (itk::Math::Absolute(p - static_cast<RealType>(totalNumberOfSpans)) <= epsilon)
+    {
+      p = static_cast<RealType>(totalNumberOfSpans) - epsilon;
+    }
+    unsigned int plane = 0;
+    if (p > RealType{})
+    {
+      plane = static_cast<unsigned int>(std::min(p, static_cast<RealType>(totalNumberOfSpans - 1)));
+    }
+    pointPlanes[n] = plane;
+    ++numberOfPointsPerPlane[plane];
+  }
+
+  // Choose the slab boundaries so that each work unit handles about the same
+  // number of points.
+  this->m_PartitionSlabBoundaries.assign(numberOfWorkUnits + 1, totalNumberOfSpans);
+  this->m_PartitionSlabBoundaries[0] = 0;
+
+  std::vector<ThreadIdType> planeWorkUnits(totalNumberOfSpans, numberOfWorkUnits - 1);
+  SizeValueType             cumulativeNumberOfPoints = 0;
+  ThreadIdType              workUnit = 0;
+  for (unsigned int plane = 0; plane < totalNumberOfSpans; ++plane)
+  {
+    planeWorkUnits[plane] = workUnit;
+    cumulativeNumberOfPoints += numberOfPointsPerPlane[plane];
+    while (workUnit + 1 < numberOfWorkUnits &&
+           cumulativeNumberOfPoints * numberOfWorkUnits >= static_cast<SizeValueType>(workUnit + 1) * numberOfPoints)
+    {
+      this->m_PartitionSlabBoundaries[++workUnit] = plane + 1;
+    }
+  }
+
+  // Sort the point ids by work unit, keeping their original order.
+  this->m_PartitionPointOffsets.assign(numberOfWorkUnits + 1, 0);
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    ++this->m_PartitionPointOffsets[planeWorkUnits[pointPlanes[n]] + 1];
+  }
+  for (ThreadIdType t = 0; t < numberOfWorkUnits; ++t)
+  {
+    this->m_PartitionPointOffsets[t + 1] += this->m_PartitionPointOffsets[t];
+  }
+  std::vector<SizeValueType> nextPosition(this->m_PartitionPointOffsets.begin(),
+                                          this->m_PartitionPointOffsets.end() - 1);
+  this->m_PartitionedPointIds.resize(numberOfPoints);
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    this->m_PartitionedPointIds[nextPosition[planeWorkUnits[pointPlanes[n]]]++] = n;
+  }
+
+  // Each work unit writes the SplineOrder planes past the end of its slab
+  // into a private halo.
+  typename RealImageType::SizeType haloSize = latticeSize;
+  haloSize[SlabDimension] = this->m_SplineOrder[SlabDimension];
+
+  this->m_OmegaHaloPerThread.resize(numberOfWorkUnits);
+  this->m_DeltaHaloPerThread.resize(numberOfWorkUnits);
+  for (ThreadIdType t = 0; t < numberOfWorkUnits; ++t)
+  {
+    this->m_OmegaHaloPerThread[t] = RealImageType::New();
+    this->m_OmegaHaloPerThread[t]->SetRegions(haloSize);
+    this->m_OmegaHaloPerThread[t]->AllocateInitialized();
+
+    this->m_DeltaHaloPerThread[t] = PointDataImageType::New();
+    this->m_DeltaHaloPerThread[t]->SetRegions(haloSize);
+    this->m_DeltaHaloPerThread[t]->AllocateInitialized();
   }
 }
 
+template <typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::MergeLatticeHalos()
+{
+  constexpr unsigned int SlabDimension = ImageDimension - 1;
+
+  RealImageType *      omegaLattice = this->m_OmegaLatticePerThread[0];
+  PointDataImageType * deltaLattice = this->m_DeltaLatticePerThread[0];
+
+  const SizeValueType numberOfPlanes = omegaLattice->GetLargestPossibleRegion().GetSize(SlabDimension);
+
+  for (ThreadIdType t = 0; t < this->m_OmegaHaloPerThread.size(); ++t)
+  {
+    ImageRegionConstIteratorWithIndex<RealImageType> ItO(this->m_OmegaHaloPerThread[t],
+                                                         this->m_OmegaHaloPerThread[t]->GetLargestPossibleRegion());
+    ImageRegionConstIterator<PointDataImageType>     ItD(this->m_DeltaHaloPerThread[t],
+                                                     this->m_DeltaHaloPerThread[t]->GetLargestPossibleRegion());
+    for (; !ItO.IsAtEnd(); ++ItO, ++ItD)
+    {
+      typename RealImageType::IndexType idx = ItO.GetIndex();
+      idx[SlabDimension] += this->m_PartitionSlabBoundaries[t + 1];
+      if (this->m_CloseDimension[SlabDimension])
+      {
+        idx[SlabDimension] %= numberOfPlanes;
+      }
+      omegaLattice->SetPixel(idx, omegaLattice->GetPixel(idx) + ItO.Get());
+      deltaLattice->SetPixel(idx, deltaLattice->GetPixel(idx) + ItD.Get());
+    }
+  }
+
+  this->m_OmegaHaloPerThread.clear();
+  this->m_DeltaHaloPerThread.clear();
+}
+
 template <typename TInputPointSet, typename TOutputImage>
 unsigned int
 BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::SplitRequestedRegion(unsigned int i,
@@ -431,18 +573,36 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
 
   // Determine which points should be handled by this particular thread.
 
-  const ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnits();
-  auto numberOfPointsPerThread = static_cast<SizeValueType>(input->GetNumberOfPoints() / numberOfWorkUnits);
-
-  const unsigned int start = threadId * numberOfPointsPerThread;
-  unsigned int       end = start + numberOfPointsPerThread;
-  if (threadId == this->GetNumberOfWorkUnits() - 1)
+  SizeValueType  start = 0;
+  SizeValueType  end = 0;
+  ThreadIdType   latticeId = threadId;
+  IndexValueType slabEnd = NumericTraits<IndexValueType>::max();
+  if (this->m_PartitionLattice)
   {
-    end = input->GetNumberOfPoints();
+    // The points of this work unit only influence its slab of the shared
+    // lattice and the halo planes following it.
+    start = this->m_PartitionPointOffsets[threadId];
+    end = this->m_PartitionPointOffsets[threadId + 1];
+    latticeId = 0;
+    slabEnd = this->m_PartitionSlabBoundaries[threadId + 1];
   }
+  else
+  {
+    const ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnits();
+    auto numberOfPointsPerThread = static_cast<SizeValueType>(input->GetNumberOfPoints() / numberOfWorkUnits);
 
-  for (unsigned int n = start; n < end; ++n)
+    start = threadId * numberOfPointsPerThread;
+    end = start + numberOfPointsPerThread;
+    if (threadId == this->GetNumberOfWorkUnits() - 1)
+    {
+      end = input->GetNumberOfPoints();
+    }
+  }
+
+  for (SizeValueType k = start; k < end; ++k)
   {
+    const SizeValueType n = this->m_PartitionLattice ? this->m_PartitionedPointIds[k] : k;
+
     PointType point{};
 
     input->GetPoint(n, &point);
@@ -512,8 +672,8 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
       w2Sum += B * B;
     }
 
-    RealImageType *      currentThreadOmegaLattice = this->m_OmegaLatticePerThread[threadId];
-    PointDataImageType * currentThreadDeltaLattice = this->m_DeltaLatticePerThread[threadId];
+    RealImageType *      currentThreadOmegaLattice = this->m_OmegaLatticePerThread[latticeId];
+    PointDataImageType * currentThreadDeltaLattice = this->m_DeltaLatticePerThread[latticeId];
 
     for (ItW.GoToBegin(); !ItW.IsAtEnd(); ++ItW)
     {
@@ -521,17 +681,30 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
       for (unsigned int i = 0; i < ImageDimension; ++i)
       {
         idx[i] += static_cast<unsigned int>(p[i]);
+      }
+
+      RealImageType *      omegaLattice = currentThreadOmegaLattice;
+      PointDataImageType * deltaLattice = currentThreadDeltaLattice;
+      if (idx[ImageDimension - 1] >= slabEnd)
+      {
+        idx[ImageDimension - 1] -= slabEnd;
+        omegaLattice = this->m_OmegaHaloPerThread[threadId];
+        deltaLattice = this->m_DeltaHaloPerThread[threadId];
+      }
+
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
         if (this->m_CloseDimension[i])
         {
-          idx[i] %= currentThreadDeltaLattice->GetLargestPossibleRegion().GetSize()[i];
+          idx[i] %= deltaLattice->GetLargestPossibleRegion().GetSize()[i];
         }
       }
       const RealType wc = this->m_PointWeights->GetElement(n);
       const RealType t = ItW.Get();
-      currentThreadOmegaLattice->SetPixel(idx, currentThreadOmegaLattice->GetPixel(idx) + wc * t * t);
+      omegaLattice->SetPixel(idx, omegaLattice->GetPixel(idx) + wc * t * t);
       PointDataType data = this->m_ResidualPointSetValues->GetElement(n);
       data *= (t * t * t * wc / w2Sum);
-      currentThreadDeltaLattice->SetPixel(idx, currentThreadDeltaLattice->GetPixel(idx) + data);
+      deltaLattice->SetPixel(idx, deltaLattice->GetPixel(idx) + data);
     }
   }
 }
@@ -645,12 +818,17 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::AfterTh
     // Accumulate all the delta lattice and omega lattice values to
     // calculate the final phi lattice.
 
+    if (this->m_PartitionLattice)
+    {
+      this->MergeLatticeHalos();
+    }
+
     ImageRegionIterator<PointDataImageType> ItD(this->m_DeltaLatticePerThread[0],
                                                 this->m_DeltaLatticePerThread[0]->GetLargestPossibleRegion());
     ImageRegionIterator<RealImageType>      ItO(this->m_OmegaLatticePerThread[0],
                                            this->m_OmegaLatticePerThread[0]->GetLargestPossibleRegion());
 
-    for (ThreadIdType n = 1; n < this->GetNumberOfWorkUnits(); ++n)
+    for (ThreadIdType n = 1; n < this->m_DeltaLatticePerThread.size(); ++n)
     {
       ImageRegionIterator<PointDataImageType> Itd(this->m_DeltaLatticePerThread[n],
                                                   this->m_DeltaLatticePerThread[n]->GetLargestPossibleRegion());
@@ -1102,6 +1280,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::PrintSe
   os << indent << "Do multi level: " << this->m_DoMultilevel << std::endl;
   os << indent << "Generate output image: " << this->m_GenerateOutputImage << std::endl;
   os << indent << "Use point weights: " << this->m_UsePointWeights << std::endl;
+  os << indent << "Partition lattice: " << this->m_PartitionLattice << std::endl;
   os << indent << "Maximum number of levels: " << this->m_MaximumNumberOfLevels << std::endl;
   os << indent << "Current level: " << this->m_CurrentLevel << std::endl;
   os << indent << "Number of control points: " << this->m_NumberOfControlPoints << std::endl;
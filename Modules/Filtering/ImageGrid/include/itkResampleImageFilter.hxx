@@ -29,6 +29,7 @@
 
 #include <algorithm>   // For max.
 #include <type_traits> // For is_same.
+#include <vector>
 
 namespace itk
 {
@@ -378,44 +379,55 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const bool isSpecialCoordinatesImage = (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr);
 
 
-  // Create an iterator that will walk the output region for this thread.
-
   using OutputType = typename InterpolatorType::OutputType;
 
-  // Walk the output region
-  for (ImageRegionIteratorWithIndex outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  // The points of each output scan line are transformed as a batch.
+  const SizeValueType                                  scanlineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(scanlineLength);
+  std::vector<typename TransformType::OutputPointType> inputPoints(scanlineLength);
+
+  // Create an iterator that will walk the output region for this thread.
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    // Determine the index of the current output pixel
+    // Determine the coordinates of the output pixels of the scan line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < scanlineLength; ++i, ++index[0])
+    {
+      outputPoints[i] = outputPtr->template TransformIndexToPhysicalPoint<double>(index);
+    }
 
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+    // Compute corresponding input pixel positions
+    transformPtr->TransformPoints(outputPoints.data(), inputPoints.data(), scanlineLength);
 
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
+    for (SizeValueType i = 0; !outIt.IsAtEndOfLine(); ++i, ++outIt)
+    {
+      const InputPointType inputPoint = inputPoints[i];
 
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+      ContinuousInputIndexType inputIndex;
+      const bool               isInsideInput =
+        inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
-    {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
-    }
-    else
-    {
-      if (m_Extrapolator.IsNull())
+      OutputType value;
+      // Evaluate input at right position and copy to the output
+      if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
       {
-        outIt.Set(m_DefaultPixelValue); // default background value
+        value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
+        outIt.Set(Self::CastPixelWithBoundsChecking(value));
       }
       else
       {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(m_DefaultPixelValue); // default background value
+        }
+        else
+        {
+          value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
+          outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        }
       }
     }
-    progress.CompletedPixel();
+    progress.Completed(scanlineLength);
   }
 }
 
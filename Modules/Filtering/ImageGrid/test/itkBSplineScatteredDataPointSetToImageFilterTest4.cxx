@@ -19,6 +19,7 @@
 #include "itkPointSet.h"
 #include "itkBSplineScatteredDataPointSetToImageFilter.h"
 #include "itkBSplineTransform.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkVectorIndexSelectionCastImageFilter.h"
 #include "itkVectorLinearInterpolateImageFunction.h"
 #include "itkTestingMacros.h"
@@ -228,5 +229,64 @@ itkBSplineScatteredDataPointSetToImageFilterTest4(int, char *[])
     return EXIT_FAILURE;
   }
 
+  // Fit a denser point set with and without partitioning the lattice among
+  // the work units and compare the resulting control point lattices.
+  auto densePointSet = PointSetType::New();
+  for (unsigned int n = 0; n < 1000; ++n)
+  {
+    PointType point;
+    point[0] = 99.0 * static_cast<RealType>((n * 37) % 1000) / 1000.0;
+    point[1] = 99.0 * static_cast<RealType>((n * 91) % 1000) / 1000.0;
+    point[2] = 99.0 * static_cast<RealType>(n) / 1000.0;
+
+    VectorType data;
+    data[0] = std::sin(0.1 * point[0]);
+    data[1] = std::cos(0.05 * point[1]);
+    data[2] = 0.01 * point[2];
+
+    densePointSet->SetPoint(n, point);
+    densePointSet->SetPointData(n, data);
+  }
+
+  auto defaultFilter = FilterType::New();
+  auto partitionedFilter = FilterType::New();
+
+  ITK_TEST_SET_GET_BOOLEAN(partitionedFilter, PartitionLattice, true);
+
+  for (const auto & currentFilter : { defaultFilter, partitionedFilter })
+  {
+    currentFilter->SetOrigin(origin);
+    currentFilter->SetSpacing(spacing);
+    currentFilter->SetSize(size);
+    currentFilter->SetDirection(direction);
+    currentFilter->SetInput(densePointSet);
+    currentFilter->SetGenerateOutputImage(false);
+    currentFilter->SetSplineOrder(SplineOrder);
+    currentFilter->SetNumberOfControlPoints(ncps);
+    currentFilter->SetNumberOfLevels(3);
+    currentFilter->SetNumberOfWorkUnits(4);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(currentFilter->Update());
+  }
+
+  const VectorImageType * defaultLattice = defaultFilter->GetPhiLattice();
+  const VectorImageType * partitionedLattice = partitionedFilter->GetPhiLattice();
+
+  ITK_TEST_EXPECT_EQUAL(defaultLattice->GetLargestPossibleRegion(), partitionedLattice->GetLargestPossibleRegion());
+
+  using LatticeIteratorType = itk::ImageRegionConstIterator<VectorImageType>;
+  LatticeIteratorType ItD(defaultLattice, defaultLattice->GetLargestPossibleRegion());
+  LatticeIteratorType ItP(partitionedLattice, partitionedLattice->GetLargestPossibleRegion());
+  for (; !ItD.IsAtEnd(); ++ItD, ++ItP)
+  {
+    if ((ItD.Get() - ItP.Get()).GetNorm() > 1e-4)
+    {
+      std::cerr << "Partitioned lattice differs from the default lattice at " << ItD.GetIndex() << std::endl;
+      std::cerr << "  default: " << ItD.Get() << std::endl;
+      std::cerr << "  partitioned: " << ItP.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
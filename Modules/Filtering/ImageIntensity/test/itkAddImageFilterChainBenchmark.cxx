@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Measures the throughput of a chain of AddImageFilters whose constant input
+// image is either first touched by a single thread, or initialized by
+// Image::FillBuffer, which first touches each page from the thread that later
+// processes it. On a NUMA system, the former places the whole input on one
+// node, and the chain runs at the memory bandwidth of that node only.
+
+#include "itkAddImageFilter.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr unsigned int Dimension{ 3 };
+
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+using FilterType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
+
+
+ImageType::Pointer
+MakeImage(itk::SizeValueType imageSize, PixelType value, bool serialFirstTouch)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(imageSize));
+  image->Allocate();
+  if (serialFirstTouch)
+  {
+    std::fill_n(image->GetBufferPointer(), image->GetBufferedRegion().GetNumberOfPixels(), value);
+  }
+  else
+  {
+    image->FillBuffer(value);
+  }
+  return image;
+}
+
+
+// Runs the chain and returns false if its output is wrong.
+bool
+RunChain(itk::SizeValueType imageSize,
+         unsigned int       numberOfFilters,
+         unsigned int       numberOfRepetitions,
+         bool               serialFirstTouch)
+{
+  constexpr PixelType initialValue{ 1.0 };
+  constexpr PixelType increment{ 0.5 };
+
+  itk::TimeProbe allocationProbe;
+  allocationProbe.Start();
+  const ImageType::Pointer initialImage = MakeImage(imageSize, initialValue, serialFirstTouch);
+  const ImageType::Pointer incrementImage = MakeImage(imageSize, increment, serialFirstTouch);
+  allocationProbe.Stop();
+
+  std::vector<FilterType::Pointer> filters;
+  const ImageType *                input = initialImage;
+  for (unsigned int n = 0; n < numberOfFilters; ++n)
+  {
+    auto filter = FilterType::New();
+    filter->SetInput1(input);
+    filter->SetInput2(incrementImage);
+    input = filter->GetOutput();
+    filters.push_back(filter);
+  }
+
+  itk::TimeProbe chainProbe;
+  for (unsigned int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+  {
+    filters.front()->Modified();
+    chainProbe.Start();
+    filters.back()->Update();
+    chainProbe.Stop();
+  }
+
+  // Each filter reads two images and writes one.
+  const double numberOfBytes = 3.0 * numberOfFilters * initialImage->GetBufferedRegion().GetNumberOfPixels() *
+                               sizeof(PixelType);
+  std::cout << (serialFirstTouch ? "Serial" : "Parallel") << " first touch: initialization "
+            << allocationProbe.GetMean() << " s, chain " << chainProbe.GetMean() << " s, "
+            << numberOfBytes / chainProbe.GetMean() / (1 << 30) << " GiB/s" << std::endl;
+
+  const PixelType expectedValue = initialValue + numberOfFilters * increment;
+  const ImageType * output = filters.back()->GetOutput();
+  const PixelType * outputEnd = output->GetBufferPointer() + output->GetBufferedRegion().GetNumberOfPixels();
+  return std::all_of(output->GetBufferPointer(), outputEnd, [expectedValue](PixelType value) {
+    return itk::Math::FloatAlmostEqual(value, expectedValue);
+  });
+}
+
+} // namespace
+
+
+int
+itkAddImageFilterChainBenchmark(int argc, char * argv[])
+{
+  if (argc > 4)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv)
+              << " [imageSize] [numberOfFilters] [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const itk::SizeValueType imageSize = argc > 1 ? std::stoul(argv[1]) : 128;
+  const unsigned int       numberOfFilters = argc > 2 ? std::stoul(argv[2]) : 8;
+  const unsigned int       numberOfRepetitions = argc > 3 ? std::stoul(argv[3]) : 3;
+
+  std::cout << "Image size: " << imageSize << "^" << Dimension << ", filters: " << numberOfFilters
+            << ", work units: " << itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(RunChain(imageSize, numberOfFilters, numberOfRepetitions, true));
+  ITK_TEST_EXPECT_TRUE(RunChain(imageSize, numberOfFilters, numberOfRepetitions, false));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
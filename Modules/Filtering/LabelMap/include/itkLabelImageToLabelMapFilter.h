@@ -21,6 +21,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkLabelMap.h"
 #include "itkLabelObject.h"
+#include "itkRunLengthLabelImage.h"
 
 namespace itk
 {
@@ -31,6 +32,9 @@ namespace itk
  * LabelImageToLabelMapFilter converts a label image to a label collection image.
  * The labels are the same in the input and the output image.
  *
+ * The input may also be a RunLengthLabelImage, whose runs are copied into
+ * the label objects without visiting every pixel.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -125,6 +129,10 @@ protected:
   AfterThreadedGenerateData() override;
 
 private:
+  /** ThreadedGenerateData() for a RunLengthLabelImage input. */
+  void
+  ThreadedGenerateDataFromRuns(const OutputImageRegionType & regionForThread, ThreadIdType threadId);
+
   OutputImagePixelType m_BackgroundValue{};
 
   typename std::vector<OutputImagePointer> m_TemporaryImages{};
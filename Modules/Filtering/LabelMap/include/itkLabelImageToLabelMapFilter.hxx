@@ -21,6 +21,7 @@
 #include "itkNumericTraits.h"
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
+#include "itkIndexRange.h"
 
 namespace itk
 {
@@ -85,40 +86,76 @@ LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
   const OutputImageRegionType & regionForThread,
   ThreadIdType                  threadId)
 {
-  TotalProgressReporter progress(this, this->GetInput()->GetRequestedRegion().GetNumberOfPixels());
-
-  ImageLinearConstIteratorWithIndex it(this->GetInput(), regionForThread);
-  it.SetDirection(0);
-
-  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  if constexpr (IsRunLengthLabelImage<InputImageType>::value)
+  {
+    this->ThreadedGenerateDataFromRuns(regionForThread, threadId);
+  }
+  else
   {
-    it.GoToBeginOfLine();
+    TotalProgressReporter progress(this, this->GetInput()->GetRequestedRegion().GetNumberOfPixels());
 
-    while (!it.IsAtEndOfLine())
+    ImageLinearConstIteratorWithIndex it(this->GetInput(), regionForThread);
+    it.SetDirection(0);
+
+    for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
     {
-      /** todo: use .Value() here? */
-      const InputImagePixelType & value = it.Get();
+      it.GoToBeginOfLine();
 
-      if (value != static_cast<InputImagePixelType>(m_BackgroundValue))
+      while (!it.IsAtEndOfLine())
       {
-        // We've hit the start of a run
-        const IndexType idx = it.GetIndex();
-        LengthType      length = 1;
-        ++it;
-        while (!it.IsAtEndOfLine() && it.Get() == value)
+        /** todo: use .Value() here? */
+        const InputImagePixelType & value = it.Get();
+
+        if (value != static_cast<InputImagePixelType>(m_BackgroundValue))
         {
-          ++length;
+          // We've hit the start of a run
+          const IndexType idx = it.GetIndex();
+          LengthType      length = 1;
+          ++it;
+          while (!it.IsAtEndOfLine() && it.Get() == value)
+          {
+            ++length;
+            ++it;
+          }
+          // create the run length object to go in the vector
+          m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        }
+        else
+        {
+          // go the next pixel
           ++it;
         }
-        // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
-      }
-      else
-      {
-        // go the next pixel
-        ++it;
       }
+      progress.Completed(regionForThread.GetSize(0));
     }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+LabelImageToLabelMapFilter<TInputImage, TOutputImage>::ThreadedGenerateDataFromRuns(
+  const OutputImageRegionType & regionForThread,
+  ThreadIdType                  threadId)
+{
+  const InputImageType * input = this->GetInput();
+
+  TotalProgressReporter progress(this, input->GetRequestedRegion().GetNumberOfPixels());
+
+  // The first pixel of each line of the region.
+  OutputImageRegionType lineStarts = regionForThread;
+  lineStarts.SetSize(0, 1);
+
+  // Copy the runs of each line, which are already as long as possible.
+  const auto copyRun = [this, threadId](const IndexType & idx, LengthType length, const InputImagePixelType & value) {
+    if (value != static_cast<InputImagePixelType>(m_BackgroundValue))
+    {
+      m_TemporaryImages[threadId]->SetLine(idx, length, value);
+    }
+  };
+
+  for (const IndexType & lineIndex : ImageRegionIndexRange<InputImageDimension>(lineStarts))
+  {
+    input->VisitLineSegment(lineIndex, regionForThread.GetSize(0), copyRun);
     progress.Completed(regionForThread.GetSize(0));
   }
 }
@@ -0,0 +1,216 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthLabelImage_h
+#define itkRunLengthLabelImage_h
+
+#include "itkImageBase.h"
+#include "itkLabelObjectLine.h"
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+/** \class RunLengthLabelImage
+ * \brief A label image stored as runs of equal labels along the first
+ * dimension.
+ *
+ * Each line of the buffered region, along the first dimension, is stored as
+ * a sorted list of runs: a LabelObjectLine and the label of its pixels.  The
+ * pixels that are not covered by a run have the BackgroundValue, so that a
+ * label image that is mostly background takes memory in proportion to the
+ * number of runs rather than of pixels, like a LabelMap, while keeping the
+ * lines in image order.
+ *
+ * The following filters take a RunLengthLabelImage directly, without
+ * decoding it into an Image:
+ *  - LabelImageToLabelMapFilter, and so LabelImageToShapeLabelMapFilter,
+ *    copy the runs into the label objects;
+ *  - BinaryDilateImageFilter dilates the runs of the foreground value;
+ *  - the filters that process their input and output with
+ *    ImageScanlineConstIterator and ImageScanlineIterator, such as
+ *    ChangeLabelImageFilter, decode and encode one line at a time.
+ *
+ * Different lines may be modified from different threads, but not the same
+ * line.
+ *
+ * \sa LabelObjectLine, LabelMap
+ * \ingroup ImageObjects
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabel, unsigned int VImageDimension = 3>
+class ITK_TEMPLATE_EXPORT RunLengthLabelImage : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(RunLengthLabelImage);
+
+  /** Standard class type aliases. */
+  using Self = RunLengthLabelImage;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(RunLengthLabelImage);
+
+  /** Pixel type alias. */
+  using LabelType = TLabel;
+  using PixelType = TLabel;
+  using ValueType = TLabel;
+
+  /** Dimension of the image. */
+  static constexpr unsigned int ImageDimension = VImageDimension;
+
+  /** Types derived from the Superclass */
+  using typename Superclass::IndexType;
+  using typename Superclass::IndexValueType;
+  using typename Superclass::SizeType;
+  using typename Superclass::SizeValueType;
+  using typename Superclass::RegionType;
+
+  using LineType = LabelObjectLine<VImageDimension>;
+  using LengthType = typename LineType::LengthType;
+
+  /** A run of pixels of the same label. */
+  struct RunType
+  {
+    LineType  Line;
+    LabelType Label;
+  };
+
+  /** The runs of a line, sorted by index, neither overlapping nor
+   * touching another run of the same label. */
+  using RunListType = std::vector<RunType>;
+
+  /** Set/Get the label of the pixels that are not covered by a run.
+   * Defaults to zero.  Changing it does not change the runs. */
+  /** @ITKStartGrouping */
+  itkSetMacro(BackgroundValue, LabelType);
+  itkGetConstMacro(BackgroundValue, LabelType);
+  /** @ITKEndGrouping */
+
+  /** Allocate the lines of the buffered region.  All the pixels have the
+   * BackgroundValue, whatever initialize. */
+  void
+  Allocate(bool initialize = false) override;
+
+  /** Restore the image to its initial state, releasing the runs. */
+  void
+  Initialize() override;
+
+  /** Set all the pixels to value. */
+  void
+  FillBuffer(const LabelType & value);
+
+  /** Get/Set a pixel of the buffered region. */
+  /** @ITKStartGrouping */
+  LabelType
+  GetPixel(const IndexType & index) const;
+  void
+  SetPixel(const IndexType & index, const LabelType & value);
+  /** @ITKEndGrouping */
+
+  /** The number of lines of the buffered region. */
+  SizeValueType
+  GetNumberOfLines() const
+  {
+    return m_Lines ? static_cast<SizeValueType>(m_Lines->size()) : 0;
+  }
+
+  /** The number of the line that contains index.  The lines are numbered
+   * with the second dimension varying fastest. */
+  SizeValueType
+  ComputeLineNumber(const IndexType & index) const;
+
+  /** The runs of line lineNumber. */
+  const RunListType &
+  GetRunList(SizeValueType lineNumber) const
+  {
+    return (*m_Lines)[lineNumber];
+  }
+
+  /** The total number of runs. */
+  SizeValueType
+  GetNumberOfRuns() const;
+
+  /** Replace the pixels of the segment of length pixels that starts at
+   * index by runs, which must be sorted and inside the segment.  The pixels
+   * of the segment that are not covered by runs get the BackgroundValue. */
+  void
+  SetLineSegment(const IndexType & index, LengthType length, const RunListType & runs);
+
+  /** Set the pixels of the segment of length pixels that starts at index
+   * to label. */
+  void
+  FillLineSegment(const IndexType & index, LengthType length, const LabelType & label);
+
+  /** Call function(index, length, label) for the successive runs of equal
+   * labels of the segment of length pixels that starts at index, including
+   * the runs of background pixels between the stored runs. */
+  template <typename TFunction>
+  void
+  VisitLineSegment(const IndexType & index, LengthType length, TFunction && function) const;
+
+  /** Graft the runs and information of another RunLengthLabelImage, which
+   * then share their runs. */
+  virtual void
+  Graft(const Self * image);
+
+protected:
+  RunLengthLabelImage() = default;
+  ~RunLengthLabelImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  Graft(const DataObject * data) override;
+
+  using Superclass::Graft;
+
+private:
+  using LineContainerType = std::vector<RunListType>;
+
+  std::shared_ptr<LineContainerType> m_Lines{};
+  LabelType                          m_BackgroundValue{};
+};
+
+
+/** Whether TImage is a RunLengthLabelImage. */
+template <typename TImage>
+struct IsRunLengthLabelImage : std::false_type
+{};
+
+template <typename TLabel, unsigned int VImageDimension>
+struct IsRunLengthLabelImage<RunLengthLabelImage<TLabel, VImageDimension>> : std::true_type
+{};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkRunLengthLabelImage.hxx"
+#endif
+
+#include "itkRunLengthLabelImageScanlineIterator.h"
+
+#endif
@@ -0,0 +1,284 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthLabelImage_hxx
+#define itkRunLengthLabelImage_hxx
+
+#include "itkMath.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::Allocate(bool itkNotUsed(initialize))
+{
+  this->ComputeOffsetTable();
+
+  const SizeType & bufferedSize = this->GetBufferedRegion().GetSize();
+  SizeValueType    numberOfLines = 1;
+  for (unsigned int i = 1; i < VImageDimension; ++i)
+  {
+    numberOfLines *= bufferedSize[i];
+  }
+  m_Lines = std::make_shared<LineContainerType>(bufferedSize[0] > 0 ? numberOfLines : 0);
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::Initialize()
+{
+  Superclass::Initialize();
+  m_Lines.reset();
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::FillBuffer(const LabelType & value)
+{
+  const RegionType & bufferedRegion = this->GetBufferedRegion();
+  for (SizeValueType lineNumber = 0; lineNumber < this->GetNumberOfLines(); ++lineNumber)
+  {
+    RunListType & runs = (*m_Lines)[lineNumber];
+    runs.clear();
+    if (Math::NotExactlyEquals(value, m_BackgroundValue))
+    {
+      // The index of the first pixel of the line.
+      IndexType     index = bufferedRegion.GetIndex();
+      SizeValueType remainder = lineNumber;
+      for (unsigned int i = 1; i < VImageDimension; ++i)
+      {
+        index[i] += static_cast<IndexValueType>(remainder % bufferedRegion.GetSize(i));
+        remainder /= bufferedRegion.GetSize(i);
+      }
+      runs.push_back({ LineType(index, bufferedRegion.GetSize(0)), value });
+    }
+  }
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+RunLengthLabelImage<TLabel, VImageDimension>::GetPixel(const IndexType & index) const -> LabelType
+{
+  const RunListType & runs = this->GetRunList(this->ComputeLineNumber(index));
+
+  // The last run that starts at or before index.
+  auto run = std::upper_bound(runs.cbegin(), runs.cend(), index[0], [](IndexValueType x, const RunType & r) {
+    return x < r.Line.GetIndex()[0];
+  });
+  if (run != runs.cbegin())
+  {
+    --run;
+    if (index[0] < run->Line.GetIndex()[0] + static_cast<IndexValueType>(run->Line.GetLength()))
+    {
+      return run->Label;
+    }
+  }
+  return m_BackgroundValue;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::SetPixel(const IndexType & index, const LabelType & value)
+{
+  this->FillLineSegment(index, 1, value);
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+RunLengthLabelImage<TLabel, VImageDimension>::ComputeLineNumber(const IndexType & index) const -> SizeValueType
+{
+  const RegionType & bufferedRegion = this->GetBufferedRegion();
+  SizeValueType      lineNumber = 0;
+  SizeValueType      stride = 1;
+  for (unsigned int i = 1; i < VImageDimension; ++i)
+  {
+    lineNumber += static_cast<SizeValueType>(index[i] - bufferedRegion.GetIndex(i)) * stride;
+    stride *= bufferedRegion.GetSize(i);
+  }
+  return lineNumber;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+auto
+RunLengthLabelImage<TLabel, VImageDimension>::GetNumberOfRuns() const -> SizeValueType
+{
+  SizeValueType numberOfRuns = 0;
+  for (SizeValueType lineNumber = 0; lineNumber < this->GetNumberOfLines(); ++lineNumber)
+  {
+    numberOfRuns += (*m_Lines)[lineNumber].size();
+  }
+  return numberOfRuns;
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::SetLineSegment(const IndexType &   index,
+                                                             LengthType          length,
+                                                             const RunListType & runs)
+{
+  RunListType &        line = (*m_Lines)[this->ComputeLineNumber(index)];
+  const IndexValueType begin = index[0];
+  const IndexValueType end = begin + static_cast<IndexValueType>(length);
+
+  RunListType newLine;
+  newLine.reserve(line.size() + runs.size() + 1);
+
+  // Append the part [runBegin, runEnd) of a run, merged with the previous
+  // run when they touch and have the same label.
+  const auto append = [&newLine, &index, this](IndexValueType    runBegin,
+                                                IndexValueType    runEnd,
+                                                const LabelType & label) {
+    if (runBegin >= runEnd || Math::ExactlyEquals(label, m_BackgroundValue))
+    {
+      return;
+    }
+    if (!newLine.empty())
+    {
+      LineType &           last = newLine.back().Line;
+      const IndexValueType lastEnd = last.GetIndex()[0] + static_cast<IndexValueType>(last.GetLength());
+      if (lastEnd == runBegin && Math::ExactlyEquals(newLine.back().Label, label))
+      {
+        last.SetLength(last.GetLength() + static_cast<LengthType>(runEnd - runBegin));
+        return;
+      }
+    }
+    IndexType runIndex = index;
+    runIndex[0] = runBegin;
+    newLine.push_back({ LineType(runIndex, static_cast<LengthType>(runEnd - runBegin)), label });
+  };
+
+  for (const RunType & run : line)
+  {
+    const IndexValueType runBegin = run.Line.GetIndex()[0];
+    append(runBegin, std::min(runBegin + static_cast<IndexValueType>(run.Line.GetLength()), begin), run.Label);
+  }
+  for (const RunType & run : runs)
+  {
+    const IndexValueType runBegin = run.Line.GetIndex()[0];
+    append(runBegin, runBegin + static_cast<IndexValueType>(run.Line.GetLength()), run.Label);
+  }
+  for (const RunType & run : line)
+  {
+    const IndexValueType runBegin = run.Line.GetIndex()[0];
+    append(std::max(runBegin, end), runBegin + static_cast<IndexValueType>(run.Line.GetLength()), run.Label);
+  }
+  line.swap(newLine);
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::FillLineSegment(const IndexType & index,
+                                                              LengthType        length,
+                                                              const LabelType & label)
+{
+  this->SetLineSegment(index, length, RunListType{ { LineType(index, length), label } });
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+template <typename TFunction>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::VisitLineSegment(const IndexType & index,
+                                                               LengthType        length,
+                                                               TFunction &&      function) const
+{
+  const IndexValueType end = index[0] + static_cast<IndexValueType>(length);
+  IndexType            position = index;
+  for (const RunType & run : this->GetRunList(this->ComputeLineNumber(index)))
+  {
+    const IndexValueType runBegin = std::max(run.Line.GetIndex()[0], position[0]);
+    const IndexValueType runEnd =
+      std::min(run.Line.GetIndex()[0] + static_cast<IndexValueType>(run.Line.GetLength()), end);
+    if (runBegin >= end)
+    {
+      break;
+    }
+    if (runBegin >= runEnd)
+    {
+      continue;
+    }
+    if (position[0] < runBegin)
+    {
+      function(position, static_cast<LengthType>(runBegin - position[0]), m_BackgroundValue);
+    }
+    position[0] = runBegin;
+    function(position, static_cast<LengthType>(runEnd - runBegin), run.Label);
+    position[0] = runEnd;
+  }
+  if (position[0] < end)
+  {
+    function(position, static_cast<LengthType>(end - position[0]), m_BackgroundValue);
+  }
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::Graft(const Self * image)
+{
+  Superclass::Graft(image);
+
+  if (image)
+  {
+    m_Lines = image->m_Lines;
+    m_BackgroundValue = image->m_BackgroundValue;
+  }
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::Graft(const DataObject * data)
+{
+  if (data)
+  {
+    const auto * const image = dynamic_cast<const Self *>(data);
+    if (image == nullptr)
+    {
+      itkExceptionMacro("itk::RunLengthLabelImage::Graft() cannot cast " << typeid(data).name() << " to "
+                                                                         << typeid(const Self *).name());
+    }
+    this->Graft(image);
+  }
+}
+
+
+template <typename TLabel, unsigned int VImageDimension>
+void
+RunLengthLabelImage<TLabel, VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BackgroundValue: " << static_cast<typename NumericTraits<LabelType>::PrintType>(m_BackgroundValue)
+     << std::endl;
+  os << indent << "NumberOfLines: " << this->GetNumberOfLines() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
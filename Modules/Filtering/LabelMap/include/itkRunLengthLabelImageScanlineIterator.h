@@ -0,0 +1,276 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthLabelImageScanlineIterator_h
+#define itkRunLengthLabelImageScanlineIterator_h
+
+#include "itkRunLengthLabelImage.h"
+#include "itkImageScanlineIterator.h"
+
+namespace itk
+{
+/** \class ImageScanlineConstIterator<RunLengthLabelImage>
+ * \brief Walks a region of a RunLengthLabelImage line by line, following
+ * the runs of each line.
+ *
+ * This specialization has the interface of ImageScanlineConstIterator that
+ * the filters use to read their input line by line, so that these filters
+ * can take a RunLengthLabelImage without decoding it into an Image.
+ *
+ * \ingroup ImageIterators
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabel, unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT ImageScanlineConstIterator<RunLengthLabelImage<TLabel, VImageDimension>>
+{
+public:
+  /** Standard class type aliases. */
+  using Self = ImageScanlineConstIterator;
+
+  using ImageType = RunLengthLabelImage<TLabel, VImageDimension>;
+  using PixelType = typename ImageType::PixelType;
+  using IndexType = typename ImageType::IndexType;
+  using IndexValueType = typename ImageType::IndexValueType;
+  using SizeType = typename ImageType::SizeType;
+  using RegionType = typename ImageType::RegionType;
+  using RunListType = typename ImageType::RunListType;
+
+  static constexpr unsigned int ImageIteratorDimension = VImageDimension;
+
+  /** Default constructor.  The iterator is at end. */
+  ImageScanlineConstIterator() = default;
+
+  /** Walk region, which must be inside the buffered region of image. */
+  ImageScanlineConstIterator(const ImageType * image, const RegionType & region)
+    : m_Image(image)
+    , m_Region(region)
+  {
+    this->GoToBegin();
+  }
+
+  /** Move to the first pixel of the region. */
+  void
+  GoToBegin()
+  {
+    m_Index = m_Region.GetIndex();
+    m_IsAtEnd = m_Image.IsNull() || m_Region.GetNumberOfPixels() == 0;
+    if (!m_IsAtEnd)
+    {
+      this->GoToBeginOfLine();
+    }
+  }
+
+  /** Move to the first pixel of the current line. */
+  void
+  GoToBeginOfLine()
+  {
+    m_Index[0] = m_Region.GetIndex(0);
+    m_Runs = &m_Image->GetRunList(m_Image->ComputeLineNumber(m_Index));
+    m_Run = 0;
+    this->FindRun();
+  }
+
+  /** Whether the iterator is past the last line of the region. */
+  bool
+  IsAtEnd() const
+  {
+    return m_IsAtEnd;
+  }
+
+  /** Whether the iterator is past the last pixel of the current line. */
+  bool
+  IsAtEndOfLine() const
+  {
+    return m_Index[0] >= m_Region.GetIndex(0) + static_cast<IndexValueType>(m_Region.GetSize(0));
+  }
+
+  /** Move to the first pixel of the next line. */
+  void
+  NextLine()
+  {
+    for (unsigned int i = 1; i < VImageDimension; ++i)
+    {
+      ++m_Index[i];
+      if (m_Index[i] < m_Region.GetIndex(i) + static_cast<IndexValueType>(m_Region.GetSize(i)))
+      {
+        this->GoToBeginOfLine();
+        return;
+      }
+      m_Index[i] = m_Region.GetIndex(i);
+    }
+    m_IsAtEnd = true;
+  }
+
+  /** Move to the next pixel of the current line. */
+  Self &
+  operator++()
+  {
+    ++m_Index[0];
+    this->FindRun();
+    return *this;
+  }
+
+  /** The value of the current pixel. */
+  PixelType
+  Get() const
+  {
+    return m_Value;
+  }
+
+  /** The index of the current pixel. */
+  const IndexType &
+  GetIndex() const
+  {
+    return m_Index;
+  }
+
+  /** The region walked. */
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+protected:
+  /** Move to the run that contains, or follows, the current pixel. */
+  void
+  FindRun()
+  {
+    const RunListType & runs = *m_Runs;
+    while (m_Run < runs.size() &&
+           runs[m_Run].Line.GetIndex()[0] + static_cast<IndexValueType>(runs[m_Run].Line.GetLength()) <= m_Index[0])
+    {
+      ++m_Run;
+    }
+    m_Value = m_Run < runs.size() && runs[m_Run].Line.GetIndex()[0] <= m_Index[0] ? runs[m_Run].Label
+                                                                                 : m_Image->GetBackgroundValue();
+  }
+
+  typename ImageType::ConstPointer m_Image{};
+  RegionType                       m_Region{};
+  IndexType                        m_Index{};
+  const RunListType *              m_Runs{ nullptr };
+  size_t                           m_Run{ 0 };
+  PixelType                        m_Value{};
+  bool                             m_IsAtEnd{ true };
+};
+
+
+/** \class ImageScanlineIterator<RunLengthLabelImage>
+ * \brief Walks and sets a region of a RunLengthLabelImage line by line.
+ *
+ * The pixels set in a line are kept in a buffer of the length of the line,
+ * and encoded into runs by NextLine(), which must be called at the end of
+ * each line, as the filters do.
+ *
+ * \ingroup ImageIterators
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabel, unsigned int VImageDimension>
+class ITK_TEMPLATE_EXPORT ImageScanlineIterator<RunLengthLabelImage<TLabel, VImageDimension>>
+  : public ImageScanlineConstIterator<RunLengthLabelImage<TLabel, VImageDimension>>
+{
+public:
+  /** Standard class type aliases. */
+  using Self = ImageScanlineIterator;
+  using Superclass = ImageScanlineConstIterator<RunLengthLabelImage<TLabel, VImageDimension>>;
+
+  using typename Superclass::ImageType;
+  using typename Superclass::PixelType;
+  using typename Superclass::IndexType;
+  using typename Superclass::IndexValueType;
+  using typename Superclass::RegionType;
+  using typename Superclass::RunListType;
+
+  /** Default constructor.  The iterator is at end. */
+  ImageScanlineIterator() = default;
+
+  /** Walk region, which must be inside the buffered region of image. */
+  ImageScanlineIterator(ImageType * image, const RegionType & region)
+    : Superclass(image, region)
+  {}
+
+  /** Set the value of the current pixel. */
+  void
+  Set(const PixelType & value) const
+  {
+    if (m_LineBuffer.empty())
+    {
+      // Start from the current values of the line.
+      m_LineBuffer.reserve(this->m_Region.GetSize(0));
+      IndexType lineIndex = this->m_Index;
+      lineIndex[0] = this->m_Region.GetIndex(0);
+      this->m_Image->VisitLineSegment(
+        lineIndex,
+        this->m_Region.GetSize(0),
+        [this](const IndexType &, typename ImageType::LengthType length, const PixelType & label) {
+          m_LineBuffer.insert(m_LineBuffer.end(), length, label);
+        });
+    }
+    m_LineBuffer[this->m_Index[0] - this->m_Region.GetIndex(0)] = value;
+  }
+
+  /** The value of the current pixel. */
+  PixelType
+  Get() const
+  {
+    return m_LineBuffer.empty() ? Superclass::Get() : m_LineBuffer[this->m_Index[0] - this->m_Region.GetIndex(0)];
+  }
+
+  /** Encode the pixels set in the current line, and move to the first pixel
+   * of the next line. */
+  void
+  NextLine()
+  {
+    if (!m_LineBuffer.empty())
+    {
+      IndexType lineIndex = this->m_Index;
+      lineIndex[0] = this->m_Region.GetIndex(0);
+
+      RunListType runs;
+      for (size_t begin = 0; begin < m_LineBuffer.size();)
+      {
+        size_t end = begin + 1;
+        while (end < m_LineBuffer.size() && Math::ExactlyEquals(m_LineBuffer[end], m_LineBuffer[begin]))
+        {
+          ++end;
+        }
+        IndexType runIndex = lineIndex;
+        runIndex[0] += static_cast<IndexValueType>(begin);
+        runs.push_back({ typename ImageType::LineType(runIndex, end - begin), m_LineBuffer[begin] });
+        begin = end;
+      }
+      const_cast<ImageType *>(this->m_Image.GetPointer())->SetLineSegment(lineIndex, m_LineBuffer.size(), runs);
+      m_LineBuffer.clear();
+    }
+    Superclass::NextLine();
+  }
+
+  /** Move to the next pixel of the current line. */
+  Self &
+  operator++()
+  {
+    Superclass::operator++();
+    return *this;
+  }
+
+private:
+  mutable std::vector<PixelType> m_LineBuffer{};
+};
+} // end namespace itk
+
+#endif
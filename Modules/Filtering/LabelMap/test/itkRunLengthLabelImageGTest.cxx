@@ -0,0 +1,195 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkRunLengthLabelImage.h"
+#include "itkBinaryBallStructuringElement.h"
+#include "itkBinaryDilateImageFilter.h"
+#include "itkChangeLabelImageFilter.h"
+#include "itkImage.h"
+#include "itkIndexRange.h"
+#include "itkLabelImageToShapeLabelMapFilter.h"
+#include <gtest/gtest.h>
+
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+
+using LabelType = unsigned short;
+using RunLengthImageType = itk::RunLengthLabelImage<LabelType, Dimension>;
+using DenseImageType = itk::Image<LabelType, Dimension>;
+
+// Two balls of labels 1 and 2, and a slab of label 3, in a region that does
+// not start at the origin.
+LabelType
+ComputeLabel(const DenseImageType::IndexType & index)
+{
+  const auto squaredDistance = [&index](int x, int y, int z) {
+    return (index[0] - x) * (index[0] - x) + (index[1] - y) * (index[1] - y) + (index[2] - z) * (index[2] - z);
+  };
+  if (squaredDistance(10, 12, 8) < 36)
+  {
+    return 1;
+  }
+  if (squaredDistance(22, 10, 12) < 25)
+  {
+    return 2;
+  }
+  if (index[2] == 17)
+  {
+    return 3;
+  }
+  return 0;
+}
+
+const DenseImageType::RegionType Region{ { { 2, 1, 0 } }, { { 29, 21, 19 } } };
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage()
+{
+  auto image = TImage::New();
+  image->SetRegions(Region);
+  image->Allocate();
+  image->FillBuffer(0);
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(Region))
+  {
+    image->SetPixel(index, ComputeLabel(index));
+  }
+  return image;
+}
+
+template <typename TImage>
+void
+ExpectSamePixels(const RunLengthImageType * image, const TImage * expected)
+{
+  ASSERT_EQ(image->GetBufferedRegion(), expected->GetBufferedRegion());
+  for (const auto & index : itk::ImageRegionIndexRange<Dimension>(expected->GetBufferedRegion()))
+  {
+    ASSERT_EQ(image->GetPixel(index), expected->GetPixel(index)) << "at " << index;
+  }
+}
+
+} // namespace
+
+
+TEST(RunLengthLabelImage, SetsAndGetsPixelsAsRuns)
+{
+  const auto image = MakeImage<RunLengthImageType>();
+  ExpectSamePixels(image.GetPointer(), MakeImage<DenseImageType>().GetPointer());
+  EXPECT_EQ(image->GetNumberOfLines(), 21u * 19u);
+
+  // Adjacent pixels of the same label are merged into a single run.
+  const RunLengthImageType::RunListType & runs = image->GetRunList(image->ComputeLineNumber({ { 2, 5, 17 } }));
+  ASSERT_EQ(runs.size(), 1u);
+  EXPECT_EQ(runs[0].Line.GetLength(), 29u);
+  EXPECT_EQ(runs[0].Label, 3);
+
+  // Splitting and merging a run.
+  image->SetPixel({ { 10, 5, 17 } }, 4);
+  EXPECT_EQ(image->GetRunList(image->ComputeLineNumber({ { 2, 5, 17 } })).size(), 3u);
+  EXPECT_EQ(image->GetPixel({ { 10, 5, 17 } }), 4);
+  EXPECT_EQ(image->GetPixel({ { 11, 5, 17 } }), 3);
+  image->SetPixel({ { 10, 5, 17 } }, 3);
+  EXPECT_EQ(image->GetRunList(image->ComputeLineNumber({ { 2, 5, 17 } })).size(), 1u);
+
+  // Background pixels take no run.
+  image->FillLineSegment({ { 2, 5, 17 } }, 29, 0);
+  EXPECT_TRUE(image->GetRunList(image->ComputeLineNumber({ { 2, 5, 17 } })).empty());
+  EXPECT_EQ(image->GetPixel({ { 10, 5, 17 } }), 0);
+}
+
+
+TEST(RunLengthLabelImage, ChangesLabels)
+{
+  const auto changeLabels = [](auto * filter) {
+    filter->SetChange(1, 5);
+    filter->SetChange(3, 0);
+    filter->SetChange(0, 7);
+    filter->Update();
+  };
+
+  auto filter = itk::ChangeLabelImageFilter<RunLengthImageType, RunLengthImageType>::New();
+  filter->SetInput(MakeImage<RunLengthImageType>());
+  changeLabels(filter.GetPointer());
+
+  auto denseFilter = itk::ChangeLabelImageFilter<DenseImageType, DenseImageType>::New();
+  denseFilter->SetInput(MakeImage<DenseImageType>());
+  changeLabels(denseFilter.GetPointer());
+
+  ExpectSamePixels(filter->GetOutput(), denseFilter->GetOutput());
+}
+
+
+TEST(RunLengthLabelImage, ComputesShapeLabelMap)
+{
+  auto filter = itk::LabelImageToShapeLabelMapFilter<RunLengthImageType>::New();
+  filter->SetInput(MakeImage<RunLengthImageType>());
+  filter->Update();
+
+  auto denseFilter = itk::LabelImageToShapeLabelMapFilter<DenseImageType>::New();
+  denseFilter->SetInput(MakeImage<DenseImageType>());
+  denseFilter->Update();
+
+  const auto * labelMap = filter->GetOutput();
+  const auto * denseLabelMap = denseFilter->GetOutput();
+  ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), 3u);
+  ASSERT_EQ(labelMap->GetNumberOfLabelObjects(), denseLabelMap->GetNumberOfLabelObjects());
+  for (LabelType label = 1; label <= 3; ++label)
+  {
+    const auto * labelObject = labelMap->GetLabelObject(label);
+    const auto * denseLabelObject = denseLabelMap->GetLabelObject(label);
+    EXPECT_EQ(labelObject->GetNumberOfPixels(), denseLabelObject->GetNumberOfPixels());
+    EXPECT_EQ(labelObject->GetBoundingBox(), denseLabelObject->GetBoundingBox());
+    EXPECT_DOUBLE_EQ(labelObject->GetPhysicalSize(), denseLabelObject->GetPhysicalSize());
+    EXPECT_DOUBLE_EQ(labelObject->GetPerimeter(), denseLabelObject->GetPerimeter());
+  }
+}
+
+
+TEST(RunLengthLabelImage, DilatesForeground)
+{
+  using KernelType = itk::BinaryBallStructuringElement<LabelType, Dimension>;
+
+  KernelType kernel;
+  kernel.SetRadius(KernelType::SizeType{ { 3, 2, 1 } });
+  kernel.CreateStructuringElement();
+
+  for (const bool boundaryToForeground : { false, true })
+  {
+    const auto dilate = [&kernel, boundaryToForeground](auto * filter) {
+      filter->SetKernel(kernel);
+      filter->SetForegroundValue(1);
+      filter->SetBackgroundValue(9);
+      filter->SetBoundaryToForeground(boundaryToForeground);
+      filter->Update();
+    };
+
+    auto filter = itk::BinaryDilateImageFilter<RunLengthImageType, RunLengthImageType, KernelType>::New();
+    filter->SetInput(MakeImage<RunLengthImageType>());
+    dilate(filter.GetPointer());
+
+    auto denseFilter = itk::BinaryDilateImageFilter<DenseImageType, DenseImageType, KernelType>::New();
+    denseFilter->SetInput(MakeImage<DenseImageType>());
+    dilate(denseFilter.GetPointer());
+
+    ExpectSamePixels(filter->GetOutput(), denseFilter->GetOutput());
+  }
+}
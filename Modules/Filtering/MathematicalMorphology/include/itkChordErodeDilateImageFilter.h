@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkChordErodeDilateImageFilter_h
+#define itkChordErodeDilateImageFilter_h
+
+#include "itkKernelImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class ChordErodeDilateImageFilter
+ * \brief Erosion or dilation by an arbitrary flat structuring element,
+ * decomposed into chords.
+ *
+ * The structuring element is decomposed into chords: the runs of
+ * consecutive elements along the first dimension.  For each line of the
+ * image along the first dimension, a table of the extrema of the runs of
+ * 2^k pixels is computed, for all the k up to the longest chord, and the
+ * extremum over a chord of any length is then the extremum of two
+ * overlapping runs of the table.  The output of a line is the extremum over
+ * the chords, each read from the table of the input line it lies on.  The
+ * tables of the input lines are reused from an output line to the next one
+ * along the second dimension.
+ *
+ * The cost per pixel grows with the number of chords, and logarithmically
+ * with their lengths, rather than with the number of elements: about the
+ * square of the radius of a 3D ball, instead of its cube.  Unlike the
+ * anchor and van Herk/Gil-Werman methods, it does not need the structuring
+ * element to be decomposable into lines, and is exact for any shape,
+ * convex or not.
+ *
+ * This is the base class, that must be instantiated with std::greater for
+ * the dilations and std::less for the erosions.  See \cite urbach2008 for
+ * the chord method in 2D.
+ *
+ * \sa ChordDilateImageFilter, ChordErodeImageFilter, GrayscaleDilateImageFilter
+ * \ingroup ITKMathematicalMorphology
+ */
+template <typename TImage, typename TKernel, typename TCompare>
+class ITK_TEMPLATE_EXPORT ChordErodeDilateImageFilter : public KernelImageFilter<TImage, TImage, TKernel>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ChordErodeDilateImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = ChordErodeDilateImageFilter;
+  using Superclass = KernelImageFilter<TImage, TImage, TKernel>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Kernel type alias. */
+  using KernelType = TKernel;
+
+  using InputImageType = TImage;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using InputImagePixelType = typename InputImageType::PixelType;
+  using IndexType = typename TImage::IndexType;
+  using OffsetType = typename TImage::OffsetType;
+  using SizeType = typename TImage::SizeType;
+
+  /** ImageDimension constants */
+  static constexpr unsigned int InputImageDimension = TImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TImage::ImageDimension;
+
+  /** Standard New method. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ChordErodeDilateImageFilter);
+
+  /** Set/Get the boundary value. */
+  /** @ITKStartGrouping */
+  itkSetMacro(Boundary, InputImagePixelType);
+  itkGetConstMacro(Boundary, InputImagePixelType);
+  /** @ITKEndGrouping */
+
+  /** The number of chords of the kernel. */
+  SizeValueType
+  GetNumberOfChords() const;
+
+protected:
+  ChordErodeDilateImageFilter();
+  ~ChordErodeDilateImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  BeforeThreadedGenerateData() override;
+
+  /** Multi-thread version GenerateData. */
+  void
+  DynamicThreadedGenerateData(const InputImageRegionType & outputRegionForThread) override;
+
+  // should be set by the meta filter
+  InputImagePixelType m_Boundary{};
+
+private:
+  /** A run of Length elements of the kernel along the first dimension, that
+   * starts at Start along it, on the line number Line of the decomposition.
+   * Level is the largest k such that 2^k is not longer than the chord. */
+  struct ChordType
+  {
+    OffsetValueType Start;
+    SizeValueType   Length;
+    unsigned int    Level;
+    SizeValueType   Line;
+  };
+
+  /** The lines of the kernel along the first dimension that have chords,
+   * given by the offset of their first element, the chords, and, for each
+   * line, the number of the line one further along the second dimension, or
+   * -1. */
+  struct DecompositionType
+  {
+    std::vector<OffsetType> LineOffsets{};
+    std::vector<ChordType>  Chords{};
+    std::vector<int>        NextLines{};
+  };
+
+  static DecompositionType
+  Decompose(const KernelType & kernel);
+
+  DecompositionType m_Decomposition{};
+
+  /** The largest level of the chords. */
+  unsigned int m_MaximumLevel{};
+
+  /** How far the chords reach before and after the pixel. */
+  OffsetValueType m_LowerPad{};
+  OffsetValueType m_UpperPad{};
+}; // end of class
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkChordErodeDilateImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,261 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkChordErodeDilateImageFilter_hxx
+#define itkChordErodeDilateImageFilter_hxx
+
+#include "itkIndexRange.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+template <typename TImage, typename TKernel, typename TCompare>
+ChordErodeDilateImageFilter<TImage, TKernel, TCompare>::ChordErodeDilateImageFilter()
+{
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+template <typename TImage, typename TKernel, typename TCompare>
+auto
+ChordErodeDilateImageFilter<TImage, TKernel, TCompare>::Decompose(const KernelType & kernel) -> DecompositionType
+{
+  DecompositionType decomposition;
+
+  // The number of each line of the kernel in the decomposition, or -1.
+  const SizeValueType width = kernel.GetSize(0);
+  std::vector<int>    lineNumbers(kernel.Size() / width, -1);
+
+  for (SizeValueType kernelLine = 0; kernelLine < lineNumbers.size(); ++kernelLine)
+  {
+    const SizeValueType first = kernelLine * width;
+    for (SizeValueType x = 0; x < width;)
+    {
+      if (!kernel[first + x])
+      {
+        ++x;
+        continue;
+      }
+      SizeValueType end = x + 1;
+      while (end < width && kernel[first + end])
+      {
+        ++end;
+      }
+
+      if (lineNumbers[kernelLine] < 0)
+      {
+        lineNumbers[kernelLine] = static_cast<int>(decomposition.LineOffsets.size());
+        decomposition.LineOffsets.push_back(kernel.GetOffset(first));
+      }
+      unsigned int level = 0;
+      while ((SizeValueType{ 2 } << level) <= end - x)
+      {
+        ++level;
+      }
+      decomposition.Chords.push_back({ kernel.GetOffset(first + x)[0],
+                                       end - x,
+                                       level,
+                                       static_cast<SizeValueType>(lineNumbers[kernelLine]) });
+      x = end;
+    }
+  }
+
+  // The kernel lines one further along the second dimension are the next
+  // ones, but on the last row of a plane.
+  decomposition.NextLines.assign(decomposition.LineOffsets.size(), -1);
+  if (InputImageDimension > 1)
+  {
+    const SizeValueType height = kernel.GetSize(1);
+    for (SizeValueType kernelLine = 0; kernelLine < lineNumbers.size(); ++kernelLine)
+    {
+      if (lineNumbers[kernelLine] >= 0 && (kernelLine + 1) % height != 0)
+      {
+        decomposition.NextLines[lineNumbers[kernelLine]] = lineNumbers[kernelLine + 1];
+      }
+    }
+  }
+  return decomposition;
+}
+
+template <typename TImage, typename TKernel, typename TCompare>
+SizeValueType
+ChordErodeDilateImageFilter<TImage, TKernel, TCompare>::GetNumberOfChords() const
+{
+  return Decompose(this->GetKernel()).Chords.size();
+}
+
+template <typename TImage, typename TKernel, typename TCompare>
+void
+ChordErodeDilateImageFilter<TImage, TKernel, TCompare>::BeforeThreadedGenerateData()
+{
+  m_Decomposition = Decompose(this->GetKernel());
+
+  m_MaximumLevel = 0;
+  m_LowerPad = 0;
+  m_UpperPad = 0;
+  for (const ChordType & chord : m_Decomposition.Chords)
+  {
+    m_MaximumLevel = std::max(m_MaximumLevel, chord.Level);
+    m_LowerPad = std::max(m_LowerPad, -chord.Start);
+    m_UpperPad = std::max(m_UpperPad, chord.Start + static_cast<OffsetValueType>(chord.Length) - 1);
+  }
+}
+
+template <typename TImage, typename TKernel, typename TCompare>
+void
+ChordErodeDilateImageFilter<TImage, TKernel, TCompare>::DynamicThreadedGenerateData(
+  const InputImageRegionType & outputRegionForThread)
+{
+  using PixelType = InputImagePixelType;
+  using TableType = std::vector<PixelType>;
+
+  const InputImageType * input = this->GetInput();
+  InputImageType *       output = this->GetOutput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  TCompare   compare;
+  const auto extremum = [compare](const PixelType & a, const PixelType & b) { return compare(a, b) ? a : b; };
+
+  const std::vector<OffsetType> & lineOffsets = m_Decomposition.LineOffsets;
+  const std::vector<ChordType> &  chords = m_Decomposition.Chords;
+  const std::vector<int> &        nextLines = m_Decomposition.NextLines;
+
+  // The tables of a line cover the output line, padded by the reach of the
+  // chords.
+  const SizeValueType length = outputRegionForThread.GetSize(0);
+  const auto          paddedLength = static_cast<SizeValueType>(m_LowerPad + m_UpperPad) + length;
+
+  const InputImageRegionType & inputRegion = input->GetBufferedRegion();
+  const PixelType *            inputBuffer = input->GetBufferPointer();
+
+  // Compute the tables of the input line of index: the extrema of its runs
+  // of 2^k pixels, for all k up to the largest level.
+  const auto computeTable = [&](TableType & table, IndexType index) {
+    table.resize((m_MaximumLevel + 1) * paddedLength);
+    PixelType * values = table.data();
+
+    bool inside = true;
+    for (unsigned int j = 1; j < InputImageDimension; ++j)
+    {
+      inside &= index[j] >= inputRegion.GetIndex(j) &&
+                index[j] < inputRegion.GetIndex(j) + static_cast<IndexValueType>(inputRegion.GetSize(j));
+    }
+    std::fill_n(values, paddedLength, m_Boundary);
+    if (inside)
+    {
+      const IndexValueType paddedBegin = outputRegionForThread.GetIndex(0) - m_LowerPad;
+      const IndexValueType begin = std::max(paddedBegin, inputRegion.GetIndex(0));
+      const IndexValueType inputEnd = inputRegion.GetIndex(0) + static_cast<IndexValueType>(inputRegion.GetSize(0));
+      const IndexValueType end = std::min(paddedBegin + static_cast<IndexValueType>(paddedLength), inputEnd);
+      if (begin < end)
+      {
+        index[0] = begin;
+        std::copy_n(inputBuffer + input->ComputeOffset(index), end - begin, values + (begin - paddedBegin));
+      }
+    }
+
+    for (unsigned int level = 1; level <= m_MaximumLevel; ++level)
+    {
+      const PixelType *   previous = values + (level - 1) * paddedLength;
+      PixelType *         current = values + level * paddedLength;
+      const SizeValueType step = SizeValueType{ 1 } << (level - 1);
+      for (SizeValueType p = 0; p + 2 * step <= paddedLength; ++p)
+      {
+        current[p] = extremum(previous[p], previous[p + step]);
+      }
+    }
+  };
+
+  std::vector<TableType> tables(lineOffsets.size());
+  std::vector<TableType> previousTables(lineOffsets.size());
+  TableType              outputLine(length);
+
+  InputImageRegionType lineStarts = outputRegionForThread;
+  lineStarts.SetSize(0, 1);
+  IndexType previousLineStart{};
+  bool      first = true;
+  for (const IndexType & lineStart : ImageRegionIndexRange<InputImageDimension>(lineStarts))
+  {
+    // The tables of the lines of the previous output line are reused if it
+    // is just before this one along the second dimension.
+    bool continued = !first && InputImageDimension > 1;
+    for (unsigned int j = 1; j < InputImageDimension; ++j)
+    {
+      continued &= lineStart[j] == previousLineStart[j] + (j == 1 ? 1 : 0);
+    }
+    first = false;
+    previousLineStart = lineStart;
+
+    tables.swap(previousTables);
+    for (SizeValueType line = 0; line < lineOffsets.size(); ++line)
+    {
+      if (continued && nextLines[line] >= 0)
+      {
+        tables[line].swap(previousTables[nextLines[line]]);
+      }
+      else
+      {
+        computeTable(tables[line], lineStart + lineOffsets[line]);
+      }
+    }
+
+    if (chords.empty())
+    {
+      std::fill(outputLine.begin(), outputLine.end(), m_Boundary);
+    }
+    for (SizeValueType c = 0; c < chords.size(); ++c)
+    {
+      const ChordType & chord = chords[c];
+      const PixelType * lower =
+        tables[chord.Line].data() + chord.Level * paddedLength + static_cast<SizeValueType>(chord.Start + m_LowerPad);
+      const PixelType * upper = lower + (chord.Length - (SizeValueType{ 1 } << chord.Level));
+      if (c == 0)
+      {
+        for (SizeValueType x = 0; x < length; ++x)
+        {
+          outputLine[x] = extremum(lower[x], upper[x]);
+        }
+      }
+      else
+      {
+        for (SizeValueType x = 0; x < length; ++x)
+        {
+          outputLine[x] = extremum(outputLine[x], extremum(lower[x], upper[x]));
+        }
+      }
+    }
+
+    std::copy(outputLine.begin(), outputLine.end(), output->GetBufferPointer() + output->ComputeOffset(lineStart));
+    progress.Completed(length);
+  }
+}
+
+template <typename TImage, typename TKernel, typename TCompare>
+void
+ChordErodeDilateImageFilter<TImage, TKernel, TCompare>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Boundary: " << static_cast<typename NumericTraits<InputImagePixelType>::PrintType>(m_Boundary)
+     << std::endl;
+}
+
+} // end namespace itk
+
+#endif
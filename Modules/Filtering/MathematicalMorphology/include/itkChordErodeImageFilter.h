@@ -0,0 +1,61 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkChordErodeImageFilter_h
+#define itkChordErodeImageFilter_h
+
+#include "itkChordErodeDilateImageFilter.h"
+#include <functional>
+
+namespace itk
+{
+/**
+ * \class ChordErodeImageFilter
+ * \brief Grayscale erosion by an arbitrary flat structuring element,
+ * decomposed into chords.
+ *
+ * \sa ChordErodeDilateImageFilter, GrayscaleErodeImageFilter
+ * \ingroup ITKMathematicalMorphology
+ */
+template <typename TImage, typename TKernel>
+class ChordErodeImageFilter
+  : public ChordErodeDilateImageFilter<TImage, TKernel, std::less<typename TImage::PixelType>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ChordErodeImageFilter);
+
+  using Self = ChordErodeImageFilter;
+  using Superclass = ChordErodeDilateImageFilter<TImage, TKernel, std::less<typename TImage::PixelType>>;
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ChordErodeImageFilter);
+
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  using PixelType = typename TImage::PixelType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+protected:
+  ChordErodeImageFilter() { this->m_Boundary = NumericTraits<PixelType>::max(); }
+  ~ChordErodeImageFilter() override = default;
+};
+} // namespace itk
+
+#endif
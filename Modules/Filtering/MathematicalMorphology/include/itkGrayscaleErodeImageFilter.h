@@ -24,6 +24,7 @@
 #include "itkBasicErodeImageFilter.h"
 #include "itkAnchorErodeImageFilter.h"
 #include "itkVanHerkGilWermanErodeImageFilter.h"
+#include "itkChordErodeImageFilter.h"
 #include "itkCastImageFilter.h"
 #include "itkConstantBoundaryCondition.h"
 #include "itkNeighborhood.h"
@@ -88,6 +89,7 @@ public:
 
   using AnchorFilterType = AnchorErodeImageFilter<TInputImage, FlatKernelType>;
   using VHGWFilterType = VanHerkGilWermanErodeImageFilter<TInputImage, FlatKernelType>;
+  using ChordFilterType = ChordErodeImageFilter<TInputImage, FlatKernelType>;
   using CastFilterType = CastImageFilter<TInputImage, TOutputImage>;
 
   /** Typedef for boundary conditions. */
@@ -113,7 +115,9 @@ public:
   static constexpr AlgorithmType VHGW = AlgorithmType::VHGW;
 #endif
 
-  /** Set kernel (structuring element). */
+  /** Set kernel (structuring element).  The algorithm is selected from the
+   * kernel: ANCHOR for the flat kernels decomposable into lines, CHORD for the
+   * other flat kernels, and BASIC or HISTO for the kernels that are not flat. */
   void
   SetKernel(const KernelType & kernel) override;
 
@@ -157,6 +161,8 @@ private:
 
   typename VHGWFilterType::Pointer m_VHGWFilter{};
 
+  typename ChordFilterType::Pointer m_ChordFilter{};
+
   // and the name of the filter
   AlgorithmEnum m_Algorithm{};
 
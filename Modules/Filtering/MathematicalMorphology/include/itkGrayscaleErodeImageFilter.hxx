@@ -30,6 +30,7 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::GrayscaleErodeIma
   , m_BasicFilter(BasicFilterType::New())
   , m_AnchorFilter(AnchorFilterType::New())
   , m_VHGWFilter(VHGWFilterType::New())
+  , m_ChordFilter(ChordFilterType::New())
   , m_Algorithm(AlgorithmEnum::HISTO)
 {
   this->SetBoundary(NumericTraits<PixelType>::max());
@@ -43,6 +44,7 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::SetNumberOfWorkUn
   m_HistogramFilter->SetNumberOfWorkUnits(nb);
   m_AnchorFilter->SetNumberOfWorkUnits(nb);
   m_VHGWFilter->SetNumberOfWorkUnits(nb);
+  m_ChordFilter->SetNumberOfWorkUnits(nb);
   m_BasicFilter->SetNumberOfWorkUnits(nb);
 }
 
@@ -57,6 +59,13 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::SetKernel(const K
     m_AnchorFilter->SetKernel(*flatKernel);
     m_Algorithm = AlgorithmEnum::ANCHOR;
   }
+  else if (flatKernel != nullptr)
+  {
+    // the chords are faster than the histogram and the basic filters for all
+    // the flat kernels, even the smallest ones
+    m_ChordFilter->SetKernel(*flatKernel);
+    m_Algorithm = AlgorithmEnum::CHORD;
+  }
   else if (m_HistogramFilter->GetUseVectorBasedAlgorithm())
   {
     // histogram based filter is as least as good as the basic one, so always
@@ -97,6 +106,7 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::SetBoundary(const
   m_HistogramFilter->SetBoundary(value);
   m_AnchorFilter->SetBoundary(value);
   m_VHGWFilter->SetBoundary(value);
+  m_ChordFilter->SetBoundary(value);
   m_BoundaryCondition.SetConstant(value);
   m_BasicFilter->OverrideBoundaryCondition(&m_BoundaryCondition);
 }
@@ -125,6 +135,10 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::SetAlgorithm(Algo
     {
       m_VHGWFilter->SetKernel(*flatKernel);
     }
+    else if (flatKernel != nullptr && algo == AlgorithmEnum::CHORD)
+    {
+      m_ChordFilter->SetKernel(*flatKernel);
+    }
     else
     {
       itkExceptionStringMacro("Invalid algorithm");
@@ -192,6 +206,20 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::GenerateData()
     cast->SetInput(m_VHGWFilter->GetOutput());
     progress->RegisterInternalFilter(cast, 0.1f);
 
+    cast->GraftOutput(this->GetOutput());
+    cast->Update();
+    this->GraftOutput(cast->GetOutput());
+  }
+  else if (m_Algorithm == AlgorithmEnum::CHORD)
+  {
+    itkDebugMacro("Running ChordErodeImageFilter");
+    m_ChordFilter->SetInput(this->GetInput());
+    progress->RegisterInternalFilter(m_ChordFilter, 0.9f);
+
+    auto cast = CastFilterType::New();
+    cast->SetInput(m_ChordFilter->GetOutput());
+    progress->RegisterInternalFilter(cast, 0.1f);
+
     cast->GraftOutput(this->GetOutput());
     cast->Update();
     this->GraftOutput(cast->GetOutput());
@@ -207,6 +235,7 @@ GrayscaleErodeImageFilter<TInputImage, TOutputImage, TKernel>::Modified() const
   m_HistogramFilter->Modified();
   m_AnchorFilter->Modified();
   m_VHGWFilter->Modified();
+  m_ChordFilter->Modified();
 }
 
 template <typename TInputImage, typename TOutputImage, typename TKernel>
@@ -111,6 +111,7 @@ GrayscaleFillholeImageFilter<TInputImage, TOutputImage>::GenerateData()
   erode->SetMarkerImage(markerPtr);
   erode->SetMaskImage(this->GetInput());
   erode->SetFullyConnected(m_FullyConnected);
+  erode->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // graft our output to the erode filter to force the proper regions
   // to be generated
@@ -65,6 +65,7 @@ HConcaveImageFilter<TInputImage, TOutputImage>::GenerateData()
   hmin->SetInput(this->GetInput());
   hmin->SetHeight(m_Height);
   hmin->SetFullyConnected(m_FullyConnected);
+  hmin->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // Need to subtract the input from the H-Minima image
   auto subtract = SubtractImageFilter<TInputImage, TInputImage, TOutputImage>::New();
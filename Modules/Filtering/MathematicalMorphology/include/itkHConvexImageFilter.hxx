@@ -66,6 +66,7 @@ HConvexImageFilter<TInputImage, TOutputImage>::GenerateData()
   hmax->SetInput(this->GetInput());
   hmax->SetHeight(m_Height);
   hmax->SetFullyConnected(m_FullyConnected);
+  hmax->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // Need to subtract the H-Maxima image from the input
   auto subtract = SubtractImageFilter<TInputImage, TInputImage, TOutputImage>::New();
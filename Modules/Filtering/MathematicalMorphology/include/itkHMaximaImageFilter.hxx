@@ -78,6 +78,7 @@ HMaximaImageFilter<TInputImage, TOutputImage>::GenerateData()
   dilate->SetMarkerImage(shift->GetOutput());
   dilate->SetMaskImage(this->GetInput());
   dilate->SetFullyConnected(m_FullyConnected);
+  dilate->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // Must cast to the output type
   auto cast = CastImageFilter<TInputImage, TOutputImage>::New();
@@ -78,6 +78,7 @@ HMinimaImageFilter<TInputImage, TOutputImage>::GenerateData()
   erode->SetMarkerImage(shift->GetOutput());
   erode->SetMaskImage(this->GetInput());
   erode->SetFullyConnected(m_FullyConnected);
+  erode->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // Must cast to the output type
   auto cast = CastImageFilter<TInputImage, TOutputImage>::New();
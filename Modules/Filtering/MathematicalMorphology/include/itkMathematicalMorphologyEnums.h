@@ -44,13 +44,27 @@ public:
     BASIC = 0,
     HISTO = 1,
     ANCHOR = 2,
-    VHGW = 3
+    VHGW = 3,
+    CHORD = 4
+  };
+
+  /** \class BinaryAlgorithm
+   * \brief Algorithm used in the binary dilation/erosion operations.
+   * \ingroup ITKMathematicalMorphology
+   */
+  enum class BinaryAlgorithm : uint8_t
+  {
+    AUTOMATIC = 0,
+    SURFACE = 1,
+    DISTANCE_MAP = 2
   };
 };
 
 /** Define how to print enumeration values. */
 extern ITKMathematicalMorphology_EXPORT std::ostream &
 operator<<(std::ostream & out, const MathematicalMorphologyEnums::Algorithm value);
+extern ITKMathematicalMorphology_EXPORT std::ostream &
+operator<<(std::ostream & out, const MathematicalMorphologyEnums::BinaryAlgorithm value);
 
 } // end namespace itk
 
@@ -41,6 +41,14 @@ namespace itk
  * antiraster propagation steps followed by a FIFO based propagation
  * step \cite vincent1993.
  *
+ * With more than one work unit, the image is split into slabs along its
+ * last dimension, on which the raster, antiraster and FIFO steps run in
+ * parallel.  Each slab only reads and writes its own pixels: the values that
+ * propagate into a neighboring slab are sent to it, and the slabs then take
+ * in the values they received and propagate them with their FIFO, in
+ * parallel, until no value is sent anymore.  The result is the same as with
+ * a single work unit, which runs the serial algorithm.
+ *
  * \author Richard Beare. Department of Medicine, Monash University,
  * Melbourne, Australia.
  *
@@ -127,7 +135,8 @@ public:
   /**
    * Perform a padding of the image internally to increase the performance
    * of the filter. UseInternalCopy can be set to false to reduce the memory
-   * usage.
+   * usage.  Only used with a single work unit: the parallel algorithm does
+   * not pad the image.
    */
   /** @ITKStartGrouping */
   itkSetMacro(UseInternalCopy, bool);
@@ -159,6 +168,10 @@ protected:
   typename TInputImage::PixelType m_MarkerValue{};
 
 private:
+  /** Reconstruct the output in parallel, slab by slab. */
+  void
+  GenerateDataInSlabs();
+
   bool m_FullyConnected{};
   bool m_UseInternalCopy{};
 
@@ -24,6 +24,11 @@
 
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
+#include "itkProgressTransformer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 namespace itk
 {
@@ -69,6 +74,19 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
 {
   // Allocate the output
   this->AllocateOutputs();
+
+  // mask and marker must have the same size
+  if (this->GetMarkerImage()->GetRequestedRegion().GetSize() != this->GetMaskImage()->GetRequestedRegion().GetSize())
+  {
+    itkExceptionStringMacro("Marker and mask must have the same size.");
+  }
+
+  if (this->GetNumberOfWorkUnits() > 1 && this->GetOutput()->GetRequestedRegion().GetSize(OutputImageDimension - 1) > 1)
+  {
+    this->GenerateDataInSlabs();
+    return;
+  }
+
   // there are 2 passes that use all pixels and a 3rd that uses some
   // subset of the pixels. We'll just pretend that the third pass
   // takes the same as each of the others. Is it OK to update more
@@ -81,12 +99,6 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
   const MaskImageConstPointer   maskImage = this->GetMaskImage();
   const OutputImagePointer      output = this->GetOutput();
 
-  // mask and marker must have the same size
-  if (this->GetMarkerImage()->GetRequestedRegion().GetSize() != this->GetMaskImage()->GetRequestedRegion().GetSize())
-  {
-    itkExceptionStringMacro("Marker and mask must have the same size.");
-  }
-
   // create padded versions of the marker image and the mask image
   using PadType = typename itk::ConstantPadImageFilter<InputImageType, InputImageType>;
 
@@ -332,6 +344,362 @@ ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TCompare>
+void
+ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateDataInSlabs()
+{
+  constexpr unsigned int Dimension = OutputImageDimension;
+  constexpr unsigned int SlabDimension = Dimension - 1;
+
+  using OffsetType = typename OutputImageType::OffsetType;
+
+  TCompare compare;
+
+  const MarkerImagePixelType * marker = this->GetMarkerImage()->GetBufferPointer();
+  const MaskImagePixelType *   mask = this->GetMaskImage()->GetBufferPointer();
+  OutputImageType *            output = this->GetOutput();
+  OutputImagePixelType *       values = output->GetBufferPointer();
+
+  const ISizeType size = output->GetRequestedRegion().GetSize();
+  const auto &    offsetTable = output->GetOffsetTable();
+
+  // The neighbors of a pixel, with their offsets in the buffer, and those
+  // that come before and after it in raster order.
+  struct NeighborType
+  {
+    OffsetType      Offset;
+    OffsetValueType BufferOffset;
+  };
+  std::vector<NeighborType> neighbors;
+  std::vector<NeighborType> previousNeighbors;
+  std::vector<NeighborType> laterNeighbors;
+  {
+    Neighborhood<char, Dimension> neighborhood;
+    neighborhood.SetRadius(1);
+    for (unsigned int n = 0; n < neighborhood.Size(); ++n)
+    {
+      const OffsetType offset = neighborhood.GetOffset(n);
+      unsigned int     distance = 0;
+      OffsetValueType  bufferOffset = 0;
+      for (unsigned int j = 0; j < Dimension; ++j)
+      {
+        distance += offset[j] != 0;
+        bufferOffset += offset[j] * offsetTable[j];
+      }
+      if (distance == 0 || (!m_FullyConnected && distance > 1))
+      {
+        continue;
+      }
+      neighbors.push_back({ offset, bufferOffset });
+      (bufferOffset < 0 ? previousNeighbors : laterNeighbors).push_back({ offset, bufferOffset });
+    }
+  }
+
+  // A value propagated into a neighboring slab.
+  struct MessageType
+  {
+    OffsetValueType      BufferOffset;
+    OutputImagePixelType Value;
+  };
+  using MessageListType = std::vector<MessageType>;
+
+  // The slabs of slices [Begin, End) along the last dimension.
+  struct SlabType
+  {
+    IndexValueType              Begin;
+    IndexValueType              End;
+    std::queue<OffsetValueType> Fifo;
+    MessageListType             SentToPrevious;
+    MessageListType             SentToNext;
+    MessageListType             ReceivedFromPrevious;
+    MessageListType             ReceivedFromNext;
+  };
+  const auto numberOfSlabs = std::min<SizeValueType>(this->GetNumberOfWorkUnits(), size[SlabDimension]);
+  std::vector<SlabType> slabs(numberOfSlabs);
+  for (SizeValueType s = 0; s < numberOfSlabs; ++s)
+  {
+    slabs[s].Begin = static_cast<IndexValueType>(s * size[SlabDimension] / numberOfSlabs);
+    slabs[s].End = static_cast<IndexValueType>((s + 1) * size[SlabDimension] / numberOfSlabs);
+  }
+
+  enum class LocationEnum
+  {
+    Outside,
+    InSlab,
+    PreviousSlab,
+    NextSlab
+  };
+  // Where the neighbor at offset of the pixel at index lies.
+  const auto locate = [&size](const SlabType & slab, const OutputImageIndexType & index, const OffsetType & offset) {
+    for (unsigned int j = 0; j < SlabDimension; ++j)
+    {
+      const IndexValueType i = index[j] + offset[j];
+      if (i < 0 || i >= static_cast<IndexValueType>(size[j]))
+      {
+        return LocationEnum::Outside;
+      }
+    }
+    const IndexValueType i = index[SlabDimension] + offset[SlabDimension];
+    if (i < 0 || i >= static_cast<IndexValueType>(size[SlabDimension]))
+    {
+      return LocationEnum::Outside;
+    }
+    if (i < slab.Begin)
+    {
+      return LocationEnum::PreviousSlab;
+    }
+    return i < slab.End ? LocationEnum::InSlab : LocationEnum::NextSlab;
+  };
+  // Whether all the neighbors of the pixel at index are in the slab.
+  const auto isInner = [&size](const SlabType & slab, const OutputImageIndexType & index) {
+    for (unsigned int j = 0; j < SlabDimension; ++j)
+    {
+      if (index[j] < 1 || index[j] >= static_cast<IndexValueType>(size[j]) - 1)
+      {
+        return false;
+      }
+    }
+    return index[SlabDimension] > slab.Begin && index[SlabDimension] < slab.End - 1;
+  };
+  // The index, from the start of the region, of the pixel at offset.
+  const auto computeIndex = [&offsetTable](OffsetValueType offset) {
+    OutputImageIndexType index;
+    for (unsigned int j = Dimension - 1; j > 0; --j)
+    {
+      index[j] = offset / offsetTable[j];
+      offset -= index[j] * offsetTable[j];
+    }
+    index[0] = offset;
+    return index;
+  };
+  // The value propagated from value into the pixel at offset.
+  const auto clamp = [compare, mask](OutputImagePixelType value, OffsetValueType offset) {
+    const auto maskValue = static_cast<OutputImagePixelType>(mask[offset]);
+    return compare(value, maskValue) ? maskValue : value;
+  };
+
+  // Propagate the values of the pixels of the FIFO of the slab, sending the
+  // values that propagate into the neighboring slabs.
+  const auto propagate = [&](SlabType & slab) {
+    while (!slab.Fifo.empty())
+    {
+      const OffsetValueType offset = slab.Fifo.front();
+      slab.Fifo.pop();
+      const OutputImageIndexType index = computeIndex(offset);
+      const bool                 inner = isInner(slab, index);
+      const OutputImagePixelType value = values[offset];
+      for (const NeighborType & neighbor : neighbors)
+      {
+        const LocationEnum location = inner ? LocationEnum::InSlab : locate(slab, index, neighbor.Offset);
+        if (location == LocationEnum::Outside)
+        {
+          continue;
+        }
+        const OffsetValueType      neighborOffset = offset + neighbor.BufferOffset;
+        const OutputImagePixelType propagated = clamp(value, neighborOffset);
+        if (location == LocationEnum::InSlab)
+        {
+          if (compare(propagated, values[neighborOffset]))
+          {
+            values[neighborOffset] = propagated;
+            slab.Fifo.push(neighborOffset);
+          }
+        }
+        else if (compare(propagated, static_cast<OutputImagePixelType>(marker[neighborOffset])))
+        {
+          // The neighbor may only be read by its slab, which keeps the value
+          // if it is larger than its own.
+          (location == LocationEnum::PreviousSlab ? slab.SentToPrevious : slab.SentToNext)
+            .push_back({ neighborOffset, propagated });
+        }
+      }
+    }
+  };
+
+  // Take in the values received from the neighboring slabs.
+  const auto receive = [&](SlabType & slab, MessageListType & messages) {
+    for (const MessageType & message : messages)
+    {
+      if (compare(message.Value, values[message.BufferOffset]))
+      {
+        values[message.BufferOffset] = message.Value;
+        slab.Fifo.push(message.BufferOffset);
+      }
+    }
+    messages.clear();
+  };
+
+  // Reconstruct each slab on its own, with the raster, antiraster and FIFO
+  // steps of the serial algorithm, ignoring the other slabs.
+  std::atomic<bool> markerIsValid{ true };
+  ProgressTransformer reconstructionProgress(0.0f, 0.9f, this);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType s) {
+      SlabType &            slab = slabs[s];
+      const OffsetValueType begin = slab.Begin * offsetTable[SlabDimension];
+      const OffsetValueType end = slab.End * offsetTable[SlabDimension];
+
+      OutputImageIndexType index{};
+      index[SlabDimension] = slab.Begin;
+      for (OffsetValueType offset = begin; offset < end; ++offset)
+      {
+        auto value = static_cast<OutputImagePixelType>(marker[offset]);
+        if (compare(value, static_cast<OutputImagePixelType>(mask[offset])))
+        {
+          markerIsValid = false;
+        }
+        const bool inner = isInner(slab, index);
+        for (const NeighborType & neighbor : previousNeighbors)
+        {
+          if (inner || locate(slab, index, neighbor.Offset) == LocationEnum::InSlab)
+          {
+            const OutputImagePixelType neighborValue = values[offset + neighbor.BufferOffset];
+            if (compare(neighborValue, value))
+            {
+              value = neighborValue;
+            }
+          }
+        }
+        values[offset] = clamp(value, offset);
+
+        for (unsigned int j = 0; j < Dimension && ++index[j] == static_cast<IndexValueType>(size[j]); ++j)
+        {
+          if (j < SlabDimension)
+          {
+            index[j] = 0;
+          }
+        }
+      }
+
+      index = computeIndex(end - 1);
+      for (OffsetValueType offset = end - 1; offset >= begin; --offset)
+      {
+        const bool           inner = isInner(slab, index);
+        OutputImagePixelType value = values[offset];
+        for (const NeighborType & neighbor : laterNeighbors)
+        {
+          if (inner || locate(slab, index, neighbor.Offset) == LocationEnum::InSlab)
+          {
+            const OutputImagePixelType neighborValue = values[offset + neighbor.BufferOffset];
+            if (compare(neighborValue, value))
+            {
+              value = neighborValue;
+            }
+          }
+        }
+        value = clamp(value, offset);
+        values[offset] = value;
+
+        for (const NeighborType & neighbor : laterNeighbors)
+        {
+          if (inner || locate(slab, index, neighbor.Offset) == LocationEnum::InSlab)
+          {
+            const OffsetValueType neighborOffset = offset + neighbor.BufferOffset;
+            if (compare(clamp(value, neighborOffset), values[neighborOffset]))
+            {
+              slab.Fifo.push(offset);
+              break;
+            }
+          }
+        }
+
+        for (unsigned int j = 0; j < Dimension && --index[j] < 0; ++j)
+        {
+          if (j < SlabDimension)
+          {
+            index[j] = static_cast<IndexValueType>(size[j]) - 1;
+          }
+        }
+      }
+
+      propagate(slab);
+    },
+    reconstructionProgress.GetProcessObject());
+
+  if (!markerIsValid)
+  {
+    if (compare(0, 1))
+    {
+      itkExceptionStringMacro("Marker pixels must be <= mask pixels.");
+    }
+    else
+    {
+      itkExceptionStringMacro("Marker pixels must be >= mask pixels.");
+    }
+  }
+
+  // Send the values of the pixels of the first and last slices of the slabs
+  // that propagate into the neighboring slabs, which are only read here.
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType s) {
+      SlabType & slab = slabs[s];
+      const auto sendSlice = [&](IndexValueType slice) {
+        const OffsetValueType begin = slice * offsetTable[SlabDimension];
+        for (OffsetValueType offset = begin; offset < begin + offsetTable[SlabDimension]; ++offset)
+        {
+          const OutputImageIndexType index = computeIndex(offset);
+          for (const NeighborType & neighbor : neighbors)
+          {
+            const LocationEnum location = locate(slab, index, neighbor.Offset);
+            if (location == LocationEnum::PreviousSlab || location == LocationEnum::NextSlab)
+            {
+              const OffsetValueType      neighborOffset = offset + neighbor.BufferOffset;
+              const OutputImagePixelType propagated = clamp(values[offset], neighborOffset);
+              if (compare(propagated, values[neighborOffset]))
+              {
+                (location == LocationEnum::PreviousSlab ? slab.SentToPrevious : slab.SentToNext)
+                  .push_back({ neighborOffset, propagated });
+              }
+            }
+          }
+        }
+      };
+      sendSlice(slab.Begin);
+      if (slab.End - 1 > slab.Begin)
+      {
+        sendSlice(slab.End - 1);
+      }
+    },
+    nullptr);
+
+  // Exchange the values sent between the slabs, until they are all stable.
+  while (true)
+  {
+    bool sent = false;
+    for (SizeValueType s = 0; s < numberOfSlabs; ++s)
+    {
+      if (s > 0)
+      {
+        slabs[s].ReceivedFromPrevious.swap(slabs[s - 1].SentToNext);
+      }
+      if (s + 1 < numberOfSlabs)
+      {
+        slabs[s].ReceivedFromNext.swap(slabs[s + 1].SentToPrevious);
+      }
+      sent = sent || !slabs[s].ReceivedFromPrevious.empty() || !slabs[s].ReceivedFromNext.empty();
+    }
+    if (!sent)
+    {
+      break;
+    }
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType s) {
+        SlabType & slab = slabs[s];
+        receive(slab, slab.ReceivedFromPrevious);
+        receive(slab, slab.ReceivedFromNext);
+        propagate(slab);
+      },
+      nullptr);
+  }
+}
+
 template <typename TInputImage, typename TOutputImage, typename TCompare>
 void
 ReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::PrintSelf(std::ostream & os, Indent indent) const
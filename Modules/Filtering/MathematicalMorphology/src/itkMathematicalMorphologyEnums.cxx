@@ -36,10 +36,30 @@ operator<<(std::ostream & out, const MathematicalMorphologyEnums::Algorithm valu
         return "itk::MathematicalMorphologyEnums::Algorithm::ANCHOR";
       case MathematicalMorphologyEnums::Algorithm::VHGW:
         return "itk::MathematicalMorphologyEnums::Algorithm::VHGW";
+      case MathematicalMorphologyEnums::Algorithm::CHORD:
+        return "itk::MathematicalMorphologyEnums::Algorithm::CHORD";
       default:
         return "INVALID VALUE FOR itk::MathematicalMorphologyEnums::Algorithm";
     }
   }();
 }
 
+std::ostream &
+operator<<(std::ostream & out, const MathematicalMorphologyEnums::BinaryAlgorithm value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case MathematicalMorphologyEnums::BinaryAlgorithm::AUTOMATIC:
+        return "itk::MathematicalMorphologyEnums::BinaryAlgorithm::AUTOMATIC";
+      case MathematicalMorphologyEnums::BinaryAlgorithm::SURFACE:
+        return "itk::MathematicalMorphologyEnums::BinaryAlgorithm::SURFACE";
+      case MathematicalMorphologyEnums::BinaryAlgorithm::DISTANCE_MAP:
+        return "itk::MathematicalMorphologyEnums::BinaryAlgorithm::DISTANCE_MAP";
+      default:
+        return "INVALID VALUE FOR itk::MathematicalMorphologyEnums::BinaryAlgorithm";
+    }
+  }();
+}
+
 } // end namespace itk
@@ -0,0 +1,212 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Compares the erosions and dilations by flat structuring elements decomposed
+// into chords with those of the basic algorithm, for balls, annuli and random
+// structuring elements, on images that do not start at the origin, with
+// several work units and boundary values.
+
+#include "itkChordDilateImageFilter.h"
+#include "itkChordErodeImageFilter.h"
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+#include <string>
+
+namespace
+{
+
+using PixelType = short;
+
+template <unsigned int VDimension>
+typename itk::Image<PixelType, VDimension>::Pointer
+MakeImage(const itk::Size<VDimension> & size)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+
+  auto                           image = ImageType::New();
+  typename ImageType::RegionType region(size);
+  region.SetIndex(0, -3);
+  region.SetIndex(VDimension - 1, 5);
+  image->SetRegions(region);
+  image->Allocate();
+
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> noise(-1000, 1000);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<PixelType>(noise(generator)));
+  }
+  return image;
+}
+
+// A structuring element whose elements are on with a probability of one half.
+template <unsigned int VDimension>
+itk::FlatStructuringElement<VDimension>
+MakeRandomKernel(const typename itk::FlatStructuringElement<VDimension>::RadiusType & radius)
+{
+  itk::FlatStructuringElement<VDimension> kernel;
+  kernel.SetRadius(radius);
+
+  std::mt19937                       generator(7);
+  std::uniform_int_distribution<int> coin(0, 1);
+  for (itk::SizeValueType n = 0; n < kernel.Size(); ++n)
+  {
+    kernel[n] = coin(generator) == 1;
+  }
+  return kernel;
+}
+
+// Run the grayscale filter with the chords and with the basic algorithm, and
+// compare their outputs.
+template <typename TFilter>
+bool
+CompareWithBasic(const typename TFilter::InputImageType * image,
+                 const typename TFilter::KernelType &     kernel,
+                 const char *                             name,
+                 itk::ThreadIdType                        numberOfWorkUnits,
+                 bool                                     defaultBoundary)
+{
+  using ImageType = typename TFilter::OutputImageType;
+
+  std::string className;
+  const auto  run = [&](typename TFilter::AlgorithmEnum algorithm) {
+    auto filter = TFilter::New();
+    filter->SetInput(image);
+    filter->SetKernel(kernel);
+    filter->SetAlgorithm(algorithm);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    if (!defaultBoundary)
+    {
+      filter->SetBoundary(0);
+    }
+    filter->Update();
+    className = filter->GetNameOfClass();
+    return typename ImageType::Pointer(filter->GetOutput());
+  };
+  const typename ImageType::Pointer expected = run(TFilter::AlgorithmEnum::BASIC);
+  const typename ImageType::Pointer output = run(TFilter::AlgorithmEnum::CHORD);
+
+  itk::SizeValueType numberOfDifferences = 0;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != expected->GetPixel(it.GetIndex()))
+    {
+      if (numberOfDifferences == 0)
+      {
+        std::cerr << className << ", " << name << " kernel, " << numberOfWorkUnits
+                  << " work units, default boundary: " << defaultBoundary << ": at " << it.GetIndex() << ", expected "
+                  << expected->GetPixel(it.GetIndex()) << ", but got " << it.Get() << std::endl;
+      }
+      ++numberOfDifferences;
+    }
+  }
+  if (numberOfDifferences > 0)
+  {
+    std::cerr << numberOfDifferences << " pixels differ" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <unsigned int VDimension>
+bool
+CompareKernels(const itk::Size<VDimension> & size)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+  using DilateType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>;
+  using ErodeType = itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>;
+
+  const auto image = MakeImage<VDimension>(size);
+
+  auto radius = itk::MakeFilled<typename KernelType::RadiusType>(3);
+  radius[0] = 4;
+
+  const std::pair<const char *, KernelType> kernels[] = {
+    { "ball", KernelType::Ball(radius) },
+    { "annulus", KernelType::Annulus(radius, 1, true) },
+    { "random", MakeRandomKernel<VDimension>(radius) },
+    { "box", KernelType::Box(radius) },
+    { "point", KernelType::Box(itk::MakeFilled<typename KernelType::RadiusType>(0)) }
+  };
+
+  bool passed = true;
+  for (const auto & kernel : kernels)
+  {
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 16 })
+    {
+      for (const bool defaultBoundary : { true, false })
+      {
+        passed &= CompareWithBasic<DilateType>(image, kernel.second, kernel.first, numberOfWorkUnits, defaultBoundary);
+        passed &= CompareWithBasic<ErodeType>(image, kernel.second, kernel.first, numberOfWorkUnits, defaultBoundary);
+      }
+    }
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkChordErodeDilateImageFilterTest(int, char *[])
+{
+  constexpr unsigned int Dimension{ 3 };
+
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using KernelType = itk::FlatStructuringElement<Dimension>;
+
+  auto filter = itk::ChordDilateImageFilter<ImageType, KernelType>::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, ChordDilateImageFilter, ChordErodeDilateImageFilter);
+
+  ITK_TEST_EXPECT_EQUAL(filter->GetBoundary(), itk::NumericTraits<PixelType>::NonpositiveMin());
+  auto erode = itk::ChordErodeImageFilter<ImageType, KernelType>::New();
+  ITK_TEST_EXPECT_EQUAL(erode->GetBoundary(), itk::NumericTraits<PixelType>::max());
+
+  // A ball of radius 2 has a chord on each line of its box, but the four in
+  // its corners.
+  const auto radius = itk::MakeFilled<KernelType::RadiusType>(2);
+  filter->SetKernel(KernelType::Ball(radius));
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfChords(), 21);
+
+  // The flat kernels that are not decomposable into lines are decomposed into
+  // chords.
+  auto dilate = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>::New();
+  dilate->SetKernel(KernelType::Ball(radius));
+  ITK_TEST_EXPECT_TRUE(dilate->GetAlgorithm() == itk::MathematicalMorphologyEnums::Algorithm::CHORD);
+  dilate->SetKernel(KernelType::Box(radius));
+  ITK_TEST_EXPECT_TRUE(dilate->GetAlgorithm() == itk::MathematicalMorphologyEnums::Algorithm::ANCHOR);
+
+  bool passed = true;
+  passed &= CompareKernels<2>(itk::MakeSize(37, 29));
+  passed &= CompareKernels<3>(itk::MakeSize(17, 11, 13));
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -29,13 +29,25 @@ itkMathematicalMorphologyEnumsTest(int, char *[])
     itk::MathematicalMorphologyEnums::Algorithm::BASIC,
     itk::MathematicalMorphologyEnums::Algorithm::HISTO,
     itk::MathematicalMorphologyEnums::Algorithm::ANCHOR,
-    itk::MathematicalMorphologyEnums::Algorithm::VHGW
+    itk::MathematicalMorphologyEnums::Algorithm::VHGW,
+    itk::MathematicalMorphologyEnums::Algorithm::CHORD
   };
   for (const auto & ee : allAlgorithm)
   {
     std::cout << "STREAMED ENUM VALUE MathematicalMorphologyEnums::Algorithm: " << ee << std::endl;
   }
 
+  // Test streaming enumeration for MathematicalMorphologyEnums::BinaryAlgorithm elements
+  const std::set<itk::MathematicalMorphologyEnums::BinaryAlgorithm> allBinaryAlgorithm{
+    itk::MathematicalMorphologyEnums::BinaryAlgorithm::AUTOMATIC,
+    itk::MathematicalMorphologyEnums::BinaryAlgorithm::SURFACE,
+    itk::MathematicalMorphologyEnums::BinaryAlgorithm::DISTANCE_MAP
+  };
+  for (const auto & ee : allBinaryAlgorithm)
+  {
+    std::cout << "STREAMED ENUM VALUE MathematicalMorphologyEnums::BinaryAlgorithm: " << ee << std::endl;
+  }
+
 
   std::cout << "Test finished" << std::endl;
   return EXIT_SUCCESS;
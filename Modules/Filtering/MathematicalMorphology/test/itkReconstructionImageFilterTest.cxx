@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Compares the reconstructions by dilation and by erosion computed in
+// parallel, slab by slab, with those of the serial algorithm, on images where
+// the values propagate back and forth across the slabs.
+
+#include "itkReconstructionByDilationImageFilter.h"
+#include "itkReconstructionByErosionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <random>
+
+namespace
+{
+
+using PixelType = short;
+
+// A noisy image with a dark corridor that winds up and down along the last
+// dimension, and is open on the border of the image.
+template <unsigned int VDimension>
+typename itk::Image<PixelType, VDimension>::Pointer
+MakeImage(const itk::Size<VDimension> & size)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> noise(100, 140);
+
+  constexpr unsigned int Last = VDimension - 1;
+  const auto             height = static_cast<itk::IndexValueType>(size[Last]);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto index = it.GetIndex();
+
+    // Vertical runs at every fourth column, joined alternately at the top
+    // and at the bottom, and entered from the first column.
+    bool inCorridor = index[0] % 4 == 2 && index[Last] >= 2 && index[Last] < height - 2;
+    if (index[0] >= 2)
+    {
+      const itk::IndexValueType joint = (index[0] - 2) / 4;
+      inCorridor |= index[Last] == (joint % 2 == 0 ? height - 3 : 2) &&
+                    4 * joint + 6 < static_cast<itk::IndexValueType>(size[0]);
+    }
+    inCorridor |= index[Last] == 2 && index[0] <= 2;
+    for (unsigned int j = 1; j < Last; ++j)
+    {
+      inCorridor &= index[j] == static_cast<itk::IndexValueType>(size[j] / 2);
+    }
+    it.Set(static_cast<PixelType>(inCorridor ? 50 : noise(generator)));
+  }
+  return image;
+}
+
+// Run the reconstruction filter on marker and mask with several numbers of
+// work units, and compare the outputs with that of a single work unit.
+template <typename TFilter>
+bool
+CompareWorkUnits(const typename TFilter::MarkerImageType * marker,
+                 const typename TFilter::MaskImageType *   mask,
+                 bool                                      fullyConnected)
+{
+  using ImageType = typename TFilter::OutputImageType;
+
+  auto serial = TFilter::New();
+  serial->SetMarkerImage(marker);
+  serial->SetMaskImage(mask);
+  serial->SetFullyConnected(fullyConnected);
+  serial->SetNumberOfWorkUnits(1);
+  serial->Update();
+  const ImageType * expected = serial->GetOutput();
+
+  bool passed = true;
+  for (const unsigned int numberOfWorkUnits : { 2, 3, 7, 64 })
+  {
+    auto filter = TFilter::New();
+    filter->SetMarkerImage(marker);
+    filter->SetMaskImage(mask);
+    filter->SetFullyConnected(fullyConnected);
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Update();
+
+    itk::SizeValueType numberOfDifferences = 0;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(filter->GetOutput(),
+                                                               filter->GetOutput()->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != expected->GetPixel(it.GetIndex()))
+      {
+        if (numberOfDifferences == 0)
+        {
+          std::cerr << filter->GetNameOfClass() << " with " << numberOfWorkUnits
+                    << " work units, fully connected: " << fullyConnected << ": at " << it.GetIndex() << ", expected "
+                    << expected->GetPixel(it.GetIndex()) << ", but got " << it.Get() << std::endl;
+        }
+        ++numberOfDifferences;
+      }
+    }
+    if (numberOfDifferences > 0)
+    {
+      std::cerr << numberOfDifferences << " pixels differ" << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+template <unsigned int VDimension>
+bool
+CompareReconstructions(const itk::Size<VDimension> & size)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+
+  const auto image = MakeImage<VDimension>(size);
+
+  // The marker of the h-maxima: the image lowered by a height.
+  auto lowered = ImageType::New();
+  lowered->SetRegions(image->GetBufferedRegion());
+  lowered->Allocate();
+
+  // The marker of the filling of the holes: the maximum of the image, but on
+  // its border.
+  auto filled = ImageType::New();
+  filled->SetRegions(image->GetBufferedRegion());
+  filled->Allocate();
+
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto index = it.GetIndex();
+    lowered->SetPixel(index, static_cast<PixelType>(it.Get() - 15));
+
+    bool onBorder = false;
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      onBorder |= index[j] == 0 || index[j] == static_cast<itk::IndexValueType>(size[j]) - 1;
+    }
+    filled->SetPixel(index, onBorder ? it.Get() : itk::NumericTraits<PixelType>::max());
+  }
+
+  using DilationType = itk::ReconstructionByDilationImageFilter<ImageType, ImageType>;
+  using ErosionType = itk::ReconstructionByErosionImageFilter<ImageType, ImageType>;
+
+  bool passed = true;
+  for (const bool fullyConnected : { false, true })
+  {
+    passed &= CompareWorkUnits<DilationType>(lowered, image, fullyConnected);
+    passed &= CompareWorkUnits<ErosionType>(filled, image, fullyConnected);
+  }
+
+  // The corridor is open on the border, so its pixels are not filled.
+  auto erosion = ErosionType::New();
+  erosion->SetMarkerImage(filled);
+  erosion->SetMaskImage(image);
+  erosion->SetNumberOfWorkUnits(4);
+  erosion->Update();
+  auto index = itk::Index<VDimension>::Filled(0);
+  for (unsigned int j = 1; j < VDimension - 1; ++j)
+  {
+    index[j] = static_cast<itk::IndexValueType>(size[j] / 2);
+  }
+  index[0] = 2 + 4 * ((size[0] - 5) / 4);
+  index[VDimension - 1] = static_cast<itk::IndexValueType>(size[VDimension - 1] / 2);
+  if (erosion->GetOutput()->GetPixel(index) != 50)
+  {
+    std::cerr << "The corridor is filled at " << index << ": " << erosion->GetOutput()->GetPixel(index) << std::endl;
+    passed = false;
+  }
+  return passed;
+}
+
+} // namespace
+
+int
+itkReconstructionImageFilterTest(int, char *[])
+{
+  bool passed = true;
+  passed &= CompareReconstructions<2>(itk::MakeSize(61, 50));
+  passed &= CompareReconstructions<3>(itk::MakeSize(23, 9, 40));
+
+  // The marker must be below the mask for the reconstruction by dilation.
+  using ImageType = itk::Image<PixelType, 3>;
+  const auto image = MakeImage<3>(itk::MakeSize(10, 10, 10));
+  auto       filter = itk::ReconstructionByDilationImageFilter<ImageType, ImageType>::New();
+  filter->SetMarkerImage(image);
+  filter->SetMaskImage(MakeImage<3>(itk::MakeSize(10, 10, 10)));
+  image->SetPixel({ { 5, 5, 5 } }, 200);
+  filter->SetNumberOfWorkUnits(3);
+  ITK_TRY_EXPECT_EXCEPTION(filter->Update());
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
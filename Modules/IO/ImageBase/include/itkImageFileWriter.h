@@ -23,6 +23,7 @@
 #include "itkImageIOBase.h"
 #include "itkMacro.h"
 #include "itkMetaProgrammingLibrary.h"
+#include "itkParallelStreamingExecutor.h"
 
 namespace itk
 {
@@ -67,8 +68,21 @@ public:
  * with a suitable suffix (".png", ".jpg", etc) and setting the input
  * to the writer is enough to get the writer to work properly.
  *
+ * By default, the pieces requested with NumberOfStreamDivisions are
+ * updated and written one after another.  When NumberOfPiecesInFlight is
+ * greater than one and a PipelineFactory is set, up to
+ * NumberOfPiecesInFlight pieces are updated at the same time, each by its
+ * own instance of the upstream pipeline, while the updated pieces are
+ * written in order.  The input of the writer updates the first piece in
+ * flight, and the PipelineFactory builds the instances for the others.  The
+ * instances must not share data objects; to share an input image, graft it
+ * into a new image in each instance.  The size of the pieces in flight,
+ * estimated from the size of the pixels written, is limited by
+ * MemoryBudget.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
+ * \sa ParallelStreamingExecutor
  *
  * \ingroup IOFilters
  * \ingroup ITKIOImageBase
@@ -167,6 +181,34 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
   /** @ITKEndGrouping */
+
+  /** Instances of the upstream pipeline, built by the PipelineFactory. */
+  using PipelineType = ParallelStreamingExecutor::PipelineType;
+  using PipelineFactoryType = ParallelStreamingExecutor::PipelineFactoryType;
+
+  /** Set/Get the maximum number of pieces updated at the same time.
+   * Defaults to one. */
+  /** @ITKStartGrouping */
+  itkSetClampMacro(NumberOfPiecesInFlight, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfPiecesInFlight, unsigned int);
+  /** @ITKEndGrouping */
+
+  /** Set/Get the maximum estimated size, in bytes, of the pieces in flight.
+   * Defaults to 256 MiB. */
+  /** @ITKStartGrouping */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+  /** @ITKEndGrouping */
+
+  /** Set the function that builds the instances of the upstream pipeline
+   * for the pieces in flight other than the first.  The primary output of
+   * the last filter of an instance must be a TInputImage. */
+  void
+  SetPipelineFactory(PipelineFactoryType factory)
+  {
+    m_PipelineFactory = std::move(factory);
+    this->Modified();
+  }
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   void
@@ -222,6 +264,17 @@ protected:
   GenerateData() override;
 
 private:
+  /** Write the IO region of input. */
+  void
+  WriteImage(const InputImageType * input);
+
+  /** Update and write the numDivisions pieces of pasteIORegion, with up to
+   * NumberOfPiecesInFlight pieces in flight. */
+  void
+  WritePiecesInFlight(unsigned int          numDivisions,
+                      const ImageIORegion & pasteIORegion,
+                      const ImageIORegion & largestIORegion);
+
   std::string m_FileName{};
 
   ImageIOBase::Pointer m_ImageIO{};
@@ -235,6 +288,10 @@ private:
   bool m_UseCompression{ false };
   int  m_CompressionLevel{ -1 };
   bool m_UseInputMetaDataDictionary{ true };
+
+  unsigned int        m_NumberOfPiecesInFlight{ 1 };
+  SizeValueType       m_MemoryBudget{ SizeValueType{ 256 } << 20 };
+  PipelineFactoryType m_PipelineFactory{};
 };
 
 
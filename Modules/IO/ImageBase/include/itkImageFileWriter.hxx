@@ -31,6 +31,7 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include <algorithm>
 #include <complex>
 
 namespace itk
@@ -261,7 +262,13 @@ ImageFileWriter<TInputImage>::Write()
    * piece, and copy the results into the output image.
    */
 
-  for (unsigned int piece = 0; piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
+  const bool piecesInFlight = m_NumberOfPiecesInFlight > 1 && m_PipelineFactory && numDivisions > 1;
+  if (piecesInFlight)
+  {
+    this->WritePiecesInFlight(numDivisions, pasteIORegion, largestIORegion);
+  }
+
+  for (unsigned int piece = 0; !piecesInFlight && piece < numDivisions && !this->GetAbortGenerateData(); ++piece)
   {
     // get the actual piece to write
     ImageIORegion streamIORegion =
@@ -324,12 +331,94 @@ ImageFileWriter<TInputImage>::Write()
   this->ReleaseInputs();
 }
 
+//---------------------------------------------------------
+template <typename TInputImage>
+void
+ImageFileWriter<TInputImage>::WritePiecesInFlight(unsigned int          numDivisions,
+                                                  const ImageIORegion & pasteIORegion,
+                                                  const ImageIORegion & largestIORegion)
+{
+  const InputImageRegionType largestRegion = this->GetInput()->GetLargestPossibleRegion();
+
+  std::vector<ImageIORegion>        streamIORegions;
+  std::vector<InputImageRegionType> streamRegions(numDivisions);
+  for (unsigned int piece = 0; piece < numDivisions; ++piece)
+  {
+    streamIORegions.push_back(m_ImageIO->GetSplitRegionForWriting(piece, numDivisions, pasteIORegion, largestIORegion));
+    if (!pasteIORegion.IsInside(streamIORegions.back()))
+    {
+      itkExceptionMacro(
+        << "ImageIO returns streamable region that is not fully contain in paste IO region. Paste IO region: "
+        << pasteIORegion << "Streamable region: " << streamIORegions.back());
+    }
+    ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(
+      streamIORegions.back(), streamRegions[piece], largestRegion.GetIndex());
+  }
+
+  // One instance of the upstream pipeline per piece in flight.
+  std::vector<PipelineType>     pipelines;
+  std::vector<InputImageType *> inputs{ const_cast<InputImageType *>(this->GetInput()) };
+  while (inputs.size() < std::min(m_NumberOfPiecesInFlight, numDivisions))
+  {
+    pipelines.push_back(m_PipelineFactory());
+    auto * const input = ParallelStreamingExecutor::GetOutput<InputImageType>(pipelines.back());
+    if (input == nullptr)
+    {
+      itkExceptionMacro("The pipeline factory built a pipeline whose output is not a "
+                        << inputs.front()->GetNameOfClass());
+    }
+    input->UpdateOutputInformation();
+    if (input->GetLargestPossibleRegion() != largestRegion)
+    {
+      itkExceptionMacro("The pipeline factory built a pipeline whose output has the largest possible region "
+                        << input->GetLargestPossibleRegion() << " instead of " << largestRegion);
+    }
+    inputs.push_back(input);
+  }
+
+  const SizeValueType pixelBytes = m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+  const auto          pieceBytes = [&streamRegions, pixelBytes](unsigned int piece) -> SizeValueType {
+    return streamRegions[piece].GetNumberOfPixels() * pixelBytes;
+  };
+
+  // The pieces are updated concurrently, and written in order.
+  const auto updatePiece = [this, &inputs, &streamRegions](unsigned int worker, unsigned int piece) {
+    if (!this->GetAbortGenerateData())
+    {
+      inputs[worker]->SetRequestedRegion(streamRegions[piece]);
+      inputs[worker]->PropagateRequestedRegion();
+      inputs[worker]->UpdateOutputData();
+    }
+  };
+  const auto writePiece = [this, &inputs, &streamIORegions, numDivisions](unsigned int worker, unsigned int piece) {
+    if (!this->GetAbortGenerateData())
+    {
+      m_ImageIO->SetIORegion(streamIORegions[piece]);
+      this->WriteImage(inputs[worker]);
+      if (worker == 0)
+      {
+        this->UpdateProgress(static_cast<float>(piece + 1) / static_cast<float>(numDivisions));
+      }
+    }
+  };
+
+  ParallelStreamingExecutor::Execute(
+    numDivisions, static_cast<unsigned int>(inputs.size()), m_MemoryBudget, pieceBytes, updatePiece, writePiece);
+}
+
 //---------------------------------------------------------
 template <typename TInputImage>
 void
 ImageFileWriter<TInputImage>::GenerateData()
 {
-  const InputImageType *     input = this->GetInput();
+  this->WriteImage(this->GetInput());
+}
+
+//---------------------------------------------------------
+template <typename TInputImage>
+void
+ImageFileWriter<TInputImage>::WriteImage(const InputImageType * input)
+{
   const InputImageRegionType largestRegion = input->GetLargestPossibleRegion();
   InputImagePointer          cacheImage;
 
@@ -392,6 +481,9 @@ ImageFileWriter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "PasteIORegion: " << m_PasteIORegion << std::endl;
   os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
+  os << indent << "NumberOfPiecesInFlight: " << m_NumberOfPiecesInFlight << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "PipelineFactory: " << (m_PipelineFactory ? "(set)" : "(none)") << std::endl;
   os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
   itkPrintSelfBooleanMacro(UseCompression);
   itkPrintSelfBooleanMacro(UseInputMetaDataDictionary);
@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileWriter.h"
+#include "itkImageFileReader.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkShiftScaleImageFilter.h"
+
+#include "itkGTest.h"
+#include "itksys/SystemTools.hxx"
+#include "itkTestDriverIncludeRequiredFactories.h"
+
+#define _STRING(s) #s
+#define TOSTRING(s) _STRING(s)
+
+namespace
+{
+
+using ImageType = itk::Image<float, 3>;
+using WriterType = itk::ImageFileWriter<ImageType>;
+
+struct ITKImageFileWriterPiecesInFlightTest : public ::testing::Test
+{
+  void
+  SetUp() override
+  {
+    RegisterRequiredFactories();
+    itksys::SystemTools::ChangeDirectory(TOSTRING(ITK_TEST_OUTPUT_DIR));
+  }
+
+  static ImageType::Pointer
+  MakeImage()
+  {
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::SizeType{ { 16, 12, 20 } });
+    image->Allocate();
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType & index = it.GetIndex();
+      it.Set(static_cast<float>(index[0] + 100 * index[1] + 10000 * index[2]));
+    }
+    return image;
+  }
+
+  // Adds one to a graft of image, so that several instances can share it.
+  static WriterType::PipelineType
+  MakePipeline(const ImageType * image)
+  {
+    auto input = ImageType::New();
+    input->Graft(image);
+    auto filter = itk::ShiftScaleImageFilter<ImageType, ImageType>::New();
+    filter->SetInput(input);
+    filter->SetShift(1.0);
+    return { filter.GetPointer() };
+  }
+};
+
+} // namespace
+
+
+TEST_F(ITKImageFileWriterPiecesInFlightTest, WritesPiecesInOrder)
+{
+  const std::string fileName = "ImageFileWriterPiecesInFlight.mha";
+  const auto        image = MakeImage();
+  const auto        pipeline = MakePipeline(image);
+
+  auto writer = WriterType::New();
+  writer->SetInput(itk::ParallelStreamingExecutor::GetOutput<ImageType>(pipeline));
+  writer->SetFileName(fileName);
+  writer->SetNumberOfStreamDivisions(10);
+  writer->SetNumberOfPiecesInFlight(3);
+  writer->SetPipelineFactory([&image] { return MakePipeline(image); });
+  writer->Update();
+
+  const auto written = itk::ReadImage<ImageType>(fileName);
+  ASSERT_EQ(written->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> writtenIt(written, written->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> imageIt(image, image->GetLargestPossibleRegion());
+  for (; !imageIt.IsAtEnd(); ++writtenIt, ++imageIt)
+  {
+    ASSERT_EQ(writtenIt.Get(), imageIt.Get() + 1.0f);
+  }
+}
@@ -144,10 +144,11 @@ SpatialNeighborSubsampler<TSample, TRegion>::Search(const InstanceIdentifier & q
   // are ordered as if someone was iterating forward through the region
   // TODO Is this a safe assumption to make?
 
+  // The offset is needed for the next positions even when the query, at the
+  // first one, is not selected.
+  ImageHelperType::ComputeOffset(this->m_SampleRegion.GetIndex(), positionIndex, offsetTable, offset);
   if (this->m_CanSelectQuery || (positionIndex != queryIndex))
   {
-    offset = 0;
-    ImageHelperType::ComputeOffset(this->m_SampleRegion.GetIndex(), positionIndex, offsetTable, offset);
     results->AddInstance(static_cast<InstanceIdentifier>(offset));
   }
 
@@ -189,5 +189,31 @@ itkSpatialNeighborSubsamplerTest(int, char *[])
 
   std::cout << "All pixels and only pixels within intersection of"
             << " the image region and constraint region are equal to 255." << std::endl;
+
+  // A query at the first point of the search, that cannot be selected, must
+  // not shift the other points.
+  queryIdx[0] = 0;
+  queryIdx[1] = 5;
+  sampler->CanSelectQueryOff();
+  sampler->Search(inImage->ComputeOffset(queryIdx), subsample);
+
+  validSz[0] = 11;
+  const RegionType cornerRegion{ queryIdx, validSz };
+  if (subsample->Size() != cornerRegion.GetNumberOfPixels() - 1)
+  {
+    std::cout << "Error! " << subsample->Size() << " points sampled around the corner instead of "
+              << cornerRegion.GetNumberOfPixels() - 1 << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (SamplerType::SubsampleConstIterator sIt = subsample->Begin(); sIt != subsample->End(); ++sIt)
+  {
+    const IndexType index = sIt.GetMeasurementVector()[0].GetIndex();
+    if (!cornerRegion.IsInside(index) || index == queryIdx)
+    {
+      std::cout << "Error! Point " << index << " sampled around the corner" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -74,6 +74,7 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4<TFixedImage,
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Correlation window radius: " << m_Radius << std::endl;
+  itkPrintSelfBooleanMacro(UseBoxSums);
 }
 
 } // end namespace itk
@@ -25,6 +25,7 @@
 
 #include <deque>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -46,6 +47,9 @@ struct IdentityHelper
  * its derivative incrementally inside the window. The sparse threader uses a sampled point set partitioner to
  * computer local cross correlation only at the sampled positions.
  *
+ * The dense threader can alternatively evaluate each block of its region with
+ * separable box sums, see \c ANTSNeighborhoodCorrelationImageToImageMetricv4::SetUseBoxSums.
+ *
  * This threader class is designed to host the dense and sparse threader under the same name so most computation
  * routine functions and interior member variables can be shared. This eliminates the need to duplicate codes
  * for two threaders. This is made by using function overloading and a helper class to identify different types of
@@ -145,6 +149,42 @@ public:
     RadiusType                              radius;
   };
 
+  // Local sums of one neighborhood window, used by the box sum evaluation
+  struct BoxSumType
+  {
+    QueueRealType sumFixed2{};
+    QueueRealType sumMoving2{};
+    QueueRealType sumFixed{};
+    QueueRealType sumMoving{};
+    QueueRealType sumFixedMoving{};
+    QueueRealType count{};
+
+    BoxSumType &
+    operator+=(const BoxSumType & other)
+    {
+      sumFixed2 += other.sumFixed2;
+      sumMoving2 += other.sumMoving2;
+      sumFixed += other.sumFixed;
+      sumMoving += other.sumMoving;
+      sumFixedMoving += other.sumFixedMoving;
+      count += other.count;
+      return *this;
+    }
+
+    BoxSumType &
+    operator-=(const BoxSumType & other)
+    {
+      sumFixed2 -= other.sumFixed2;
+      sumMoving2 -= other.sumMoving2;
+      sumFixed -= other.sumFixed;
+      sumMoving -= other.sumMoving;
+      sumFixedMoving -= other.sumFixedMoving;
+      count -= other.count;
+      return *this;
+    }
+  };
+  using BoxSumBufferType = std::vector<BoxSumType>;
+
 protected:
   ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader()
     : m_ANTSAssociate(nullptr)
@@ -247,6 +287,21 @@ protected:
   void
   ThreadedExecution_impl(IdentityHelper<T> itkNotUsed(self), const DomainType & domain, const ThreadIdType threadId);
 
+  /** Dense evaluation of one thread region with separable box sums. The
+   * region is split into slabs along the last dimension; each slab, padded
+   * by the radius, is sampled once and then box summed in place. */
+  void
+  ThreadedExecutionWithBoxSums(const DomainType & virtualImageSubRegion, const ThreadIdType threadId);
+
+  /** Sample fixed and moving values at every index of \c region into \c buffer. */
+  void
+  SampleRegionIntoBoxSumBuffer(const ImageRegionType & region, BoxSumBufferType & buffer) const;
+
+  /** Replace every entry of \c buffer, which covers \c region, by the sum of
+   * the entries within the radius along each dimension. */
+  void
+  BoxSumBuffer(const ImageRegionType & region, BoxSumBufferType & buffer) const;
+
   /** Common functions for computing correlation over scanning windows **/
 
   /** Create an iterator over the virtual sub region */
@@ -287,6 +342,11 @@ protected:
                                const ScanParametersType & scanParameters,
                                const ThreadIdType         threadId) const;
 
+  /** Compute the centered window statistics from the window sums and
+   * evaluate the images at the window center \c index. */
+  bool
+  ComputeInformationFromSums(const VirtualIndexType & index, const BoxSumType & sums, ScanMemType & scanMem) const;
+
   void
   ComputeMovingTransformDerivative(const ScanIteratorType &   scanIt,
                                    ScanMemType &              scanMem,
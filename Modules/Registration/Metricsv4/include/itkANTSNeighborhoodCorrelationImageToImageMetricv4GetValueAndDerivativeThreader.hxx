@@ -18,6 +18,9 @@
 #ifndef itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 #define itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -41,6 +44,12 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
 
   std::call_once(this->m_ANTSAssociateOnceFlag, [this, &associate]() { this->m_ANTSAssociate = associate; });
 
+  if (associate->GetUseBoxSums())
+  {
+    this->ThreadedExecutionWithBoxSums(virtualImageSubRegion, threadId);
+    return;
+  }
+
   VirtualPointType   virtualPoint;
   MeasureType        metricValueResult{};
   MeasureType        metricValueSum{};
@@ -385,40 +394,35 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
 
   constexpr LocalRealType localZero{};
 
-  LocalRealType count = localZero;
+  BoxSumType sums;
 
   auto itcount = scanMem.Qcount.begin();
   while (itcount != scanMem.Qcount.end())
   {
-    count += *itcount;
+    sums.count += *itcount;
     ++itcount;
   }
 
-  if (count <= localZero)
+  if (sums.count <= localZero)
   {
     // no points available in the queue, perhaps out of image region
     return false;
   }
 
   // If there are values, we need to calculate the different quantities
-  LocalRealType sumFixed2 = localZero;
-  LocalRealType sumMoving2 = localZero;
-  LocalRealType sumFixed = localZero;
-  LocalRealType sumMoving = localZero;
-  LocalRealType sumFixedMoving = localZero;
-  auto          itFixed2 = scanMem.QsumFixed2.begin();
-  auto          itMoving2 = scanMem.QsumMoving2.begin();
-  auto          itFixed = scanMem.QsumFixed.begin();
-  auto          itMoving = scanMem.QsumMoving.begin();
-  auto          itFixedMoving = scanMem.QsumFixedMoving.begin();
+  auto itFixed2 = scanMem.QsumFixed2.begin();
+  auto itMoving2 = scanMem.QsumMoving2.begin();
+  auto itFixed = scanMem.QsumFixed.begin();
+  auto itMoving = scanMem.QsumMoving.begin();
+  auto itFixedMoving = scanMem.QsumFixedMoving.begin();
 
   while (itFixed2 != scanMem.QsumFixed2.end())
   {
-    sumFixed2 += *itFixed2;
-    sumMoving2 += *itMoving2;
-    sumFixed += *itFixed;
-    sumMoving += *itMoving;
-    sumFixedMoving += *itFixedMoving;
+    sums.sumFixed2 += *itFixed2;
+    sums.sumMoving2 += *itMoving2;
+    sums.sumFixed += *itFixed;
+    sums.sumMoving += *itMoving;
+    sums.sumFixedMoving += *itFixedMoving;
 
     ++itFixed2;
     ++itMoving2;
@@ -427,6 +431,27 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
     ++itFixedMoving;
   }
 
+  return this->ComputeInformationFromSums(scanIt.GetIndex(), sums, scanMem);
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+bool
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TNeighborhoodCorrelationMetric>::ComputeInformationFromSums(const VirtualIndexType & oindex,
+                                                              const BoxSumType &       sums,
+                                                              ScanMemType &            scanMem) const
+{
+  using LocalRealType = InternalComputationValueType;
+
+  const LocalRealType count = sums.count;
+  const LocalRealType sumFixed2 = sums.sumFixed2;
+  const LocalRealType sumMoving2 = sums.sumMoving2;
+  const LocalRealType sumFixed = sums.sumFixed;
+  const LocalRealType sumMoving = sums.sumMoving;
+  const LocalRealType sumFixedMoving = sums.sumFixedMoving;
+
   const LocalRealType fixedMean = sumFixed / count;
   const LocalRealType movingMean = sumMoving / count;
 
@@ -437,8 +462,6 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   const LocalRealType sFixedMoving =
     sumFixedMoving - movingMean * sumFixed - fixedMean * sumMoving + count * movingMean * fixedMean;
 
-  const typename VirtualImageType::IndexType oindex = scanIt.GetIndex();
-
   VirtualPointType        virtualPoint;
   FixedImagePointType     mappedFixedPoint;
   FixedImagePixelType     fixedImageValue;
@@ -575,6 +598,215 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+void
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TNeighborhoodCorrelationMetric>::ThreadedExecutionWithBoxSums(const DomainType & virtualImageSubRegion,
+                                                                const ThreadIdType threadId)
+{
+  constexpr unsigned int Dimension = TImageToImageMetric::VirtualImageDimension;
+  constexpr unsigned int SlabDimension = Dimension - 1;
+
+  // Target number of padded pixels per block. With six sums per pixel this
+  // keeps the block buffer at a few megabytes.
+  constexpr SizeValueType blockNumberOfPixels = 1 << 18;
+
+  const RadiusType      radius = this->m_ANTSAssociate->GetRadius();
+  const ImageRegionType virtualRegion = this->m_ANTSAssociate->GetVirtualRegion();
+
+  // Choose the slab thickness so that the padded block fits the target, but
+  // never thinner than the window, so that the 2 * radius halo slices that
+  // are sampled again for each slab less than double the sampling work.
+  SizeValueType slicePixels = 1;
+  for (unsigned int d = 0; d < SlabDimension; ++d)
+  {
+    slicePixels *= virtualImageSubRegion.GetSize(d) + 2 * radius[d];
+  }
+  const SizeValueType window = 2 * radius[SlabDimension] + 1;
+  SizeValueType       slabThickness = blockNumberOfPixels / std::max(slicePixels, SizeValueType{ 1 });
+  slabThickness = std::max(slabThickness, window + 2 * radius[SlabDimension]) - 2 * radius[SlabDimension];
+
+  MeasureType      metricValueResult{};
+  MeasureType      metricValueSum{};
+  ScanIteratorType scanIt;
+  ScanMemType      scanMem;
+  BoxSumBufferType buffer;
+
+  scanMem.fixedImageGradient.Fill(0.0);
+  scanMem.movingImageGradient.Fill(0.0);
+  scanMem.mappedMovingPoint.Fill(0.0);
+
+  DerivativeType & localDerivativeResult = this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives;
+
+  const IndexValueType regionEnd = virtualImageSubRegion.GetIndex(SlabDimension) +
+                                   static_cast<IndexValueType>(virtualImageSubRegion.GetSize(SlabDimension));
+  for (IndexValueType slabBegin = virtualImageSubRegion.GetIndex(SlabDimension); slabBegin < regionEnd;
+       slabBegin += static_cast<IndexValueType>(slabThickness))
+  {
+    ImageRegionType block = virtualImageSubRegion;
+    block.SetIndex(SlabDimension, slabBegin);
+    block.SetSize(SlabDimension, std::min(slabThickness, static_cast<SizeValueType>(regionEnd - slabBegin)));
+
+    // Samples outside the virtual region do not contribute, as with the queues.
+    ImageRegionType paddedBlock = block;
+    paddedBlock.PadByRadius(radius);
+    paddedBlock.Crop(virtualRegion);
+
+    this->SampleRegionIntoBoxSumBuffer(paddedBlock, buffer);
+    this->BoxSumBuffer(paddedBlock, buffer);
+
+    for (ImageRegionConstIteratorWithIndex<VirtualImageType> it(this->m_ANTSAssociate->GetVirtualImage(), block);
+         !it.IsAtEnd();
+         ++it)
+    {
+      const VirtualIndexType & index = it.GetIndex();
+      SizeValueType            bufferOffset = 0;
+      SizeValueType            stride = 1;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        bufferOffset += static_cast<SizeValueType>(index[d] - paddedBlock.GetIndex(d)) * stride;
+        stride *= paddedBlock.GetSize(d);
+      }
+      const BoxSumType & sums = buffer[bufferOffset];
+      if (sums.count <= QueueRealType{})
+      {
+        continue;
+      }
+
+      bool pointIsValid = false;
+      try
+      {
+        pointIsValid = this->ComputeInformationFromSums(index, sums, scanMem);
+        if (pointIsValid)
+        {
+          this->ComputeMovingTransformDerivative(
+            scanIt, scanMem, ScanParametersType(), localDerivativeResult, metricValueResult, threadId);
+        }
+      }
+      catch (const ExceptionObject & exc)
+      {
+        std::string msg("Caught exception: \n");
+        msg += exc.what();
+        throw ExceptionObject(__FILE__, __LINE__, msg);
+      }
+
+      if (pointIsValid)
+      {
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+        metricValueSum -= metricValueResult;
+        if (this->GetComputeDerivative())
+        {
+          this->StorePointDerivativeResult(index, threadId);
+        }
+      }
+    }
+  }
+
+  this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure = metricValueSum;
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+void
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TNeighborhoodCorrelationMetric>::SampleRegionIntoBoxSumBuffer(const ImageRegionType & region,
+                                                                BoxSumBufferType &      buffer) const
+{
+  buffer.assign(region.GetNumberOfPixels(), BoxSumType());
+
+  VirtualPointType     virtualPoint;
+  FixedImagePointType  mappedFixedPoint;
+  FixedImagePixelType  fixedImageValue;
+  MovingImagePointType mappedMovingPoint;
+  MovingImagePixelType movingImageValue;
+
+  auto bufferIt = buffer.begin();
+  for (ImageRegionConstIteratorWithIndex<VirtualImageType> it(this->m_ANTSAssociate->GetVirtualImage(), region);
+       !it.IsAtEnd();
+       ++it, ++bufferIt)
+  {
+    this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(it.GetIndex(), virtualPoint);
+    try
+    {
+      if (this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue) &&
+          this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue))
+      {
+        BoxSumType & sample = *bufferIt;
+        sample.sumFixed2 = fixedImageValue * fixedImageValue;
+        sample.sumMoving2 = movingImageValue * movingImageValue;
+        sample.sumFixed = fixedImageValue;
+        sample.sumMoving = movingImageValue;
+        sample.sumFixedMoving = fixedImageValue * movingImageValue;
+        sample.count = NumericTraits<QueueRealType>::OneValue();
+      }
+    }
+    catch (const ExceptionObject & exc)
+    {
+      std::string msg("Caught exception: \n");
+      msg += exc.what();
+      throw ExceptionObject(__FILE__, __LINE__, msg);
+    }
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
+void
+ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TNeighborhoodCorrelationMetric>::BoxSumBuffer(const ImageRegionType & region, BoxSumBufferType & buffer) const
+{
+  const RadiusType radius = this->m_ANTSAssociate->GetRadius();
+
+  BoxSumBufferType line;
+  SizeValueType    stride = 1;
+  for (unsigned int d = 0; d < TImageToImageMetric::VirtualImageDimension; ++d)
+  {
+    const SizeValueType length = region.GetSize(d);
+    const SizeValueType r = radius[d];
+    const SizeValueType lineSpan = stride * length;
+    const SizeValueType numberOfOuterLines = buffer.size() / lineSpan;
+    line.resize(length);
+
+    // Running window sum along every line of dimension d. Lines in the
+    // fastest dimension are contiguous; the others are visited in
+    // contiguous groups of stride lines to keep the access pattern linear.
+    for (SizeValueType outer = 0; outer < numberOfOuterLines; ++outer)
+    {
+      for (SizeValueType inner = 0; inner < stride; ++inner)
+      {
+        const SizeValueType base = outer * lineSpan + inner;
+        for (SizeValueType i = 0; i < length; ++i)
+        {
+          line[i] = buffer[base + i * stride];
+        }
+
+        BoxSumType windowSum;
+        for (SizeValueType i = 0; i < std::min(r, length); ++i)
+        {
+          windowSum += line[i];
+        }
+        for (SizeValueType i = 0; i < length; ++i)
+        {
+          if (i + r < length)
+          {
+            windowSum += line[i + r];
+          }
+          buffer[base + i * stride] = windowSum;
+          if (i >= r)
+          {
+            windowSum -= line[i - r];
+          }
+        }
+      }
+    }
+    stride = lineSpan;
+  }
+}
+
 /*
  * Specific implementation for sparse threader. It reuse most of the routine from the dense threader by
  * reinitializing the scanning at every point.
@@ -350,6 +350,49 @@ itkANTSNeighborhoodCorrelationImageToImageMetricv4Test(int, char ** const)
       fixedImage, derivativeReturn, ImageDimension);
   }
 
+  /* Compare the dense threader using box sums to the dense threader using queues */
+  const MetricTypePointer metricBoxSums = MetricType::New();
+  ITK_TEST_SET_GET_BOOLEAN(metricBoxSums, UseBoxSums, false);
+  metricBoxSums->UseBoxSumsOn();
+  for (const itk::SizeValueType radiusValue : { 1, 2 })
+  {
+    const auto boxSumRadius = itk::Size<ImageDimension>::Filled(radiusValue);
+    metric->SetRadius(boxSumRadius);
+    metricBoxSums->SetRadius(boxSumRadius);
+    metricBoxSums->SetFixedImage(fixedImage);
+    metricBoxSums->SetMovingImage(movingImage);
+    metricBoxSums->SetFixedTransform(transformFId);
+    metricBoxSums->SetMovingTransform(transformMdisplacement);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(metric->Initialize());
+    ITK_TRY_EXPECT_NO_EXCEPTION(metricBoxSums->Initialize());
+
+    MetricType::MeasureType    valueReturnQueues = NAN;
+    MetricType::DerivativeType derivativeReturnQueues;
+    ITK_TRY_EXPECT_NO_EXCEPTION(metric->GetValueAndDerivative(valueReturnQueues, derivativeReturnQueues));
+
+    MetricType::MeasureType    valueReturnBoxSums = NAN;
+    MetricType::DerivativeType derivativeReturnBoxSums;
+    ITK_TRY_EXPECT_NO_EXCEPTION(metricBoxSums->GetValueAndDerivative(valueReturnBoxSums, derivativeReturnBoxSums));
+
+    std::cout << "radius " << radiusValue << " queues: " << valueReturnQueues << ", box sums: " << valueReturnBoxSums
+              << std::endl;
+    ITK_TEST_EXPECT_EQUAL(metric->GetNumberOfValidPoints(), metricBoxSums->GetNumberOfValidPoints());
+    if (!itk::Math::FloatAlmostEqual(valueReturnQueues, valueReturnBoxSums, 4, tolerance))
+    {
+      std::cerr << "Results for Value don't match using queues and box sums: " << valueReturnQueues << ", (box sums) "
+                << valueReturnBoxSums << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!derivativeReturnQueues.is_equal(derivativeReturnBoxSums, tolerance))
+    {
+      std::cerr << "Results for derivative don't match using queues and box sums." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  metric->SetRadius(neighborhoodRadius);
+  ITK_TRY_EXPECT_NO_EXCEPTION(metric->Initialize());
+
   // Test that non-overlapping images will generate a warning
   // and return max value for metric value.
   DisplacementTransformType::ParametersType parameters(